@@ -0,0 +1,399 @@
+//
+//  crxs_bench: reproducible benchmarks of CRXS.
+//
+//      kernel      single pp kernels and helper functions, evaluated on fixed pseudo-random points
+//      dE          energy-differential cross sections, for each integration method
+//      table       regeneration of the KDD18 antiproton table (write_kdd18_tab/write.py) on a reduced grid
+//
+//  Usage:  crxs_bench [--quick] [--full] [--repetitions N] [--filter NAME] [--output FILE]
+//
+//  Every benchmark is repeated and the fastest repetition is reported, as ns/point and points/s, in JSON (stdout or FILE).
+//  The points and the configuration are fixed, so the results of different releases can be compared directly.
+//
+
+#include "math.h"
+#include "stdio.h"
+#include "string.h"
+#include "stdlib.h"
+
+#include "iostream"
+#include "string"
+#include "vector"
+#include "sstream"
+#include "chrono"
+#include "algorithm"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+
+using namespace CRXS;
+
+
+//  ------------------------------------------------------------- #
+//   Points                                                       #
+//  ------------------------------------------------------------- #
+
+//  Linear congruential generator with a fixed seed, identical points on all platforms
+struct bench__random{
+    unsigned long long state;
+    bench__random( unsigned long long seed ) : state(seed) {}
+    double uniform( double a, double b ){
+        state = state*6364136223846793005ULL + 1442695040888963407ULL;
+        return a + (b-a)*( (state>>11)*(1./9007199254740992.) );
+    }
+    double log_uniform( double a, double b ){
+        return exp( uniform( log(a), log(b) ) );
+    }
+};
+
+//  CM frame points of the pp kernels: sqrt(s) in [5, 1000] GeV, xF in [-0.8, 0.8], pT in [0.01, 2] GeV
+struct bench__points_CM{
+    std::vector<double> s, xF, E, pT;
+    bench__points_CM( int n, double mass ) : s(n), xF(n), E(n), pT(n) {
+        bench__random random( 1 );
+        for (int i=0; i<n; i++) {
+            double sq__s = random.log_uniform( 5., 1000. );
+            s [i] = sq__s*sq__s;
+            xF[i] = random.uniform( -0.8, 0.8 );
+            pT[i] = random.log_uniform( 0.01, 2. );
+            double pL = xF[i]*sq__s/2.;
+            E [i] = sqrt( mass*mass + pT[i]*pT[i] + pL*pL );
+        }
+    }
+};
+
+//  LAB frame points: Tn_proj in [10, 1e5] GeV, T_prod in [0.1, Tn_proj/2], eta in [0, 10]
+struct bench__points_LAB{
+    std::vector<double> Tn_proj, T, eta;
+    bench__points_LAB( int n, double T_min=0.1 ) : Tn_proj(n), T(n), eta(n) {
+        bench__random random( 2 );
+        for (int i=0; i<n; i++) {
+            Tn_proj[i] = random.log_uniform( 10., 1e5 );
+            T      [i] = random.log_uniform( T_min, Tn_proj[i]/2. );
+            eta    [i] = random.uniform( 0., 10. );
+        }
+    }
+};
+
+
+//  ------------------------------------------------------------- #
+//   Timing and output                                            #
+//  ------------------------------------------------------------- #
+
+struct bench__result{
+    std::string name;
+    std::string group;
+    std::string method;
+    long        points;
+    double      seconds;    // fastest repetition
+    double      checksum;   // sum of all results, to compare releases and to keep the compiler from removing the loops
+};
+
+struct bench__options{
+    int         repetitions;
+    bool        quick;
+    bool        full;
+    std::string filter;
+    std::string output;
+};
+
+typedef double (*bench__function)( void* data );
+
+static double bench__seconds( bench__function function, void* data, double& checksum ){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    checksum = function( data );
+    return std::chrono::duration<double>( std::chrono::steady_clock::now()-start ).count();
+}
+
+static void bench__run( std::vector<bench__result>& results, const bench__options& options, const char* group, const char* name, const char* method, long points, bench__function function, void* data, int repetitions=-1 ){
+    std::string full_name = std::string(name) + (method[0] ? std::string("/")+method : std::string(""));
+    if ( !options.filter.empty() && full_name.find(options.filter)==std::string::npos ) {
+        return;
+    }
+    if (repetitions<0) {
+        repetitions = options.repetitions;
+    }
+    double checksum = 0;
+    bench__seconds( function, data, checksum );     // warm up: tables, caches, CPU frequency
+    double best = 1e100;
+    for (int r=0; r<repetitions; r++) {
+        best = std::min( best, bench__seconds( function, data, checksum ) );
+    }
+    bench__result result = { name, group, method, points, best, checksum };
+    results.push_back( result );
+    fprintf( stderr, "%-8s %-45s %12.1f ns/point\n", group, full_name.c_str(), best/points*1e9 );
+}
+
+static std::string bench__json( const std::vector<bench__result>& results, const bench__options& options ){
+    std::ostringstream out;
+    char line[1024];
+    out << "{\n";
+    out << "  \"context\": {\n";
+    snprintf( line, sizeof(line), "    \"compiler\": \"%s\",\n", __VERSION__ );                     out << line;
+    snprintf( line, sizeof(line), "    \"simd\": %i,\n", CRXS_config::Get_SIMD() );                 out << line;
+    snprintf( line, sizeof(line), "    \"repetitions\": %i,\n", options.repetitions );              out << line;
+    snprintf( line, sizeof(line), "    \"size\": \"%s\"\n", options.quick ? "quick" : ( options.full ? "full" : "default" ) ); out << line;
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (unsigned i=0; i<results.size(); i++) {
+        const bench__result& r = results[i];
+        snprintf( line, sizeof(line), "    { \"name\": \"%s\", \"group\": \"%s\", \"method\": \"%s\", \"points\": %li, \"seconds\": %.6e, \"ns_per_point\": %.6e, \"points_per_second\": %.6e, \"checksum\": %.15e }%s\n",
+                  r.name.c_str(), r.group.c_str(), r.method.c_str(), r.points, r.seconds, r.seconds/r.points*1e9, r.points/r.seconds, r.checksum, i+1<results.size() ? "," : "" );
+        out << line;
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return out.str();
+}
+
+
+//  ------------------------------------------------------------- #
+//   Kernels                                                      #
+//  ------------------------------------------------------------- #
+
+struct bench__kernel_data{
+    bench__points_CM*   CM;
+    bench__points_LAB*  LAB;
+    std::vector<double> x;
+};
+
+static double bench__Winkler( void* data ){
+    bench__points_CM& p = *((bench__kernel_data*)data)->CM;
+    double* C = XS_definitions::Get_C_parameters( KORSMEIER_II );
+    double sum = 0;
+    for (unsigned i=0; i<p.s.size(); i++) sum += XS_definitions::inv_pp_pbar_CM__Winkler( p.s[i], p.E[i], p.pT[i], C );
+    return sum;
+}
+
+static double bench__diMauro( void* data ){
+    bench__points_CM& p = *((bench__kernel_data*)data)->CM;
+    double* C = XS_definitions::Get_C_parameters( DI_MAURO_I );
+    double sum = 0;
+    for (unsigned i=0; i<p.s.size(); i++) sum += XS_definitions::inv_pp_pbar_CM__diMauro( p.s[i], p.E[i], p.pT[i], C );
+    return sum;
+}
+
+static double bench__Anderson( void* data ){
+    bench__points_CM& p = *((bench__kernel_data*)data)->CM;
+    double sum = 0;
+    for (unsigned i=0; i<p.s.size(); i++) sum += XS_definitions::inv_pp_p_CM__Anderson( p.s[i], p.E[i], p.pT[i] );
+    return sum;
+}
+
+static double bench__factor_AA( void* data ){
+    bench__points_CM& p = *((bench__kernel_data*)data)->CM;
+    double sum = 0;
+    for (unsigned i=0; i<p.s.size(); i++) sum += XS_definitions::factor__AA( p.s[i], p.xF[i], 4, 2, 1, 0, KORSMEIER_II );
+    return sum;
+}
+
+static double bench__convert_LAB_to_CM( void* data ){
+    bench__points_LAB& p = *((bench__kernel_data*)data)->LAB;
+    double sum = 0;
+    double s, E, pT, xF;
+    for (unsigned i=0; i<p.T.size(); i++) {
+        XS::convert_LAB_to_CM( p.Tn_proj[i], p.T[i], p.eta[i], s, E, pT, xF, P_BAR );
+        sum += xF;
+    }
+    return sum;
+}
+
+static double bench__tot_pbarp( void* data ){
+    std::vector<double>& x = ((bench__kernel_data*)data)->x;
+    double sum = 0;
+    for (unsigned i=0; i<x.size(); i++) sum += XS_definitions::tot_pbarp( x[i] );
+    return sum;
+}
+
+static double bench__batch__tot_pbarp( void* data ){
+    std::vector<double>& x = ((bench__kernel_data*)data)->x;
+    std::vector<double>  result( x.size() );
+    XS_definitions::batch__tot_pbarp( x.size(), &x[0], &result[0] );
+    double sum = 0;
+    for (unsigned i=0; i<x.size(); i++) sum += result[i];
+    return sum;
+}
+
+static void bench__kernels( std::vector<bench__result>& results, const bench__options& options ){
+    int n = options.quick ? 100000 : 1000000;
+    bench__points_CM    CM_pbar( n, XS_definitions::fMass_proton );
+    bench__points_LAB   LAB    ( n );
+    bench__kernel_data  data;
+    data.CM  = &CM_pbar;
+    data.LAB = &LAB;
+    bench__random random( 3 );
+    for (int i=0; i<n; i++) data.x.push_back( random.log_uniform( 0.1, 1e4 ) );
+
+    bench__run( results, options, "kernel", "inv_pp_pbar_CM__Winkler",        "", n, bench__Winkler,             &data );
+    bench__run( results, options, "kernel", "inv_pp_pbar_CM__diMauro",        "", n, bench__diMauro,             &data );
+    bench__run( results, options, "kernel", "inv_pp_p_CM__Anderson",          "", n, bench__Anderson,            &data );
+    bench__run( results, options, "kernel", "factor__AA",                     "", n, bench__factor_AA,           &data );
+    bench__run( results, options, "kernel", "convert_LAB_to_CM",              "", n, bench__convert_LAB_to_CM,   &data );
+    bench__run( results, options, "kernel", "tot_pbarp",                      "", n, bench__tot_pbarp,           &data );
+    bench__run( results, options, "kernel", "batch__tot_pbarp",               "", n, bench__batch__tot_pbarp,    &data );
+}
+
+
+//  ------------------------------------------------------------- #
+//   Energy-differential cross sections                           #
+//  ------------------------------------------------------------- #
+
+typedef double (*bench__dE_function)( double Tn_proj_LAB, double T_LAB );
+
+struct bench__dE_data{
+    bench__points_LAB*  LAB;
+    bench__dE_function  function;
+    XS_engine*          engine;
+};
+
+static double bench__dE( void* data ){
+    bench__dE_data& d = *(bench__dE_data*)data;
+    XS_engine::Scope scope( *d.engine );
+    double sum = 0;
+    for (unsigned i=0; i<d.LAB->T.size(); i++) sum += d.function( d.LAB->Tn_proj[i], d.LAB->T[i] );
+    return sum;
+}
+
+static double bench__dE_AA_pbar_LAB                   ( double Tn, double T ){ return XS::dE_AA_pbar_LAB                   ( Tn, T, 1, 0, 1, 0, KORSMEIER_II ); }
+static double bench__dE_AA_pbar_LAB_incNbarAndHyperon ( double Tn, double T ){ return XS::dE_AA_pbar_LAB_incNbarAndHyperon ( Tn, T, 4, 2, 1, 0, KORSMEIER_II ); }
+static double bench__dE_AA_p_LAB                      ( double Tn, double T ){ return XS::dE_AA_p_LAB                      ( Tn, T, 1, 0, 1, 0, ANDERSON     ); }
+static double bench__dE_AA_p_LAB__numerical           ( double Tn, double T ){ return XS::dE_AA_p_LAB__numerical           ( Tn, T, 1, 0, 1, 0, ANDERSON     ); }
+static double bench__dEn_AA_Dbar_LAB                  ( double Tn, double T ){ return XS::dEn_AA_Dbar_LAB                  ( Tn, T, 1, 0, 1, 0, KORSMEIER_II, ENERGY_DEP__VAN_DOETINCHEM ); }
+static double bench__dEn_AA_He3bar_LAB                ( double Tn, double T ){ return XS::dEn_AA_He3bar_LAB                ( Tn, T, 1, 0, 1, 0, KORSMEIER_II, ENERGY_DEP__VAN_DOETINCHEM ); }
+static double bench__dEn_AA_He4bar_LAB                ( double Tn, double T ){ return XS::dEn_AA_He4bar_LAB                ( Tn, T, 1, 0, 1, 0, KORSMEIER_II, ENERGY_DEP__VAN_DOETINCHEM ); }
+
+static void bench__energy_differential( std::vector<bench__result>& results, const bench__options& options ){
+
+    //  Integration method which is varied: pbar (XS_engine::fIntegrationMethod), p (fIntegrationMethod_p),
+    //  antinuclei (fIntegrationMethod_antinuclei), or none for the semi-analytic dE_AA_p_LAB
+    enum { METHOD__NONE, METHOD__PBAR, METHOD__P, METHOD__ANTINUCLEI };
+    struct { const char* name; bench__dE_function function; int method; int n; } list[] = {
+        { "dE_AA_pbar_LAB",                   bench__dE_AA_pbar_LAB,                   METHOD__PBAR,       2000 },
+        { "dE_AA_pbar_LAB_incNbarAndHyperon", bench__dE_AA_pbar_LAB_incNbarAndHyperon, METHOD__PBAR,       2000 },
+        { "dE_AA_p_LAB",                      bench__dE_AA_p_LAB,                      METHOD__NONE,       2000 },
+        { "dE_AA_p_LAB__numerical",           bench__dE_AA_p_LAB__numerical,           METHOD__P,           200 },
+        { "dEn_AA_Dbar_LAB",                  bench__dEn_AA_Dbar_LAB,                  METHOD__ANTINUCLEI,  500 },
+        { "dEn_AA_He3bar_LAB",                bench__dEn_AA_He3bar_LAB,                METHOD__ANTINUCLEI,  200 },
+        { "dEn_AA_He4bar_LAB",                bench__dEn_AA_He4bar_LAB,                METHOD__ANTINUCLEI,  200 },
+    };
+    struct { const char* name; int method; } methods[] = { { "GSL", GSL }, { "TRAPEZE", TRAPEZE } };
+
+    for (unsigned f=0; f<sizeof(list)/sizeof(list[0]); f++) {
+        int n = options.quick ? list[f].n/10 : list[f].n;
+        bench__points_LAB LAB( n, 0.5 );
+        for (unsigned m=0; m<sizeof(methods)/sizeof(methods[0]); m++) {
+            if (list[f].method==METHOD__NONE && m>0) break;
+            XS_engine engine;   // default configuration, except for the integration method
+            if (list[f].method==METHOD__PBAR      ) engine.fIntegrationMethod            = methods[m].method;
+            if (list[f].method==METHOD__P         ) engine.fIntegrationMethod_p          = methods[m].method;
+            if (list[f].method==METHOD__ANTINUCLEI) engine.fIntegrationMethod_antinuclei = methods[m].method;
+            bench__dE_data data = { &LAB, list[f].function, &engine };
+            bench__run( results, options, "dE", list[f].name, list[f].method==METHOD__NONE ? "" : methods[m].name, n, bench__dE, &data, std::min( options.repetitions, 3 ) );
+        }
+    }
+}
+
+
+//  ------------------------------------------------------------- #
+//   KDD18 table                                                  #
+//  ------------------------------------------------------------- #
+
+struct bench__table_data{
+    std::vector<double> Tn, T;
+    std::vector<int>    A_projectile, N_projectile, A_target, N_target;
+};
+
+static double bench__table( void* data ){
+    bench__table_data& d = *(bench__table_data*)data;
+    int n_species = d.A_projectile.size();
+    std::vector<double> XS( d.Tn.size()*d.T.size()*n_species );
+    XS::grid__dE_AA_pbar_LAB_incNbarAndHyperon( d.Tn.size(), &d.Tn[0], d.T.size(), &d.T[0], n_species, &d.A_projectile[0], &d.N_projectile[0], &d.A_target[0], &d.N_target[0], &XS[0], KORSMEIER_II, 1 );
+
+    std::ostringstream table;
+    char entry[64];
+    double sum = 0;
+    for (unsigned i_Tn=0; i_Tn<d.Tn.size(); i_Tn++) {
+        for (unsigned i_T=0; i_T<d.T.size(); i_T++) {
+            snprintf( entry, sizeof(entry), " %-23.6e  %-23.6e ", d.Tn[i_Tn], d.T[i_T] );
+            table << entry;
+            for (int i=0; i<n_species; i++) {
+                double xs = XS[ (i_Tn*d.T.size()+i_T)*n_species+i ] * 1e-31;   // conversion from mbarn to m^2
+                snprintf( entry, sizeof(entry), " %-23.6e ", xs );
+                table << entry;
+                sum += xs;
+            }
+            table << "\n";
+        }
+    }
+    return sum*1e31 + 1e-9*table.str().size();
+}
+
+static void bench__KDD18_table( std::vector<bench__result>& results, const bench__options& options ){
+    //  Grid and species of write_kdd18_tab/write.py, every stride-th energy
+    int stride = options.full ? 1 : ( options.quick ? 15 : 5 );
+    bench__table_data data;
+    for (int i=0; i<=150; i+=stride) data.T .push_back( pow( 10, -1+i/30. ) );
+    for (int i=0; i<=210; i+=stride) data.Tn.push_back( pow( 10,    i/30. ) );
+    int Z_projectile[] = { 1, 1, 2, 2, 6, 6, 7, 7, 8, 8, 8 };
+    int A_projectile[] = { 1, 2, 3, 4, 12, 13, 14, 15, 16, 17, 18 };
+    for (int i=0; i<11; i++) {
+        for (int j=0; j<2; j++) {
+            data.A_projectile.push_back( A_projectile[i] );
+            data.N_projectile.push_back( A_projectile[i]-Z_projectile[i] );
+            data.A_target    .push_back( j==0 ? 1 : 4 );
+            data.N_target    .push_back( j==0 ? 0 : 2 );
+        }
+    }
+    long points = data.Tn.size()*data.T.size()*data.A_projectile.size();
+    bench__run( results, options, "table", "KDD18_dE_AA_pbar_LAB_incNbarAndHyperon", "", points, bench__table, &data, 1 );
+}
+
+
+//  ------------------------------------------------------------- #
+//   Main                                                         #
+//  ------------------------------------------------------------- #
+
+int main( int argc, char** argv ){
+
+    bench__options options;
+    options.repetitions = 5;
+    options.quick       = false;
+    options.full        = false;
+    for (int i=1; i<argc; i++) {
+        if      ( !strcmp( argv[i], "--quick" ) )                       options.quick       = true;
+        else if ( !strcmp( argv[i], "--full"  ) )                       options.full        = true;
+        else if ( !strcmp( argv[i], "--repetitions" ) && i+1<argc )     options.repetitions = std::max( 1, atoi( argv[++i] ) );
+        else if ( !strcmp( argv[i], "--filter" ) && i+1<argc )          options.filter      = argv[++i];
+        else if ( !strcmp( argv[i], "--output" ) && i+1<argc )          options.output      = argv[++i];
+        else {
+            fprintf( stderr, "Usage: %s [--quick] [--full] [--repetitions N] [--filter NAME] [--output FILE]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    //  Read the tables of total cross sections now, the messages go to stderr to keep the JSON on stdout clean
+    std::streambuf* cout_buffer = std::cout.rdbuf( std::cerr.rdbuf() );
+    XS_definitions::tot_pbarp( 1. );
+    std::cout.rdbuf( cout_buffer );
+
+    std::vector<bench__result> results;
+    bench__kernels              ( results, options );
+    bench__energy_differential  ( results, options );
+    bench__KDD18_table          ( results, options );
+
+    std::string json = bench__json( results, options );
+    if (options.output.empty()) {
+        printf( "%s", json.c_str() );
+        return 0;
+    }
+    FILE* file = fopen( options.output.c_str(), "w" );
+    if (!file) {
+        fprintf( stderr, "Error in crxs_bench. Cannot write %s\n", options.output.c_str() );
+        return 1;
+    }
+    fprintf( file, "%s", json.c_str() );
+    fclose( file );
+    return 0;
+}
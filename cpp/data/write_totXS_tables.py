@@ -0,0 +1,84 @@
+#! /usr/bin/env python3
+
+#
+#   Writes the tables of total cross sections (table_*.txt) as constexpr arrays to ../src/xs_definitions_tables.h,
+#   which is compiled into the library (XS_definitions::tot_pbarp, ...). Run this script after changing a table:
+#
+#       cd cpp/data; python3 write_totXS_tables.py
+#
+#   The logarithms are computed here with the math library of python (the same libm as the C++ code), so the
+#   interpolation is identical to the former version which read the files at runtime. Values below 1e-100 are set to
+#   1e-100 (log-log interpolation of vanishing cross sections).
+#
+
+import math
+import os
+
+tables = [ ( 'el_pbarp',  'table_ppbar_el.txt',  'elastic            pbar+p XS' ),
+           ( 'tot_pbarp', 'table_ppbar_tot.txt', 'total              pbar+p XS' ),
+           ( 'tot_pbarD', 'table_dpbar_tot.txt', 'total              pbar+D XS' ),
+           ( 'nar_pbarD', 'table_dpbar_nar.txt', 'non-annihilation   pbar+D XS' ) ]
+
+directory   = os.path.dirname( os.path.abspath(__file__) )
+output      = os.path.join( directory, '..', 'src', 'xs_definitions_tables.h' )
+
+
+def read( file ):
+    x, y = [], []
+    for line in open( os.path.join( directory, file ) ):
+        line = line.strip()
+        if line=='' or line[0]=='#' or line[0]=='*':
+            continue
+        columns = line.split()
+        x.append( max( float(columns[0]), 1e-100 ) )
+        y.append( max( float(columns[1]), 1e-100 ) )
+    return x, y
+
+
+def array( name, values ):
+    s = '    static constexpr double %s[%i] = {\n' % ( name, len(values) )
+    for i in range( 0, len(values), 4 ):
+        s += '        ' + ''.join( '%25s,' % repr(v) for v in values[i:i+4] ) + '\n'
+    return s + '    };\n'
+
+
+s  = '//\n'
+s += '//  Internal header (not installed), generated by cpp/data/write_totXS_tables.py from cpp/data/table_*.txt. Do not edit.\n'
+s += '//\n'
+s += '//  Tables of the total cross sections for XS_definitions::el_pbarp, tot_pbarp, tot_pbarD and nar_pbarD: kinetic energy\n'
+s += '//  of the antiproton in GeV (x), cross section in mbarn (y), their natural logarithms, and the coefficients of the linear\n'
+s += '//  interpolation in log-log (4 per interval, see XS_interpolation__table). The grids are uniform in log(x).\n'
+s += '//\n\n'
+s += '#ifndef CRXS__XS_DEFINITIONS_TABLES_H\n'
+s += '#define CRXS__XS_DEFINITIONS_TABLES_H\n\n'
+s += 'namespace CRXS {\n\n'
+
+for name, file, description in tables:
+    x, y    = read( file )
+    n       = len(x)
+    log_x   = [ math.log(v) for v in x ]
+    log_y   = [ math.log(v) for v in y ]
+    step    = ( log_x[-1]-log_x[0] )/(n-1)
+    for i in range(n):
+        if abs( log_x[i] - log_x[0] - i*step ) > 1e-6*step:
+            raise Exception( 'The grid of %s is not uniform in log(x).' % file )
+    coefficients = []
+    for i in range(n-1):
+        coefficients += [ log_y[i], log_y[i+1]-log_y[i], 0.0, 0.0 ]
+
+    s += '    //  %s, %s\n' % ( description, file )
+    s += '    static constexpr int    totXS__%s__n          = %i;\n'   % ( name, n )
+    s += '    static constexpr double totXS__%s__log_x_min  = %s;\n'   % ( name, repr(log_x[0]) )
+    s += '    static constexpr double totXS__%s__inv_dlog_x = %s;\n'   % ( name, repr(1./step)  )
+    s += array( 'totXS__%s__x'            % name, x            )
+    s += array( 'totXS__%s__y'            % name, y            )
+    s += array( 'totXS__%s__log_x'        % name, log_x        )
+    s += array( 'totXS__%s__log_y'        % name, log_y        )
+    s += array( 'totXS__%s__coefficients' % name, coefficients )
+    s += '\n'
+
+s += '}\n\n'
+s += '#endif\n'
+
+open( output, 'w' ).write( s )
+print( 'Wrote %s' % os.path.normpath(output) )
@@ -20,7 +20,8 @@ example_module = Extension('_xs_wrapper',
                            include_dirs=[CDIR+'/cpp/include',numpy_include],
                            library_dirs=[CDIR+'/cpp/lib'],
                            libraries=['CRXS'],
-                           extra_compile_args=['-std=c++11']
+                           extra_compile_args=['-std=c++11','-pthread'],
+                           extra_link_args=['-pthread']
                            )
 
 
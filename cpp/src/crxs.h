@@ -6,17 +6,79 @@
 namespace CRXS {
     
     enum IntegrationMethod{
-        GSL     =  1,
-        TRAPEZE =  2,
+        GSL            =  1,   // adaptive Gauss-Kronrod (gsl_integration_qag)
+        TRAPEZE        =  2,   // midpoint rule with fixed number of steps
+        GSL_QAGIU      =  3,   // adaptive, upper limit infinity (gsl_integration_qagiu)
+        GAUSS_LEGENDRE =  4,   // fixed-order Gauss-Legendre
+        TANH_SINH      =  5,   // double exponential
+        ROMBERG        =  6,   // trapezoidal rule with step halving and Richardson extrapolation, reuses all evaluations
+        AUTOTUNE       =  7,   // rule and nodes per region of (Tn_proj_LAB, T_pbar_LAB) from an XS_autotune (XS::dE_AA_pbar_LAB only)
+    };
+    
+    class XS_autotune;
+    
+    //! Integration variable of the angular integrals (XS::dE_AA_pbar_LAB, XS::dEn_AA_Dbar_LAB, XS::dEn_AA_He3bar_LAB, XS::dEn_AA_He4bar_LAB)
+    enum IntegrationVariable{
+        ETA_LAB        =  1,   // pseudo rapidity eta_LAB in [eta_min, 50]
+        RAPIDITY_LAB   =  2,   // w = sqrt(y_max - y_LAB) with the rapidity y_LAB of the product, cf. XS::kinematics__rapidity_to_eta
+    };
+    
+    //! Instruction set of the vectorized pp kernels (XS_definitions::batch__inv_pp_pbar_CM__Winkler, ...)
+    enum SIMD{
+        SIMD_AUTO   =  0,   // best instruction set supported by the CPU
+        SIMD_NONE   =  1,   // scalar functions
+        SIMD_SSE2   =  2,
+        SIMD_AVX2   =  3,
+        SIMD_AVX512 =  4,
     };
     
     class CRXS_config{
     public:
+        //! Directory of the data files in the source tree. The tables used by the library are compiled into it (XS_definitions::fXS__tot_pbarp, ...).
         static std::string Get_CRXS_DataDir();
-        static int  IntegrationMethod;
-        static void SetupIntegrationMethod( int method ){
-            IntegrationMethod=method;
-        };
+        
+        //  The configuration is stored in XS_engine (see xs_engine.h): the Setup functions act on the engine of the calling
+        //  thread, XS_engine::Current(), the static members refer to the default engine, XS_engine::Default().
+        static int& IntegrationMethod;
+        //! Integration method of the antiproton cross section (XS::dE_AA_pbar_LAB), enum from [GSL, GSL_QAGIU, TRAPEZE (default), GAUSS_LEGENDRE, TANH_SINH, ROMBERG, AUTOTUNE]
+        static void SetupIntegrationMethod( int method );
+        //! Integration method of the numerical proton cross section (XS::dE_AA_p_LAB__numerical), default: GSL. XS::dE_AA_p_LAB (ANDERSON) is evaluated semi-analytically.
+        static void SetupIntegrationMethod_p( int method );
+        //! Integration method of the antinuclei cross sections (XS::dEn_AA_Dbar_LAB, XS::dEn_AA_He3bar_LAB, XS::dEn_AA_He4bar_LAB), default: GSL
+        static void SetupIntegrationMethod_antinuclei( int method );
+        //! Required relative accuracy of the adaptive integration methods (GSL, GSL_QAGIU, TANH_SINH), default: 1e-4
+        static void SetupIntegrationAccuracy( double epsrel );
+        //! Number of nodes of the GAUSS_LEGENDRE integration method, default: 64
+        static void SetupGaussLegendreNodes( int nodes );
+        //! Integration variable of the angular integrals, enum from [ETA_LAB (default), RAPIDITY_LAB]
+        /*!
+         *  RAPIDITY_LAB maps the peak of the integrand at small pT to a smooth bump with a width independent of the product
+         *  energy, such that low-order Gauss-Legendre rules suffice. Integrand evaluations for a relative accuracy of 1e-4
+         *  at all points of Tn_proj_LAB = 10 GeV ... 1 PeV and T_LAB = 0.2 GeV ... 3 TeV (per nucleon):
+         *
+         *                                            GAUSS_LEGENDRE nodes      GSL, epsrel=1e-4 (mean evaluations)
+         *                                            ETA_LAB   RAPIDITY_LAB    ETA_LAB   RAPIDITY_LAB
+         *      dE_AA_pbar_LAB       KORSMEIER_II        96         12            199         24
+         *      dE_AA_pbar_LAB       DI_MAURO_I          96         16            210         41
+         *      dEn_AA_Dbar_LAB      DI_MAURO_I          96         12            205         36
+         *      dEn_AA_Dbar_LAB      KORSMEIER_II       192         48            210         30
+         *      dEn_AA_He3bar_LAB    KORSMEIER_II       192         48            214         37
+         *      dEn_AA_He4bar_LAB    KORSMEIER_II       192         24            218         43
+         *
+         *  For the antinuclei with the Winkler-type parametrizations the reduced CM energies of the coalescence chain cross
+         *  sqrt(s) = 10 GeV within the integration domain, where the factor R of the parametrization is only finitely
+         *  differentiable. This limits the convergence of the fixed rules in both variables.
+         *
+         *  The AUTOTUNE calibration holds for the integration variable it was calibrated with.
+         */
+        static void SetupIntegrationVariable( int variable );
+        //! Calibrated rules of the integration method AUTOTUNE, cf. XS_autotune. The object has to exist as long as it is used.
+        static void SetupAutotune( const XS_autotune* autotune );
+        
+        static int& SIMD;
+        static void SetupSIMD( int level );
+        //! Instruction set used by the vectorized kernels: the requested one (SIMD) if supported by the CPU, otherwise the best supported one.
+        static int  Get_SIMD();
         
     };
     
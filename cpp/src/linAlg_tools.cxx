@@ -1,4 +1,11 @@
 #include "linAlg_tools.h"
+#include "xs_engine.h"
+
+#include "stdio.h"
+#include "map"
+#include "vector"
+
+#include "gsl_integration.h"
 
 namespace CRXS {
     
@@ -108,9 +115,413 @@ namespace CRXS {
         return true;
     }
     
-    int Integration::steps = 1000;
+    
+    //  ------------------------------------------------------------- #
+    //   Convex hull                                                  #
+    //  ------------------------------------------------------------- #
+    
+    ConvexHull::ConvexHull(){
+        Clear();
+    }
+    
+    void ConvexHull::Clear(){
+        fPoints.clear();
+        fFacets.clear();
+        fTolerance = 0;
+        for (int k=0; k<3; k++) {
+            fMin[k] =  1e90;
+            fMax[k] = -1e90;
+        }
+    }
+    
+    void ConvexHull::Add( double x, double y, double z ){
+        double p[3] = { x, y, z };
+        double diagonal = 0;
+        for (int k=0; k<3; k++) {
+            fPoints.push_back( p[k] );
+            if (p[k]<fMin[k]) fMin[k] = p[k];
+            if (p[k]>fMax[k]) fMax[k] = p[k];
+            diagonal += (fMax[k]-fMin[k])*(fMax[k]-fMin[k]);
+        }
+        fTolerance = 1e-10*sqrt(diagonal);
+        
+        if (fFacets.size()) {
+            Insert( Get_nPoints()-1 );
+        }else{
+            Setup_simplex();
+        }
+    }
+    
+    //  Points closer than this distance to the surface are outside, as for LA::inside. The tolerance is absolute (not
+    //  relative to the size of the hull like fTolerance), such that containment is the same as with LA::inside.
+    static const double ConvexHull__inside_tolerance = 1e-10;
+    
+    bool ConvexHull::isInside( double x, double y, double z ) const{
+        if (x<fMin[0] || x>fMax[0]) return false;
+        if (y<fMin[1] || y>fMax[1]) return false;
+        if (z<fMin[2] || z>fMax[2]) return false;
+        if (fFacets.empty())        return false;
+        for (size_t f=0; f<fFacets.size(); f++) {
+            const Facet& F = fFacets[f];
+            if ( F.n[0]*x + F.n[1]*y + F.n[2]*z - F.d > -ConvexHull__inside_tolerance ) return false;
+        }
+        return true;
+    }
+    
+    ConvexHull::Facet ConvexHull::Make_facet( int a, int b, int c ) const{
+        const double* A = &fPoints[3*a];
+        const double* B = &fPoints[3*b];
+        const double* C = &fPoints[3*c];
+        double v1[3] = { B[0]-A[0], B[1]-A[1], B[2]-A[2] };
+        double v2[3] = { C[0]-A[0], C[1]-A[1], C[2]-A[2] };
+        Facet F;
+        F.v[0] = a;
+        F.v[1] = b;
+        F.v[2] = c;
+        LA::cross( v1, v2, F.n );
+        double l = LA::len( F.n );
+        if (l>0) {
+            F.n[0] /= l;
+            F.n[1] /= l;
+            F.n[2] /= l;
+        }
+        F.d = F.n[0]*A[0] + F.n[1]*A[1] + F.n[2]*A[2];
+        return F;
+    }
+    
+    //
+    //  Looks for 4 points which span a volume (a tetrahedron), builds its 4 facets and inserts all other points.
+    //
+    bool ConvexHull::Setup_simplex(){
+        int n = Get_nPoints();
+        if (n<4) {
+            return false;
+        }
+        const double* P = &fPoints[0];
+        
+        // point farthest from point 0
+        int    i1 = -1;
+        double dmax = fTolerance;
+        for (int i=1; i<n; i++) {
+            double v[3] = { P[3*i]-P[0], P[3*i+1]-P[1], P[3*i+2]-P[2] };
+            double d    = LA::len( v );
+            if (d>dmax) { dmax = d; i1 = i; }
+        }
+        if (i1<0) return false;
+        
+        // point farthest from the line through 0 and i1
+        double u[3] = { P[3*i1]-P[0], P[3*i1+1]-P[1], P[3*i1+2]-P[2] };
+        double lu   = LA::len( u );
+        int    i2 = -1;
+        dmax = fTolerance;
+        for (int i=1; i<n; i++) {
+            double v[3] = { P[3*i]-P[0], P[3*i+1]-P[1], P[3*i+2]-P[2] };
+            double c[3];
+            LA::cross( u, v, c );
+            double d    = LA::len( c )/lu;
+            if (d>dmax) { dmax = d; i2 = i; }
+        }
+        if (i2<0) return false;
+        
+        // point farthest from the plane through 0, i1, and i2
+        Facet  base = Make_facet( 0, i1, i2 );
+        int    i3 = -1;
+        dmax = fTolerance;
+        for (int i=1; i<n; i++) {
+            double d = fabs( base.n[0]*P[3*i] + base.n[1]*P[3*i+1] + base.n[2]*P[3*i+2] - base.d );
+            if (d>dmax) { dmax = d; i3 = i; }
+        }
+        if (i3<0) return false;
+        
+        // orient the tetrahedron such that all normals point outwards
+        int a = 0, b = i1, c = i2, d = i3;
+        if ( base.n[0]*P[3*d] + base.n[1]*P[3*d+1] + base.n[2]*P[3*d+2] - base.d > 0 ) {
+            b = i2;
+            c = i1;
+        }
+        fFacets.clear();
+        fFacets.push_back( Make_facet( a, b, c ) );
+        fFacets.push_back( Make_facet( a, d, b ) );
+        fFacets.push_back( Make_facet( b, d, c ) );
+        fFacets.push_back( Make_facet( c, d, a ) );
+        
+        for (int i=1; i<n; i++) {
+            if (i!=i1 && i!=i2 && i!=i3) {
+                Insert( i );
+            }
+        }
+        return true;
+    }
+    
+    //
+    //  Removes all facets which see point i and closes the hole (bounded by the horizon edges) with new facets through i.
+    //  The vertices of all facets are ordered counter-clockwise (seen from outside), therefore each edge appears in the
+    //  opposite direction in the neighbouring facet.
+    //
+    void ConvexHull::Insert( int i ){
+        const double* p = &fPoints[3*i];
+        std::vector<Facet>  hidden;
+        std::vector<int>    edges;
+        for (size_t f=0; f<fFacets.size(); f++) {
+            const Facet& F = fFacets[f];
+            if ( F.n[0]*p[0] + F.n[1]*p[1] + F.n[2]*p[2] - F.d > fTolerance ) {
+                for (int k=0; k<3; k++) {
+                    edges.push_back( F.v[k]       );
+                    edges.push_back( F.v[(k+1)%3] );
+                }
+            }else{
+                hidden.push_back( F );
+            }
+        }
+        if (edges.empty()) {
+            return;
+        }
+        int n_edges = edges.size()/2;
+        for (int e=0; e<n_edges; e++) {
+            bool horizon = true;
+            for (int o=0; o<n_edges; o++) {
+                if (edges[2*o]==edges[2*e+1] && edges[2*o+1]==edges[2*e]) {
+                    horizon = false;
+                    break;
+                }
+            }
+            if (horizon) {
+                hidden.push_back( Make_facet( edges[2*e], edges[2*e+1], i ) );
+            }
+        }
+        fFacets.swap( hidden );
+    }
+    
+    
+    int& Integration::steps = XS_engine::Default().fTrapezeSteps;
+    
+    void Integration::SetTrapezeIntegrationSteps( int _steps ){
+        XS_engine::Current().fTrapezeSteps = _steps;
+    }
+    
+    double Integration::integrate_trapeze( double (*integrand)(double, void*), double min, double max, void* parameter ){
+        return integrate_trapeze( integrand, min, max, parameter, XS_engine::Current().fTrapezeSteps );
+    }
+    
+    
+    double Integration::integrate( double (*integrand)(double, void*), double min, double max, void* parameter, const Integration_options& options, double* abserr ){
+        double err = 0;
+        double res = 0;
+        if        (options.method==GSL){
+            res = integrate_gsl_qag       ( integrand, min, max, parameter, options.epsabs, options.epsrel, options.limit, &err );
+        }else if  (options.method==GSL_QAGIU){
+            res = integrate_gsl_qagiu     ( integrand, min,      parameter, options.epsabs, options.epsrel, options.limit, &err );
+        }else if  (options.method==TRAPEZE){
+            res = integrate_trapeze       ( integrand, min, max, parameter, options.steps );
+        }else if  (options.method==GAUSS_LEGENDRE){
+            res = integrate_gauss_legendre( integrand, min, max, parameter, options.nodes );
+        }else if  (options.method==TANH_SINH){
+            res = integrate_tanh_sinh     ( integrand, min, max, parameter, options.epsrel, options.levels, &err );
+        }else if  (options.method==ROMBERG){
+            res = integrate_romberg       ( integrand, min, max, parameter, options.epsrel, options.levels, &err );
+        }else{
+            printf( "Warning in CRXS::Integration::integrate. Integration method %i is not known.", options.method);
+        }
+        if (abserr) {
+            *abserr = err;
+        }
+        return res;
+    }
+    
+    
+    //
+    //  GSL workspace of the calling thread. It is allocated at the first adaptive integral of the thread and freed when the
+    //  thread ends. If an integrand starts another adaptive integral, the inner one gets a temporary workspace.
+    //
+    struct Integration_workspace{
+        gsl_integration_workspace*  w;
+        size_t                      size;
+        bool                        in_use;
+        Integration_workspace() : w(0), size(0), in_use(false) {};
+        ~Integration_workspace(){ if (w) gsl_integration_workspace_free(w); };
+    };
+    
+    static Integration_workspace& Integration_thread_workspace(){
+        static thread_local Integration_workspace workspace;
+        return workspace;
+    }
+    
+    static gsl_integration_workspace* Integration_acquire_workspace( size_t limit, bool& temporary ){
+        Integration_workspace& ws = Integration_thread_workspace();
+        temporary = ws.in_use;
+        if (temporary) {
+            return gsl_integration_workspace_alloc( limit );
+        }
+        if (ws.size<limit) {
+            if (ws.w) gsl_integration_workspace_free( ws.w );
+            ws.w    = gsl_integration_workspace_alloc( limit );
+            ws.size = limit;
+        }
+        ws.in_use = true;
+        return ws.w;
+    }
+    
+    static void Integration_release_workspace( gsl_integration_workspace* w, bool temporary ){
+        if (temporary) {
+            gsl_integration_workspace_free( w );
+            return;
+        }
+        Integration_thread_workspace().in_use = false;
+    }
+    
+    
+    double Integration::integrate_gsl_qag( double (*integrand)(double, void*), double min, double max, void* parameter, double epsabs, double epsrel, int limit, double* abserr ){
+        double res, err;
+        bool temporary;
+        gsl_integration_workspace * w = Integration_acquire_workspace( limit, temporary );
+        gsl_function F;
+        F.function = integrand;
+        F.params   = parameter;
+        gsl_integration_qag(&F, min, max, epsabs, epsrel, limit, GSL_INTEG_GAUSS21, w, &res, &err);
+        Integration_release_workspace( w, temporary );
+        *abserr = err;
+        return res;
+    }
+    
+    double Integration::integrate_gsl_qagiu( double (*integrand)(double, void*), double min, void* parameter, double epsabs, double epsrel, int limit, double* abserr ){
+        double res, err;
+        bool temporary;
+        gsl_integration_workspace * w = Integration_acquire_workspace( limit, temporary );
+        gsl_function F;
+        F.function = integrand;
+        F.params   = parameter;
+        gsl_integration_qagiu(&F, min, epsabs, epsrel, limit, w, &res, &err);
+        Integration_release_workspace( w, temporary );
+        *abserr = err;
+        return res;
+    }
+    
+    
+    //
+    //  Nodes and weights of the Gauss-Legendre rule on [-1,1], computed by Newton iteration on the Legendre polynomial and
+    //  stored per thread and order.
+    //
+    struct Integration_gauss_legendre_rule{
+        std::vector<double> x;
+        std::vector<double> w;
+    };
+    
+    static const Integration_gauss_legendre_rule& Integration_gauss_legendre_nodes( int n ){
+        static thread_local std::map<int, Integration_gauss_legendre_rule> rules;
+        std::map<int, Integration_gauss_legendre_rule>::iterator it = rules.find(n);
+        if (it!=rules.end()) {
+            return it->second;
+        }
+        Integration_gauss_legendre_rule& rule = rules[n];
+        rule.x.resize(n);
+        rule.w.resize(n);
+        for (int i=0; i<(n+1)/2; i++) {
+            double z  = cos( M_PI*(i+0.75)/(n+0.5) );
+            double dp = 1;
+            for (int iter=0; iter<100; iter++) {
+                double p0 = 1;
+                double p1 = 0;
+                for (int j=1; j<=n; j++) {
+                    double p2 = p1;
+                    p1 = p0;
+                    p0 = ( (2.*j-1.)*z*p1 - (j-1.)*p2 )/j;
+                }
+                dp = n*( z*p0 - p1 )/( z*z - 1 );
+                double z_old = z;
+                z  = z_old - p0/dp;
+                if (fabs(z-z_old)<1e-15) break;
+            }
+            rule.x[i]     = -z;
+            rule.x[n-1-i] =  z;
+            rule.w[i]     = 2./( (1-z*z)*dp*dp );
+            rule.w[n-1-i] = rule.w[i];
+        }
+        return rule;
+    }
+    
+    double Integration::integrate_gauss_legendre( double (*integrand)(double, void*), double min, double max, void* parameter, int n_nodes ){
+        const Integration_gauss_legendre_rule& rule = Integration_gauss_legendre_nodes( n_nodes );
+        double c   = (max+min)/2.;
+        double d   = (max-min)/2.;
+        double res = 0;
+        for (int i=0; i<n_nodes; i++) {
+            res += rule.w[i] * integrand( c + d*rule.x[i], parameter );
+        }
+        return res * d;
+    }
+    
+    
+    //
+    //  Tanh-sinh: x = c + d*tanh( pi/2*sinh(t) ). The nodes are written as distance from the closer limit,
+    //  d*(1-tanh(u)) = 2d/(exp(2u)+1), such that the integrand is never evaluated at the limits.
+    //
+    double Integration::integrate_tanh_sinh( double (*integrand)(double, void*), double min, double max, void* parameter, double epsrel, int levels, double* abserr ){
+        const double t_max = 3.2;
+        double d = (max-min)/2.;
+        
+        double sum = M_PI/2. * integrand( min+d, parameter );
+        double h   = 1;
+        double res = h*sum;
+        double err = fabs(res);
+        for (int level=0; level<=levels; level++) {
+            int    step  = (level==0) ? 1 : 2;
+            double start = (level==0) ? h : h/2.;
+            if (level>0) h /= 2.;
+            for (double t=start; t<=t_max; t+=step*h) {
+                double u      = M_PI/2.*sinh(t);
+                double e2u    = exp(2*u);
+                double dist   = 2.*d/(e2u+1);
+                double cosh_u = cosh(u);
+                double weight = M_PI/2.*cosh(t)/(cosh_u*cosh_u);
+                sum += weight*( integrand( min+dist, parameter ) + integrand( max-dist, parameter ) );
+            }
+            double res_new = h*sum;
+            err = fabs( res_new-res );
+            res = res_new;
+            if (level>=3 && err<=epsrel*fabs(res)) {
+                break;
+            }
+        }
+        *abserr = err * d;
+        return res * d;
+    }
+    
+    
+    
+    double Integration::integrate_romberg( double (*integrand)(double, void*), double min, double max, void* parameter, double epsrel, int levels, double* abserr ){
+        const int levels_max = 30;
+        if (levels>levels_max) levels = levels_max;
+        if (levels<1)          levels = 1;
+        
+        //  R[j]: j-fold extrapolation of the trapezoidal rule on the current level, R_prev on the previous level
+        double R[levels_max+1], R_prev[levels_max+1];
+        double h   = max-min;
+        R_prev[0]  = h/2.*( integrand( min, parameter ) + integrand( max, parameter ) );
+        double res = R_prev[0];
+        double err = fabs(res);
+        long   n   = 1;
+        for (int k=1; k<=levels; k++) {
+            h /= 2.;
+            double sum = 0;
+            for (long i=1; i<2*n; i+=2) {
+                sum += integrand( min + i*h, parameter );
+            }
+            n *= 2;
+            R[0] = R_prev[0]/2. + h*sum;
+            double factor = 1;
+            for (int j=1; j<=k; j++) {
+                factor *= 4;
+                R[j] = R[j-1] + ( R[j-1]-R_prev[j-1] )/( factor-1 );
+            }
+            err = fabs( R[k]-R_prev[k-1] );
+            res = R[k];
+            if (k>=4 && err<=epsrel*fabs(res)) {
+                break;
+            }
+            for (int j=0; j<=k; j++) R_prev[j] = R[j];
+        }
+        *abserr = err;
+        return res;
+    }
     
 }
-
-
-
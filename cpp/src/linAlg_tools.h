@@ -2,6 +2,8 @@
 #define CRXS__LA_tools_H
 
 #include "math.h"
+#include "vector"
+#include "crxs.h"
 
 namespace CRXS {
     
@@ -25,22 +27,133 @@ namespace CRXS {
         static bool inside(double* a, double *b , double* c, double* d, double* p);
     };
     
+    //! Convex hull of a set of points in three dimensions, stored as half spaces (one plane per triangular facet).
+    /*!
+     *  The points are added one by one and the hull is updated with every point (incremental construction), such that
+     *  isInside only checks the bounding box and computes one dot product per facet. The number of points is not
+     *  limited. As long as all points are coplanar, the hull has no volume and isInside is false. Points on the surface
+     *  (within an absolute distance of 1e-10) are outside, as for LA::inside. The construction of the hull uses a
+     *  tolerance relative to the size of the bounding box.
+     */
+    class ConvexHull{
+        
+        public:
+        ConvexHull();
+        
+        /// Removes all points
+        void    Clear   ();
+        /// Adds the point (x,y,z) and updates the hull
+        void    Add     ( double x, double y, double z );
+        /// true if (x,y,z) is inside of the hull
+        bool    isInside( double x, double y, double z ) const;
+        
+        int     Get_nPoints() const { return fPoints.size()/3; };
+        int     Get_nFacets() const { return fFacets.size();   };
+        
+        /// Coordinates of the points, point i at fPoints[3*i], fPoints[3*i+1], fPoints[3*i+2]
+        std::vector<double> fPoints;
+        /// Bounding box of the points
+        double  fMin[3];
+        double  fMax[3];
+        
+        private:
+        
+        // Facet with the vertices v, oriented such that the normal n points outwards; plane n*x = d
+        struct Facet{
+            int     v[3];
+            double  n[3];
+            double  d;
+        };
+        
+        bool    Setup_simplex();
+        void    Insert       ( int i );
+        Facet   Make_facet   ( int a, int b, int c ) const;
+        
+        std::vector<Facet>  fFacets;
+        double              fTolerance;
+    };
+    
+    //! Options of Integration::integrate
+    struct Integration_options{
+        
+        //! Constructor
+        /*!
+         *  \param int    method   Integration method, enum from [GSL (adaptive QAG), GSL_QAGIU, TRAPEZE, GAUSS_LEGENDRE, TANH_SINH, ROMBERG]
+         *  \param double epsrel   Required relative accuracy (GSL, GSL_QAGIU, TANH_SINH, ROMBERG)
+         *  \param int    steps    Number of steps of the midpoint rule (TRAPEZE)
+         *  \param int    nodes    Number of nodes of the Gauss-Legendre rule (GAUSS_LEGENDRE)
+         */
+        Integration_options( int method=GSL, double epsrel=1e-4, int steps=1000, int nodes=64 )
+            : method(method), epsabs(0), epsrel(epsrel), steps(steps), nodes(nodes), levels(12), limit(1000) {};
+        
+        int     method;
+        double  epsabs;
+        double  epsrel;
+        int     steps;
+        int     nodes;
+        int     levels;             // maximal number of step halvings (TANH_SINH, ROMBERG)
+        int     limit;              // maximal number of subintervals (GSL, GSL_QAGIU)
+    };
+    
+    //! Numerical integration of integrands of the form double f(double x, void* parameter).
+    /*!
+     *  All methods are reentrant. The adaptive GSL methods use a workspace which is allocated once per thread and
+     *  reused by all integrals of the thread. The Gauss-Legendre nodes are computed once per thread and order.
+     */
     class Integration{
         
         public:
-        static double integrate_trapeze( double (*integrand)(double, void*), double min, double max, void* parameter ){
+        //! Integral of integrand from min to max with the method and accuracy in options
+        /*!
+         *  \param double (*integrand)(double, void*)   Integrand
+         *  \param double              min             Lower limit
+         *  \param double              max             Upper limit, ignored by GSL_QAGIU (integration to infinity)
+         *  \param void*               parameter       Passed to the integrand
+         *  \param Integration_options options         Method and accuracy
+         *  \param double*             abserr          Returns: estimate of the absolute error (0 for the fixed rules TRAPEZE and GAUSS_LEGENDRE), may be 0
+         *
+         *  The method AUTOTUNE is resolved by the caller (XS_autotune::GetIntegrationOptions) and is not known here.
+         *
+         *  \return double integral
+         */
+        static double integrate( double (*integrand)(double, void*), double min, double max, void* parameter, const Integration_options& options, double* abserr=0 );
+        
+        /// Adaptive Gauss-Kronrod integration (gsl_integration_qag, 21 points), workspace of the calling thread
+        static double integrate_gsl_qag       ( double (*integrand)(double, void*), double min, double max, void* parameter, double epsabs, double epsrel, int limit, double* abserr );
+        /// Adaptive integration from min to infinity (gsl_integration_qagiu), workspace of the calling thread
+        static double integrate_gsl_qagiu     ( double (*integrand)(double, void*), double min,             void* parameter, double epsabs, double epsrel, int limit, double* abserr );
+        /// Gauss-Legendre rule with n_nodes nodes
+        static double integrate_gauss_legendre( double (*integrand)(double, void*), double min, double max, void* parameter, int n_nodes );
+        /// Tanh-sinh (double exponential) rule, the step size is halved until the relative change is below epsrel (at most levels times)
+        static double integrate_tanh_sinh     ( double (*integrand)(double, void*), double min, double max, void* parameter, double epsrel, int levels, double* abserr );
+        
+        //! Romberg integration: trapezoidal rule on 2^k intervals, k = 1, ..., levels, with Richardson extrapolation.
+        /*!
+         *  Every halving of the step only evaluates the new midpoints, all previous evaluations are reused. The iteration
+         *  stops after at least 4 halvings if two successive extrapolations agree within epsrel. The integral of a
+         *  smooth integrand converges quickly, while for peaked integrands the extrapolation is not better than the
+         *  trapezoidal rule.
+         */
+        static double integrate_romberg       ( double (*integrand)(double, void*), double min, double max, void* parameter, double epsrel, int levels, double* abserr );
+        
+        /// Midpoint rule with the number of steps of the current engine (XS_engine::Current())
+        static double integrate_trapeze( double (*integrand)(double, void*), double min, double max, void* parameter );
+        /// Midpoint rule with n_steps steps
+        static double integrate_trapeze( double (*integrand)(double, void*), double min, double max, void* parameter, int n_steps ){
             double res = 0;
-            double dd  = (max-min)/steps;
+            double dd  = (max-min)/n_steps;
             double d;
-            for (int i=0; i<steps; i++) {
+            for (int i=0; i<n_steps; i++) {
                 d = min + dd * ( 0.5 + i );
                 res += integrand(d,parameter);
             }
             res *= dd;
             return res;
         };
-        static int    steps;
-        static void   SetTrapezeIntegrationSteps( int _steps ){steps=_steps;};
+        /// Number of steps of the default engine (XS_engine::Default())
+        static int&   steps;
+        /// Sets the number of steps of the current engine (XS_engine::Current())
+        static void   SetTrapezeIntegrationSteps( int _steps );
         
     };
 }
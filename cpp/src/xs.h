@@ -2,6 +2,7 @@
 #define CRXS__XS_H
 
 #include "linAlg_tools.h"
+#include "xs_engine.h"
 
 namespace CRXS {
     
@@ -100,9 +101,26 @@ namespace CRXS {
          *  \return double XS              Cross section in mbarn/GeV
          */
         static double dE_AA_pbar_LAB( double Tn_proj_LAB, double T_pbar_LAB, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II);
-        //! Helper function for dE_AA_pbar_LAB
+        //! Helper function for dE_AA_pbar_LAB, parameters: pointer to XS_setup__integrand_parameters (xs_setup.h)
         static double integrand__dE_AA_pbar_LAB (double eta_LAB, void* parameters  );
         
+        //! dE_AA_pbar_LAB for n antiproton energies at the same projectile energy.
+        /*!
+         *  All quantities which depend only on Tn_proj_LAB are computed once (see XS_energy_context) and reused for all
+         *  antiproton energies and all nodes of the angular integration. Same results as dE_AA_pbar_LAB.
+         *
+         *  \param double        Tn_proj_LAB      Kinetic energy per nucleus of the prjectile (in the LAB frame)
+         *  \param int           n                Number of antiproton energies
+         *  \param const double* T_pbar_LAB       Array of kinetic energies of the antiproton (in the LAB frame)
+         *  \param double*       result           Returns: Array of length n with the cross sections in mbarn/GeV (provided by the caller)
+         *  \param int           A_projectile     Mass number of the projectile
+         *  \param int           N_projectile     Number of neutrons in the projectile
+         *  \param int           A_target         Mass number of the target
+         *  \param int           N_target         Number of neutrons in the target
+         *  \param int           parametrization  Cross section parametrization, cf. dE_AA_pbar_LAB
+         */
+        static void   batch__dE_AA_pbar_LAB( double Tn_proj_LAB, int n, const double* T_pbar_LAB, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+        
         
         
          //!Energy-differential antiproton production cross section including antineutrons and antihyperons for general projectile and target nucleus and for different XS parametrization as function of LAB frame kinetic variables. This cross section is integrated over all angles.
@@ -134,6 +152,35 @@ namespace CRXS {
         static double dE_AA_pbar_LAB_incNbarAndHyperon(double Tn_proj_LAB, double T_pbar_LAB, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II);
         
         
+        //! Energy-differential gamma-ray production cross section (from pi0 decays) in pp collisions as function of LAB frame kinetic variables.
+        /*!
+         *  Parametrization of Kafexhiu et al. 2014, cf. XS_definitions::dE_pp_gamma_LAB__Kafexhiu.
+         *
+         *  \param double T_p_LAB          Kinetic energy of the proton (in the LAB frame)
+         *  \param double E_gamma_LAB      Energy of the gamma ray (in the LAB frame)
+         *
+         *  \return double XS              Cross section in mbarn/GeV
+         */
+        static double dE_pp_gamma_LAB( double T_p_LAB, double E_gamma_LAB );
+        
+        //! dE_pp_gamma_LAB for n gamma-ray energies at the same proton energy.
+        /*!
+         *  All quantities which depend only on the proton energy (peak value, maximal gamma-ray energy, shape parameters)
+         *  are computed once. The gamma-ray energies are evaluated with the vectorized kernels of the instruction set chosen
+         *  at runtime (cf. XS_definitions::batch__inv_pp_pbar_CM__Winkler), the limits of the spectrum are applied as masks.
+         *
+         *  Accuracy: the powers of Eq. (11) are computed as exp(b*log(a)), the deviation from dE_pp_gamma_LAB is below
+         *  256 ulp (relative 3e-14) for 0.28 GeV < T_p_LAB < 3*10^6 GeV (measured max: 198 ulp, close to the maximal
+         *  gamma-ray energy). For bit-identical results use CRXS_config::SetupSIMD(SIMD_NONE).
+         *
+         *  \param double        T_p_LAB       Kinetic energy of the proton (in the LAB frame)
+         *  \param int           n             Number of gamma-ray energies
+         *  \param const double* E_gamma_LAB   Array of energies of the gamma ray (in the LAB frame), length n
+         *  \param double*       result        Returns: Array of cross sections in mbarn/GeV, length n (provided by the caller)
+         */
+        static void   batch__dE_pp_gamma_LAB( double T_p_LAB, int n, const double* E_gamma_LAB, double* result );
+        
+        
         
         //!Invariant proton production cross section for general projectile and target nucleus for different XS parametrization
         /*!
@@ -179,11 +226,27 @@ namespace CRXS {
          *  \param int    N_target         Number of neutrons in the target
          *  \param int    parametrization  Cross section parametrization, enum from[ANDERSON]
          *
+         *  The angular integral of the ANDERSON parametrization is evaluated semi-analytically, cf. XS_setup::dE_AA_p_LAB__Anderson.
+         *
          *  \return double XS              Cross section in mbarn/GeV
          */
         static double dE_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=ANDERSON);
-        //! Helper function for dE_AA_p_LAB
+        //! Same as dE_AA_p_LAB, but the angular integral is always computed numerically in eta_LAB with the integration method of CRXS_config::SetupIntegrationMethod_p (reference for validation)
+        static double dE_AA_p_LAB__numerical( double Tn_proj_LAB, double T_p_LAB, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=ANDERSON);
+        //! Helper function for dE_AA_p_LAB__numerical, parameters: pointer to XS_setup__integrand_parameters (xs_setup.h)
         static double integrand__dE_AA_p_LAB (double eta_LAB, void* parameters  );
+
+        //! Normalization of the energy-differential pp -> p + X cross section (ANDERSON), used as shape of the tertiary cross sections (dEn_DbarA_Dbar_LAB, ...).
+        /*!
+         *  Integral of T_p_LAB * dE_AA_p_LAB( Tn_proj_LAB, T_p_LAB ) over log(T_p_LAB) from 1e-7 GeV to Tn_proj_LAB in steps of
+         *  0.1 in log10(T_p_LAB). The result is memoized per Tn_proj_LAB, such that it is computed once per projectile energy
+         *  for all antinuclei and targets. The cache is shared by all threads.
+         *
+         *  \param double Tn_proj_LAB      Kinetic energy per nucleon of the projectile (in the LAB frame)
+         *
+         *  \return double norm            Normalization in mbarn
+         */
+        static double norm__dE_pp_p_LAB( double Tn_proj_LAB );
         
         
         
@@ -306,8 +369,10 @@ namespace CRXS {
          *  \return double XS              Cross section in mbarn/GeV^2
          */
         static double inv_AA_Dbar_LAB( double Tn_proj_LAB, double Tn_Dbar_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val=0.160 );
-        //! Helper function for inv_AA_Dbar_LAB
+        //! Helper function for dEn_AA_Dbar_LAB, parameters: pointer to XS_setup__integrand_parameters (xs_setup.h)
         static double integrand__dE_AA_Dbar_LAB (double eta_LAB, void* parameters  );
+        //! Helper function for dEn_AA_Dbar_LAB in the integration variable RAPIDITY_LAB (cf. kinematics__rapidity_to_eta), parameters as in integrand__dE_AA_Dbar_LAB
+        static double integrand__dE_AA_Dbar_LAB__rapidity (double w, void* parameters  );
         
         
         //! Energy-differential antideuteron production cross section for general projectile and target nucleus for different XS parametrization as function of LAB frame kinetic variables. The cross section contains the contribution from antineutrons and antihyperons. In the case of DI_MAURO parametrizations the antihyperon contribution is set to 0. The nuclear scaling for AA initial states is done as explained in XS_definitions::factor__AA.
@@ -407,8 +472,10 @@ namespace CRXS {
          *  \return double XS              Cross section in mbarn/GeV^2
          */
         static double inv_AA_He3bar_LAB( double Tn_proj_LAB, double Tn_Hebar_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val=0.160 );
-        //! Helper function for inv_AA_Hebar_LAB
+        //! Helper function for dEn_AA_He3bar_LAB, parameters: pointer to XS_setup__integrand_parameters (xs_setup.h)
         static double integrand__dE_AA_He3bar_LAB (double eta_LAB, void* parameters  );
+        //! Helper function for dEn_AA_He3bar_LAB in the integration variable RAPIDITY_LAB (cf. kinematics__rapidity_to_eta), parameters as in integrand__dE_AA_He3bar_LAB
+        static double integrand__dE_AA_He3bar_LAB__rapidity (double w, void* parameters  );
         
         
         //! Energy-differential antihelion production cross section for general projectile and target nucleus for different XS parametrization as function of LAB frame kinetic variables. The cross section contains the contribution from antineutrons and antihyperons. In the case of DI_MAURO parametrizations the antihyperon contribution is set to 0. The nuclear scaling for AA initial states is done as explained in XS_definitions::factor__AA.
@@ -507,8 +574,10 @@ namespace CRXS {
         *  \return double XS              Cross section in mbarn/GeV^2
         */
        static double inv_AA_He4bar_LAB( double Tn_proj_LAB, double Tn_Hebar_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val=0.160 );
-       //! Helper function for inv_AA_Hebar_LAB
+       //! Helper function for dEn_AA_He4bar_LAB, parameters: pointer to XS_setup__integrand_parameters (xs_setup.h)
        static double integrand__dE_AA_He4bar_LAB (double eta_LAB, void* parameters  );
+       //! Helper function for dEn_AA_He4bar_LAB in the integration variable RAPIDITY_LAB (cf. kinematics__rapidity_to_eta), parameters as in integrand__dE_AA_He4bar_LAB
+       static double integrand__dE_AA_He4bar_LAB__rapidity (double w, void* parameters  );
        
        
        //! Energy-differential antihelion production cross section for general projectile and target nucleus for different XS parametrization as function of LAB frame kinetic variables. The cross section contains the contribution from antineutrons and antihyperons. In the case of DI_MAURO parametrizations the antihyperon contribution is set to 0. The nuclear scaling for AA initial states is done as explained in XS_definitions::factor__AA.
@@ -548,6 +617,243 @@ namespace CRXS {
         *  \return double XS              Cross section in mbarn/GeV
         */
        static double dEn_He4barA_He4bar_LAB( double Tn_Hebar_proj_LAB, double Tn_Hebar_prod_LAB, int A_target=1, int N_target=0, int parametrization=ANDERSON );
+
+
+        //! Invariant antideuteron, antihelium-3, and antihelium-4 production cross sections for the same momentum per nucleon in one call.
+        /*!
+         *  Same as inv_AA_Dbar_CM( s, 2*xF_nucleon, 2*pT_nucleon, ... ), inv_AA_He3bar_CM( s, 3*xF_nucleon, 3*pT_nucleon, ... ),
+         *  and inv_AA_He4bar_CM( s, 4*xF_nucleon, 4*pT_nucleon, ... ). The antinuclei share the antinucleon momentum, so the
+         *  pp cross sections at the reduced CM energies of the coalescence chain are evaluated only once for all of them
+         *  (5 instead of 9 evaluations). Products with a null pointer are not computed.
+         *
+         *  \param double  s               CM energy, squared (in the nucleon-nucleon frame).
+         *  \param doulbe  xF_nucleon      Feynman scaling per nucleon (2*pL/A/sqrt(s) in CMF)
+         *  \param doulbe  pT_nucleon      Transverse momentum per nucleon
+         *  \param double* Dbar            Returns: antideuteron cross section in mbarn/GeV^2, or null
+         *  \param double* He3bar          Returns: antihelium-3 cross section in mbarn/GeV^2, or null
+         *  \param double* He4bar          Returns: antihelium-4 cross section in mbarn/GeV^2, or null
+         *
+         *  All other parameters as in inv_AA_Dbar_CM.
+         */
+        static void   inv_AA_antinuclei_CM( double s, double xF_nucleon, double pT_nucleon, double* Dbar, double* He3bar, double* He4bar, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val=0.160 );
+
+
+        //! Batch version of inv_AA_pbar_CM for n kinematic points with a common configuration.
+        /*!
+         *  The inputs are contiguous arrays (structure of arrays) of length n. The parametrization dispatch, the
+         *  parameter lookup, and the nuclear factors are resolved once per batch (cf. XS_setup). No memory is allocated.
+         *  The pp cross section is evaluated with the vectorized kernels (XS_definitions::batch__inv_pp_pbar_CM__Winkler,
+         *  XS_definitions::batch__inv_pp_pbar_CM__diMauro), see there for the deviation from the scalar function.
+         *
+         *  \param int           n                Number of kinematic points
+         *  \param const double* s                Array of CM energies, squared.
+         *  \param const doulbe* xF               Array of Feynman scaling variables (2*pL_pbar/sqrt(s) in CMF)
+         *  \param const doulbe* pT_pbar          Array of transverse momenta of the antiproton
+         *  \param double*       result           Returns: Array of length n with the cross sections in mbarn/GeV^2 (provided by the caller)
+         *  \param int           A_projectile     Mass number of the projectile
+         *  \param int           N_projectile     Number of neutrons in the projectile
+         *  \param int           A_target         Mass number of the target
+         *  \param int           N_target         Number of neutrons in the target
+         *  \param int           parametrization  Cross section parametrization, cf. inv_AA_pbar_CM
+         */
+        static void batch__inv_AA_pbar_CM   ( int n, const double* s, const double* xF, const double* pT_pbar, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+        //! Batch version of inv_AA_pbar_LAB for n kinematic points with a common configuration. Arguments as in batch__inv_AA_pbar_CM, with the LAB frame variables Tn_proj_LAB, T_pbar_LAB, and eta_LAB.
+        static void batch__inv_AA_pbar_LAB  ( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+
+        //! Ensemble version of batch__inv_AA_pbar_CM: n kinematic points and K parameter sets in one call.
+        /*!
+         *  Evaluates the functional form of the parametrization (pp kernel and nuclear scaling) for K parameter sets given
+         *  by the caller, e.g. the walkers of an ensemble MCMC sampler, without changing the SELF parameters of the engine.
+         *  The kinematic quantities of each point are computed once and the pp kernel is vectorized across the parameter
+         *  sets (XS_definitions::ensemble__inv_pp_pbar_CM__Winkler, XS_definitions::ensemble__inv_pp_pbar_CM__diMauro).
+         *  Set k gives the same result as batch__inv_AA_pbar_CM with WINKLER_SELF (DI_MAURO_SELF) and the SELF parameters
+         *  set to the parameters of set k (bit by bit, also for SIMD_NONE). The restricted parameter space of the engine is applied.
+         *
+         *  \param int           n                Number of kinematic points
+         *  \param const double* s                Array of CM energies, squared.
+         *  \param const doulbe* xF               Array of Feynman scaling variables (2*pL_pbar/sqrt(s) in CMF)
+         *  \param const doulbe* pT_pbar          Array of transverse momenta of the antiproton
+         *  \param double*       result           Returns: cross sections in mbarn/GeV^2, result[i*K+k] for point i and parameter set k (array of length n*K, provided by the caller)
+         *  \param int           K                Number of parameter sets
+         *  \param const double* C_sets           Parameters of the pp cross section, C_sets[k*n_C+c] is C_c of set k, with n_C=17 for the Winkler
+         *                                        (C0,...,C16, cf. XS_definitions::Winkler_SELF_C1_to_C16) and n_C=12 for the di Mauro kernel (C0,...,C11)
+         *  \param const double* D_sets           Parameters of the nuclear scaling, D_sets[k*3+d] is D_d of set k, or null: XS_definitions::Get_D_parameters(parametrization) for all sets
+         *  \param const double* C_isospin_sets   Isospin parameters (C14, C15, C16 of arrays of length 17), C_isospin_sets[k*17+c], or null:
+         *                                        C_sets for the Winkler kernel, XS_definitions::Get_C_parameters_isospin(parametrization) for all sets otherwise
+         *  \param int           A_projectile     Mass number of the projectile
+         *  \param int           N_projectile     Number of neutrons in the projectile
+         *  \param int           A_target         Mass number of the target
+         *  \param int           N_target         Number of neutrons in the target
+         *  \param int           parametrization  Functional form, enum from [WINKLER_SELF (default), DI_MAURO_SELF] or any other antiproton parametrization of inv_AA_pbar_CM
+         */
+        static void ensemble__inv_AA_pbar_CM ( int n, const double* s, const double* xF, const double* pT_pbar, double* result, int K, const double* C_sets, const double* D_sets=0, const double* C_isospin_sets=0, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=WINKLER_SELF );
+        //! Ensemble version of batch__inv_AA_pbar_LAB. Arguments as in ensemble__inv_AA_pbar_CM, with the LAB frame variables Tn_proj_LAB, T_pbar_LAB, and eta_LAB (converted to the CM frame once per point).
+        static void ensemble__inv_AA_pbar_LAB( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result, int K, const double* C_sets, const double* D_sets=0, const double* C_isospin_sets=0, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=WINKLER_SELF );
+
+        //! Batch version of inv_AA_p_CM for n kinematic points with a common configuration. Arguments as in batch__inv_AA_pbar_CM.
+        static void batch__inv_AA_p_CM      ( int n, const double* s, const double* xF, const double* pT_p, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=ANDERSON );
+        //! Batch version of inv_AA_p_LAB for n kinematic points with a common configuration. Arguments as in batch__inv_AA_pbar_LAB.
+        static void batch__inv_AA_p_LAB     ( int n, const double* Tn_proj_LAB, const double* T_p_LAB, const double* eta_LAB, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=ANDERSON );
+
+        //! Batch version of inv_AA_Dbar_CM for n kinematic points with a common configuration. Arguments as in batch__inv_AA_pbar_CM, the coalescence options as in inv_AA_Dbar_CM.
+        static void batch__inv_AA_Dbar_CM   ( int n, const double* s, const double* xF_Dbar, const double* pT_Dbar, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+        //! Batch version of inv_AA_Dbar_LAB for n kinematic points with a common configuration. Arguments as in batch__inv_AA_pbar_LAB, the coalescence options as in inv_AA_Dbar_CM.
+        static void batch__inv_AA_Dbar_LAB  ( int n, const double* Tn_proj_LAB, const double* Tn_Dbar_LAB, const double* eta_LAB, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+
+        //! Batch version of inv_AA_He3bar_CM for n kinematic points with a common configuration. Arguments as in batch__inv_AA_Dbar_CM.
+        static void batch__inv_AA_He3bar_CM ( int n, const double* s, const double* xF_Hebar, const double* pT_Hebar, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+        //! Batch version of inv_AA_He3bar_LAB for n kinematic points with a common configuration. Arguments as in batch__inv_AA_Dbar_LAB.
+        static void batch__inv_AA_He3bar_LAB( int n, const double* Tn_proj_LAB, const double* Tn_Hebar_LAB, const double* eta_LAB, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+
+        //! Batch version of inv_AA_He4bar_CM for n kinematic points with a common configuration. Arguments as in batch__inv_AA_Dbar_CM.
+        static void batch__inv_AA_He4bar_CM ( int n, const double* s, const double* xF_Hebar, const double* pT_Hebar, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+        //! Batch version of inv_AA_He4bar_LAB for n kinematic points with a common configuration. Arguments as in batch__inv_AA_Dbar_LAB.
+        static void batch__inv_AA_He4bar_LAB( int n, const double* Tn_proj_LAB, const double* Tn_Hebar_LAB, const double* eta_LAB, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+
+
+        //! Table of dE_AA_pbar_LAB on a grid of projectile energies, antiproton energies, and projectile-target combinations (species), computed with several threads.
+        /*!
+         *  The table is split into rows (one species and one projectile energy) which are distributed dynamically to
+         *  n_threads threads. All threads use the engine of the calling thread (XS_engine::Current()), the results are
+         *  identical to dE_AA_pbar_LAB for any number of threads.
+         *
+         *  The result is stored with the species index running fastest (same order as the tables of Korsmeier et al. 2018):
+         *      result[ (i_Tn*n_T + i_T)*n_species + i_species ] = dE_AA_pbar_LAB( Tn_proj_LAB[i_Tn], T_pbar_LAB[i_T], A_projectile[i_species], ... )
+         *
+         *  \param int           n_Tn             Number of projectile energies
+         *  \param const double* Tn_proj_LAB      Array of kinetic energies per nucleon of the prjectile (in the LAB frame)
+         *  \param int           n_T              Number of antiproton energies
+         *  \param const double* T_pbar_LAB       Array of kinetic energies of the antiproton (in the LAB frame)
+         *  \param int           n_species        Number of projectile-target combinations
+         *  \param const int*    A_projectile     Array of mass numbers of the projectile, length n_species
+         *  \param const int*    N_projectile     Array of numbers of neutrons in the projectile, length n_species
+         *  \param const int*    A_target         Array of mass numbers of the target, length n_species
+         *  \param const int*    N_target         Array of numbers of neutrons in the target, length n_species
+         *  \param double*       result           Returns: Array of length n_Tn*n_T*n_species with the cross sections in mbarn/GeV (provided by the caller)
+         *  \param int           parametrization  Cross section parametrization, cf. dE_AA_pbar_LAB
+         *  \param int           n_threads        Number of threads, 0: number of cores (std::thread::hardware_concurrency)
+         */
+        static void grid__dE_AA_pbar_LAB                    ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_pbar_LAB,   int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization=KORSMEIER_II, int n_threads=0 );
+        //! Grid version of dE_AA_pbar_LAB_incNbarAndHyperon. Arguments and layout as in grid__dE_AA_pbar_LAB.
+        static void grid__dE_AA_pbar_LAB_incNbarAndHyperon  ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_pbar_LAB,   int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization=KORSMEIER_II, int n_threads=0 );
+        //! Grid version of dE_AA_p_LAB. Arguments and layout as in grid__dE_AA_pbar_LAB.
+        static void grid__dE_AA_p_LAB                       ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_p_LAB,      int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization=ANDERSON,     int n_threads=0 );
+        //! Grid version of dEn_AA_Dbar_LAB. Arguments and layout as in grid__dE_AA_pbar_LAB, the coalescence options as in dEn_AA_Dbar_LAB.
+        static void grid__dEn_AA_Dbar_LAB                   ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* Tn_Dbar_LAB,  int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160, int n_threads=0 );
+        //! Grid version of dEn_AA_He3bar_LAB. Arguments as in grid__dEn_AA_Dbar_LAB.
+        static void grid__dEn_AA_He3bar_LAB                 ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* Tn_Hebar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160, int n_threads=0 );
+        //! Grid version of dEn_AA_He4bar_LAB. Arguments as in grid__dEn_AA_Dbar_LAB.
+        static void grid__dEn_AA_He4bar_LAB                 ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* Tn_Hebar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160, int n_threads=0 );
+        //! Grid version of dE_pp_gamma_LAB, result[ i_Tp*n_E + i_E ] = dE_pp_gamma_LAB( T_p_LAB[i_Tp], E_gamma_LAB[i_E] ). Threads as in grid__dE_AA_pbar_LAB.
+        static void grid__dE_pp_gamma_LAB                   ( int n_Tp, const double* T_p_LAB,     int n_E, const double* E_gamma_LAB,  double* result, int n_threads=0 );
+
+
+        //! dEn_AA_Dbar_LAB for n coalescence models and momenta, computed from one p0-independent integral.
+        /*!
+         *  The coalescence momentum enters the cross section of an antinucleus with A nucleons as a factor p_coal^(3*(A-1)):
+         *
+         *      FIXED_P0                     p_coal = p0                            constant over the angular integral
+         *      ENERGY_DEP__VAN_DOETINCHEM   p_coal = p_coal__VonDoetinchen(s)      constant, s only depends on Tn_proj_LAB
+         *      PT_DEP                       p_coal = p0 * f(pT/A)                  f=1 for pT/A < 0.8 GeV
+         *
+         *  The angular integral is therefore computed once with p_coal=1 and rescaled for all entries. PT_DEP needs a second
+         *  integral (with p_coal=f(pT/A), also rescaled for all p0) only if the antinucleus momentum allows pT/A > 0.8 GeV,
+         *  otherwise it is identical to FIXED_P0. Unknown coalescence models are passed on to dEn_AA_Dbar_LAB.
+         *
+         *  \param double        Tn_proj_LAB      Kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param double        Tn_Dbar_LAB      Kinetic energy per nucleon of the antideuteron (in the LAB frame)
+         *  \param int           n                Number of coalescence models and momenta
+         *  \param const int*    coalescence      Array of length n, coalescence models, enum from[FIXED_P0, ENERGY_DEP__VAN_DOETINCHEM, PT_DEP]
+         *  \param const double* p0_val           Array of length n, coalescence momenta in GeV (ignored for ENERGY_DEP__VAN_DOETINCHEM)
+         *  \param double*       result           Returns: Array of length n with the cross sections in mbarn/GeV (provided by the caller)
+         *
+         *  All other parameters as in dEn_AA_Dbar_LAB.
+         */
+        static void scan__dEn_AA_Dbar_LAB   ( double Tn_proj_LAB, double Tn_Dbar_LAB,  int n, const int* coalescence, const double* p0_val, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+        //! dEn_AA_He3bar_LAB for n coalescence models and momenta. Arguments as in scan__dEn_AA_Dbar_LAB.
+        static void scan__dEn_AA_He3bar_LAB ( double Tn_proj_LAB, double Tn_Hebar_LAB, int n, const int* coalescence, const double* p0_val, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+        //! dEn_AA_He4bar_LAB for n coalescence models and momenta. Arguments as in scan__dEn_AA_Dbar_LAB.
+        static void scan__dEn_AA_He4bar_LAB ( double Tn_proj_LAB, double Tn_Hebar_LAB, int n, const int* coalescence, const double* p0_val, double* result, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+
+
+        //! Largest CM energy of the product for which the production cross section is not zero.
+        /*!
+         *  The pp kernels (Winkler, di Mauro) vanish for s < 16 m_p^2 and for x_R = E_pbar/E_pbar_Max > 1, with
+         *  E_pbar_Max = (s-8m_p^2)/(2 sqrt(s)). For the antinuclei the kernels are evaluated at the reduced CM energies of
+         *  the coalescence chain (cf. XS_coalescence) which must not become negative. All conditions are upper limits on the
+         *  CM energy E_CM of the product, such that the cross section vanishes for E_CM > E_CM_max:
+         *
+         *      P_BAR       E_CM_max = E_pbar_Max
+         *      antinuclei  largest E_CM (bisection) for which all levels of the chain are above threshold and x_R<=1.
+         *                  For antiproton projectiles (A_projectile<0) the antiproton kernels are replaced by Anderson et al.,
+         *                  then only the first level is required to be above threshold.
+         *
+         *  \param double Tn_proj_LAB    Kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param int    product        Product (from enum [P_BAR, D_BAR, HE3_BAR, HE4_BAR])
+         *  \param int    A_projectile   Mass number of the projectile (only the sign is used)
+         *  \return double               E_CM_max in GeV (energy of the whole antinucleus), 0 below the production threshold
+         */
+        static double kinematics__E_CM_max      ( double Tn_proj_LAB, int product=P_BAR, int A_projectile=1 );
+        //! Production threshold: smallest kinetic energy per nucleon of the projectile (LAB frame) with kinematics__E_CM_max>0. Arguments as in kinematics__E_CM_max.
+        static double kinematics__Tn_threshold  ( int product=P_BAR, int A_projectile=1 );
+        //! Range of kinetic energies of the product (LAB frame, per nucleon for antinuclei) with a non-zero cross section.
+        /*!
+         *  The product reaches the smallest CM energy at eta_LAB -> infinity, it is produced if gamma*(E_LAB-beta*p_LAB) <= E_CM_max,
+         *  i.e. for E_LAB between gamma*(E_CM_max -/+ beta*p_CM_max).
+         *
+         *  \param double  Tn_proj_LAB   Kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param double& T_min         Returns: Minimal kinetic energy of the product (per nucleon for antinuclei)
+         *  \param double& T_max         Returns: Maximal kinetic energy of the product (per nucleon for antinuclei)
+         *  \return bool                 False (and T_min=T_max=0) below the production threshold
+         *
+         *  All other parameters as in kinematics__E_CM_max.
+         */
+        static bool   kinematics__T_LAB_range   ( double Tn_proj_LAB, double& T_min, double& T_max, int product=P_BAR, int A_projectile=1 );
+        //! Interval of the pseudo rapidity eta_LAB with a non-zero cross section, the integration domain of dE_AA_pbar_LAB, dEn_AA_Dbar_LAB, ...
+        /*!
+         *  The CM energy of the product, gamma*E_LAB - gamma*beta*p_LAB*tanh(eta_LAB), decreases with eta_LAB. The cross section
+         *  is therefore non-zero for eta_LAB > eta_min with tanh(eta_min) = (gamma*E_LAB-E_CM_max)/(gamma*beta*p_LAB), the upper
+         *  limit is the upper limit of the angular integrals, eta_max = 50.
+         *
+         *  \param double  Tn_proj_LAB   Kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param double  T_LAB         Kinetic energy of the product (per nucleon for antinuclei, in the LAB frame)
+         *  \param double& eta_min       Returns: Lower limit of eta_LAB
+         *  \param double& eta_max       Returns: Upper limit of eta_LAB
+         *  \return bool                 False (and eta_min=eta_max=0) if the cross section vanishes for all eta_LAB
+         *
+         *  All other parameters as in kinematics__E_CM_max.
+         */
+        static bool   kinematics__eta_range     ( double Tn_proj_LAB, double T_LAB, double& eta_min, double& eta_max, int product=P_BAR, int A_projectile=1 );
+        //! Lower limit eta_min of kinematics__eta_range for the Lorentz factors gamma, gamma*beta of the CM frame, the LAB energy and momentum of the product, and E_CM_max; -1 if the cross section vanishes for all eta_LAB.
+        static double kinematics__eta_min       ( double gamma, double gammabeta, double E_LAB, double p_LAB, double E_CM_max );
+        /// Upper limit of the angular integrals over eta_LAB
+        static const double fEta_max_LAB;
+
+        //! Integration variable RAPIDITY_LAB of the angular integrals: eta_LAB and the Jacobian as function of w = sqrt(y_max - y_LAB).
+        /*!
+         *  y_LAB is the rapidity of the product at fixed LAB energy, y_max = asinh(p_LAB/mass) its value in forward direction.
+         *  With tanh(eta_LAB) = E_LAB*tanh(y_LAB)/p_LAB the angular integrals transform as
+         *
+         *      int deta cosh(eta)^-2 f(eta)  =  int dw  2w E_LAB/(p_LAB cosh(y_LAB)^2)  f(eta(w)).
+         *
+         *  Close to the forward direction pT is proportional to w, the peak of f at small pT has a width of about
+         *  pT^2/(2 mass^2) in y_LAB, independent of the energy of the product, and the kernels are smooth in w (also
+         *  the terms linear in pT of the di Mauro parametrization). pT is computed without cancellation as
+         *  pT^2 = E_LAB mass sinh(w^2) (p_LAB/E_LAB+tanh(y_LAB))/cosh(y_LAB).
+         *
+         *  \param double  w             Integration variable
+         *  \param double  mass          Mass of the product
+         *  \param double  E_LAB         Energy of the product (in the LAB frame)
+         *  \param double  p_LAB         Momentum of the product (in the LAB frame)
+         *  \param double& eta_LAB       Returns: Pseudo rapidity of the product
+         *  \param double& cosh_eta_LAB  Returns: cosh(eta_LAB) = p_LAB/pT
+         *  \return double               Jacobian, 0 in backward direction (eta_LAB<0) which is not part of the angular integrals
+         */
+        static double kinematics__rapidity_to_eta( double w, double mass, double E_LAB, double p_LAB, double& eta_LAB, double& cosh_eta_LAB );
+        //! Interval [w_min, w_max] of the integration variable RAPIDITY_LAB which corresponds to [eta_min, eta_max], arguments as in kinematics__rapidity_to_eta.
+        static void   kinematics__rapidity_range( double eta_min, double eta_max, double mass, double p_LAB, double& w_min, double& w_max );
+
+
         //! Function to set the parameter values of the di Mauro parametrization yourself.
         /*!
          *  The nameing of the parameters corresponds to the definition
@@ -615,26 +921,26 @@ namespace CRXS {
         
         
         
-        static bool     fIsRestricted_pp;
-        static void     SetRestricted_pp     ( bool is_pp ){fIsRestricted_pp=is_pp;};
+        //
+        //  The restricted parameter space is stored in XS_engine (see xs_engine.h). The functions act on the engine of the calling
+        //  thread, XS_engine::Current(); the static members refer to the default engine, XS_engine::Default().
+        //  It is the convex hull of all points set with SetRestrictedParameterSpace_CM (or _LAB);
+        //  the hull is updated with every point, the number of points is not limited.
+        //
+        static bool&    fIsRestricted_pp;
+        static void     SetRestricted_pp     ( bool is_pp );
         
         static bool     isInRestricted_CM                  ( double s, double xf, double pT );
         static void     SetRestrictedParameterSpace_CM     ( double s, double xf, double pT );
         static void     RemoveRestrictedParameterSpace_CM  (  );
-        static int      fRestrictedParameterSpace_CM;
-        static double   fRestrictedParameterSpace_CM__s    [103];
-        static double   fRestrictedParameterSpace_CM__xf   [103];
-        static double   fRestrictedParameterSpace_CM__pT   [103];
+        static int&     fRestrictedParameterSpace_CM;
         
         
         
         static bool     isInRestricted_LAB                  ( double Tp, double Tpbar, double eta );
         static void     SetRestrictedParameterSpace_LAB     ( double Tp, double Tpbar, double eta );
         static void     RemoveRestrictedParameterSpace_LAB  (  );
-        static int      fRestrictedParameterSpace_LAB;
-        static double   fRestrictedParameterSpace_LAB__Tp   [103];
-        static double   fRestrictedParameterSpace_LAB__Tpbar[103];
-        static double   fRestrictedParameterSpace_LAB__eta  [103];
+        static int&     fRestrictedParameterSpace_LAB;
         
         //        static double fRestrictedParameterSpace_LAB__Tp_Tpbar_eta[100][3];
         
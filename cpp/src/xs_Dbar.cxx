@@ -1,10 +1,11 @@
 #include "math.h"
 #include "iostream"
 
-#include "gsl_integration.h"
-
 #include "xs.h"
 #include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_setup.h"
+#include "xs_coalescence.h"
 
 namespace CRXS {
 
@@ -34,118 +35,42 @@ namespace CRXS {
     }
     
     double XS::inv_AA_Dbar_CM( double s, double xF_dbar, double pT_dbar, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
-        
-        int signed_A_projectile = A_projectile; //For pbar signed_A_projectile=-1, for Dbar signed_A_projectile=-2 ....
-        A_projectile = fabs(1.0001*A_projectile);
-        
-        int nucleons = 2; //This is for deuterion.
-        double p_coalescence;
-        if       (coalescence==FIXED_P0) {
-            p_coalescence = p0_val; //USING THE NOTATION WITH pow(pc/2,3.)
-        }else if (coalescence==ENERGY_DEP__VAN_DOETINCHEM) {
-            p_coalescence = p_coal__VonDoetinchen(s);
-        }else if (coalescence==PT_DEP) {
-            p_coalescence = p_coal__pTdep(pT_dbar/nucleons,p0_val);
-        }else{
-            return -1;
-        }
-        
-        
-        double pL_dbar = xF_dbar/2.*sqrt(s);
-        if(pL_dbar!=pL_dbar){
-            return 0;
-        }
-        double E_pbar = sqrt( pow(XS_definitions::fMass_proton,  2) + pow(pT_dbar/nucleons,2) + pow(pL_dbar/nucleons,2) );
-        //double E_nbar = sqrt( pow(XS_definitions::fMass_neutron, 2) + pow(pT_dbar/nucleons,2) + pow(pL_dbar/nucleons,2) );
-        double E_dbar = sqrt( pow(XS_definitions::fMass_deuteron,2) + pow(pT_dbar,         2) + pow(pL_dbar,         2) );
-        
-        double sq__s_red = sqrt(s) - E_dbar; //it should be -2E_pbar which is about the same of -E_dbar
-        if (sq__s_red<0) {
-            return 0;
-        }
-        double s_red = sq__s_red*sq__s_red;
-        
-        double inv_pp_pbar, inv_pp_nbar, inv_pp_pbar_reduced, inv_pp_nbar_reduced, AA, AA_reduced;
-        
-        double * C_array         = XS_definitions::Get_C_parameters        (parametrization);
-        double * C_array_isospin = XS_definitions::Get_C_parameters_isospin(parametrization);
-        double * D_array         = XS_definitions::Get_D_parameters        (parametrization);
-        
-        double XS;
-        XS  = XS_definitions::fMass_deuteron/XS_definitions::fMass_proton/XS_definitions::fMass_neutron;
-        XS *= (4./3. * 3.1415926536 * pow(p_coalescence/2.,3)) / (pow(A_target*A_projectile, D_array[1]+D_array[2])*XS_definitions::tot_pp__diMauro(s)); //USING THE NOTATION WITH pow(pc/2,3.)  
-        //The factor pow(A_target*A_projectile, D_array[1]+D_array[2]) is used to rescale the total CS. For pp it is 1 while to pHe or Hep it takes a A^0.8.
-        if      (  parametrization==KORSMEIER_II || parametrization==KORSMEIER_III || parametrization==WINKLER || parametrization==WINKLER_II  ){
-            inv_pp_pbar         = XS_definitions::inv_pp_pbar_CM__Winkler(s,     E_pbar, pT_dbar/nucleons, C_array );
-            inv_pp_pbar_reduced = XS_definitions::inv_pp_pbar_CM__Winkler(s_red, E_pbar, pT_dbar/nucleons, C_array );
-        }else if(  parametrization==KORSMEIER_I  || parametrization==DI_MAURO_I || parametrization==DI_MAURO_II ){
-            inv_pp_pbar         = XS_definitions::inv_pp_pbar_CM__diMauro(s,     E_pbar, pT_dbar/nucleons, C_array );
-            inv_pp_pbar_reduced = XS_definitions::inv_pp_pbar_CM__diMauro(s_red, E_pbar, pT_dbar/nucleons, C_array );
-        }else{
-            printf( "Warning in CRXS::XS::inv_AA_pbar_CM. Parametrization %i is not known.", parametrization);
-            return 0;
-        }
-        
-        double deltaHyperon     = XS_definitions::deltaHyperon(s,     C_array_isospin);
-        double deltaHyperon_red = XS_definitions::deltaHyperon(s_red, C_array_isospin);
-        
-        double deltaIsospin     = XS_definitions::deltaIsospin(s,     C_array_isospin);
-        double deltaIsospin_red = XS_definitions::deltaIsospin(s_red, C_array_isospin);
-
-        inv_pp_nbar         = inv_pp_pbar*        (1+deltaIsospin    +deltaHyperon    );
-        inv_pp_nbar_reduced = inv_pp_pbar_reduced*(1+deltaIsospin_red+deltaHyperon_red);
-        
-        if (signed_A_projectile<0){ //This is for the tertiary contribution Dbar-ISM
-            inv_pp_pbar         = XS_definitions::inv_pp_p_CM__Anderson(s,     E_pbar, pT_dbar/nucleons);
-            inv_pp_pbar_reduced = XS_definitions::inv_pp_p_CM__Anderson(s_red, E_pbar, pT_dbar/nucleons);
-        }
-
-        inv_pp_pbar         = inv_pp_pbar*        (1+deltaHyperon);
-        inv_pp_pbar_reduced = inv_pp_pbar_reduced*(1+deltaHyperon);
-
-        AA         = XS_definitions::factor__AA( s,     xF_dbar/nucleons, A_projectile, N_projectile, A_target, N_target, parametrization );
-        AA_reduced = XS_definitions::factor__AA( s_red, xF_dbar/nucleons, A_projectile, N_projectile, A_target, N_target, parametrization );
-        
-        XS *= 0.5 * AA * AA_reduced * (  inv_pp_pbar * inv_pp_nbar_reduced   +   inv_pp_nbar * inv_pp_pbar_reduced  );
-        
-        return XS;
+        return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val ).inv_AA_Dbar_CM( s, xF_dbar, pT_dbar );
+    }
+    
+    double XS_setup::inv_AA_Dbar_CM( double s, double xF_dbar, double pT_dbar ) const{
+        return inv_AA_coalescence_CM<2>( s, xF_dbar, pT_dbar );
     }
 
 
     double XS::inv_AA_Dbar_LAB( double Tn_proj_LAB, double Tn_Dbar_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val ).inv_AA_Dbar_LAB( Tn_proj_LAB, Tn_Dbar_LAB, eta_LAB );
+    }
+    
+    double XS_setup::inv_AA_Dbar_LAB( double Tn_proj_LAB, double Tn_Dbar_LAB, double eta_LAB ) const{
         int    nucleons = 2;
         double s, E_Dbar, pT_pbar, x_F;
         double T_Dbar_LAB = nucleons * Tn_Dbar_LAB;
-        convert_LAB_to_CM( Tn_proj_LAB, T_Dbar_LAB, eta_LAB, s, E_Dbar, pT_pbar, x_F, D_BAR );
-        return inv_AA_Dbar_CM(s, x_F, pT_pbar, A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val);
+        XS::convert_LAB_to_CM( Tn_proj_LAB, T_Dbar_LAB, eta_LAB, s, E_Dbar, pT_pbar, x_F, D_BAR );
+        return inv_AA_Dbar_CM(s, x_F, pT_pbar);
     }
     
     
     double XS::integrand__dE_AA_Dbar_LAB (double eta_LAB, void* parameters  ){
-        
-        double* par = (double * ) parameters;
-        double Tn_proj_LAB      = par[0];
-        double Tn_Dbar_LAB      = par[1];
-        int    A_projectile     = par[2];
-        int    N_projectile     = par[3];
-        int    A_target         = par[4];
-        int    N_target         = par[5];
-        int    parametrization  = par[6];
-        int    coalescence      = par[7];
-        double p0_val           = par[8];
-        
-//        std::cout << " Tn_proj_LAB     " <<  Tn_proj_LAB      << std::endl;
-//        std::cout << " Tn_Dbar_LAB     " <<  Tn_Dbar_LAB      << std::endl;
-//        std::cout << " A_projectile    " <<  A_projectile     << std::endl;
-//        std::cout << " par[2]          " <<  par[2]           << std::endl;
-//        std::cout << " N_projectile    " <<  N_projectile     << std::endl;
-//        std::cout << " A_target        " <<  A_target         << std::endl;
-//        std::cout << " N_target        " <<  N_target         << std::endl;
-//        std::cout << " parametrization " <<  parametrization  << std::endl;
-//        std::cout << " coalescence     " <<  coalescence      << std::endl;
-        
-        return  pow( cosh(eta_LAB), -2 ) * XS::inv_AA_Dbar_LAB( Tn_proj_LAB, Tn_Dbar_LAB, eta_LAB, A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
-        
+        XS_setup__integrand_parameters* par = (XS_setup__integrand_parameters*) parameters;
+        return  pow( cosh(eta_LAB), -2 ) * par->setup->inv_AA_Dbar_LAB( par->Tn_proj_LAB, par->T_LAB, eta_LAB );
+    }
+
+    double XS::integrand__dE_AA_Dbar_LAB__rapidity (double w, void* parameters  ){
+        XS_setup__integrand_parameters* par = (XS_setup__integrand_parameters*) parameters;
+        double T_LAB    = 2 * par->T_LAB;
+        double p_LAB    = sqrt(  T_LAB*(T_LAB+2*XS_definitions::fMass_deuteron)  );
+        double eta_LAB, cosh_eta_LAB;
+        double Jacobian = kinematics__rapidity_to_eta( w, XS_definitions::fMass_deuteron, T_LAB+XS_definitions::fMass_deuteron, p_LAB, eta_LAB, cosh_eta_LAB );
+        if (Jacobian==0) {
+            return 0;
+        }
+        return  Jacobian * par->setup->inv_AA_Dbar_LAB( par->Tn_proj_LAB, par->T_LAB, eta_LAB );
     }
     
     
@@ -161,21 +86,29 @@ namespace CRXS {
         }
         double Jacobian_and_conversion      = 2*3.1415926536*p_Dbar_LAB;
         // it contains: phi_integration (2 pi), inv to d3p (1/E_pbar_LAB), Jacobian(p_pbar_Lab*p_pbar_Lab), dp to dE (E_pbar_LAB/p_pbar_Lab)
-        double epsabs = 0;
-        double epsrel = 1e-4;
+        // the cross section vanishes outside of [eta_min, eta_max], cf. XS::kinematics__eta_range
+        double eta_min, eta_max;
+        if (!kinematics__eta_range( Tn_proj_LAB, Tn_Dbar_LAB, eta_min, eta_max, D_BAR, A_projectile )) {
+            return 0;
+        }
+        const XS_engine&   engine  = XS_engine::Current();
+        Integration_options options = engine.GetIntegrationOptions( engine.fIntegrationMethod_antinuclei );
         double res, err;
-        double par[] = { Tn_proj_LAB, Tn_Dbar_LAB, 1.0001*A_projectile, 1.0001*N_projectile, 1.0001*A_target, 1.0001*N_target, 1.0001*parametrization, 1.0001*coalescence, 1.0001*p0_val };
-        
-        gsl_integration_workspace * w = gsl_integration_workspace_alloc (1000);
-        
-        gsl_function F;
-        F.function = &integrand__dE_AA_Dbar_LAB;
-        F.params   = &par[0];
-        
-        gsl_integration_qag(&F, 0, 50, epsabs, epsrel, 1000, 2, w, &res, &err);
-        gsl_integration_workspace_free (w);
-        if(err/res>epsrel){
-            printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Integral accuarcy of %f is below required value of %f. \n", err/res, epsrel);
+        XS_setup                        setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        XS_setup__integrand_parameters  par;
+        par.setup       = &setup;
+        par.Tn_proj_LAB = Tn_proj_LAB;
+        par.T_LAB       = Tn_Dbar_LAB;
+        
+        if (engine.fIntegrationVariable==RAPIDITY_LAB) {
+            double w_min, w_max;
+            kinematics__rapidity_range( eta_min, eta_max, XS_definitions::fMass_deuteron, p_Dbar_LAB, w_min, w_max );
+            res = Integration::integrate( &integrand__dE_AA_Dbar_LAB__rapidity, w_min, w_max, &par, options, &err );
+        }else{
+            res = Integration::integrate( &integrand__dE_AA_Dbar_LAB,           eta_min, eta_max, &par, options, &err );
+        }
+        if(err/res>options.epsrel){
+            printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Integral accuarcy of %f is below required value of %f. \n", err/res, options.epsrel);
         }
         
         res *=  Jacobian_and_conversion;
@@ -189,19 +122,12 @@ namespace CRXS {
         double shape      = 1.;
         double norm_shape = 0.;
         
-        double log_10 = log(10.);
-        
         if (parametrization==APPROX_1_OVER_T) {
             norm_shape = Tn_Dbar_proj_LAB;
             if(Tn_Dbar_prod_LAB>Tn_Dbar_proj_LAB) shape=0;
         }else if (parametrization==ANDERSON) {
             shape = dE_AA_p_LAB( Tn_Dbar_proj_LAB, Tn_Dbar_prod_LAB, 1, 0, A_target, N_target, ANDERSON);
-            double dlog10T    = 0.1;
-            for (double log10T=-7; log10T<log10(Tn_Dbar_proj_LAB); log10T+=dlog10T) {
-                double T = pow(10,log10T);
-                norm_shape += T* dE_AA_p_LAB( Tn_Dbar_proj_LAB, T, 1, 0, 1, 0, ANDERSON);
-            }
-            norm_shape *= dlog10T * log_10;
+            norm_shape = norm__dE_pp_p_LAB( Tn_Dbar_proj_LAB );
         }else{
             printf( "Warning in CRXS::XS::dEn_DbarA_Dbar_LAB. Parametrization %i is not known.", parametrization);
             return 0;
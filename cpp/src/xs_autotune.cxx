@@ -0,0 +1,242 @@
+#include "math.h"
+#include "stdio.h"
+#include "iostream"
+#include "algorithm"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+#include "xs_context.h"
+#include "xs_autotune.h"
+
+namespace CRXS {
+
+
+    XS_autotune::XS_autotune( int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        fA_projectile           = A_projectile;
+        fN_projectile           = N_projectile;
+        fA_target               = A_target;
+        fN_target               = N_target;
+        fParametrization        = parametrization;
+        fEpsrel                 = 0;
+        fN_Tn                   = 0;
+        fN_T                    = 0;
+        fLog_Tn_min             = 0;
+        fLog_Tn_max             = 0;
+        fLog_T_min              = 0;
+        fLog_T_max              = 0;
+        fError                  = 0;
+        fError_reference        = 0;
+        fEvaluations            = 0;
+        fEvaluations_GSL        = 0;
+        fEvaluations_calibration= 0;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Calibration                                                  #
+    //  ------------------------------------------------------------- #
+
+    //  Only candidates with a tolerance below autotune__safety*epsrel at the calibration points are accepted, since the
+    //  error between the points can be larger.
+    static const double autotune__safety = 0.25;
+
+    //  Integrals of a candidate rule at the calibration points of one region
+    struct autotune__trial{
+        double  error;          // maximal relative deviation from the reference
+        double  evaluations;    // mean number of integrand evaluations
+    };
+
+    static int autotune__cost( const Integration_options& options ){
+        return options.method==TRAPEZE ? options.steps : options.nodes;
+    }
+
+    static bool autotune__cheaper( const Integration_options& a, const Integration_options& b ){
+        return autotune__cost( a ) < autotune__cost( b );
+    }
+
+    static double autotune__relative( double value, double reference ){
+        if (reference==0) {
+            return value==0 ? 0 : 1e100;
+        }
+        return fabs( value-reference )/fabs( reference );
+    }
+
+    static autotune__trial autotune__run( const std::vector<const XS_energy_context*>& context, const std::vector<double>& T, const std::vector<double>& reference, const Integration_options& options, long& evaluations_calibration ){
+        autotune__trial trial = { 0, 0 };
+        long evaluations = 0;
+        for (unsigned i=0; i<T.size(); i++) {
+            double res   = context[i]->dE_AA_pbar_LAB( T[i], options, 0, &evaluations );
+            trial.error  = std::max( trial.error, autotune__relative( res, reference[i] ) );
+        }
+        evaluations_calibration += evaluations;
+        trial.evaluations = evaluations/double(T.size());
+        return trial;
+    }
+
+    //  Reference: the number of Gauss-Legendre nodes is doubled until two successive results agree to 1e-3*epsrel
+    static double autotune__reference( const XS_energy_context& context, double T, double epsrel, double& error, long& evaluations_calibration ){
+        int    nodes = 256;
+        double res   = context.dE_AA_pbar_LAB( T, Integration_options( GAUSS_LEGENDRE, 0, 0, nodes ), 0, &evaluations_calibration );
+        for (nodes*=2; nodes<=8192; nodes*=2) {
+            double res_new = context.dE_AA_pbar_LAB( T, Integration_options( GAUSS_LEGENDRE, 0, 0, nodes ), 0, &evaluations_calibration );
+            error = autotune__relative( res, res_new );
+            res   = res_new;
+            if (error<=1e-3*epsrel) {
+                break;
+            }
+        }
+        if (res==0) {
+            error = 0;
+        }
+        return res;
+    }
+
+
+    void XS_autotune::Calibrate( double epsrel, int n_Tn, double Tn_min, double Tn_max, int n_T, double T_min, double T_max, int n_samples ){
+
+        if (n_Tn<1 || n_T<1 || n_samples<1 || Tn_min<=0 || T_min<=0 || Tn_max<Tn_min || T_max<T_min) {
+            printf( "Warning in CRXS::XS_autotune::Calibrate. Invalid grid, no calibration.\n" );
+            return;
+        }
+        fEpsrel     = epsrel;
+        fN_Tn       = n_Tn;
+        fN_T        = n_T;
+        fLog_Tn_min = log( Tn_min );
+        fLog_Tn_max = log( Tn_max );
+        fLog_T_min  = log( T_min  );
+        fLog_T_max  = log( T_max  );
+        fRegions.assign( n_Tn*n_T, XS_autotune__region() );
+        fError                   = 0;
+        fError_reference         = 0;
+        fEvaluations             = 0;
+        fEvaluations_GSL         = 0;
+        fEvaluations_calibration = 0;
+
+        //  Candidates with a fixed number of evaluations, sorted by this number below
+        std::vector<Integration_options> fixed;
+        int GL_nodes[] = { 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512 };
+        for (unsigned i=0; i<sizeof(GL_nodes)/sizeof(GL_nodes[0]); i++) fixed.push_back( Integration_options( GAUSS_LEGENDRE, epsrel, 0, GL_nodes[i] ) );
+        for (int steps=32; steps<=8192; steps*=2)                           fixed.push_back( Integration_options( TRAPEZE,        epsrel, steps, 0 ) );
+        std::stable_sort( fixed.begin(), fixed.end(), autotune__cheaper );
+
+        Integration_options Romberg( ROMBERG, autotune__safety*epsrel );
+        Romberg.levels = 16;
+        Integration_options GSL_epsrel( GSL, epsrel );
+
+        XS_setup setup( fA_projectile, fN_projectile, fA_target, fN_target, fParametrization );
+
+        double log_dTn = (fLog_Tn_max-fLog_Tn_min)/n_Tn;
+        double log_dT  = (fLog_T_max -fLog_T_min )/n_T;
+        for (int i_Tn=0; i_Tn<n_Tn; i_Tn++) {
+
+            //  Calibration points at the centers of n_samples x n_samples sub-cells
+            std::vector<XS_energy_context> context_Tn;
+            for (int k=0; k<n_samples; k++) {
+                context_Tn.push_back( XS_energy_context( setup, exp( fLog_Tn_min + log_dTn*( i_Tn + (k+0.5)/n_samples ) ) ) );
+            }
+
+            for (int i_T=0; i_T<n_T; i_T++) {
+
+                XS_autotune__region& region = fRegions[ i_Tn*n_T + i_T ];
+                region.Tn_min = exp( fLog_Tn_min + log_dTn* i_Tn    );
+                region.Tn_max = exp( fLog_Tn_min + log_dTn*(i_Tn+1) );
+                region.T_min  = exp( fLog_T_min  + log_dT * i_T     );
+                region.T_max  = exp( fLog_T_min  + log_dT *(i_T +1) );
+
+                std::vector<const XS_energy_context*> context;
+                std::vector<double> T, reference;
+                for (int k=0; k<n_samples; k++) {
+                    for (int l=0; l<n_samples; l++) {
+                        double T_pbar = exp( fLog_T_min + log_dT*( i_T + (l+0.5)/n_samples ) );
+                        double error_reference = 0;
+                        context  .push_back( &context_Tn[k] );
+                        T        .push_back( T_pbar );
+                        reference.push_back( autotune__reference( context_Tn[k], T_pbar, epsrel, error_reference, fEvaluations_calibration ) );
+                        fError_reference = std::max( fError_reference, error_reference );
+                    }
+                }
+
+                autotune__trial GSL_trial     = autotune__run( context, T, reference, GSL_epsrel, fEvaluations_calibration );
+                autotune__trial Romberg_trial = autotune__run( context, T, reference, Romberg,    fEvaluations_calibration );
+                region.evaluations_GSL = GSL_trial.evaluations;
+                region.error_GSL       = GSL_trial.error;
+
+                //  Cheapest candidate: the fixed rules in increasing order, as long as they are cheaper than Romberg
+                bool   found = Romberg_trial.error<=autotune__safety*epsrel;
+                region.options     = Romberg;
+                region.error       = Romberg_trial.error;
+                region.evaluations = Romberg_trial.evaluations;
+                for (unsigned c=0; c<fixed.size(); c++) {
+                    if (found && autotune__cost( fixed[c] )>=region.evaluations) {
+                        break;
+                    }
+                    autotune__trial trial = autotune__run( context, T, reference, fixed[c], fEvaluations_calibration );
+                    if (trial.error<=autotune__safety*epsrel) {
+                        found              = true;
+                        region.options     = fixed[c];
+                        region.error       = trial.error;
+                        region.evaluations = trial.evaluations;
+                        break;
+                    }
+                }
+                if (!found) {
+                    region.options     = GSL_epsrel;
+                    region.error       = GSL_trial.error;
+                    region.evaluations = GSL_trial.evaluations;
+                }
+                region.converged = found;
+
+                fError           = std::max( fError, region.error );
+                fEvaluations    += region.evaluations    /fRegions.size();
+                fEvaluations_GSL+= region.evaluations_GSL/fRegions.size();
+            }
+        }
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Lookup                                                       #
+    //  ------------------------------------------------------------- #
+
+    const XS_autotune__region& XS_autotune::GetRegion( double Tn_proj_LAB, double T_pbar_LAB ) const{
+        int i_Tn = int( floor( (log(Tn_proj_LAB)-fLog_Tn_min)/(fLog_Tn_max-fLog_Tn_min)*fN_Tn ) );
+        int i_T  = int( floor( (log(T_pbar_LAB )-fLog_T_min )/(fLog_T_max -fLog_T_min )*fN_T  ) );
+        i_Tn = std::min( std::max( i_Tn, 0 ), fN_Tn-1 );
+        i_T  = std::min( std::max( i_T,  0 ), fN_T -1 );
+        return fRegions[ i_Tn*fN_T + i_T ];
+    }
+
+    Integration_options XS_autotune::GetIntegrationOptions( double Tn_proj_LAB, double T_pbar_LAB ) const{
+        if (fRegions.empty()) {
+            printf( "Warning in CRXS::XS_autotune::GetIntegrationOptions. Not calibrated, GSL is used.\n" );
+            return Integration_options( GSL );
+        }
+        return GetRegion( Tn_proj_LAB, T_pbar_LAB ).options;
+    }
+
+    Integration_options XS_autotune::GetIntegrationOptions( const XS_engine* engine, double Tn_proj_LAB, double T_pbar_LAB ){
+        if (!engine->fAutotune) {
+            printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Integration method AUTOTUNE without calibration (CRXS_config::SetupAutotune), GSL is used.\n" );
+            return engine->GetIntegrationOptions( GSL );
+        }
+        return engine->fAutotune->GetIntegrationOptions( Tn_proj_LAB, T_pbar_LAB );
+    }
+
+
+    void XS_autotune::Print() const{
+        printf( "CRXS::XS_autotune, epsrel = %.1e, parametrization %i, A_projectile = %i, N_projectile = %i, A_target = %i, N_target = %i\n",
+                fEpsrel, fParametrization, fA_projectile, fN_projectile, fA_target, fN_target );
+        printf( "  %-10s %-10s  %-10s %-10s  %-15s %6s  %10s %12s  %10s %12s\n", "Tn_min", "Tn_max", "T_min", "T_max", "method", "nodes", "error", "evaluations", "error_GSL", "evals_GSL" );
+        for (unsigned i=0; i<fRegions.size(); i++) {
+            const XS_autotune__region& r = fRegions[i];
+            const char* method = r.options.method==GAUSS_LEGENDRE ? "GAUSS_LEGENDRE" : ( r.options.method==TRAPEZE ? "TRAPEZE" : ( r.options.method==ROMBERG ? "ROMBERG" : "GSL" ) );
+            int nodes = r.options.method==GAUSS_LEGENDRE ? r.options.nodes : ( r.options.method==TRAPEZE ? r.options.steps : 0 );
+            printf( "  %-10.3e %-10.3e  %-10.3e %-10.3e  %-15s %6i  %10.2e %12.1f  %10.2e %12.1f%s\n",
+                    r.Tn_min, r.Tn_max, r.T_min, r.T_max, method, nodes, r.error, r.evaluations, r.error_GSL, r.evaluations_GSL, r.converged ? "" : "  (not converged)" );
+        }
+        printf( "  maximal error %.2e (reference %.1e), mean evaluations per integral %.1f (GSL: %.1f), calibration: %li evaluations\n",
+                fError, fError_reference, fEvaluations, fEvaluations_GSL, fEvaluations_calibration );
+    }
+
+}
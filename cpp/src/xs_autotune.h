@@ -0,0 +1,118 @@
+#ifndef CRXS__XS_AUTOTUNE_H
+#define CRXS__XS_AUTOTUNE_H
+
+#include "vector"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_engine.h"
+#include "linAlg_tools.h"
+
+namespace CRXS {
+
+    //! Integration rule of one region of an XS_autotune, with the result of the calibration.
+    struct XS_autotune__region{
+        double              Tn_min;
+        double              Tn_max;
+        double              T_min;
+        double              T_max;
+        /// Cheapest rule which reached the tolerance at all calibration points (GSL if none did, see converged)
+        Integration_options options;
+        /// Maximal relative deviation from the reference at the calibration points
+        double              error;
+        /// Mean number of integrand evaluations per integral with options
+        double              evaluations;
+        /// Mean number of integrand evaluations per integral with GSL at the requested accuracy, for comparison
+        double              evaluations_GSL;
+        /// Maximal relative deviation of GSL at the requested accuracy from the reference, for comparison
+        double              error_GSL;
+        /// false if no rule reached the tolerance at all calibration points
+        bool                converged;
+    };
+
+
+    //! Accuracy-vs-cost calibration of the angular integration of XS::dE_AA_pbar_LAB (integration method AUTOTUNE).
+    /*!
+     *  The plane (Tn_proj_LAB, T_pbar_LAB) is divided into logarithmic regions. Calibrate evaluates the eta integral at
+     *  n_samples x n_samples points of every region with a reference (Gauss-Legendre rule, the number of nodes is doubled
+     *  until two successive results agree to 1e-3*epsrel) and then selects the rule with the fewest integrand evaluations
+     *  which deviates from the reference by less than epsrel/4 at all points. The candidates are
+     *
+     *      GAUSS_LEGENDRE      8, 12, 16, ..., 512 nodes
+     *      TRAPEZE             32, 64, ..., 8192 steps
+     *      ROMBERG             epsrel/4, reuses all evaluations when the step is halved
+     *
+     *  If no candidate is accurate enough the region uses GSL with epsrel. The rules are calibrated for one projectile
+     *  and target; the shape of the integrand depends only weakly on them, but the achieved accuracy for other
+     *  configurations is not checked.
+     *
+     *  Usage:
+     *
+     *      XS_autotune autotune( 1, 0, 1, 0, KORSMEIER_II );
+     *      autotune.Calibrate( 1e-4, 10, 1, 1e6, 10, 0.1, 1e4 );
+     *      autotune.Print();
+     *      CRXS_config::SetupAutotune( &autotune );
+     *      CRXS_config::SetupIntegrationMethod( AUTOTUNE );
+     *      double xs = XS::dE_AA_pbar_LAB( Tn, T );
+     */
+    class XS_autotune{
+
+    public:
+
+        XS_autotune( int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II );
+
+        //! Calibration on n_Tn x n_T logarithmic regions.
+        /*!
+         *  \param double epsrel      Required relative accuracy of the angular integral
+         *  \param int    n_Tn        Number of regions in Tn_proj_LAB
+         *  \param double Tn_min      Lower limit of Tn_proj_LAB (kinetic energy per nucleon of the projectile, LAB frame)
+         *  \param double Tn_max      Upper limit of Tn_proj_LAB
+         *  \param int    n_T         Number of regions in T_pbar_LAB
+         *  \param double T_min       Lower limit of T_pbar_LAB (kinetic energy of the antiproton, LAB frame)
+         *  \param double T_max       Upper limit of T_pbar_LAB
+         *  \param int    n_samples   Calibration points per region and dimension
+         */
+        void    Calibrate( double epsrel, int n_Tn, double Tn_min, double Tn_max, int n_T, double T_min, double T_max, int n_samples=3 );
+
+        /// Rule of the region which contains (Tn_proj_LAB, T_pbar_LAB); outside of the calibrated range the closest region.
+        Integration_options     GetIntegrationOptions( double Tn_proj_LAB, double T_pbar_LAB ) const;
+        /// Rule of engine->fAutotune, or GSL (with a warning) if the engine has no calibration
+        static Integration_options GetIntegrationOptions( const XS_engine* engine, double Tn_proj_LAB, double T_pbar_LAB );
+
+        /// Region which contains (Tn_proj_LAB, T_pbar_LAB), cf. GetIntegrationOptions
+        const XS_autotune__region& GetRegion( double Tn_proj_LAB, double T_pbar_LAB ) const;
+
+        /// Prints the rule, error, and evaluation counts of every region and the summary
+        void    Print() const;
+
+        int     fA_projectile;
+        int     fN_projectile;
+        int     fA_target;
+        int     fN_target;
+        int     fParametrization;
+
+        double  fEpsrel;
+        int     fN_Tn;
+        int     fN_T;
+        double  fLog_Tn_min;
+        double  fLog_Tn_max;
+        double  fLog_T_min;
+        double  fLog_T_max;
+
+        /// Regions, index i_Tn*fN_T + i_T
+        std::vector<XS_autotune__region>    fRegions;
+
+        /// Maximal relative deviation of the calibrated rules from the reference at all calibration points
+        double  fError;
+        /// Maximal estimated relative error of the reference
+        double  fError_reference;
+        /// Mean number of integrand evaluations per integral with the calibrated rules and with GSL at epsrel
+        double  fEvaluations;
+        double  fEvaluations_GSL;
+        /// Number of integrand evaluations of the calibration
+        long    fEvaluations_calibration;
+    };
+
+}
+
+#endif
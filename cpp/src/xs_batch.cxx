@@ -0,0 +1,151 @@
+#include "math.h"
+#include "iostream"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+
+namespace CRXS {
+
+
+    //
+    //  All batch functions resolve the configuration once (XS_setup) and then loop over the kinematic points.
+    //  An unknown parametrization is reported once per batch and the result is set to 0.
+    //  The antiproton functions use the vectorized pp kernels (XS_definitions::batch__inv_pp_pbar_CM__Winkler, ...).
+    //  The ensemble functions evaluate K parameter sets per point (XS_definitions::ensemble__inv_pp_pbar_CM__Winkler, ...).
+    //
+
+
+    void XS::batch__inv_AA_pbar_CM( int n, const double* s, const double* xF, const double* pT_pbar, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        if (!setup.fKernel_pbar) {
+            printf( "Warning in CRXS::XS::batch__inv_AA_pbar_CM. Parametrization %i is not known.", parametrization);
+            for (int i=0; i<n; i++) result[i] = 0;
+            return;
+        }
+        setup.inv_AA_pbar_CM( n, s, xF, pT_pbar, result );
+    }
+
+    void XS::batch__inv_AA_pbar_LAB( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        if (!setup.fKernel_pbar) {
+            printf( "Warning in CRXS::XS::batch__inv_AA_pbar_LAB. Parametrization %i is not known.", parametrization);
+            for (int i=0; i<n; i++) result[i] = 0;
+            return;
+        }
+        setup.inv_AA_pbar_LAB( n, Tn_proj_LAB, T_pbar_LAB, eta_LAB, result );
+    }
+
+
+    void XS::ensemble__inv_AA_pbar_CM( int n, const double* s, const double* xF, const double* pT_pbar, double* result, int K, const double* C_sets, const double* D_sets, const double* C_isospin_sets, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        if (!setup.fEnsembleKernel_pbar) {
+            printf( "Warning in CRXS::XS::ensemble__inv_AA_pbar_CM. Parametrization %i is not known.", parametrization);
+            for (long i=0; i<(long)n*K; i++) result[i] = 0;
+            return;
+        }
+        setup.inv_AA_pbar_CM( n, s, xF, pT_pbar, result, K, C_sets, D_sets, C_isospin_sets );
+    }
+
+    void XS::ensemble__inv_AA_pbar_LAB( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result, int K, const double* C_sets, const double* D_sets, const double* C_isospin_sets, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        if (!setup.fEnsembleKernel_pbar) {
+            printf( "Warning in CRXS::XS::ensemble__inv_AA_pbar_LAB. Parametrization %i is not known.", parametrization);
+            for (long i=0; i<(long)n*K; i++) result[i] = 0;
+            return;
+        }
+        setup.inv_AA_pbar_LAB( n, Tn_proj_LAB, T_pbar_LAB, eta_LAB, result, K, C_sets, D_sets, C_isospin_sets );
+    }
+
+
+    void XS::batch__inv_AA_p_CM( int n, const double* s, const double* xF, const double* pT_p, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        if (parametrization!=ANDERSON) {
+            printf( "Warning in CRXS::XS::batch__inv_AA_p_CM. Parametrization %i is not known.", parametrization);
+            for (int i=0; i<n; i++) result[i] = 0;
+            return;
+        }
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_p_CM( s[i], xF[i], pT_p[i] );
+        }
+    }
+
+    void XS::batch__inv_AA_p_LAB( int n, const double* Tn_proj_LAB, const double* T_p_LAB, const double* eta_LAB, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        if (parametrization!=ANDERSON) {
+            printf( "Warning in CRXS::XS::batch__inv_AA_p_LAB. Parametrization %i is not known.", parametrization);
+            for (int i=0; i<n; i++) result[i] = 0;
+            return;
+        }
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_p_LAB( Tn_proj_LAB[i], T_p_LAB[i], eta_LAB[i] );
+        }
+    }
+
+
+    //
+    //  Antinuclei: an unknown coalescence model returns -1 for every point (as the scalar functions do).
+    //
+
+    static bool batch__check_coalescence( const XS_setup& setup, int n, double* result, const char* name ){
+        if (!setup.fCoalescence_known) {
+            for (int i=0; i<n; i++) result[i] = -1;
+            return false;
+        }
+        if (!setup.fKernel_coalescence) {
+            printf( "Warning in CRXS::XS::%s. Parametrization %i is not known.", name, setup.fParametrization);
+            for (int i=0; i<n; i++) result[i] = 0;
+            return false;
+        }
+        return true;
+    }
+
+    void XS::batch__inv_AA_Dbar_CM( int n, const double* s, const double* xF_Dbar, const double* pT_Dbar, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        if (!batch__check_coalescence( setup, n, result, "batch__inv_AA_Dbar_CM" )) return;
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_Dbar_CM( s[i], xF_Dbar[i], pT_Dbar[i] );
+        }
+    }
+
+    void XS::batch__inv_AA_Dbar_LAB( int n, const double* Tn_proj_LAB, const double* Tn_Dbar_LAB, const double* eta_LAB, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        if (!batch__check_coalescence( setup, n, result, "batch__inv_AA_Dbar_LAB" )) return;
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_Dbar_LAB( Tn_proj_LAB[i], Tn_Dbar_LAB[i], eta_LAB[i] );
+        }
+    }
+
+    void XS::batch__inv_AA_He3bar_CM( int n, const double* s, const double* xF_Hebar, const double* pT_Hebar, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        if (!batch__check_coalescence( setup, n, result, "batch__inv_AA_He3bar_CM" )) return;
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_He3bar_CM( s[i], xF_Hebar[i], pT_Hebar[i] );
+        }
+    }
+
+    void XS::batch__inv_AA_He3bar_LAB( int n, const double* Tn_proj_LAB, const double* Tn_Hebar_LAB, const double* eta_LAB, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        if (!batch__check_coalescence( setup, n, result, "batch__inv_AA_He3bar_LAB" )) return;
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_He3bar_LAB( Tn_proj_LAB[i], Tn_Hebar_LAB[i], eta_LAB[i] );
+        }
+    }
+
+    void XS::batch__inv_AA_He4bar_CM( int n, const double* s, const double* xF_Hebar, const double* pT_Hebar, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        if (!batch__check_coalescence( setup, n, result, "batch__inv_AA_He4bar_CM" )) return;
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_He4bar_CM( s[i], xF_Hebar[i], pT_Hebar[i] );
+        }
+    }
+
+    void XS::batch__inv_AA_He4bar_LAB( int n, const double* Tn_proj_LAB, const double* Tn_Hebar_LAB, const double* eta_LAB, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val );
+        if (!batch__check_coalescence( setup, n, result, "batch__inv_AA_He4bar_LAB" )) return;
+        for (int i=0; i<n; i++) {
+            result[i] = setup.inv_AA_He4bar_LAB( Tn_proj_LAB[i], Tn_Hebar_LAB[i], eta_LAB[i] );
+        }
+    }
+
+}
@@ -0,0 +1,190 @@
+#include "math.h"
+#include "iostream"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+#include "xs_coalescence.h"
+
+namespace CRXS {
+
+
+    //  ------------------------------------------------------------- #
+    //   Coalescence engine                                           #
+    //  ------------------------------------------------------------- #
+
+    void XS_setup::coalescence__levels( int n, const double* s, double E_pbar, double pT_nucleon, double xF_nucleon, XS_coalescence__levels& levels ) const{
+
+        double E [XS_coalescence__levels::n_max] = {};
+        double pT[XS_coalescence__levels::n_max] = {};
+        for (int k=0; k<n; k++) {
+            levels.s[k] = s[k];
+            E [k]       = E_pbar;
+            pT[k]       = pT_nucleon;
+        }
+        //  All single-nucleon kernels of the chain in one vectorized call. The vectorized kernels pad the input to the
+        //  SIMD width, for the two levels of Dbar the scalar kernel is faster.
+        if (n>2) {
+            fBatchKernel_pbar( n, levels.s, E, pT, levels.inv_pbar, fC_array );
+        }else{
+            for (int k=0; k<n; k++) levels.inv_pbar[k] = fKernel_coalescence( s[k], E_pbar, pT_nucleon, fC_array, -1 );
+        }
+
+        //  The antihyperon contribution to the antiprotons is taken at the unreduced energy s[0]
+        double deltaHyperon_0 = XS_definitions::deltaHyperon( s[0], fC_array_isospin );
+        for (int k=0; k<n; k++) {
+            double deltaHyperon = k==0 ? deltaHyperon_0 : XS_definitions::deltaHyperon( s[k], fC_array_isospin );
+            double deltaIsospin = XS_definitions::deltaIsospin( s[k], fC_array_isospin );
+            levels.inv_nbar[k]  = levels.inv_pbar[k]*(1+deltaIsospin+deltaHyperon);
+            if (fSigned_A_projectile<0) { //If the incoming CR is an antiproton then use Anderson CS.
+                levels.inv_pbar[k] = XS_definitions::inv_pp_p_CM__Anderson( s[k], E_pbar, pT_nucleon );
+            }
+            levels.inv_pbar[k] *= (1+deltaHyperon_0);
+            levels.AA[k]        = factor__AA( s[k], xF_nucleon );
+        }
+        levels.p_coalescence = p_coalescence( s[0], pT_nucleon );
+        levels.tot_pp        = XS_definitions::tot_pp__diMauro( s[0] );
+    }
+
+
+    double XS_setup::coalescence__combine( int A, int Z, double mass, const XS_coalescence__levels& levels, const int* level ) const{
+
+        double XS = mass;
+        for (int i=0; i<Z;   i++) XS /= XS_definitions::fMass_proton;
+        for (int i=Z; i<A;   i++) XS /= XS_definitions::fMass_neutron;
+        //USING THE NOTATION WITH pow(pc/2,3.) as in MK paper
+        //fNorm_coalescence=pow(A_target*A_projectile,(nucleons-1.)*(D_array[1]+D_array[2])) rescales the total cross section for target over nuclei
+        double norm = A<5 ? fNorm_coalescence[A] : pow(fNorm_coalescence[2], A-1.);
+        XS *= pow(4./3. * 3.1415926536 * pow(levels.p_coalescence/2.,3),A-1.) / (norm*pow(levels.tot_pp,A-1.));
+
+        //  Sum over all distinct orderings of Z antiprotons and A-Z antineutrons on the levels of the chain.
+        //  sum[z]: orderings of the levels so far with z antiprotons.
+        double sum[XS_coalescence__levels::n_max+1];
+        double AA       = 1;
+        int    orderings = 1;
+        sum[0] = 1;
+        for (int z=1; z<=Z; z++) sum[z] = 0;
+        for (int k=0; k<A; k++) {
+            int l = level[k];
+            for (int z=Z; z>0; z--) {
+                sum[z] = sum[z]*levels.inv_nbar[l] + sum[z-1]*levels.inv_pbar[l];
+            }
+            sum[0] *= levels.inv_nbar[l];
+            AA     *= levels.AA[l];
+        }
+        for (int i=0; i<Z; i++) orderings = orderings*(A-i)/(i+1);
+
+        XS *= (1./orderings) * AA * sum[Z];
+        return XS;
+    }
+
+
+    void XS_setup::inv_AA_antinuclei_CM( double s, double xF_nucleon, double pT_nucleon, double* Dbar, double* He3bar, double* He4bar ) const{
+
+        if (Dbar  ) *Dbar   = 0;
+        if (He3bar) *He3bar = 0;
+        if (He4bar) *He4bar = 0;
+        if (!fCoalescence_known) {
+            if (Dbar  ) *Dbar   = -1;
+            if (He3bar) *He3bar = -1;
+            if (He4bar) *He4bar = -1;
+            return;
+        }
+        double pL_nucleon = xF_nucleon/2.*sqrt(s);
+        if (pL_nucleon!=pL_nucleon) {
+            return;
+        }
+        if (!fKernel_coalescence) {
+            printf( "Warning in CRXS::XS::inv_AA_antinuclei_CM. Parametrization %i is not known.", fParametrization);
+            return;
+        }
+        double E_pbar  = sqrt( pow(XS_definitions::fMass_proton,  2) + pow(pT_nucleon,2) + pow(pL_nucleon,2) );
+        double E_nbar  = sqrt( pow(XS_definitions::fMass_neutron, 2) + pow(pT_nucleon,2) + pow(pL_nucleon,2) );
+        double E_Dbar  = sqrt( pow(XS_definitions::fMass_deuteron,2) + pow(2*pT_nucleon,2) + pow(2*pL_nucleon,2) );
+
+        //  Levels: s, s reduced by E_Dbar (Dbar), and the chain s - 2E_pbar, - 2E_nbar, - 2E_pbar (He3bar, He4bar)
+        double s_level[5];
+        int    n_level = 0;
+        int    level_Dbar[2]   = { 0, -1 };
+        int    level_Hebar[4]  = { 0, -1, -1, -1 };
+        s_level[n_level++] = s;
+
+        double sq__s_Dbar = sqrt(s) - E_Dbar;
+        if (Dbar && sq__s_Dbar>=0) {
+            level_Dbar[1]      = n_level;
+            s_level[n_level++] = sq__s_Dbar*sq__s_Dbar;
+        }
+        int n_Hebar = He4bar ? 4 : ( He3bar ? 3 : 1 );
+        double sq__s = sqrt(s);
+        for (int k=1; k<n_Hebar; k++) {
+            sq__s -= 2.*( k%2==1 ? E_pbar : E_nbar );
+            if (sq__s<0) break;
+            level_Hebar[k]     = n_level;
+            s_level[n_level++] = sq__s*sq__s;
+        }
+
+        XS_coalescence__levels levels;
+        coalescence__levels( n_level, s_level, E_pbar, pT_nucleon, xF_nucleon, levels );
+
+        if (Dbar   && level_Dbar [1]>=0) *Dbar   = coalescence__combine( 2, XS_coalescence<2>::Z, XS_coalescence<2>::mass(), levels, level_Dbar  );
+        if (He3bar && level_Hebar[2]>=0) *He3bar = coalescence__combine( 3, XS_coalescence<3>::Z, XS_coalescence<3>::mass(), levels, level_Hebar );
+        if (He4bar && level_Hebar[3]>=0) *He4bar = coalescence__combine( 4, XS_coalescence<4>::Z, XS_coalescence<4>::mass(), levels, level_Hebar );
+    }
+
+
+    void XS::inv_AA_antinuclei_CM( double s, double xF_nucleon, double pT_nucleon, double* Dbar, double* He3bar, double* He4bar, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+        XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val ).inv_AA_antinuclei_CM( s, xF_nucleon, pT_nucleon, Dbar, He3bar, He4bar );
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Scans of the coalescence momentum                            #
+    //  ------------------------------------------------------------- #
+
+    typedef double (*coalescence__dEn)( double Tn_proj_LAB, double Tn_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val );
+
+    static void coalescence__scan( coalescence__dEn dEn, int A, double mass, double Tn_proj_LAB, double Tn_LAB, int n, const int* coalescence, const double* p0_val, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+
+        double exponent = 3.*(A-1);
+        double s        = 4*XS_definitions::fMass_proton*XS_definitions::fMass_proton + 2 * Tn_proj_LAB * XS_definitions::fMass_proton;
+        //  pT is at most the LAB momentum of the antinucleus
+        double p_LAB    = sqrt( A*Tn_LAB*(A*Tn_LAB+2*mass) );
+        bool   pT_dep   = p_LAB/A >= 0.80;
+
+        //  p-independent integrals with p_coal=1 (FIXED_P0) and p_coal=f(pT/A) (PT_DEP), computed when needed
+        double unit     = 0;    bool has_unit    = false;
+        double unit_pT  = 0;    bool has_unit_pT = false;
+
+        for (int i=0; i<n; i++) {
+            int  model = coalescence[i];
+            bool use_pT = model==PT_DEP && pT_dep;
+            if ( model!=FIXED_P0 && model!=ENERGY_DEP__VAN_DOETINCHEM && model!=PT_DEP ) {
+                result[i] = dEn( Tn_proj_LAB, Tn_LAB, A_projectile, N_projectile, A_target, N_target, parametrization, model, p0_val[i] );
+                continue;
+            }
+            if (use_pT && !has_unit_pT) {
+                unit_pT     = dEn( Tn_proj_LAB, Tn_LAB, A_projectile, N_projectile, A_target, N_target, parametrization, PT_DEP,   1. );
+                has_unit_pT = true;
+            }
+            if (!use_pT && !has_unit) {
+                unit        = dEn( Tn_proj_LAB, Tn_LAB, A_projectile, N_projectile, A_target, N_target, parametrization, FIXED_P0, 1. );
+                has_unit    = true;
+            }
+            double p_coal = model==ENERGY_DEP__VAN_DOETINCHEM ? XS::p_coal__VonDoetinchen(s) : p0_val[i];
+            result[i]     = ( use_pT ? unit_pT : unit ) * pow( p_coal, exponent );
+        }
+    }
+
+    void XS::scan__dEn_AA_Dbar_LAB( double Tn_proj_LAB, double Tn_Dbar_LAB, int n, const int* coalescence, const double* p0_val, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        coalescence__scan( &XS::dEn_AA_Dbar_LAB,   2, XS_definitions::fMass_deuteron, Tn_proj_LAB, Tn_Dbar_LAB,  n, coalescence, p0_val, result, A_projectile, N_projectile, A_target, N_target, parametrization );
+    }
+
+    void XS::scan__dEn_AA_He3bar_LAB( double Tn_proj_LAB, double Tn_Hebar_LAB, int n, const int* coalescence, const double* p0_val, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        coalescence__scan( &XS::dEn_AA_He3bar_LAB, 3, XS_definitions::fMass_helion3,  Tn_proj_LAB, Tn_Hebar_LAB, n, coalescence, p0_val, result, A_projectile, N_projectile, A_target, N_target, parametrization );
+    }
+
+    void XS::scan__dEn_AA_He4bar_LAB( double Tn_proj_LAB, double Tn_Hebar_LAB, int n, const int* coalescence, const double* p0_val, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        coalescence__scan( &XS::dEn_AA_He4bar_LAB, 4, XS_definitions::fMass_helion4,  Tn_proj_LAB, Tn_Hebar_LAB, n, coalescence, p0_val, result, A_projectile, N_projectile, A_target, N_target, parametrization );
+    }
+
+}
@@ -0,0 +1,114 @@
+#ifndef CRXS__XS_COALESCENCE_H
+#define CRXS__XS_COALESCENCE_H
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+
+namespace CRXS {
+
+    //! Compile-time description of the antinucleus with A nucleons for the coalescence engine (traits).
+    /*!
+     *  Each specialization provides:
+     *
+     *      Z                   number of antiprotons (the others are antineutrons)
+     *      reduce_by_nucleus   true if the first reduction of sqrt(s) is the energy of the antinucleus instead of 2*E_pbar
+     *      mass()              mass of the antinucleus
+     *      name()              name of the function in warnings
+     *
+     *  The CM energy is reduced by twice the energy of each coalescing antinucleon (or by the energy of the antinucleus
+     *  for the first reduction, if reduce_by_nucleus), alternating between antiprotons and antineutrons:
+     *
+     *      sqrt(s_0) = sqrt(s),   sqrt(s_1) = sqrt(s_0) - 2*E_pbar,   sqrt(s_2) = sqrt(s_1) - 2*E_nbar,   ...
+     *
+     *  Heavier antinuclei can be added by a specialization of XS_coalescence with A < XS_coalescence__levels::n_max.
+     */
+    template<int A> struct XS_coalescence;
+
+    template<> struct XS_coalescence<2>{
+        static const int  Z                 = 1;
+        static const bool reduce_by_nucleus = true;     // it should be -2E_pbar which is about the same as -E_Dbar
+        static double      mass() { return XS_definitions::fMass_deuteron; }
+        static const char* name() { return "inv_AA_Dbar_CM";   }
+    };
+
+    template<> struct XS_coalescence<3>{
+        static const int  Z                 = 2;
+        static const bool reduce_by_nucleus = false;
+        static double      mass() { return XS_definitions::fMass_helion3;  }
+        static const char* name() { return "inv_AA_He3bar_CM"; }
+    };
+
+    template<> struct XS_coalescence<4>{
+        static const int  Z                 = 2;
+        static const bool reduce_by_nucleus = false;
+        static double      mass() { return XS_definitions::fMass_helion4;  }
+        static const char* name() { return "inv_AA_He4bar_CM"; }
+    };
+
+
+    //! Single-nucleon cross sections at the reduced CM energies of the coalescence chain, cf. XS_setup::coalescence__levels
+    struct XS_coalescence__levels{
+        static const int n_max = 8;
+        double  s        [n_max];
+        /// pp -> pbar + X, including the antihyperons (Anderson for antiproton projectiles)
+        double  inv_pbar [n_max];
+        /// pp -> nbar + X, including the antihyperons
+        double  inv_nbar [n_max];
+        /// Nuclear scaling factor XS_setup::factor__AA
+        double  AA       [n_max];
+        /// Coalescence momentum, XS_setup::p_coalescence
+        double  p_coalescence;
+        /// Total pp cross section at s[0]
+        double  tot_pp;
+    };
+
+
+    template<int A> double XS_setup::inv_AA_coalescence_CM( double s, double xF, double pT ) const{
+
+        typedef XS_coalescence<A> nucleus;
+
+        if (!fCoalescence_known) {
+            return -1;
+        }
+        double pL = xF/2.*sqrt(s);
+        if (pL!=pL) {
+            return 0;
+        }
+        double pT_nucleon = pT/A;
+        double pL_nucleon = pL/A;
+        double xF_nucleon = xF/A;
+        double E_pbar  = sqrt( pow(XS_definitions::fMass_proton,  2) + pow(pT_nucleon,2) + pow(pL_nucleon,2) );
+        double E_nbar  = sqrt( pow(XS_definitions::fMass_neutron, 2) + pow(pT_nucleon,2) + pow(pL_nucleon,2) );
+
+        double s_level[A];
+        double sq__s   = sqrt(s);
+        s_level[0]     = s;
+        for (int k=1; k<A; k++) {
+            if (k==1 && nucleus::reduce_by_nucleus) {
+                sq__s -= sqrt( pow(nucleus::mass(), 2) + pow(pT, 2) + pow(pL, 2) );
+            }else{
+                sq__s -= 2.*( k%2==1 ? E_pbar : E_nbar );
+            }
+            if (sq__s<0) {
+                return 0;
+            }
+            s_level[k] = sq__s*sq__s;
+        }
+
+        if (!fKernel_coalescence) {
+            printf( "Warning in CRXS::XS::%s. Parametrization %i is not known.", nucleus::name(), fParametrization);
+            return 0;
+        }
+
+        XS_coalescence__levels levels;
+        coalescence__levels( A, s_level, E_pbar, pT_nucleon, xF_nucleon, levels );
+
+        int level[A];
+        for (int k=0; k<A; k++) level[k] = k;
+        return coalescence__combine( A, nucleus::Z, nucleus::mass(), levels, level );
+    }
+
+}
+
+#endif
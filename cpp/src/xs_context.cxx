@@ -0,0 +1,233 @@
+#include "math.h"
+#include "iostream"
+#include "crxs.h"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+#include "xs_context.h"
+#include "xs_parametrization.h"
+
+#include "linAlg_tools.h"
+
+namespace CRXS {
+
+
+    //
+    //  All expressions are evaluated in the same order as in XS::convert_LAB_to_CM, XS_definitions::inv_pp_pbar_CM__Winkler,
+    //  XS_definitions::inv_pp_pbar_CM__diMauro, and XS_setup::factor__AA, such that the results are bit-identical.
+    //
+
+    XS_energy_context::XS_energy_context( const XS_setup& setup, double Tn_proj_LAB ){
+
+        double m_p = XS_definitions::fMass_proton;
+
+        fSetup          = &setup;
+        fTn_proj_LAB    = Tn_proj_LAB;
+
+        fS              = 4*m_p*m_p + 2 * Tn_proj_LAB * m_p;
+        fSqrt_s         = sqrt( fS );
+        fE_pbar_Max     = ( fS-8.*m_p*m_p )/2./sqrt( fS );
+        fMass_over_E_pbar_Max = m_p/fE_pbar_Max;
+        fBelowThreshold = ( fS<16*m_p*m_p );
+
+        double E_p_LAB  = Tn_proj_LAB+m_p;
+        double beta     = sqrt(E_p_LAB - m_p)/sqrt(E_p_LAB + m_p);
+        fGamma          = 1./sqrt(1 - beta*beta);
+        fGammabeta      = fGamma * beta;
+
+        fIsWinkler      = ( setup.fKernel_pbar && setup.fKernel==PP_KERNEL__WINKLER  );
+        fIsDiMauro      = ( setup.fKernel_pbar && setup.fKernel==PP_KERNEL__DI_MAURO );
+
+        double* C_array = setup.fC_array;
+
+        fW_R_active      = false;
+        fW_R_prefactor   = 1;
+        fW_R_coefficient = 0;
+        fW_sigma_in      = 0;
+        fW_X             = 0;
+        fW_exponent      = 0;
+        if (fIsWinkler) {
+            fW_R_active  = ( sqrt(fS)<10 );
+            if (fW_R_active) {
+                fW_R_prefactor   = (1 +C_array[9]*pow(10-sqrt(fS),5));
+                // fixed exponent C0 of the parametrization (XS_parametrization), or C0 from the parameters (SELF)
+                fW_R_coefficient = C_array[10]*pow(10-sqrt(fS), setup.fC0>0 ? setup.fC0 : C_array[0]);
+            }
+            fW_sigma_in  = C_array[11] +C_array[12]*log(sqrt(fS)) + C_array[13]*pow(log(sqrt(fS)), 2);
+            fW_X         = C_array[8] * pow(log(sqrt(fS)/4./m_p),2);
+            fW_exponent  = -1./fW_X/C_array[7];
+        }
+
+        fDM_sigma_in     = 0;
+        fDM_s_C4         = 0;
+        fDM_s_C7         = 0;
+        fDM_s_C10        = 0;
+        if (fIsDiMauro) {
+            fDM_sigma_in = XS_definitions::tot_pp__diMauro(fS) - XS_definitions::el_pp__diMauro(fS);
+            fDM_s_C4     = C_array[3] * pow( fS, C_array[4] /2. );
+            fDM_s_C7     = C_array[6] * pow( fS, C_array[7] /2. );
+            fDM_s_C10    = C_array[9] * pow( fS, C_array[10]/2. );
+        }
+
+        fAA_proj         = setup.fAA_proj;
+        fAA_targ         = setup.fAA_targ;
+        if (setup.fKernel_pbar && !setup.fAA_is_pp && !setup.fAA_is_diMauro && setup.fAA_isospin) {
+            double deltaIsospin = XS_definitions::deltaIsospin(fS, setup.fC_array_isospin);
+            fAA_proj    *= (1+deltaIsospin*setup.fN_projectile/setup.fA_projectile);
+            fAA_targ    *= (1+deltaIsospin*setup.fN_target    /setup.fA_target    );
+        }
+    }
+
+
+    double XS_energy_context::inv_pp_pbar_CM( double E_pbar, double pT_pbar ) const{
+        if (fIsWinkler) {
+            return inv_pp_pbar_CM__Winkler( E_pbar, pT_pbar );
+        }
+        if (fIsDiMauro) {
+            return inv_pp_pbar_CM__diMauro( E_pbar, pT_pbar );
+        }
+        return 0;
+    }
+
+
+    double XS_energy_context::inv_pp_pbar_CM__Winkler( double E_pbar_d, double pT_pbar ) const{
+
+        double  m_p     = XS_definitions::fMass_proton;
+        double* C_array = fSetup->fC_array;
+
+        if (fBelowThreshold) {
+            return 0;
+        }
+        double E_pbar = fabs(E_pbar_d);
+        if ( pow(pT_pbar, 2.) > pow(E_pbar, 2.) - pow(m_p, 2.) ){
+            return 0;
+        }
+        double x_R  = E_pbar/fE_pbar_Max;
+        if ( x_R > 1. )
+            return  0.;
+        double m_T  = sqrt(  pT_pbar*pT_pbar  +  m_p*m_p  );
+        double R    = 1.;
+        if (fW_R_active) {
+            R = fW_R_prefactor  *  exp(fW_R_coefficient*pow(x_R-fMass_over_E_pbar_Max, 2));
+        }
+        return R * fW_sigma_in * C_array[5] * pow(1-x_R, C_array[6]) * pow( 1+fW_X*(m_T-m_p), fW_exponent );
+    }
+
+
+    double XS_energy_context::inv_pp_pbar_CM__diMauro( double E_pbar, double pT_pbar ) const{
+
+        double  m_p     = XS_definitions::fMass_proton;
+        double* C_array = fSetup->fC_array;
+
+        if (fBelowThreshold) {
+            return 0;
+        }
+        if ( pow(pT_pbar*0.9, 2.) > pow(E_pbar, 2.) - pow(m_p, 2.) ){
+            return 0;
+        }
+        double x_R  = E_pbar/fE_pbar_Max;
+        if ( x_R > 1. ){
+            return  0.;
+        }
+        return  fDM_sigma_in *
+                pow(1 - x_R, C_array[1]) *
+                exp(-C_array[2] * x_R)*
+                fabs(fDM_s_C4  * exp( -C_array[5] *pT_pbar                 ) +
+                     fDM_s_C7  * exp( -C_array[8] *pT_pbar*pT_pbar         ) +
+                     fDM_s_C10 * exp( -C_array[11]*pT_pbar*pT_pbar*pT_pbar )
+                     );
+    }
+
+
+    double XS_energy_context::factor__AA( double xF ) const{
+        if (fSetup->fAA_is_pp) {
+            return 1;
+        }
+        if (fSetup->fAA_is_diMauro) {
+            return fSetup->fAA_norm;
+        }
+        double proj = fAA_proj * XS_definitions::pbar_overlap_function_projectile( xF );
+        double targ = fAA_targ * XS_definitions::pbar_overlap_function_target    ( xF );
+        return fSetup->fAA_norm*( proj + targ );
+    }
+
+
+    bool XS_energy_context::isOutside_CM( double xF, double pT_pbar ) const{
+        if(fSetup->fEngine->fIsRestricted_pp){
+            return !(fSetup->fEngine->isInRestricted_CM(fS, -xF, pT_pbar)||fSetup->fEngine->isInRestricted_CM(fS, xF, pT_pbar));
+        }
+        return !fSetup->fEngine->isInRestricted_CM(fS, xF, pT_pbar);
+    }
+
+
+    bool XS_energy_context::isOutside_LAB( double T_pbar_LAB, double eta_LAB ) const{
+        if(fSetup->fEngine->fIsRestricted_pp){
+            return !(fSetup->fEngine->isInRestricted_LAB(fTn_proj_LAB, T_pbar_LAB, -eta_LAB)||fSetup->fEngine->isInRestricted_LAB(fTn_proj_LAB, T_pbar_LAB, eta_LAB));
+        }
+        return !fSetup->fEngine->isInRestricted_LAB(fTn_proj_LAB, T_pbar_LAB, eta_LAB);
+    }
+
+
+    double XS_energy_context::inv_AA_pbar_CM( double xF, double pT_pbar ) const{
+        if (fIsWinkler) {
+            return inv_AA_pbar_CM( xF, pT_pbar, XS_energy_context__Winkler( *this ) );
+        }
+        if (fIsDiMauro) {
+            return inv_AA_pbar_CM( xF, pT_pbar, XS_energy_context__diMauro( *this ) );
+        }
+        printf( "Warning in CRXS::XS::inv_AA_pbar_CM. Parametrization %i is not known.", fSetup->fParametrization);
+        return 0;
+    }
+
+
+    double XS_energy_context::inv_AA_pbar_LAB( double T_pbar_LAB, double eta_LAB ) const{
+        double m_p = XS_definitions::fMass_proton;
+        double p_pbar_LAB = sqrt(  T_pbar_LAB*(T_pbar_LAB+2*m_p)  );
+        double E_pbar_LAB = T_pbar_LAB+m_p;
+        if (fIsWinkler) {
+            return inv_AA_pbar_LAB( T_pbar_LAB, p_pbar_LAB, E_pbar_LAB, eta_LAB, cosh(eta_LAB), XS_energy_context__Winkler( *this ) );
+        }
+        if (fIsDiMauro) {
+            return inv_AA_pbar_LAB( T_pbar_LAB, p_pbar_LAB, E_pbar_LAB, eta_LAB, cosh(eta_LAB), XS_energy_context__diMauro( *this ) );
+        }
+        printf( "Warning in CRXS::XS::inv_AA_pbar_CM. Parametrization %i is not known.", fSetup->fParametrization);
+        return 0;
+    }
+
+
+    double XS_energy_context::dE_AA_pbar_LAB( double T_pbar_LAB ) const{
+
+        //
+        //  The angular integrand is instantiated for the pp kernel, see dE_AA_pbar_LAB( T_pbar_LAB, kernel ) in xs_context.h
+        //
+        if (fIsWinkler) {
+            return dE_AA_pbar_LAB( T_pbar_LAB, XS_energy_context__Winkler( *this ) );
+        }
+        if (fIsDiMauro) {
+            return dE_AA_pbar_LAB( T_pbar_LAB, XS_energy_context__diMauro( *this ) );
+        }
+        double m_p        = XS_definitions::fMass_proton;
+        double E_pbar_LAB = T_pbar_LAB + m_p;
+        double p_pbar_LAB = sqrt(  pow( E_pbar_LAB, 2 ) - pow( m_p, 2 )  );
+        if (p_pbar_LAB!=p_pbar_LAB){
+            return 0;
+        }
+        printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Parametrization %i is not known.", fSetup->fParametrization);
+        return 0;
+    }
+
+
+    double XS_energy_context::dE_AA_pbar_LAB( double T_pbar_LAB, const Integration_options& options, double* abserr, long* evaluations ) const{
+        if (abserr) *abserr = 0;
+        if (fIsWinkler) {
+            return dE_AA_pbar_LAB( T_pbar_LAB, XS_energy_context__Winkler( *this ), options, abserr, evaluations );
+        }
+        if (fIsDiMauro) {
+            return dE_AA_pbar_LAB( T_pbar_LAB, XS_energy_context__diMauro( *this ), options, abserr, evaluations );
+        }
+        printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Parametrization %i is not known.", fSetup->fParametrization);
+        return 0;
+    }
+
+}
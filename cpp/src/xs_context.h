@@ -0,0 +1,263 @@
+#ifndef CRXS__XS_CONTEXT_H
+#define CRXS__XS_CONTEXT_H
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+#include "xs_autotune.h"
+
+namespace CRXS {
+
+    //! Antiproton production cross sections at a fixed projectile energy.
+    /*!
+     *  The constructor computes all quantities which depend only on the projectile energy Tn_proj_LAB (and the configuration
+     *  in XS_setup): s, the maximal antiproton energy E_pbar_Max, the LAB->CM boost, the energy-dependent terms of the Winkler
+     *  parametrization (sigma_in, X, and the prefactors of R), the di Mauro inelastic cross section and the powers of s, and
+     *  the isospin-corrected nucleus factors of XS_definitions::factor__AA. These are then reused for every eta node of the
+     *  angular integration and every antiproton energy.
+     *
+     *  The results are bit-identical to XS::inv_AA_pbar_LAB and XS::dE_AA_pbar_LAB.
+     *
+     *  Usage for a table at fixed Tn_proj_LAB:
+     *
+     *      XS_setup          setup  ( A_projectile, N_projectile, A_target, N_target, parametrization );
+     *      XS_energy_context context( setup, Tn_proj_LAB );
+     *      for (...) dE[i] = context.dE_AA_pbar_LAB( T_pbar_LAB[i] );
+     */
+    class XS_energy_context{
+
+    public:
+
+        //! Constructor
+        /*!
+         *  \param XS_setup setup          Configuration (projectile, target, parametrization), has to exist as long as this object.
+         *  \param double   Tn_proj_LAB    Kinetic energy per nucleon of the projectile (in the LAB frame)
+         */
+        XS_energy_context( const XS_setup& setup, double Tn_proj_LAB );
+
+        /// Same as XS_setup::inv_AA_pbar_LAB at the energy of this object.
+        double inv_AA_pbar_LAB ( double T_pbar_LAB, double eta_LAB ) const;
+        /// Same as XS_setup::inv_AA_pbar_CM at the energy of this object.
+        double inv_AA_pbar_CM  ( double xF, double pT_pbar ) const;
+        /// Same as XS::dE_AA_pbar_LAB at the energy of this object.
+        double dE_AA_pbar_LAB  ( double T_pbar_LAB ) const;
+        //! dE_AA_pbar_LAB with the angular integration given by options instead of the engine.
+        /*!
+         *  \param double              T_pbar_LAB   Kinetic energy of the antiproton (in the LAB frame)
+         *  \param Integration_options options      Integration method and accuracy (not AUTOTUNE)
+         *  \param double*             abserr       Returns: error estimate of the integral as in Integration::integrate, may be 0
+         *  \param long*               evaluations  Returns: number of integrand evaluations are added, may be 0
+         */
+        double dE_AA_pbar_LAB  ( double T_pbar_LAB, const Integration_options& options, double* abserr=0, long* evaluations=0 ) const;
+
+        //! dE_AA_pbar_LAB with the pp cross section given by a functor.
+        /*!
+         *  The angular integrand is instantiated for the type Kernel, such that kernel is called directly (and can be
+         *  inlined) at every eta node. Kernel has to provide
+         *
+         *      double operator()( double s, double E_pbar, double pT_pbar ) const;
+         *
+         *  which returns the invariant pp cross section in mbarn/GeV^2 (including all kinematic cutoffs). The nuclear
+         *  scaling factor, the restricted parameter spaces, and the integration settings are those of the XS_setup. The
+         *  built-in kernels are XS_energy_context__Winkler and XS_energy_context__diMauro.
+         */
+        template<class Kernel> double dE_AA_pbar_LAB( double T_pbar_LAB, const Kernel& kernel ) const;
+        /// dE_AA_pbar_LAB with the pp cross section given by a functor and the integration given by options, cf. dE_AA_pbar_LAB( T_pbar_LAB, options, abserr, evaluations )
+        template<class Kernel> double dE_AA_pbar_LAB( double T_pbar_LAB, const Kernel& kernel, const Integration_options& options, double* abserr, long* evaluations ) const;
+
+        /// inv_AA_pbar_CM with the pp cross section given by a functor, cf. dE_AA_pbar_LAB( T_pbar_LAB, kernel )
+        template<class Kernel> double inv_AA_pbar_CM ( double xF, double pT_pbar, const Kernel& kernel ) const;
+
+        /// Invariant pp cross section of the configured parametrization (XS_definitions::inv_pp_pbar_CM__Winkler or XS_definitions::inv_pp_pbar_CM__diMauro)
+        double inv_pp_pbar_CM  ( double E_pbar, double pT_pbar ) const;
+        /// XS_definitions::inv_pp_pbar_CM__Winkler with the energy-dependent terms of this object
+        double inv_pp_pbar_CM__Winkler( double E_pbar, double pT_pbar ) const;
+        /// XS_definitions::inv_pp_pbar_CM__diMauro with the energy-dependent terms of this object
+        double inv_pp_pbar_CM__diMauro( double E_pbar, double pT_pbar ) const;
+        /// Same as XS_setup::factor__AA at the energy of this object.
+        double factor__AA      ( double xF ) const;
+
+
+        const XS_setup* fSetup;
+
+        double  fTn_proj_LAB;
+        double  fS;
+        double  fSqrt_s;
+        double  fE_pbar_Max;
+
+        // LAB -> CM boost
+        double  fGamma;
+        double  fGammabeta;
+
+    private:
+
+        /// inv_AA_pbar_LAB with the LAB momentum and energy of the antiproton and cosh(eta_LAB) computed by the caller
+        template<class Kernel> double inv_AA_pbar_LAB ( double T_pbar_LAB, double p_pbar_LAB, double E_pbar_LAB, double eta_LAB, double cosh_eta_LAB, const Kernel& kernel ) const;
+        /// true if (xF, pT) or (T_pbar_LAB, eta_LAB) is outside of the restricted parameter space
+        bool   isOutside_CM    ( double xF, double pT_pbar ) const;
+        bool   isOutside_LAB   ( double T_pbar_LAB, double eta_LAB ) const;
+
+        /// Integrand of dE_AA_pbar_LAB, parameters: pointer to XS_energy_context__integrand_parameters
+        template<class Kernel> static double integrand__dE_AA_pbar_LAB( double eta_LAB, void* parameters );
+        /// Integrand of dE_AA_pbar_LAB in the integration variable RAPIDITY_LAB, cf. XS::kinematics__rapidity_to_eta
+        template<class Kernel> static double integrand__dE_AA_pbar_LAB__rapidity( double w, void* parameters );
+
+        bool    fIsWinkler;
+        bool    fIsDiMauro;
+        bool    fBelowThreshold;                // s<16 m_p^2
+
+        double  fMass_over_E_pbar_Max;
+
+        // Winkler: R = fW_R_prefactor*exp( fW_R_coefficient*pow(x_R-m_p/E_pbar_Max,2) ) if sqrt(s)<10
+        bool    fW_R_active;
+        double  fW_R_prefactor;
+        double  fW_R_coefficient;
+        double  fW_sigma_in;
+        double  fW_X;
+        double  fW_exponent;                    // -1./X/C7
+
+        // di Mauro
+        double  fDM_sigma_in;
+        double  fDM_s_C4;                       // C3*pow(s, C4/2.)
+        double  fDM_s_C7;                       // C6*pow(s, C7/2.)
+        double  fDM_s_C10;                      // C9*pow(s, C10/2.)
+
+        // factor__AA, nucleus factors including the isospin correction
+        double  fAA_proj;
+        double  fAA_targ;
+    };
+
+    /// Parameters of XS_energy_context::integrand__dE_AA_pbar_LAB
+    struct XS_energy_context__integrand_parameters{
+        const XS_energy_context*  context;
+        double                    T_pbar_LAB;
+        double                    p_pbar_LAB;
+        double                    E_pbar_LAB;
+        const void*               kernel;       // functor of the templated integrand
+        long*                     evaluations;  // counter of the integrand evaluations, or 0
+    };
+
+    /// Winkler pp kernel of an XS_energy_context as functor, cf. XS_energy_context::dE_AA_pbar_LAB( T_pbar_LAB, kernel )
+    struct XS_energy_context__Winkler{
+        XS_energy_context__Winkler( const XS_energy_context& context ) : context(&context) {};
+        double operator()( double /*s*/, double E_pbar, double pT_pbar ) const { return context->inv_pp_pbar_CM__Winkler( E_pbar, pT_pbar ); };
+        const XS_energy_context* context;
+    };
+
+    /// di Mauro pp kernel of an XS_energy_context as functor, cf. XS_energy_context::dE_AA_pbar_LAB( T_pbar_LAB, kernel )
+    struct XS_energy_context__diMauro{
+        XS_energy_context__diMauro( const XS_energy_context& context ) : context(&context) {};
+        double operator()( double /*s*/, double E_pbar, double pT_pbar ) const { return context->inv_pp_pbar_CM__diMauro( E_pbar, pT_pbar ); };
+        const XS_energy_context* context;
+    };
+
+
+    //  ------------------------------------------------------------- #
+    //   Templates                                                    #
+    //  ------------------------------------------------------------- #
+
+    template<class Kernel> double XS_energy_context::inv_AA_pbar_CM( double xF, double pT_pbar, const Kernel& kernel ) const{
+        double pL_pbar = xF*fSqrt_s/2.;
+        double E_pbar  = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_pbar*pL_pbar + pT_pbar*pT_pbar );
+        if (fSetup->fEngine->fRestrictedParameterSpace_CM && isOutside_CM( xF, pT_pbar )) {
+            return 0;
+        }
+        double pp = kernel( fS, E_pbar, pT_pbar );
+        double AA = factor__AA( xF );
+        return pp * AA;
+    }
+
+    template<class Kernel> double XS_energy_context::inv_AA_pbar_LAB( double T_pbar_LAB, double p_pbar_LAB, double E_pbar_LAB, double eta_LAB, double cosh_eta_LAB, const Kernel& kernel ) const{
+        double tanh_eta = tanh(eta_LAB);
+        double pL_pbar  = -fGammabeta * E_pbar_LAB + fGamma     * p_pbar_LAB*tanh_eta;
+        double pT_pbar  = p_pbar_LAB/cosh_eta_LAB;
+        double x_F      = 2. * pL_pbar / fSqrt_s;
+        if (fSetup->fEngine->fRestrictedParameterSpace_LAB && isOutside_LAB( T_pbar_LAB, eta_LAB )) {
+            return 0;
+        }
+        return inv_AA_pbar_CM( x_F, pT_pbar, kernel );
+    }
+
+    template<class Kernel> double XS_energy_context::integrand__dE_AA_pbar_LAB( double eta_LAB, void* parameters ){
+        XS_energy_context__integrand_parameters* par = (XS_energy_context__integrand_parameters*) parameters;
+        if (par->evaluations) {
+            (*par->evaluations)++;
+        }
+        double cosh_eta_LAB = cosh(eta_LAB);
+        return  pow( cosh_eta_LAB, -2 ) * par->context->inv_AA_pbar_LAB( par->T_pbar_LAB, par->p_pbar_LAB, par->E_pbar_LAB, eta_LAB, cosh_eta_LAB, *(const Kernel*) par->kernel );
+    }
+
+    template<class Kernel> double XS_energy_context::integrand__dE_AA_pbar_LAB__rapidity( double w, void* parameters ){
+        XS_energy_context__integrand_parameters* par = (XS_energy_context__integrand_parameters*) parameters;
+        if (par->evaluations) {
+            (*par->evaluations)++;
+        }
+        double eta_LAB, cosh_eta_LAB;
+        double Jacobian = XS::kinematics__rapidity_to_eta( w, XS_definitions::fMass_proton, par->E_pbar_LAB, par->p_pbar_LAB, eta_LAB, cosh_eta_LAB );
+        if (Jacobian==0) {
+            return 0;
+        }
+        return  Jacobian * par->context->inv_AA_pbar_LAB( par->T_pbar_LAB, par->p_pbar_LAB, par->E_pbar_LAB, eta_LAB, cosh_eta_LAB, *(const Kernel*) par->kernel );
+    }
+
+    template<class Kernel> double XS_energy_context::dE_AA_pbar_LAB( double T_pbar_LAB, const Kernel& kernel ) const{
+
+        const XS_engine*    engine  = fSetup->fEngine;
+        Integration_options options = engine->GetIntegrationOptions( engine->fIntegrationMethod );
+        if (options.method==AUTOTUNE) {
+            options = XS_autotune::GetIntegrationOptions( engine, fTn_proj_LAB, T_pbar_LAB );
+        }
+        double res, err;
+        res = dE_AA_pbar_LAB( T_pbar_LAB, kernel, options, &err, 0 );
+        if(err/res>options.epsrel){
+            printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Integral accuarcy of %f is below required value of %f. \n", err/res, options.epsrel);
+        }
+        return res;
+    }
+
+    template<class Kernel> double XS_energy_context::dE_AA_pbar_LAB( double T_pbar_LAB, const Kernel& kernel, const Integration_options& options, double* abserr, long* evaluations ) const{
+
+        double m_p = XS_definitions::fMass_proton;
+
+        //
+        //  Integrate over all solid angle and transform to enery differential (d sigma / d E), see XS::dE_AA_pbar_LAB
+        //
+        double E_pbar_LAB = T_pbar_LAB + m_p;
+        double p_pbar_LAB = sqrt(  pow( E_pbar_LAB, 2 ) - pow( m_p, 2 )  );
+        if (p_pbar_LAB!=p_pbar_LAB){
+            if (abserr) *abserr = 0;
+            return 0;
+        }
+        double Jacobian_and_conversion      = 2*3.1415926536*p_pbar_LAB;
+
+        //  Only the kinematically allowed interval [eta_min, fEta_max_LAB] is integrated, cf. XS::kinematics__eta_range
+        double eta_min = XS::kinematics__eta_min( fGamma, fGammabeta, E_pbar_LAB, p_pbar_LAB, fBelowThreshold ? 0 : fE_pbar_Max );
+        if (eta_min<0) {
+            if (abserr) *abserr = 0;
+            return 0;
+        }
+
+        XS_energy_context__integrand_parameters par;
+        par.context     = this;
+        par.T_pbar_LAB  = T_pbar_LAB;
+        par.p_pbar_LAB  = sqrt(  T_pbar_LAB*(T_pbar_LAB+2*m_p)  );
+        par.E_pbar_LAB  = T_pbar_LAB+m_p;
+        par.kernel      = &kernel;
+        par.evaluations = evaluations;
+
+        double res;
+        if (fSetup->fEngine->fIntegrationVariable==RAPIDITY_LAB) {
+            double w_min, w_max;
+            XS::kinematics__rapidity_range( eta_min, XS::fEta_max_LAB, m_p, par.p_pbar_LAB, w_min, w_max );
+            res = Integration::integrate( &integrand__dE_AA_pbar_LAB__rapidity<Kernel>, w_min, w_max, &par, options, abserr );
+        }else{
+            res = Integration::integrate( &integrand__dE_AA_pbar_LAB<Kernel>,           eta_min, XS::fEta_max_LAB, &par, options, abserr );
+        }
+
+        res *=  Jacobian_and_conversion;
+        if (abserr) *abserr *= Jacobian_and_conversion;
+        return res;
+    }
+}
+
+#endif
@@ -1,11 +1,12 @@
 #include "iostream"
-#include "fstream"
-#include "sstream"
 #include "math.h"
-#include "stdexcept"
 
 #include "xs.h"
 #include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_parametrization.h"
+#include "xs_interpolation.h"
+#include "xs_definitions_tables.h"
 #include "crxs.h"
 
 
@@ -156,15 +157,18 @@ namespace CRXS {
     }
     
     
+    const double XS_definitions::pbar_overlap_function__xF[] = {-0.25, -0.225, -0.2,   -0.175, -0.15, -0.125, -0.1,  -0.075, -0.05, -0.025, 0.,  0.025, 0.05,  0.075, 0.1,   0.125, 0.15, 0.175,   0.2,   0.225,   0.25 };
+    const double XS_definitions::pbar_overlap_function__F [] = {0.   , 0.0003, 0.0008, 0.0027, 0.010, 0.035,  0.110, 0.197,  0.295,  0.4,   0.5, 0.6,   0.705, 0.803, 0.890, 0.965, 0.990, 0.9973, 0.9992, 0.9997, 1.0  };
+    
     double XS_definitions::pbar_overlap_function_projectile(double x_F){
         
-        int n = 25;
+        int n = pbar_overlap_function__n;
         
         if( x_F < -0.2499 ) return 0;
         if( x_F >  0.25   ) return 1;
         
-        double xF[] = {-0.25, -0.225, -0.2,   -0.175, -0.15, -0.125, -0.1,  -0.075, -0.05, -0.025, 0.,  0.025, 0.05,  0.075, 0.1,   0.125, 0.15, 0.175,   0.2,   0.225,   0.25 };
-        double F [] = {0.   , 0.0003, 0.0008, 0.0027, 0.010, 0.035,  0.110, 0.197,  0.295,  0.4,   0.5, 0.6,   0.705, 0.803, 0.890, 0.965, 0.990, 0.9973, 0.9992, 0.9997, 1.0  };
+        const double* xF = pbar_overlap_function__xF;
+        const double* F  = pbar_overlap_function__F;
         
         double xl = 0;
         double xu = 1;
@@ -192,112 +196,103 @@ namespace CRXS {
     }
 
 
+    //
+    //  Parameter arrays and nuclear scaling factor from the traits in xs_parametrization.h
+    //
+    struct definitions__parameters{
+        definitions__parameters() : C(0), C_isospin(0), D(0) {};
+        template<class P> void apply(){
+            C         = P::C();
+            C_isospin = P::C_isospin();
+            D         = P::D();
+        }
+        void unknown(){}
+        double* C;
+        double* C_isospin;
+        double* D;
+    };
+
+
     double * XS_definitions::Get_D_parameters(int parametrization){
-        if(parametrization==CRXS::KORSMEIER_I){
-             return Korsmeier_I_D1_to_D2;
-        }else if(parametrization==CRXS::KORSMEIER_II){
-            return Korsmeier_II_D1_to_D2;
-        }else if(parametrization==CRXS::KORSMEIER_III){
-            return Korsmeier_III_D1_to_D2;
-        }else if(parametrization==CRXS::WINKLER){
-            return Winkler_D1_to_D2;
-        }else if(parametrization==CRXS::WINKLER_II){
-            return Winkler_II_D1_to_D2;
-        }else if(parametrization==CRXS::DI_MAURO_I){
-            return diMauro_I_D1_to_D2;
-        }else if(parametrization==CRXS::DI_MAURO_II){
-            return diMauro_II_D1_to_D2;
-        }else if(parametrization==CRXS::ANDERSON){
-            return Korsmeier_II_D1_to_D2;
-        }else if(parametrization==CRXS::WINKLER_SELF){
-            return Winkler_SELF_D1_to_D2;
-        }else if(parametrization==CRXS::DI_MAURO_SELF){
-            return diMauro_SELF_D1_to_D2;
-        }else{
+        definitions__parameters parameters;
+        XS_parametrization__dispatch( parametrization, parameters );
+        if (!parameters.D) {
             printf( "Warning in CRXS::XS_definitions::Get_D_parameters. Parametrizatino %i is not known.", parametrization);
+            return Dummy;
         }
-        return Dummy;
-        
+        return parameters.D;
     }
     
     
     double *  XS_definitions::Get_C_parameters(int parametrization){
-        if(parametrization==CRXS::KORSMEIER_I){
-            return Korsmeier_I_C1_to_C11;
-        }else if(parametrization==CRXS::KORSMEIER_II){
-            return Korsmeier_II_C1_to_C16;
-        }else if(parametrization==CRXS::KORSMEIER_III){
-            return Korsmeier_III_C1_to_C16;
-        }else if(parametrization==CRXS::WINKLER){
-            return Winkler_C1_to_C16;
-        }else if(parametrization==CRXS::WINKLER_II){
-            return Winkler_II_C1_to_C16;
-        }else if(parametrization==CRXS::DI_MAURO_I){
-            return diMauro_I_C1_to_C11;
-        }else if(parametrization==CRXS::DI_MAURO_II){
-            return diMauro_II_C1_to_C11;
-        }else if(parametrization==CRXS::ANDERSON){
-                return Korsmeier_II_C1_to_C16;
-        }else if(parametrization==CRXS::WINKLER_SELF){
-            return Winkler_SELF_C1_to_C16;
-        }else if(parametrization==CRXS::DI_MAURO_SELF){
-            return diMauro_SELF_C1_to_C11;
-        }else{
+        definitions__parameters parameters;
+        XS_parametrization__dispatch( parametrization, parameters );
+        if (!parameters.C) {
             printf( "Warning in CRXS::XS_definitions::Get_C_parameters. Parametrizatino %i is not known.", parametrization);
+            return Dummy;
         }
-        return Dummy;
+        return parameters.C;
     }
     
     
     double *  XS_definitions::Get_C_parameters_isospin(int parametrization){
-        if(parametrization==CRXS::KORSMEIER_I){
-            return Korsmeier_II_C1_to_C16; // is correct since KORSMEIER I and II use same isospin parameters
-        }else if(parametrization==CRXS::KORSMEIER_II){
-            return Korsmeier_II_C1_to_C16;
-        }else if(parametrization==CRXS::KORSMEIER_III){
-            return Korsmeier_III_C1_to_C16;
-        }else if(parametrization==CRXS::WINKLER){
-            return Winkler_C1_to_C16;
-        }else if(parametrization==CRXS::WINKLER_II){
-            return Winkler_II_C1_to_C16;
-        }else if(parametrization==CRXS::DI_MAURO_I){
-            return diMauro_I_C1_to_C16;
-        }else if(parametrization==CRXS::DI_MAURO_II){
-            return diMauro_II_C1_to_C16;
-        }else if(parametrization==CRXS::ANDERSON){
-            return Anderson_C1_to_C16;
-        }else if(parametrization==CRXS::WINKLER_SELF){
-            return Winkler_SELF_C1_to_C16;
-        }else if(parametrization==CRXS::DI_MAURO_SELF){
-            return diMauro_SELF_C1_to_C16;
-        }else{
+        definitions__parameters parameters;
+        XS_parametrization__dispatch( parametrization, parameters );
+        if (!parameters.C_isospin) {
             printf( "Warning in CRXS::XS_definitions::Get_C_parameters_isospin. Parametrizatino %i is not known.", parametrization);
+            return Dummy;
         }
-        return Dummy;
+        return parameters.C_isospin;
     }
     
     
+    struct definitions__factor__AA{
+        template<class P> void apply(){
+            double * D_array = P::D();
+            double * C_array = P::C_isospin();
+            if (P::diMauro_AA) {
+                result = pow(A_projectile*A_target, D_array[1]);
+                return;
+            }
+            double proj, targ;
+            if (P::isospin_AA) {
+                proj = pow(A_projectile, D_array[2])*(1+   XS_definitions::deltaIsospin(s,&C_array[0])*N_projectile/A_projectile)*XS_definitions::pbar_overlap_function_projectile( xF );
+                targ = pow(A_target,     D_array[2])*(1+   XS_definitions::deltaIsospin(s,&C_array[0])*N_target    /A_target    )*XS_definitions::pbar_overlap_function_target    ( xF );
+            }else{
+                proj = pow(A_projectile, D_array[2])*(1+0.*XS_definitions::deltaIsospin(s,&C_array[0])*N_projectile/A_projectile)*XS_definitions::pbar_overlap_function_projectile( xF );
+                targ = pow(A_target,     D_array[2])*(1+0.*XS_definitions::deltaIsospin(s,&C_array[0])*N_target    /A_target    )*XS_definitions::pbar_overlap_function_target    ( xF );
+            }
+            result = pow(A_projectile*A_target, D_array[1])*( proj + targ );
+        }
+        void unknown(){
+            unknown_parametrization = true;
+        }
+        double  s, xF;
+        int     A_projectile, N_projectile, A_target, N_target;
+        double  result;
+        bool    unknown_parametrization;
+    };
+    
+    
     double XS_definitions::factor__AA( double s, double xF, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
         
         if (1000*A_projectile+100*N_projectile+10*A_target+N_target==1010) {
             return 1;
         }
-        double * D_array = Get_D_parameters        (parametrization);
-        double * C_array = Get_C_parameters_isospin(parametrization);
-
-        if(parametrization==DI_MAURO_I || parametrization==DI_MAURO_II){
-            return pow(A_projectile*A_target, D_array[1]);
+        definitions__factor__AA factor;
+        factor.s                        = s;
+        factor.xF                       = xF;
+        factor.A_projectile             = A_projectile;
+        factor.N_projectile             = N_projectile;
+        factor.A_target                 = A_target;
+        factor.N_target                 = N_target;
+        factor.result                   = 0;
+        factor.unknown_parametrization  = false;
+        XS_parametrization__dispatch( parametrization, factor );
+        if (factor.unknown_parametrization) {
+            printf( "Warning in CRXS::XS_definitions::factor__AA. Parametrizatino %i is not known. Return 0.", parametrization);
         }
-
-        double proj = pow(A_projectile, D_array[2])*(1+   deltaIsospin(s,&C_array[0])*N_projectile/A_projectile)*pbar_overlap_function_projectile( xF );
-        double targ = pow(A_target,     D_array[2])*(1+   deltaIsospin(s,&C_array[0])*N_target    /A_target    )*pbar_overlap_function_target    ( xF );
-        
-        if(parametrization==WINKLER || parametrization==WINKLER_II){
-            proj    = pow(A_projectile, D_array[2])*(1+0.*deltaIsospin(s,&C_array[0])*N_projectile/A_projectile)*pbar_overlap_function_projectile( xF );
-            targ    = pow(A_target,     D_array[2])*(1+0.*deltaIsospin(s,&C_array[0])*N_target    /A_target    )*pbar_overlap_function_target    ( xF );
-        }
-        
-        return pow(A_projectile*A_target, D_array[1])*( proj + targ );
+        return factor.result;
     }
     
     
@@ -328,7 +323,7 @@ namespace CRXS {
     double XS_definitions::Korsmeier_I_C1_to_C11 [] = {  -1,   3.50193e+00, 5.58513e+00, 3.99553e-02, -2.50716e-01, 2.65053e+00, 3.78145e-02, 4.29478e-02, 2.69520e+00,   0.0,       0.0,    0.0   };
     double XS_definitions::diMauro_I_C1_to_C11   [] = {  -1,   4.499,       3.41,        0.00942,      0.445,       3.502,       0.0622,      -0.247,      2.576,         0.0,       0.0,    0.0   };
     double XS_definitions::diMauro_II_C1_to_C11  [] = {  -1,   4.448,       3.735,       0.00502,      0.708,       3.527,       0.236,       -0.729,      2.517,        -1.822e-11, 3.527,  0.384 };
-    double XS_definitions::diMauro_SELF_C1_to_C11[] = {  -1,   3.50193e+00, 5.58513e+00, 3.99553e-02, -2.50716e-01, 2.65053e+00, 3.78145e-02, 4.29478e-02, 2.69520e+00,   0.0,       0.0,    0.0   };
+    const double XS_definitions::diMauro_SELF_C1_to_C11__default[] = {  -1,   3.50193e+00, 5.58513e+00, 3.99553e-02, -2.50716e-01, 2.65053e+00, 3.78145e-02, 4.29478e-02, 2.69520e+00,   0.0,       0.0,    0.0   };
     //
     //
     //  The names of the parameters correspond to Korsmeier et al. 2018
@@ -336,7 +331,7 @@ namespace CRXS {
     //                                                 {  D0,   D1,   D2    }
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     double XS_definitions::Korsmeier_I_D1_to_D2  []  = {  -1,  0.825, 0.167 };
-    double XS_definitions::diMauro_SELF_D1_to_D2 []  = {  -1,  0.825, 0.167 };
+    const double XS_definitions::diMauro_SELF_D1_to_D2__default []  = {  -1,  0.825, 0.167 };
     
     // Parameters are choosen such that the XS is simply scaled by A^0.8 for projectile and target in the case of di Mauro, et al. XSs.
     double XS_definitions::diMauro_I_D1_to_D2    []  = {  -1,  0.8,   0.    };
@@ -356,10 +351,10 @@ namespace CRXS {
     double XS_definitions::Winkler_II_C1_to_C16   [] = {   2,   0.31,   0.30, 21316., 0.9,  0.047,       7.76,    0.168,       0.038, 1.0e-3,      0.7,         30.9,  -1.74,  0.71,  0.114, 20736., 0.51 };
     double XS_definitions::Korsmeier_II_C1_to_C16 [] = {   1,   0.31,   0.30, 21316., 0.9,  5.01767e-02, 7.79045, 1.64809e-01, 0.038, 4.74370e-04, 3.70480e+00, 30.9,  -1.74,  0.71,  0.114, 20736., 0.51 };
     double XS_definitions::Korsmeier_III_C1_to_C16[] = {   2,   0.31,   0.30, 21316., 0.9,  5.01767e-02, 7.79045, 1.64809e-01, 0.038, 4.74370e-04, 3.70480e+00, 30.9,  -1.74,  0.71,  0.114, 20736., 0.51 };
-    double XS_definitions::Winkler_SELF_C1_to_C16 [] = {   1,   0.31,   0.30, 21316., 0.9,  5.01767e-02, 7.79045, 1.64809e-01, 0.038, 4.74370e-04, 3.70480e+00, 30.9,  -1.74,  0.71,  0.114, 20736., 0.51 };
+    const double XS_definitions::Winkler_SELF_C1_to_C16__default [] = {   1,   0.31,   0.30, 21316., 0.9,  5.01767e-02, 7.79045, 1.64809e-01, 0.038, 4.74370e-04, 3.70480e+00, 30.9,  -1.74,  0.71,  0.114, 20736., 0.51 };
     
     // This array contains only the isospin and hyperon parameters, all others are set to 0
-    double XS_definitions::diMauro_SELF_C1_to_C16[] = {  -1,   0.31,   0.30, 21316., 0.9,  0,           0,       0,           0,     0,           0,           0,      0,     0,     0.114, 20736., 0.51 };
+    const double XS_definitions::diMauro_SELF_C1_to_C16__default[] = {  -1,   0.31,   0.30, 21316., 0.9,  0,           0,       0,           0,     0,           0,           0,      0,     0,     0.114, 20736., 0.51 };
     
     // Parameters are choosen to make deltaHyperon=0 and delta isoSpin=0.3 for diMauro XS:
     double XS_definitions::diMauro_I_C1_to_C16   [] = {  -1,   0.00,   0.00,     0., 0.0,  0.,          0.,      0.,          0.,    0.,          0,            0.,    0.,    0.,    0.6,     100., 0.0 };
@@ -379,9 +374,16 @@ namespace CRXS {
     double XS_definitions::Korsmeier_III_D1_to_D2[] = {  -1, 0.828, 0.145  };
     double XS_definitions::Winkler_D1_to_D2      [] = {  -1, 0.839, 0.161  };      // value of <nu_He>=1.25 is translated to D_1 and D_2 (see Korsmeier et al. 2018)
     double XS_definitions::Winkler_II_D1_to_D2   [] = {  -1, 0.839, 0.161  };      // value of <nu_He>=1.25 is translated to D_1 and D_2 (see Korsmeier et al. 2018)
-    double XS_definitions::Winkler_SELF_D1_to_D2 [] = {  -1, 0.828, 0.145  };
+    const double XS_definitions::Winkler_SELF_D1_to_D2__default [] = {  -1, 0.828, 0.145  };
     
     double XS_definitions::Dummy                 [] = {  -1  };
+    
+    
+    double (&XS_definitions::Winkler_SELF_C1_to_C16)[17] = XS_engine::Default().fWinkler_SELF_C1_to_C16;
+    double (&XS_definitions::diMauro_SELF_C1_to_C11)[12] = XS_engine::Default().fdiMauro_SELF_C1_to_C11;
+    double (&XS_definitions::diMauro_SELF_C1_to_C16)[17] = XS_engine::Default().fdiMauro_SELF_C1_to_C16;
+    double (&XS_definitions::Winkler_SELF_D1_to_D2 ) [3] = XS_engine::Default().fWinkler_SELF_D1_to_D2;
+    double (&XS_definitions::diMauro_SELF_D1_to_D2 ) [3] = XS_engine::Default().fdiMauro_SELF_D1_to_D2;
 
     
     
@@ -392,115 +394,47 @@ namespace CRXS {
     //  ------------------------------------------------------------- #
   
     
-    double XS_definitions::totXS_get_interpolation_loglin(double x, double array[91][4] ){
-        
-        double  dx = 10 * (log10(x)+2);
-        int     ix = dx;
-        
-        if(ix<0)  ix =  0;
-        if(ix>90) ix = 90;
-        
-        double vl = log( array[ix  ][1]  );
-        double vu = log( array[ix+1][1]  );
-        
-        return exp( vl+(vu-vl)*(dx-ix)  );
-        
-    }
-    
-    bool XS_definitions::f_totXS_IsRead = false;
-    
-    void XS_definitions::totXS_TableToArray( std::string file, double array[91][4] ){
-        std::ifstream   ifs;
-        std::string     line;
-        std::string     line2;
-        ifs.open(file.c_str());
-        if(!ifs){
-            std::cerr << ("ERROR: File: "+file+" does not exist.").c_str() << std::endl;
-            return;
-        }
-        int idxrow = 0;
-        while(!ifs.eof()){
-            std::getline(ifs, line);
-            std::stringstream ss(line);
-            if (line == "" ) {
-                continue;
-            }
-            if ((line.at(0) == '#') || (line.at(0) == '*')) {
-                continue;
-            }
-            if (idxrow>=91) {
-                std::cerr << "ERROR: Table in " << file << " has too many rows." << std::endl;
-                exit(0);
-            }
-            int idxcol = 0;
-            while (std::getline(ss, line2, ' ')) {
-                if (line2=="") {
-                    continue;
-                }
-                if (idxcol>=4) {
-                    std::cerr << "ERROR: Table in " << file << " has too many colums." << std::endl;
-                    exit(0);
-                }
-                try {
-                    double v = std::stod(line2);
-                    if (v<1e-100) v = 1e-100;
-                    array[idxrow][idxcol] = v;
-                } catch(const std::invalid_argument &ia) {
-                    std::cerr << "ERROR: Some value in " << file << " is not a double" << std::endl;
-                    throw;
-                }
-                idxcol++;
-            }
-            idxrow++;
-        }
-        ifs.close();
-    }
-    
-    
-    double XS_definitions::fXS__el_pbarp [91][4];
-    double XS_definitions::fXS__tot_pbarp[91][4];
-    double XS_definitions::fXS__tot_pbarD[91][4];
-    double XS_definitions::fXS__nar_pbarD[91][4];
-    
-    void XS_definitions::totXS_Read(){
-        
-        std::string file_ppbar_el  = CRXS_config::Get_CRXS_DataDir()+"/table_ppbar_el.txt" ;
-        std::string file_ppbar_tot = CRXS_config::Get_CRXS_DataDir()+"/table_ppbar_tot.txt";
-        std::string file_dpbar_tot = CRXS_config::Get_CRXS_DataDir()+"/table_dpbar_tot.txt";
-        std::string file_dpbar_nar = CRXS_config::Get_CRXS_DataDir()+"/table_dpbar_nar.txt";
-        
-        std::cout << "Read file: " << file_ppbar_el << std::endl;
-        totXS_TableToArray( file_ppbar_el, fXS__el_pbarp );
-        
-        std::cout << "Read file: " << file_ppbar_tot << std::endl;
-        totXS_TableToArray( file_ppbar_tot, fXS__tot_pbarp );
-        
-        std::cout << "Read file: " << file_dpbar_tot << std::endl;
-        totXS_TableToArray( file_dpbar_tot, fXS__tot_pbarD );
-        
-        std::cout << "Read file: " << file_dpbar_nar << std::endl;
-        totXS_TableToArray( file_dpbar_nar, fXS__nar_pbarD );
-        
-        f_totXS_IsRead = true;
-    }
+    //  Tables compiled into the library (generated from cpp/data/table_*.txt by cpp/data/write_totXS_tables.py), uniform
+    //  in log(T_pbar) with 10 nodes per decade from 10^-2 to 10^7 GeV. Constant initialization, no runtime setup.
+#define CRXS_TOTXS_TABLE(NAM)                                                                                           \
+    const XS_interpolation__table XS_definitions::fXS__##NAM = {                                                        \
+        totXS__##NAM##__n, INTERPOLATION__LOGLOG_LINEAR, true, totXS__##NAM##__log_x_min, totXS__##NAM##__inv_dlog_x,   \
+        totXS__##NAM##__x, totXS__##NAM##__y, totXS__##NAM##__log_x, totXS__##NAM##__log_y, totXS__##NAM##__coefficients  \
+    };
+
+    CRXS_TOTXS_TABLE(el_pbarp )
+    CRXS_TOTXS_TABLE(tot_pbarp)
+    CRXS_TOTXS_TABLE(tot_pbarD)
+    CRXS_TOTXS_TABLE(nar_pbarD)
+
+#undef CRXS_TOTXS_TABLE
     
     double XS_definitions::el_pbarp (double T_pbar){
-        if(!f_totXS_IsRead) totXS_Read();
-        return totXS_get_interpolation_loglin(T_pbar, fXS__el_pbarp);
+        return XS_interpolation::Interpolate( fXS__el_pbarp,  T_pbar );
     };
     double XS_definitions::tot_pbarp (double T_pbar){
-        if(!f_totXS_IsRead) totXS_Read();
-        return totXS_get_interpolation_loglin(T_pbar, fXS__tot_pbarp);
+        return XS_interpolation::Interpolate( fXS__tot_pbarp, T_pbar );
     };
     double XS_definitions::tot_pbarD (double T_pbar){
-        if(!f_totXS_IsRead) totXS_Read();
-        return totXS_get_interpolation_loglin(T_pbar, fXS__tot_pbarD);
+        return XS_interpolation::Interpolate( fXS__tot_pbarD, T_pbar );
     };
     double XS_definitions::nar_pbarD (double T_pbar){
-        if(!f_totXS_IsRead) totXS_Read();
-        return totXS_get_interpolation_loglin(T_pbar, fXS__nar_pbarD);
+        return XS_interpolation::Interpolate( fXS__nar_pbarD, T_pbar );
     };
     
+    void XS_definitions::batch__el_pbarp ( int n, const double* T_pbar, double* result ){
+        XS_interpolation::Interpolate( fXS__el_pbarp,  n, T_pbar, result );
+    }
+    void XS_definitions::batch__tot_pbarp( int n, const double* T_pbar, double* result ){
+        XS_interpolation::Interpolate( fXS__tot_pbarp, n, T_pbar, result );
+    }
+    void XS_definitions::batch__tot_pbarD( int n, const double* T_pbar, double* result ){
+        XS_interpolation::Interpolate( fXS__tot_pbarD, n, T_pbar, result );
+    }
+    void XS_definitions::batch__nar_pbarD( int n, const double* T_pbar, double* result ){
+        XS_interpolation::Interpolate( fXS__nar_pbarD, n, T_pbar, result );
+    }
+    
 }
 
 
@@ -2,6 +2,7 @@
 #define CRXS__XS_DEFINITIONS_H
 
 #include "xs.h"
+#include "xs_interpolation.h"
 #include "stdio.h"
 
 #include "string"
@@ -51,7 +52,63 @@ namespace CRXS {
          *  \return double           Cross section in mbarn/GeV^2
          * */
         static double inv_pp_pbar_CM__diMauro( double s, double E_pbar, double pT_pbar, double* C_array, int len_C_array=-1 );
-        
+
+        //! Vectorized version of inv_pp_pbar_CM__Winkler for n points.
+        /*!
+         *  The points are evaluated with SSE2 (2 points), AVX2 (4 points) or AVX-512 (8 points) instructions, the instruction
+         *  set is chosen at runtime (CRXS_config::SetupSIMD, CRXS_config::Get_SIMD). Without SIMD support the scalar function
+         *  is called for each point. The kinematic cutoffs are applied as masks, i.e. without branches.
+         *
+         *  Accuracy: the vectorized exp and log deviate from the scalar math library by up to 1 ulp. Since pow(a,b) is computed
+         *  as exp(b*log(a)), the deviation of the result from inv_pp_pbar_CM__Winkler grows with the size of the exponents.
+         *  It is below 512 ulp (relative 1e-13) for 3.5 GeV < sqrt(s) < 3.5*10^5 GeV, x_R > 1e-4 and pT < 5 GeV (measured
+         *  max: 305 ulp). Results smaller than 2.2e-308 are set to 0. For bit-identical results use CRXS_config::SetupSIMD(SIMD_NONE).
+         *
+         *  \param int     n         Number of points.
+         *  \param double* s         CM energy squared, array of length n.
+         *  \param double* E_pbar    Energy of the produced antiproton in CMF, array of length n.
+         *  \param double* pT_pbar   Transverse momentum of the produced antiproton in CMF, array of length n.
+         *  \param double* result    Output: cross section in mbarn/GeV^2, array of length n (allocated by the caller).
+         *  \param double* C_array   Parameters, see inv_pp_pbar_CM__Winkler.
+         * */
+        static void   batch__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* C_array );
+
+        //! Vectorized version of inv_pp_pbar_CM__diMauro for n points.
+        /*!
+         *  See batch__inv_pp_pbar_CM__Winkler for the instruction sets.
+         *
+         *  Accuracy: in the region given for batch__inv_pp_pbar_CM__Winkler the deviation from inv_pp_pbar_CM__diMauro is below
+         *  64 ulp for the parameters of KORSMEIER_I and DI_MAURO_I. The parameters of DI_MAURO_II have a negative coefficient
+         *  (C9) and the pT-dependent terms cancel at large s and small pT, there the deviation reaches 10^4 ulp (relative 1e-12).
+         *  Results smaller than 2.2e-308 are set to 0.
+         *
+         *  \param int     n         Number of points.
+         *  \param double* s         CM energy squared, array of length n.
+         *  \param double* E_pbar    Energy of the produced antiproton in CMF, array of length n.
+         *  \param double* pT_pbar   Transverse momentum of the produced antiproton in CMF, array of length n.
+         *  \param double* result    Output: cross section in mbarn/GeV^2, array of length n (allocated by the caller).
+         *  \param double* C_array   Parameters, see inv_pp_pbar_CM__diMauro.
+         * */
+        static void   batch__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* C_array );
+
+        //! Evaluates inv_pp_pbar_CM__Winkler for n points and K parameter sets in one call (e.g. the walkers of an ensemble sampler).
+        /*!
+         *  The kinematic quantities of each point are computed once and the kernel is vectorized across the parameter sets
+         *  (instruction sets as in batch__inv_pp_pbar_CM__Winkler). The results agree bit by bit with
+         *  batch__inv_pp_pbar_CM__Winkler called with each parameter set.
+         *
+         *  \param int     n         Number of points.
+         *  \param double* s         CM energy squared, array of length n.
+         *  \param double* E_pbar    Energy of the produced antiproton in CMF, array of length n.
+         *  \param double* pT_pbar   Transverse momentum of the produced antiproton in CMF, array of length n.
+         *  \param double* result    Output: cross sections in mbarn/GeV^2, result[i*K+k] for point i and parameter set k (array of length n*K, allocated by the caller).
+         *  \param int     K         Number of parameter sets.
+         *  \param double* C_sets    Parameters, C_sets[k*17+c] is C_c of set k (cf. inv_pp_pbar_CM__Winkler, C0 is the exponent of 10-sqrt(s)).
+         * */
+        static void   ensemble__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_sets );
+        //! Evaluates inv_pp_pbar_CM__diMauro for n points and K parameter sets in one call, as ensemble__inv_pp_pbar_CM__Winkler with C_sets[k*12+c].
+        static void   ensemble__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_sets );
+
         //! Parametrization of the total pp cross section.
         /*!
          *  Taken from:     di Mauro, et al.; 2014;
@@ -77,40 +134,62 @@ namespace CRXS {
         static double tot_pp__diMauro(double s);
         
         
-        //! Function to read a simple text table.
-        /*!
-         *  \param std::string file      File name of the table.
-         *  \param double array[91][4]   Array to store the table entries.
-         * */
-        static void   totXS_TableToArray( std::string file, double array[91][4] );
-        
-        /// Bool to store whether the tables are alread read.
-        static bool   f_totXS_IsRead;
-        
-        //! Function to read all the total XS tables.
+        //! Parametrization of the gamma-ray production (from pi0 decays) in pp collisions, Eq. (8) of Kafexhiu et al.
         /*!
+         *  Taken from:     Kafexhiu, et al.; 2014;
+         *                  Parametrization of gamma-ray production cross sections for pp interactions in a broad proton
+         *                  energy range from the kinematic threshold to PeV energies;
+         *                  arXiv:1406.7369v2, DOI: 10.1103/PhysRevD.90.123014
+         *
+         *  C++ version of python/XS_pp_gamma.py (same masses, parameters and branches). Below the minimal gamma-ray energy
+         *  at the given proton energy the cross section is 0.
+         *
+         *  \param double T_p_LAB       Kinetic energy of the proton (in the LAB frame), GeV
+         *  \param double E_gamma_LAB   Energy of the gamma ray (in the LAB frame), GeV
+         *  \return double              Cross section in mbarn/GeV
+         *
          * */
-        static void   totXS_Read();
-        
-        
-        //! Function to interpolate the the XS tables. Interpolation is linear in log-log.
+        static double dE_pp_gamma_LAB__Kafexhiu( double T_p_LAB, double E_gamma_LAB );
+        
+        /// Kinematic threshold of pi0 production, 2 m_pi + m_pi^2/(2 m_p), in GeV
+        static const double pp_gamma__T_p_threshold;
+        /// Peak value of the spectrum in mbarn/GeV, parameters of Tab. VII of Kafexhiu et al.
+        static double pp_gamma__A_max    ( double T_p_LAB );
+        /// Spectral shape, Eq. (11) of Kafexhiu et al.
+        static double pp_gamma__F        ( double T_p_LAB, double E_gamma_LAB );
+        /// Total pi0 production cross section in mbarn, Sec. II.4 of Kafexhiu et al.
+        static double pp_gamma__sigma_pi ( double T_p_LAB );
+        /// One-pion production cross section in mbarn, Eq. (2) of Kafexhiu et al.
+        static double pp_gamma__sigma_1pi( double T_p_LAB );
+        /// Two-pion production cross section in mbarn, Eq. (5) of Kafexhiu et al.
+        static double pp_gamma__sigma_2pi( double T_p_LAB );
+        /// Inelastic pp cross section in mbarn, Eq. (1) of Kafexhiu et al.
+        static double pp_gamma__sigma_in ( double T_p_LAB );
+        /// Average pi0 multiplicity, Eq. (7) of Kafexhiu et al.
+        static double pp_gamma__n_pi     ( double T_p_LAB );
+        /// Relativistic Breit-Wigner distribution of the Delta resonance, Eq. (4) of Kafexhiu et al.
+        static double pp_gamma__f_BW     ( double sqrt_s );
+        /// Maximal pi0 energy in the LAB frame, Eq. (10) of Kafexhiu et al.
+        static double pp_gamma__E_pi_max_LAB( double T_p_LAB );
+        /// Parameters of the spectral shape F below 4 GeV
+        static double pp_gamma__kappa    ( double T_p_LAB );
+        static double pp_gamma__mu       ( double T_p_LAB );
+        
+        
+        //! Tables of the total cross sections, compiled into the library (no files are read at runtime).
         /*!
-         *  To be used with the arrays fXS__*
-         *  \param double x              Value in column 0 of array.
-         *  \param double array[91][4]   Table which is supposed to be interpolated (use column 1).
-         *  \return double               Interpolted value
+         *  Generated from <CRXS dir>/cpp/data/table_*.txt by cpp/data/write_totXS_tables.py. Kinetic energy of the
+         *  antiproton in GeV from 10^-2 to 10^7 (10 nodes per decade), cross section in mbarn, linear interpolation in
+         *  log-log. To be used with XS_interpolation::Interpolate.
          * */
-        static double totXS_get_interpolation_loglin(double x, double array[91][4] );
-        
-        
-        /// Array to store the total              pbar+p XS; column 0: T_pbar in GeV, column 1: XS in mbarn
-        static double fXS__tot_pbarp[91][4];
-        /// Array to store the elastic            pbar+p XS; column 0: T_pbar in GeV, column 1: XS in mbarn
-        static double fXS__el_pbarp [91][4];
-        /// Array to store the total              pbar+D XS; column 0: T_pbar in GeV, column 1: XS in mbarn
-        static double fXS__tot_pbarD[91][4];
-        /// Array to store the non-annihilation   pbar+D XS; column 0: T_pbar in GeV, column 1: XS in mbarn
-        static double fXS__nar_pbarD[91][4];
+        /// Total              pbar+p XS
+        static const XS_interpolation__table fXS__tot_pbarp;
+        /// Elastic            pbar+p XS
+        static const XS_interpolation__table fXS__el_pbarp;
+        /// Total              pbar+D XS
+        static const XS_interpolation__table fXS__tot_pbarD;
+        /// Non-annihilation   pbar+D XS
+        static const XS_interpolation__table fXS__nar_pbarD;
         
         
         //! Interpolation of the total pbar+p cross section.
@@ -159,6 +238,19 @@ namespace CRXS {
          * */
         static double nar_pbarD (double T_pbar);
         
+        //! Vectorized versions of tot_pbarp, el_pbarp, tot_pbarD and nar_pbarD for n kinetic energies.
+        /*!
+         *  See XS_interpolation for the instruction sets and the accuracy with respect to the scalar functions.
+         *
+         *  \param int     n        Number of points.
+         *  \param double* T_pbar   Kinetic energy of the antiproton (target at rest), array of length n.
+         *  \param double* result   Output: cross section in mbarn, array of length n (allocated by the caller).
+         * */
+        static void   batch__tot_pbarp( int n, const double* T_pbar, double* result );
+        static void   batch__el_pbarp ( int n, const double* T_pbar, double* result );
+        static void   batch__tot_pbarD( int n, const double* T_pbar, double* result );
+        static void   batch__nar_pbarD( int n, const double* T_pbar, double* result );
+        
         
         
         
@@ -204,6 +296,13 @@ namespace CRXS {
          **/
         static double pbar_overlap_function_target    (double x_F);
         
+        /// Number of nodes of the piecewise linear overlap function
+        static const int    pbar_overlap_function__n = 21;
+        /// Nodes of the overlap function in x_F, the function is 0 below the first and 1 above the last node
+        static const double pbar_overlap_function__xF[pbar_overlap_function__n];
+        /// Values of the projectile overlap function at the nodes
+        static const double pbar_overlap_function__F [pbar_overlap_function__n];
+        
         
         //! Parametrization of the nuclear scaling factor
         /*!
@@ -235,7 +334,51 @@ namespace CRXS {
         
         static double deltaHyperon( double s, double* C_array, int len_C_array=-1 );
         static double deltaIsospin( double s, double* C_array, int len_C_array=-1 );
-        
+
+
+        //! inv_pp_pbar_CM__Winkler and its gradient with respect to the parameters, in one pass.
+        /*!
+         *  The derivatives are analytic and reuse the factors of the cross section, so the value and all 17 derivatives cost
+         *  about one evaluation of inv_pp_pbar_CM__Winkler (instead of 17 for finite differences). The value is identical to
+         *  inv_pp_pbar_CM__Winkler. Outside of the kinematically allowed range the value and the gradient are 0.
+         *
+         *  \param double  s         CM energy squared.
+         *  \param double  E_pbar    Energy of the produced antiproton in CMF
+         *  \param double  pT_pbar   Transverse momentum of the produced antiproton in CMF.
+         *  \param double* C_array   Parameters, see inv_pp_pbar_CM__Winkler (C0 is the exponent of 10-sqrt(s)).
+         *  \param double* gradient  Output: d XS/d C_i in gradient[i], i=0,...,16 (array of length 17, allocated by the caller).
+         *  \return double           Cross section in mbarn/GeV^2
+         * */
+        static double gradient__inv_pp_pbar_CM__Winkler( double s, double E_pbar, double pT_pbar, double* C_array, double* gradient );
+        //! inv_pp_pbar_CM__diMauro and its gradient with respect to the parameters, in one pass.
+        /*!
+         *  As gradient__inv_pp_pbar_CM__Winkler, gradient has length 12 (gradient[0]=0).
+         * */
+        static double gradient__inv_pp_pbar_CM__diMauro( double s, double E_pbar, double pT_pbar, double* C_array, double* gradient );
+        //! deltaHyperon and its gradient with respect to C_array (length 17, non-zero for C1,...,C4).
+        static double gradient__deltaHyperon( double s, double* C_array, double* gradient );
+        //! deltaIsospin and its gradient with respect to C_array (length 17, non-zero for C14,...,C16).
+        static double gradient__deltaIsospin( double s, double* C_array, double* gradient );
+        //! factor__AA and its gradient with respect to the parameters of the parametrization.
+        /*!
+         *  \param double* gradient_C    Output: derivatives with respect to Get_C_parameters_isospin(parametrization), length 17
+         *  \param double* gradient_D    Output: derivatives with respect to Get_D_parameters(parametrization), length 3
+         *
+         *  The other arguments and the value as in factor__AA (1 with a vanishing gradient for pp).
+         * */
+        static double gradient__factor__AA( double s, double xF, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, double* gradient_C, double* gradient_D );
+
+        //! Jacobians of the pp kernels for n points (e.g. all data points of a fit).
+        /*!
+         *  result[i] is the cross section at point i and gradient[i*n_C+k] its derivative with respect to C_k, with n_C=17
+         *  (Winkler) or n_C=12 (di Mauro); gradient is an array of length n*n_C allocated by the caller. Same values as the
+         *  scalar gradient__* functions.
+         * */
+        static void   batch__gradient__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* gradient, double* C_array );
+        static void   batch__gradient__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* gradient, double* C_array );
+        //! Jacobian of factor__AA for n points, gradient_C has length n*17, gradient_D length n*3 (cf. gradient__factor__AA).
+        static void   batch__gradient__factor__AA( int n, const double* s, const double* xF, double* result, double* gradient_C, double* gradient_D, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization );
+
         // Parameter definitions:
         
         static double Korsmeier_I_C1_to_C11 [12];
@@ -261,13 +404,21 @@ namespace CRXS {
         
         
         
-        static double Winkler_SELF_C1_to_C16     [17];
-        static double diMauro_SELF_C1_to_C11     [12];
+        // The SELF parameters are stored in XS_engine (see xs_engine.h), these refer to the default engine.
+        static double (&Winkler_SELF_C1_to_C16)  [17];
+        static double (&diMauro_SELF_C1_to_C11)  [12];
+        
+        static double (&diMauro_SELF_C1_to_C16)  [17];
         
-        static double diMauro_SELF_C1_to_C16     [17];
+        static double (&Winkler_SELF_D1_to_D2)    [3];
+        static double (&diMauro_SELF_D1_to_D2)    [3];
         
-        static double Winkler_SELF_D1_to_D2       [3];
-        static double diMauro_SELF_D1_to_D2       [3];
+        // Initial values of the SELF parameters of each XS_engine
+        static const double Winkler_SELF_C1_to_C16__default [17];
+        static const double diMauro_SELF_C1_to_C11__default [12];
+        static const double diMauro_SELF_C1_to_C16__default [17];
+        static const double Winkler_SELF_D1_to_D2__default   [3];
+        static const double diMauro_SELF_D1_to_D2__default   [3];
         
         
         static double Dummy                  [1];
@@ -0,0 +1,804 @@
+//
+//  Internal header (not installed), generated by cpp/data/write_totXS_tables.py from cpp/data/table_*.txt. Do not edit.
+//
+//  Tables of the total cross sections for XS_definitions::el_pbarp, tot_pbarp, tot_pbarD and nar_pbarD: kinetic energy
+//  of the antiproton in GeV (x), cross section in mbarn (y), their natural logarithms, and the coefficients of the linear
+//  interpolation in log-log (4 per interval, see XS_interpolation__table). The grids are uniform in log(x).
+//
+
+#ifndef CRXS__XS_DEFINITIONS_TABLES_H
+#define CRXS__XS_DEFINITIONS_TABLES_H
+
+namespace CRXS {
+
+    //  elastic            pbar+p XS, table_ppbar_el.txt
+    static constexpr int    totXS__el_pbarp__n          = 91;
+    static constexpr double totXS__el_pbarp__log_x_min  = -4.605170185988091;
+    static constexpr double totXS__el_pbarp__inv_dlog_x = 4.342944819032518;
+    static constexpr double totXS__el_pbarp__x[91] = {
+                             0.01,          0.0125892541179,          0.0158489319246,          0.0199526231497,
+                  0.0251188643151,          0.0316227766017,          0.0398107170553,          0.0501187233627,
+                   0.063095734448,          0.0794328234724,                      0.1,           0.125892541179,
+                   0.158489319246,           0.199526231497,           0.251188643151,           0.316227766017,
+                   0.398107170553,           0.501187233627,            0.63095734448,           0.794328234724,
+                              1.0,            1.25892541179,            1.58489319246,            1.99526231497,
+                    2.51188643151,            3.16227766017,            3.98107170553,            5.01187233627,
+                     6.3095734448,            7.94328234724,                     10.0,            12.5892541179,
+                    15.8489319246,            19.9526231497,            25.1188643151,            31.6227766017,
+                    39.8107170554,            50.1187233627,             63.095734448,            79.4328234724,
+                            100.0,            125.892541179,            158.489319246,            199.526231497,
+                    251.188643151,            316.227766017,            398.107170554,            501.187233627,
+                     630.95734448,            794.328234724,                   1000.0,            1258.92541179,
+                    1584.89319246,            1995.26231497,            2511.88643151,            3162.27766017,
+                    3981.07170554,            5011.87233627,             6309.5734448,            7943.28234724,
+                          10000.0,            12589.2541179,            15848.9319246,            19952.6231497,
+                    25118.8643151,            31622.7766017,            39810.7170554,            50118.7233627,
+                     63095.734448,            79432.8234724,                 100000.0,            125892.541179,
+                    158489.319246,            199526.231497,            251188.643151,            316227.766017,
+                    398107.170554,            501187.233627,             630957.34448,            794328.234724,
+                        1000000.0,            1258925.41179,            1584893.19246,            1995262.31497,
+                    2511886.43151,            3162277.66017,            3981071.70554,            5011872.33627,
+                     6309573.4448,            7943282.34724,               10000000.0,
+    };
+    static constexpr double totXS__el_pbarp__y[91] = {
+                          99.0832,            97.1239896997,            95.4194253771,            93.4936780429,
+                    91.0033600589,            87.7405006297,              83.64921645,            79.0810740419,
+                    74.4257043252,              69.87655232,            65.4702688714,            61.2466895375,
+                    57.2935466253,             53.688128623,            50.4769395106,            47.6837619096,
+                    45.2902061478,            43.1511542185,            41.1066442556,            38.8247827259,
+                    35.8672529875,            32.1358380515,            28.2790444564,            24.8710318308,
+                     22.007336077,            19.5117677126,            17.2827867469,            15.3515435834,
+                    13.7458527362,              12.40733334,             11.231134885,            10.1745370878,
+                    9.32986452023,            8.78196502922,            8.47296716375,            8.23880651716,
+                     7.9631059198,             7.6603744267,            7.37160513613,            7.13070960864,
+                    6.96618385707,            6.89357186772,            6.88401779766,            6.90059756735,
+                    6.93292576403,            6.99695339742,            7.10212167633,             7.2240309218,
+                    7.32907905301,            7.40723981735,            7.47398752091,            7.54374458041,
+                    7.61977069213,            7.70299549732,            7.80589330036,            7.95340547058,
+                    8.16326704263,             8.4143151695,            8.67345198704,            8.92626929037,
+                    9.18017566686,            9.44325512689,            9.71918026268,            10.0105435755,
+                    10.3176375573,            10.6380856203,            10.9694795861,            11.3108770453,
+                    11.6617367305,            12.0234466491,            12.3996306725,            12.7936723806,
+                    13.2062105413,            13.6370756222,             14.085582335,             14.550447036,
+                    15.0303390457,            15.5245601847,            16.0326480593,            16.5576365685,
+                    17.1066370077,            17.6862699663,            18.2975525807,            18.9398195705,
+                    19.6113168201,            20.3090137608,            21.0301785023,            21.7753206881,
+                    22.5459360744,            23.3443546278,            24.1738388407,
+    };
+    static constexpr double totXS__el_pbarp__log_x[91] = {
+               -4.605170185988091,       -4.374911676691997,      -4.1446531673899845,       -3.914394658089316,
+               -3.684136148790306,       -3.453877639490556,       -3.223619130192913,      -2.9933606208928025,
+              -2.7631021115931613,       -2.532843602293805,      -2.3025850929940455,       -2.072326583697951,
+              -1.8420680743959392,      -1.6118095650952704,      -1.3815510557962603,      -1.1512925464965105,
+              -0.9210340371988673,       -0.690775527898757,      -0.4605170185991155,     -0.23025850929975888,
+                              0.0,       0.2302585092960944,       0.4605170185981066,       0.6907755278987752,
+               0.9210340371977853,       1.1512925464975354,       1.3815510557951782,       1.6118095650952886,
+               1.8420680743949303,       2.0723265836942866,        2.302585092994046,         2.53284360229014,
+               2.7631021115921524,       2.9933606208928207,       3.2236191301918313,        3.453877639491581,
+                3.684136148791736,       3.9143946580893343,        4.144653167388976,        4.374911676688332,
+                4.605170185988092,        4.835428695284186,        5.065687204586198,        5.295945713886867,
+                5.526204223185877,        5.756462732485627,        5.986721241785782,         6.21697975108338,
+                6.447238260383021,        6.677496769682378,        6.907755278982137,        7.138013788278231,
+                7.368272297580243,       7.5985308068809125,        7.828789316179923,        8.059047825479672,
+                8.289306334779827,        8.519564844077426,        8.749823353377067,        8.980081862676423,
+                9.210340371976184,        9.440598881272278,         9.67085739057429,        9.901115899874958,
+               10.131374409173969,       10.361632918473719,       10.591891427773874,        10.82214993707147,
+               11.052408446371112,        11.28266695567047,       11.512925464970229,       11.743183974266323,
+               11.973442483568334,       12.203700992869004,       12.433959502168014,       12.664218011467764,
+               12.894476520767919,       13.124735030065517,       13.354993539365159,       13.585252048664515,
+               13.815510557964274,       14.045769067260368,       14.276027576562381,        14.50628608586305,
+                14.73654459516206,       14.966803104461809,       15.197061613761964,       15.427320123059562,
+               15.657578632359204,       15.887837141658562,        16.11809565095832,
+    };
+    static constexpr double totXS__el_pbarp__log_y[91] = {
+                4.595959901233247,        4.575988406571419,       4.5582821780314715,        4.537893819494238,
+                4.510896429559362,        4.474383601553793,        4.426632060383583,         4.37047357992364,
+                4.309801370413662,        4.246730146899339,        4.181596129232409,        4.114909799596823,
+                4.048187993037782,        3.983191908602584,        3.921516588633531,       3.8645909187554617,
+                3.813090809286622,       3.7647091661519907,       3.7161697691566977,       3.6590587727769797,
+                 3.57982470616109,       3.4699718575714176,       3.3421210517870836,        3.213703745929338,
+               3.0913758558189928,       2.9710177559944575,       2.8497110204485203,        2.731216028156624,
+                2.620737159430911,       2.5182876961909786,        2.418689821970216,        2.319888235237216,
+               2.2332204938781537,        2.172700190034125,       2.1368807618104935,        2.108855493280547,
+               2.0748191146812553,        2.036060863328109,       1.9976354757211205,        1.964410753827421,
+               1.9410675650881861,       1.9305893640078562,       1.9292024637120173,        1.931608011817075,
+                1.936281912277179,       1.9454748253757084,       1.9603935670592925,         1.97741309653188,
+               1.9918498672151905,        2.002457875630016,        2.011428661395053,        2.020718687442237,
+               2.0307462763494293,       2.0416092788347626,        2.054878999738536,        2.073600198025071,
+               2.0996444617195076,        2.129934442215795,       2.1602668646116836,        2.188998534962169,
+                2.217046340272841,       2.2453007434834746,       2.2741012798007154,       2.3036388950995144,
+               2.3338548149812146,       2.3644405448212957,       2.3951168334261963,         2.42576483312503,
+               2.4563131175580075,        2.486858630857764,       2.5176666876916185,        2.548950703431042,
+                2.580687214497028,       2.6127922322295376,       2.6451517448116304,       2.6776217172692367,
+                2.710070761441262,       2.7424232979303325,       2.7746271469460013,        2.806847419478268,
+               2.8394665173112603,       2.8727886304439187,        2.906767312143987,       2.9412665613397997,
+                2.976106788392317,        3.011064815122263,       3.0459584776624182,       3.0807772499825883,
+               3.1155548312772394,       3.1503551830546925,       3.1852710087773333,
+    };
+    static constexpr double totXS__el_pbarp__coefficients[360] = {
+                4.595959901233247,    -0.019971494661827904,                      0.0,                      0.0,
+                4.575988406571419,     -0.01770622853994741,                      0.0,                      0.0,
+               4.5582821780314715,     -0.02038835853723331,                      0.0,                      0.0,
+                4.537893819494238,    -0.026997389934876104,                      0.0,                      0.0,
+                4.510896429559362,      -0.0365128280055691,                      0.0,                      0.0,
+                4.474383601553793,    -0.047751541170209855,                      0.0,                      0.0,
+                4.426632060383583,     -0.05615848045994287,                      0.0,                      0.0,
+                 4.37047357992364,    -0.060672209509978536,                      0.0,                      0.0,
+                4.309801370413662,     -0.06307122351432248,                      0.0,                      0.0,
+                4.246730146899339,     -0.06513401766693061,                      0.0,                      0.0,
+                4.181596129232409,      -0.0666863296355853,                      0.0,                      0.0,
+                4.114909799596823,     -0.06672180655904114,                      0.0,                      0.0,
+                4.048187993037782,     -0.06499608443519822,                      0.0,                      0.0,
+                3.983191908602584,     -0.06167531996905318,                      0.0,                      0.0,
+                3.921516588633531,     -0.05692566987806913,                      0.0,                      0.0,
+               3.8645909187554617,     -0.05150010946883965,                      0.0,                      0.0,
+                3.813090809286622,    -0.048381643134631336,                      0.0,                      0.0,
+               3.7647091661519907,     -0.04853939699529297,                      0.0,                      0.0,
+               3.7161697691566977,     -0.05711099637971806,                      0.0,                      0.0,
+               3.6590587727769797,     -0.07923406661588972,                      0.0,                      0.0,
+                 3.57982470616109,     -0.10985284858967237,                      0.0,                      0.0,
+               3.4699718575714176,     -0.12785080578433394,                      0.0,                      0.0,
+               3.3421210517870836,     -0.12841730585774558,                      0.0,                      0.0,
+                3.213703745929338,     -0.12232789011034528,                      0.0,                      0.0,
+               3.0913758558189928,     -0.12035809982453527,                      0.0,                      0.0,
+               2.9710177559944575,     -0.12130673554593718,                      0.0,                      0.0,
+               2.8497110204485203,      -0.1184949922918963,                      0.0,                      0.0,
+                2.731216028156624,     -0.11047886872571322,                      0.0,                      0.0,
+                2.620737159430911,      -0.1024494632399322,                      0.0,                      0.0,
+               2.5182876961909786,      -0.0995978742207626,                      0.0,                      0.0,
+                2.418689821970216,     -0.09880158673299988,                      0.0,                      0.0,
+                2.319888235237216,     -0.08666774135906241,                      0.0,                      0.0,
+               2.2332204938781537,     -0.06052030384402851,                      0.0,                      0.0,
+                2.172700190034125,     -0.03581942822363171,                      0.0,                      0.0,
+               2.1368807618104935,    -0.028025268529946246,                      0.0,                      0.0,
+                2.108855493280547,     -0.03403637859929187,                      0.0,                      0.0,
+               2.0748191146812553,     -0.03875825135314637,                      0.0,                      0.0,
+                2.036060863328109,     -0.03842538760698844,                      0.0,                      0.0,
+               1.9976354757211205,     -0.03322472189369963,                      0.0,                      0.0,
+                1.964410753827421,      -0.0233431887392348,                      0.0,                      0.0,
+               1.9410675650881861,     -0.01047820108032993,                      0.0,                      0.0,
+               1.9305893640078562,   -0.0013869002958388776,                      0.0,                      0.0,
+               1.9292024637120173,    0.0024055481050577754,                      0.0,                      0.0,
+                1.931608011817075,    0.0046739004601039635,                      0.0,                      0.0,
+                1.936281912277179,      0.00919291309852932,                      0.0,                      0.0,
+               1.9454748253757084,     0.014918741683584091,                      0.0,                      0.0,
+               1.9603935670592925,     0.017019529472587447,                      0.0,                      0.0,
+                 1.97741309653188,     0.014436770683310618,                      0.0,                      0.0,
+               1.9918498672151905,     0.010608008414825676,                      0.0,                      0.0,
+                2.002457875630016,     0.008970785765036737,                      0.0,                      0.0,
+                2.011428661395053,     0.009290026047183986,                      0.0,                      0.0,
+                2.020718687442237,     0.010027588907192353,                      0.0,                      0.0,
+               2.0307462763494293,      0.01086300248533334,                      0.0,                      0.0,
+               2.0416092788347626,     0.013269720903773319,                      0.0,                      0.0,
+                2.054878999738536,     0.018721198286534957,                      0.0,                      0.0,
+                2.073600198025071,     0.026044263694436687,                      0.0,                      0.0,
+               2.0996444617195076,     0.030289980496287505,                      0.0,                      0.0,
+                2.129934442215795,     0.030332422395888514,                      0.0,                      0.0,
+               2.1602668646116836,     0.028731670350485405,                      0.0,                      0.0,
+                2.188998534962169,      0.02804780531067186,                      0.0,                      0.0,
+                2.217046340272841,      0.02825440321063377,                      0.0,                      0.0,
+               2.2453007434834746,     0.028800536317240777,                      0.0,                      0.0,
+               2.2741012798007154,     0.029537615298798947,                      0.0,                      0.0,
+               2.3036388950995144,      0.03021591988170025,                      0.0,                      0.0,
+               2.3338548149812146,      0.03058572984008112,                      0.0,                      0.0,
+               2.3644405448212957,      0.03067628860490057,                      0.0,                      0.0,
+               2.3951168334261963,     0.030647999698833583,                      0.0,                      0.0,
+                 2.42576483312503,     0.030548284432977635,                      0.0,                      0.0,
+               2.4563131175580075,      0.03054551329975652,                      0.0,                      0.0,
+                2.486858630857764,     0.030808056833854458,                      0.0,                      0.0,
+               2.5176666876916185,      0.03128401573942341,                      0.0,                      0.0,
+                2.548950703431042,      0.03173651106598596,                      0.0,                      0.0,
+                2.580687214497028,      0.03210501773250973,                      0.0,                      0.0,
+               2.6127922322295376,       0.0323595125820928,                      0.0,                      0.0,
+               2.6451517448116304,       0.0324699724576063,                      0.0,                      0.0,
+               2.6776217172692367,      0.03244904417202532,                      0.0,                      0.0,
+                2.710070761441262,      0.03235253648907044,                      0.0,                      0.0,
+               2.7424232979303325,      0.03220384901566886,                      0.0,                      0.0,
+               2.7746271469460013,      0.03222027253226667,                      0.0,                      0.0,
+                2.806847419478268,      0.03261909783299233,                      0.0,                      0.0,
+               2.8394665173112603,     0.033322113132658426,                      0.0,                      0.0,
+               2.8727886304439187,     0.033978681700068236,                      0.0,                      0.0,
+                2.906767312143987,      0.03449924919581271,                      0.0,                      0.0,
+               2.9412665613397997,     0.034840227052517214,                      0.0,                      0.0,
+                2.976106788392317,       0.0349580267299463,                      0.0,                      0.0,
+                3.011064815122263,     0.034893662540155024,                      0.0,                      0.0,
+               3.0459584776624182,     0.034818772320170055,                      0.0,                      0.0,
+               3.0807772499825883,      0.03477758129465114,                      0.0,                      0.0,
+               3.1155548312772394,      0.03480035177745311,                      0.0,                      0.0,
+               3.1503551830546925,     0.034915825722640736,                      0.0,                      0.0,
+    };
+
+    //  total              pbar+p XS, table_ppbar_tot.txt
+    static constexpr int    totXS__tot_pbarp__n          = 91;
+    static constexpr double totXS__tot_pbarp__log_x_min  = -4.605170185988091;
+    static constexpr double totXS__tot_pbarp__inv_dlog_x = 4.342944819032518;
+    static constexpr double totXS__tot_pbarp__x[91] = {
+                             0.01,          0.0125892541179,          0.0158489319246,          0.0199526231497,
+                  0.0251188643151,          0.0316227766017,          0.0398107170553,          0.0501187233627,
+                   0.063095734448,          0.0794328234724,                      0.1,           0.125892541179,
+                   0.158489319246,           0.199526231497,           0.251188643151,           0.316227766017,
+                   0.398107170553,           0.501187233627,            0.63095734448,           0.794328234724,
+                              1.0,            1.25892541179,            1.58489319246,            1.99526231497,
+                    2.51188643151,            3.16227766017,            3.98107170553,            5.01187233627,
+                     6.3095734448,            7.94328234724,                     10.0,            12.5892541179,
+                    15.8489319246,            19.9526231497,            25.1188643151,            31.6227766017,
+                    39.8107170554,            50.1187233627,             63.095734448,            79.4328234724,
+                            100.0,            125.892541179,            158.489319246,            199.526231497,
+                    251.188643151,            316.227766017,            398.107170554,            501.187233627,
+                     630.95734448,            794.328234724,                   1000.0,            1258.92541179,
+                    1584.89319246,            1995.26231497,            2511.88643151,            3162.27766017,
+                    3981.07170554,            5011.87233627,             6309.5734448,            7943.28234724,
+                          10000.0,            12589.2541179,            15848.9319246,            19952.6231497,
+                    25118.8643151,            31622.7766017,            39810.7170554,            50118.7233627,
+                     63095.734448,            79432.8234724,                 100000.0,            125892.541179,
+                    158489.319246,            199526.231497,            251188.643151,            316227.766017,
+                    398107.170554,            501187.233627,             630957.34448,            794328.234724,
+                        1000000.0,            1258925.41179,            1584893.19246,            1995262.31497,
+                    2511886.43151,            3162277.66017,            3981071.70554,            5011872.33627,
+                     6309573.4448,            7943282.34724,               10000000.0,
+    };
+    static constexpr double totXS__tot_pbarp__y[91] = {
+                          420.727,            388.375222702,            357.699359905,            328.681433685,
+                    301.402412693,            275.998252746,            252.611170909,            231.557113167,
+                    213.048139708,            196.799617699,            182.208497579,            168.849489726,
+                    156.611793249,            145.460187619,            135.638064737,            127.579524133,
+                    121.301282389,            115.588110163,            109.196954833,            102.078120313,
+                    95.0919374326,            88.8048717827,             83.146691027,            77.9420774287,
+                    73.0918755711,            68.5543791509,            64.3523457798,            60.7139945274,
+                    57.8536013122,            55.6713659062,            53.8216195167,            52.0557523519,
+                    50.3861371014,            48.8769168365,            47.5389148234,            46.3374420404,
+                    45.2534363477,            44.3239972973,             43.594464256,            43.0475534278,
+                    42.6081184938,            42.2252582603,             41.940552864,            41.8146158961,
+                    41.8429016335,            41.9565862112,            42.0941124572,            42.2333289403,
+                     42.362679048,            42.4897963406,            42.6418052987,            42.8475165904,
+                    43.1381392483,            43.5444039432,            44.0491933161,            44.5848881243,
+                    45.1024858349,             45.647669753,            46.2903674469,            47.0436162489,
+                    47.8595512378,            48.6982277332,            49.5732108214,            50.5115022777,
+                    51.4978253907,            52.4704668451,            53.3809566587,            54.2587411973,
+                     55.156408707,             56.136886791,            57.2746065021,             58.620641422,
+                    60.1075730649,            61.6325649008,            63.1528031983,            64.6936954118,
+                    66.2848587557,            67.9521668166,            69.7208372385,            71.5837293504,
+                    73.4969042893,            75.4356903057,            77.4787908221,            79.7363247741,
+                    82.2247280071,            84.8522046765,            87.5311715748,            90.2516771467,
+                    93.0267582018,            95.9002929416,            98.9515111562,
+    };
+    static constexpr double totXS__tot_pbarp__log_x[91] = {
+               -4.605170185988091,       -4.374911676691997,      -4.1446531673899845,       -3.914394658089316,
+               -3.684136148790306,       -3.453877639490556,       -3.223619130192913,      -2.9933606208928025,
+              -2.7631021115931613,       -2.532843602293805,      -2.3025850929940455,       -2.072326583697951,
+              -1.8420680743959392,      -1.6118095650952704,      -1.3815510557962603,      -1.1512925464965105,
+              -0.9210340371988673,       -0.690775527898757,      -0.4605170185991155,     -0.23025850929975888,
+                              0.0,       0.2302585092960944,       0.4605170185981066,       0.6907755278987752,
+               0.9210340371977853,       1.1512925464975354,       1.3815510557951782,       1.6118095650952886,
+               1.8420680743949303,       2.0723265836942866,        2.302585092994046,         2.53284360229014,
+               2.7631021115921524,       2.9933606208928207,       3.2236191301918313,        3.453877639491581,
+                3.684136148791736,       3.9143946580893343,        4.144653167388976,        4.374911676688332,
+                4.605170185988092,        4.835428695284186,        5.065687204586198,        5.295945713886867,
+                5.526204223185877,        5.756462732485627,        5.986721241785782,         6.21697975108338,
+                6.447238260383021,        6.677496769682378,        6.907755278982137,        7.138013788278231,
+                7.368272297580243,       7.5985308068809125,        7.828789316179923,        8.059047825479672,
+                8.289306334779827,        8.519564844077426,        8.749823353377067,        8.980081862676423,
+                9.210340371976184,        9.440598881272278,         9.67085739057429,        9.901115899874958,
+               10.131374409173969,       10.361632918473719,       10.591891427773874,        10.82214993707147,
+               11.052408446371112,        11.28266695567047,       11.512925464970229,       11.743183974266323,
+               11.973442483568334,       12.203700992869004,       12.433959502168014,       12.664218011467764,
+               12.894476520767919,       13.124735030065517,       13.354993539365159,       13.585252048664515,
+               13.815510557964274,       14.045769067260368,       14.276027576562381,        14.50628608586305,
+                14.73654459516206,       14.966803104461809,       15.197061613761964,       15.427320123059562,
+               15.657578632359204,       15.887837141658562,        16.11809565095832,
+    };
+    static constexpr double totXS__tot_pbarp__log_y[91] = {
+                 6.04198416728681,        5.961971941133067,        5.879692856788951,        5.795088995001265,
+                5.708446291113906,        5.620394535066676,        5.531851432647973,        5.444826552243301,
+                 5.36151814819224,        5.282186042029884,        5.205151622481445,        5.129007724771932,
+                5.053770088824638,        4.979902424557819,       4.9099900495133655,       4.8487398888570175,
+                4.798277387938638,        4.750033097687272,         4.69315317677729,        4.625738405565265,
+                4.554844186068788,         4.48644151091103,        4.420606409621589,       4.3559659537598625,
+               4.2917172192808595,       4.2276272865485165,       4.1643733868322705,        4.106174223838308,
+                  4.0579157042898,        4.019465937662337,        3.985675236200539,       3.9523153048411945,
+               3.9197160797301627,        3.889305236697604,         3.86154863507076,       3.8359503176619327,
+               3.8122786086481697,        3.791526230098082,       3.7749301756885423,        3.762305398313388,
+               3.7520448100900525,        3.743018578964088,       3.7362532076472608,       3.7332459409991197,
+               3.7339221680570853,       3.7366354220486557,       3.7399078842865574,        3.743209694640825,
+                3.746267763492547,       3.7492639610015592,       3.7528351171109797,       3.7576476874809677,
+                3.764407507167989,         3.77378119775615,       3.7853070392996355,       3.7973949703160037,
+               3.8089373632801413,       3.8209525598016163,       3.8349338929442727,        3.851075176675101,
+               3.8682707058754646,       3.8856426379109563,       3.9034505834146986,        3.922201078221397,
+                3.941539581354871,       3.9602504750308705,       3.9774540654849515,       3.9937641075016668,
+                4.010172943970896,        4.027793115014183,       4.0478573579903365,       4.0710868772563185,
+                4.096135841338295,        4.121190381839782,        4.145557237333088,        4.169663753355538,
+                4.193961496384848,         4.21880402848608,        4.244499229164055,        4.270867804433339,
+                4.297243286818857,        4.323280509250367,       4.3500042320940935,        4.378725250774398,
+                4.409456084159647,       4.4409109745660125,       4.4719949764919695,        4.502602180383258,
+                4.532887174369047,       4.5633090365416615,         4.59462994384909,
+    };
+    static constexpr double totXS__tot_pbarp__coefficients[360] = {
+                 6.04198416728681,      -0.0800122261537437,                      0.0,                      0.0,
+                5.961971941133067,     -0.08227908434411546,                      0.0,                      0.0,
+                5.879692856788951,     -0.08460386178768609,                      0.0,                      0.0,
+                5.795088995001265,      -0.0866427038873594,                      0.0,                      0.0,
+                5.708446291113906,     -0.08805175604722937,                      0.0,                      0.0,
+                5.620394535066676,     -0.08854310241870333,                      0.0,                      0.0,
+                5.531851432647973,     -0.08702488040467227,                      0.0,                      0.0,
+                5.444826552243301,     -0.08330840405106077,                      0.0,                      0.0,
+                 5.36151814819224,      -0.0793321061623562,                      0.0,                      0.0,
+                5.282186042029884,     -0.07703441954843893,                      0.0,                      0.0,
+                5.205151622481445,     -0.07614389770951302,                      0.0,                      0.0,
+                5.129007724771932,     -0.07523763594729349,                      0.0,                      0.0,
+                5.053770088824638,     -0.07386766426681923,                      0.0,                      0.0,
+                4.979902424557819,     -0.06991237504445369,                      0.0,                      0.0,
+               4.9099900495133655,     -0.06125016065634803,                      0.0,                      0.0,
+               4.8487398888570175,     -0.05046250091837923,                      0.0,                      0.0,
+                4.798277387938638,     -0.04824429025136645,                      0.0,                      0.0,
+                4.750033097687272,     -0.05687992090998151,                      0.0,                      0.0,
+                 4.69315317677729,     -0.06741477121202522,                      0.0,                      0.0,
+                4.625738405565265,       -0.070894219496477,                      0.0,                      0.0,
+                4.554844186068788,       -0.068402675157758,                      0.0,                      0.0,
+                 4.48644151091103,      -0.0658351012894407,                      0.0,                      0.0,
+                4.420606409621589,     -0.06464045586172684,                      0.0,                      0.0,
+               4.3559659537598625,     -0.06424873447900303,                      0.0,                      0.0,
+               4.2917172192808595,     -0.06408993273234298,                      0.0,                      0.0,
+               4.2276272865485165,     -0.06325389971624595,                      0.0,                      0.0,
+               4.1643733868322705,     -0.05819916299396244,                      0.0,                      0.0,
+                4.106174223838308,    -0.048258519548507905,                      0.0,                      0.0,
+                  4.0579157042898,      -0.0384497666274628,                      0.0,                      0.0,
+                4.019465937662337,     -0.03379070146179819,                      0.0,                      0.0,
+                3.985675236200539,    -0.033359931359344674,                      0.0,                      0.0,
+               3.9523153048411945,     -0.03259922511103186,                      0.0,                      0.0,
+               3.9197160797301627,      -0.0304108430325587,                      0.0,                      0.0,
+                3.889305236697604,    -0.027756601626844013,                      0.0,                      0.0,
+                 3.86154863507076,     -0.02559831740882723,                      0.0,                      0.0,
+               3.8359503176619327,     -0.02367170901376303,                      0.0,                      0.0,
+               3.8122786086481697,    -0.020752378550087602,                      0.0,                      0.0,
+                3.791526230098082,    -0.016596054409539818,                      0.0,                      0.0,
+               3.7749301756885423,    -0.012624777375154217,                      0.0,                      0.0,
+                3.762305398313388,    -0.010260588223335532,                      0.0,                      0.0,
+               3.7520448100900525,    -0.009026231125964568,                      0.0,                      0.0,
+                3.743018578964088,    -0.006765371316827196,                      0.0,                      0.0,
+               3.7362532076472608,   -0.0030072666481411048,                      0.0,                      0.0,
+               3.7332459409991197,    0.0006762270579656615,                      0.0,                      0.0,
+               3.7339221680570853,     0.002713253991570408,                      0.0,                      0.0,
+               3.7366354220486557,    0.0032724622379016743,                      0.0,                      0.0,
+               3.7399078842865574,     0.003301810354267687,                      0.0,                      0.0,
+                3.743209694640825,    0.0030580688517218846,                      0.0,                      0.0,
+                3.746267763492547,     0.002996197509012255,                      0.0,                      0.0,
+               3.7492639610015592,    0.0035711561094204924,                      0.0,                      0.0,
+               3.7528351171109797,     0.004812570369987945,                      0.0,                      0.0,
+               3.7576476874809677,     0.006759819687021551,                      0.0,                      0.0,
+                3.764407507167989,     0.009373690588160954,                      0.0,                      0.0,
+                 3.77378119775615,     0.011525841543485349,                      0.0,                      0.0,
+               3.7853070392996355,      0.01208793101636818,                      0.0,                      0.0,
+               3.7973949703160037,     0.011542392964137616,                      0.0,                      0.0,
+               3.8089373632801413,      0.01201519652147498,                      0.0,                      0.0,
+               3.8209525598016163,     0.013981333142656371,                      0.0,                      0.0,
+               3.8349338929442727,      0.01614128373082835,                      0.0,                      0.0,
+                3.851075176675101,     0.017195529200363602,                      0.0,                      0.0,
+               3.8682707058754646,       0.0173719320354917,                      0.0,                      0.0,
+               3.8856426379109563,     0.017807945503742317,                      0.0,                      0.0,
+               3.9034505834146986,     0.018750494806698548,                      0.0,                      0.0,
+                3.922201078221397,      0.01933850313347385,                      0.0,                      0.0,
+                3.941539581354871,      0.01871089367599943,                      0.0,                      0.0,
+               3.9602504750308705,      0.01720359045408104,                      0.0,                      0.0,
+               3.9774540654849515,     0.016310042016715265,                      0.0,                      0.0,
+               3.9937641075016668,     0.016408836469229193,                      0.0,                      0.0,
+                4.010172943970896,      0.01762017104328706,                      0.0,                      0.0,
+                4.027793115014183,       0.0200642429761535,                      0.0,                      0.0,
+               4.0478573579903365,     0.023229519265981935,                      0.0,                      0.0,
+               4.0710868772563185,     0.025048964081976877,                      0.0,                      0.0,
+                4.096135841338295,     0.025054540501487033,                      0.0,                      0.0,
+                4.121190381839782,     0.024366855493305195,                      0.0,                      0.0,
+                4.145557237333088,     0.024106516022450286,                      0.0,                      0.0,
+                4.169663753355538,      0.02429774302930987,                      0.0,                      0.0,
+                4.193961496384848,     0.024842532101231996,                      0.0,                      0.0,
+                 4.21880402848608,      0.02569520067797537,                      0.0,                      0.0,
+                4.244499229164055,      0.02636857526928349,                      0.0,                      0.0,
+                4.270867804433339,     0.026375482385518012,                      0.0,                      0.0,
+                4.297243286818857,     0.026037222431510187,                      0.0,                      0.0,
+                4.323280509250367,     0.026723722843726705,                      0.0,                      0.0,
+               4.3500042320940935,      0.02872101868030441,                      0.0,                      0.0,
+                4.378725250774398,     0.030730833385248957,                      0.0,                      0.0,
+                4.409456084159647,      0.03145489040636562,                      0.0,                      0.0,
+               4.4409109745660125,      0.03108400192595706,                      0.0,                      0.0,
+               4.4719949764919695,      0.03060720389128857,                      0.0,                      0.0,
+                4.502602180383258,     0.030284993985788766,                      0.0,                      0.0,
+                4.532887174369047,     0.030421862172614667,                      0.0,                      0.0,
+               4.5633090365416615,     0.031320907307428314,                      0.0,                      0.0,
+    };
+
+    //  total              pbar+D XS, table_dpbar_tot.txt
+    static constexpr int    totXS__tot_pbarD__n          = 91;
+    static constexpr double totXS__tot_pbarD__log_x_min  = -4.605170185988091;
+    static constexpr double totXS__tot_pbarD__inv_dlog_x = 4.342944819032518;
+    static constexpr double totXS__tot_pbarD__x[91] = {
+                             0.01,          0.0125892541179,          0.0158489319246,          0.0199526231497,
+                  0.0251188643151,          0.0316227766017,          0.0398107170553,          0.0501187233627,
+                   0.063095734448,          0.0794328234724,                      0.1,           0.125892541179,
+                   0.158489319246,           0.199526231497,           0.251188643151,           0.316227766017,
+                   0.398107170553,           0.501187233627,            0.63095734448,           0.794328234724,
+                              1.0,            1.25892541179,            1.58489319246,            1.99526231497,
+                    2.51188643151,            3.16227766017,            3.98107170553,            5.01187233627,
+                     6.3095734448,            7.94328234724,                     10.0,            12.5892541179,
+                    15.8489319246,            19.9526231497,            25.1188643151,            31.6227766017,
+                    39.8107170554,            50.1187233627,             63.095734448,            79.4328234724,
+                            100.0,            125.892541179,            158.489319246,            199.526231497,
+                    251.188643151,            316.227766017,            398.107170554,            501.187233627,
+                     630.95734448,            794.328234724,                   1000.0,            1258.92541179,
+                    1584.89319246,            1995.26231497,            2511.88643151,            3162.27766017,
+                    3981.07170554,            5011.87233627,             6309.5734448,            7943.28234724,
+                          10000.0,            12589.2541179,            15848.9319246,            19952.6231497,
+                    25118.8643151,            31622.7766017,            39810.7170554,            50118.7233627,
+                     63095.734448,            79432.8234724,                 100000.0,            125892.541179,
+                    158489.319246,            199526.231497,            251188.643151,            316227.766017,
+                    398107.170554,            501187.233627,             630957.34448,            794328.234724,
+                        1000000.0,            1258925.41179,            1584893.19246,            1995262.31497,
+                    2511886.43151,            3162277.66017,            3981071.70554,            5011872.33627,
+                     6309573.4448,            7943282.34724,               10000000.0,
+    };
+    static constexpr double totXS__tot_pbarD__y[91] = {
+                          831.764,            743.601449286,             669.18739079,             605.43436283,
+                    549.775924054,            500.074134537,            454.784031603,            413.012556454,
+                    374.212509128,            339.342276168,            310.204248934,             287.25202966,
+                    268.073467366,             250.29260761,            233.885484797,            220.499012722,
+                    210.834928583,            203.004496161,            194.864220304,            185.482955608,
+                    174.964285853,            163.645199337,            152.430693298,            142.145690196,
+                    133.063932569,            125.061063299,             118.03276183,            111.952214177,
+                    106.802908638,            102.450344513,            98.6671213529,             95.284137293,
+                    92.2685873072,            89.6195723217,            87.3403004168,            85.4383546612,
+                    83.9078851502,            82.6863614452,            81.7025233511,            80.8849079901,
+                    80.1605332478,            79.5010472861,            79.0455040285,            78.9652779777,
+                    79.2710703564,            79.8141706727,            80.4554875506,            81.1236392341,
+                    81.7661228122,            82.4025903236,            83.1277780082,            84.0054116302,
+                    84.9494682513,            85.8386789058,            86.7095710758,             87.765016191,
+                      89.15765823,            90.7745236166,            92.4308201865,            94.0571603236,
+                    95.7104157963,            97.4415492062,            99.2406952605,            101.081359282,
+                     102.94916184,            104.843045005,            106.765149722,            108.728578091,
+                    110.748153652,            112.793437955,            114.784532405,            116.704648597,
+                    118.823929888,            121.492074504,             124.75308508,            128.309468048,
+                    131.892252158,            135.520769834,            139.295385052,            143.248340444,
+                     147.33353129,            151.497664327,            155.690466855,            159.865666272,
+                    164.140990826,            168.820566871,            174.166705577,            180.124492124,
+                     186.53661632,            193.135725849,            199.525733358,
+    };
+    static constexpr double totXS__tot_pbarD__log_x[91] = {
+               -4.605170185988091,       -4.374911676691997,      -4.1446531673899845,       -3.914394658089316,
+               -3.684136148790306,       -3.453877639490556,       -3.223619130192913,      -2.9933606208928025,
+              -2.7631021115931613,       -2.532843602293805,      -2.3025850929940455,       -2.072326583697951,
+              -1.8420680743959392,      -1.6118095650952704,      -1.3815510557962603,      -1.1512925464965105,
+              -0.9210340371988673,       -0.690775527898757,      -0.4605170185991155,     -0.23025850929975888,
+                              0.0,       0.2302585092960944,       0.4605170185981066,       0.6907755278987752,
+               0.9210340371977853,       1.1512925464975354,       1.3815510557951782,       1.6118095650952886,
+               1.8420680743949303,       2.0723265836942866,        2.302585092994046,         2.53284360229014,
+               2.7631021115921524,       2.9933606208928207,       3.2236191301918313,        3.453877639491581,
+                3.684136148791736,       3.9143946580893343,        4.144653167388976,        4.374911676688332,
+                4.605170185988092,        4.835428695284186,        5.065687204586198,        5.295945713886867,
+                5.526204223185877,        5.756462732485627,        5.986721241785782,         6.21697975108338,
+                6.447238260383021,        6.677496769682378,        6.907755278982137,        7.138013788278231,
+                7.368272297580243,       7.5985308068809125,        7.828789316179923,        8.059047825479672,
+                8.289306334779827,        8.519564844077426,        8.749823353377067,        8.980081862676423,
+                9.210340371976184,        9.440598881272278,         9.67085739057429,        9.901115899874958,
+               10.131374409173969,       10.361632918473719,       10.591891427773874,        10.82214993707147,
+               11.052408446371112,        11.28266695567047,       11.512925464970229,       11.743183974266323,
+               11.973442483568334,       12.203700992869004,       12.433959502168014,       12.664218011467764,
+               12.894476520767919,       13.124735030065517,       13.354993539365159,       13.585252048664515,
+               13.815510557964274,       14.045769067260368,       14.276027576562381,        14.50628608586305,
+                14.73654459516206,       14.966803104461809,       15.197061613761964,       15.427320123059562,
+               15.657578632359204,       15.887837141658562,        16.11809565095832,
+    };
+    static constexpr double totXS__tot_pbarD__log_y[91] = {
+                6.723548746737693,          6.6115052048583,        6.506064126720568,        6.405946155515287,
+                6.309510784401275,        6.214756356505419,        6.119822650448636,        6.023477995535189,
+                5.924823842271098,       5.8270092622247605,        5.737230948050306,         5.66035998253506,
+                5.591261074906242,        5.522630663882531,       5.4548316143622335,       5.3958932174256296,
+                5.351075498306521,        5.313228127372866,       5.2723030098967065,        5.222962994311116,
+                5.164581872256186,       5.0977006655764905,       5.0267100225675465,        4.956852518931795,
+                4.890829708731958,        4.828802124413898,       4.7709622285572015,         4.71807212111626,
+                4.670985160593446,        4.629378237422056,        4.591751773951751,       4.5568633465749295,
+                4.524703751049502,        4.495573737216506,        4.469811987675955,       4.4477951177839525,
+                4.429719591776966,       4.4150546724101565,       4.4030848869593875,        4.393027255241294,
+                4.384031289607343,       4.3757701949835806,        4.370023687003247,        4.369008236580496,
+                4.372873249424739,        4.379701066042902,        4.387704081809476,        4.395974401189892,
+                4.403863011276211,        4.411616872387346,        4.420378918065113,        4.430881220937214,
+                4.442056588549203,       4.4524697080106295,       4.4625642707247755,        4.474662972389577,
+                4.490406243367897,        4.508378669328491,        4.526460474833551,        4.543902686008016,
+                4.561327130533349,        4.579252702913605,        4.597548164648515,        4.615925730015646,
+                 4.63423529201278,        4.652464422339037,        4.670631559809852,        4.688854667493816,
+               4.7072587374725074,        4.725558163213975,        4.743056739659787,        4.759646372235244,
+               4.7776428166779095,        4.799849030233254,        4.826336464426045,        4.854445065064025,
+                4.881985317725057,         4.90912491148088,        4.936596750674868,        4.964579770494583,
+               4.9926989370059704,        5.020570207847083,        5.047869849316138,       5.0743338767842685,
+                5.100725758652215,        5.128836416392609,        5.160012918579444,        5.193648234740416,
+                5.228627553968338,         5.26339318448651,        5.295943217274677,
+    };
+    static constexpr double totXS__tot_pbarD__coefficients[360] = {
+                6.723548746737693,      -0.1120435418793928,                      0.0,                      0.0,
+                  6.6115052048583,     -0.10544107813773262,                      0.0,                      0.0,
+                6.506064126720568,     -0.10011797120528065,                      0.0,                      0.0,
+                6.405946155515287,     -0.09643537111401201,                      0.0,                      0.0,
+                6.309510784401275,     -0.09475442789585564,                      0.0,                      0.0,
+                6.214756356505419,     -0.09493370605678297,                      0.0,                      0.0,
+                6.119822650448636,     -0.09634465491344724,                      0.0,                      0.0,
+                6.023477995535189,       -0.098654153264091,                      0.0,                      0.0,
+                5.924823842271098,      -0.0978145800463377,                      0.0,                      0.0,
+               5.8270092622247605,     -0.08977831417445437,                      0.0,                      0.0,
+                5.737230948050306,     -0.07687096551524597,                      0.0,                      0.0,
+                 5.66035998253506,     -0.06909890762881776,                      0.0,                      0.0,
+                5.591261074906242,      -0.0686304110237117,                      0.0,                      0.0,
+                5.522630663882531,     -0.06779904952029714,                      0.0,                      0.0,
+               5.4548316143622335,    -0.058938396936603965,                      0.0,                      0.0,
+               5.3958932174256296,     -0.04481771911910837,                      0.0,                      0.0,
+                5.351075498306521,     -0.03784737093365553,                      0.0,                      0.0,
+                5.313228127372866,     -0.04092511747615912,                      0.0,                      0.0,
+               5.2723030098967065,    -0.049340015585590535,                      0.0,                      0.0,
+                5.222962994311116,      -0.0583811220549304,                      0.0,                      0.0,
+                5.164581872256186,      -0.0668812066796951,                      0.0,                      0.0,
+               5.0977006655764905,     -0.07099064300894398,                      0.0,                      0.0,
+               5.0267100225675465,      -0.0698575036357516,                      0.0,                      0.0,
+                4.956852518931795,     -0.06602281019983725,                      0.0,                      0.0,
+                4.890829708731958,    -0.062027584318059326,                      0.0,                      0.0,
+                4.828802124413898,      -0.0578398958566968,                      0.0,                      0.0,
+               4.7709622285572015,    -0.052890107440941136,                      0.0,                      0.0,
+                 4.71807212111626,     -0.04708696052281436,                      0.0,                      0.0,
+                4.670985160593446,     -0.04160692317138981,                      0.0,                      0.0,
+                4.629378237422056,     -0.03762646347030518,                      0.0,                      0.0,
+                4.591751773951751,     -0.03488842737682152,                      0.0,                      0.0,
+               4.5568633465749295,     -0.03215959552542724,                      0.0,                      0.0,
+                4.524703751049502,    -0.029130013832996404,                      0.0,                      0.0,
+                4.495573737216506,     -0.02576174954055066,                      0.0,                      0.0,
+                4.469811987675955,     -0.02201686989200269,                      0.0,                      0.0,
+               4.4477951177839525,     -0.01807552600698692,                      0.0,                      0.0,
+                4.429719591776966,    -0.014664919366809137,                      0.0,                      0.0,
+               4.4150546724101565,    -0.011969785450768988,                      0.0,                      0.0,
+               4.4030848869593875,    -0.010057631718093596,                      0.0,                      0.0,
+                4.393027255241294,    -0.008995965633951108,                      0.0,                      0.0,
+                4.384031289607343,    -0.008261094623762233,                      0.0,                      0.0,
+               4.3757701949835806,    -0.005746507980333604,                      0.0,                      0.0,
+                4.370023687003247,   -0.0010154504227513073,                      0.0,                      0.0,
+                4.369008236580496,     0.003865012844243232,                      0.0,                      0.0,
+                4.372873249424739,     0.006827816618162785,                      0.0,                      0.0,
+                4.379701066042902,      0.00800301576657425,                      0.0,                      0.0,
+                4.387704081809476,     0.008270319380415891,                      0.0,                      0.0,
+                4.395974401189892,      0.00788861008631958,                      0.0,                      0.0,
+                4.403863011276211,     0.007753861111134519,                      0.0,                      0.0,
+                4.411616872387346,     0.008762045677767283,                      0.0,                      0.0,
+                4.420378918065113,     0.010502302872100522,                      0.0,                      0.0,
+                4.430881220937214,      0.01117536761198945,                      0.0,                      0.0,
+                4.442056588549203,     0.010413119461426312,                      0.0,                      0.0,
+               4.4524697080106295,     0.010094562714145994,                      0.0,                      0.0,
+               4.4625642707247755,     0.012098701664801759,                      0.0,                      0.0,
+                4.474662972389577,       0.0157432709783194,                      0.0,                      0.0,
+                4.490406243367897,      0.01797242596059423,                      0.0,                      0.0,
+                4.508378669328491,     0.018081805505060444,                      0.0,                      0.0,
+                4.526460474833551,      0.01744221117446454,                      0.0,                      0.0,
+                4.543902686008016,     0.017424444525333094,                      0.0,                      0.0,
+                4.561327130533349,      0.01792557238025605,                      0.0,                      0.0,
+                4.579252702913605,     0.018295461734910035,                      0.0,                      0.0,
+                4.597548164648515,     0.018377565367130977,                      0.0,                      0.0,
+                4.615925730015646,     0.018309561997133628,                      0.0,                      0.0,
+                 4.63423529201278,      0.01822913032625717,                      0.0,                      0.0,
+                4.652464422339037,      0.01816713747081522,                      0.0,                      0.0,
+                4.670631559809852,     0.018223107683963846,                      0.0,                      0.0,
+                4.688854667493816,     0.018404069978691595,                      0.0,                      0.0,
+               4.7072587374725074,       0.0182994257414677,                      0.0,                      0.0,
+                4.725558163213975,     0.017498576445811764,                      0.0,                      0.0,
+                4.743056739659787,     0.016589632575456648,                      0.0,                      0.0,
+                4.759646372235244,     0.017996444442665904,                      0.0,                      0.0,
+               4.7776428166779095,      0.02220621355534469,                      0.0,                      0.0,
+                4.799849030233254,     0.026487434192790538,                      0.0,                      0.0,
+                4.826336464426045,     0.028108600637980707,                      0.0,                      0.0,
+                4.854445065064025,     0.027540252661031772,                      0.0,                      0.0,
+                4.881985317725057,       0.0271395937558232,                      0.0,                      0.0,
+                 4.90912491148088,     0.027471839193987435,                      0.0,                      0.0,
+                4.936596750674868,     0.027983019819715516,                      0.0,                      0.0,
+                4.964579770494583,     0.028119166511387128,                      0.0,                      0.0,
+               4.9926989370059704,     0.027871270841112405,                      0.0,                      0.0,
+                5.020570207847083,     0.027299641469054947,                      0.0,                      0.0,
+                5.047869849316138,     0.026464027468130702,                      0.0,                      0.0,
+               5.0743338767842685,     0.026391881867946054,                      0.0,                      0.0,
+                5.100725758652215,      0.02811065774039445,                      0.0,                      0.0,
+                5.128836416392609,     0.031176502186834654,                      0.0,                      0.0,
+                5.160012918579444,      0.03363531616097237,                      0.0,                      0.0,
+                5.193648234740416,      0.03497931922792219,                      0.0,                      0.0,
+                5.228627553968338,      0.03476563051817205,                      0.0,                      0.0,
+                 5.26339318448651,      0.03255003278816648,                      0.0,                      0.0,
+    };
+
+    //  non-annihilation   pbar+D XS, table_dpbar_nar.txt
+    static constexpr int    totXS__nar_pbarD__n          = 91;
+    static constexpr double totXS__nar_pbarD__log_x_min  = -4.605170185988091;
+    static constexpr double totXS__nar_pbarD__inv_dlog_x = 4.342944819032518;
+    static constexpr double totXS__nar_pbarD__x[91] = {
+                             0.01,          0.0125892541179,          0.0158489319246,          0.0199526231497,
+                  0.0251188643151,          0.0316227766017,          0.0398107170553,          0.0501187233627,
+                   0.063095734448,          0.0794328234724,                      0.1,           0.125892541179,
+                   0.158489319246,           0.199526231497,           0.251188643151,           0.316227766017,
+                   0.398107170553,           0.501187233627,            0.63095734448,           0.794328234724,
+                              1.0,            1.25892541179,            1.58489319246,            1.99526231497,
+                    2.51188643151,            3.16227766017,            3.98107170553,            5.01187233627,
+                     6.3095734448,            7.94328234724,                     10.0,            12.5892541179,
+                    15.8489319246,            19.9526231497,            25.1188643151,            31.6227766017,
+                    39.8107170554,            50.1187233627,             63.095734448,            79.4328234724,
+                            100.0,            125.892541179,            158.489319246,            199.526231497,
+                    251.188643151,            316.227766017,            398.107170554,            501.187233627,
+                     630.95734448,            794.328234724,                   1000.0,            1258.92541179,
+                    1584.89319246,            1995.26231497,            2511.88643151,            3162.27766017,
+                    3981.07170554,            5011.87233627,             6309.5734448,            7943.28234724,
+                          10000.0,            12589.2541179,            15848.9319246,            19952.6231497,
+                    25118.8643151,            31622.7766017,            39810.7170554,            50118.7233627,
+                     63095.734448,            79432.8234724,                 100000.0,            125892.541179,
+                    158489.319246,            199526.231497,            251188.643151,            316227.766017,
+                    398107.170554,            501187.233627,             630957.34448,            794328.234724,
+                        1000000.0,            1258925.41179,            1584893.19246,            1995262.31497,
+                    2511886.43151,            3162277.66017,            3981071.70554,            5011872.33627,
+                     6309573.4448,            7943282.34724,               10000000.0,
+    };
+    static constexpr double totXS__nar_pbarD__y[91] = {
+                           1e-100,                   1e-100,                   1e-100,                   1e-100,
+                           1e-100,                   1e-100,                   1e-100,                   1e-100,
+                           1e-100,                   1e-100,                   1e-100,                   1e-100,
+                           1e-100,                   1e-100,                   1e-100,          0.0383149320719,
+                    0.13981401695,           0.406176808509,           0.972384659289,             1.9058996864,
+                    3.00417045589,            3.74036715032,            3.87590321761,              3.522775783,
+                    2.97961720488,            2.40097039485,             1.9922608291,            1.79626783537,
+                    1.68286860015,            1.59370852063,            1.52158054096,            1.46132601258,
+                    1.40844647845,            1.35921215888,            1.31333179471,            1.27236282208,
+                    1.23776500152,            1.21091883542,            1.19319918164,            1.17930314332,
+                    1.16234947251,            1.15190504534,            1.14413828213,            1.14070272165,
+                    1.14147435656,            1.14457567184,            1.14832738783,            1.15212521349,
+                    1.15565388443,            1.15912164417,            1.16326844855,            1.16888025259,
+                    1.17680843869,            1.18789133957,            1.20166199366,            1.21627574803,
+                    1.23039581358,            1.24526843086,            1.26280122395,            1.28334985127,
+                    1.30560855777,            1.32848765256,            1.35235719121,            1.37795378214,
+                    1.40486067666,            1.43139433553,            1.45623249765,            1.48017845986,
+                    1.50466682953,            1.53141427166,            1.56245126538,            1.59917109799,
+                    1.63973459321,             1.6813363705,            1.72280847125,            1.76484401084,
+                    1.80825094686,            1.85373511076,            1.90198443987,            1.95280413667,
+                    2.00499554901,            2.05788563154,            2.11362141363,            2.17520693984,
+                    2.24309058003,            2.31476814357,            2.38785036056,            2.46206575257,
+                    2.53776996375,            2.61615999145,            2.71615999145,
+    };
+    static constexpr double totXS__nar_pbarD__log_x[91] = {
+               -4.605170185988091,       -4.374911676691997,      -4.1446531673899845,       -3.914394658089316,
+               -3.684136148790306,       -3.453877639490556,       -3.223619130192913,      -2.9933606208928025,
+              -2.7631021115931613,       -2.532843602293805,      -2.3025850929940455,       -2.072326583697951,
+              -1.8420680743959392,      -1.6118095650952704,      -1.3815510557962603,      -1.1512925464965105,
+              -0.9210340371988673,       -0.690775527898757,      -0.4605170185991155,     -0.23025850929975888,
+                              0.0,       0.2302585092960944,       0.4605170185981066,       0.6907755278987752,
+               0.9210340371977853,       1.1512925464975354,       1.3815510557951782,       1.6118095650952886,
+               1.8420680743949303,       2.0723265836942866,        2.302585092994046,         2.53284360229014,
+               2.7631021115921524,       2.9933606208928207,       3.2236191301918313,        3.453877639491581,
+                3.684136148791736,       3.9143946580893343,        4.144653167388976,        4.374911676688332,
+                4.605170185988092,        4.835428695284186,        5.065687204586198,        5.295945713886867,
+                5.526204223185877,        5.756462732485627,        5.986721241785782,         6.21697975108338,
+                6.447238260383021,        6.677496769682378,        6.907755278982137,        7.138013788278231,
+                7.368272297580243,       7.5985308068809125,        7.828789316179923,        8.059047825479672,
+                8.289306334779827,        8.519564844077426,        8.749823353377067,        8.980081862676423,
+                9.210340371976184,        9.440598881272278,         9.67085739057429,        9.901115899874958,
+               10.131374409173969,       10.361632918473719,       10.591891427773874,        10.82214993707147,
+               11.052408446371112,        11.28266695567047,       11.512925464970229,       11.743183974266323,
+               11.973442483568334,       12.203700992869004,       12.433959502168014,       12.664218011467764,
+               12.894476520767919,       13.124735030065517,       13.354993539365159,       13.585252048664515,
+               13.815510557964274,       14.045769067260368,       14.276027576562381,        14.50628608586305,
+                14.73654459516206,       14.966803104461809,       15.197061613761964,       15.427320123059562,
+               15.657578632359204,       15.887837141658562,        16.11809565095832,
+    };
+    static constexpr double totXS__nar_pbarD__log_y[91] = {
+              -230.25850929940458,      -230.25850929940458,      -230.25850929940458,      -230.25850929940458,
+              -230.25850929940458,      -230.25850929940458,      -230.25850929940458,      -230.25850929940458,
+              -230.25850929940458,      -230.25850929940458,      -230.25850929940458,      -230.25850929940458,
+              -230.25850929940458,      -230.25850929940458,      -230.25850929940458,      -3.2619155874466337,
+               -1.967442189902405,      -0.9009667252397672,     -0.02800381279686337,       0.6449541734167603,
+               1.1000014752647698,       1.3191837751429847,       1.3547787240599098,       1.2592492535642354,
+               1.0917948375280415,       0.8758729868215724,       0.6892700888939479,        0.585711087586577,
+               0.5204998373834913,      0.46606370331453734,      0.41974962418883416,       0.3793442513254579,
+                0.342487308641775,      0.30690523695064104,       0.2725672631004374,         0.24087566172973,
+              0.21330733517786962,       0.1913794395502622,       0.1766380878050533,      0.16492370752192004,
+              0.15044336408243367,      0.14141713295635772,      0.13465176164045475,      0.13164449499609424,
+              0.13232072204856277,       0.1350339760404379,      0.13830643827757766,      0.14160824863274815,
+              0.14466631748615588,        0.147662514993331,      0.15123367110536254,      0.15604624147741833,
+              0.16280606115803403,      0.17217975174885666,      0.18370559329009017,      0.19579352430838462,
+              0.20733591727645787,       0.2193511137932628,      0.23333244693626304,      0.24947373066823145,
+               0.2666692598707459,       0.2840411919028041,       0.3018491374094557,      0.32059963221767407,
+              0.33993813534920847,      0.35864902902097123,      0.37585261947853166,      0.39216266149320744,
+              0.40857149796604103,      0.42619166900829986,       0.4462559119851965,      0.46948543124809206,
+              0.49453439533113147,       0.5195889358365797,       0.5439557913264306,       0.5680623073521162,
+               0.5923600503804631,       0.6172025824809042,       0.6428977831591353,       0.6692663584218993,
+               0.6956418408109314,       0.7216790632437357,       0.7484027860886897,       0.7771238047686952,
+               0.8078546381511267,       0.8393095285570112,       0.8703935304848656,       0.9010007343796418,
+               0.9312857283641002,       0.9617075905359905,       0.9992191149754909,
+    };
+    static constexpr double totXS__nar_pbarD__coefficients[360] = {
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,                      0.0,                      0.0,                      0.0,
+              -230.25850929940458,       226.99659371195796,                      0.0,                      0.0,
+              -3.2619155874466337,       1.2944733975442286,                      0.0,                      0.0,
+               -1.967442189902405,       1.0664754646626378,                      0.0,                      0.0,
+              -0.9009667252397672,       0.8729629124429038,                      0.0,                      0.0,
+             -0.02800381279686337,       0.6729579862136237,                      0.0,                      0.0,
+               0.6449541734167603,      0.45504730184800946,                      0.0,                      0.0,
+               1.1000014752647698,      0.21918229987821491,                      0.0,                      0.0,
+               1.3191837751429847,      0.03559494891692516,                      0.0,                      0.0,
+               1.3547787240599098,      -0.0955294704956744,                      0.0,                      0.0,
+               1.2592492535642354,     -0.16745441603619393,                      0.0,                      0.0,
+               1.0917948375280415,     -0.21592185070646908,                      0.0,                      0.0,
+               0.8758729868215724,     -0.18660289792762452,                      0.0,                      0.0,
+               0.6892700888939479,     -0.10355900130737095,                      0.0,                      0.0,
+                0.585711087586577,     -0.06521125020308571,                      0.0,                      0.0,
+               0.5204998373834913,     -0.05443613406895392,                      0.0,                      0.0,
+              0.46606370331453734,     -0.04631407912570318,                      0.0,                      0.0,
+              0.41974962418883416,    -0.040405372863376254,                      0.0,                      0.0,
+               0.3793442513254579,     -0.03685694268368289,                      0.0,                      0.0,
+                0.342487308641775,    -0.035582071691133976,                      0.0,                      0.0,
+              0.30690523695064104,     -0.03433797385020365,                      0.0,                      0.0,
+               0.2725672631004374,    -0.031691601370707395,                      0.0,                      0.0,
+                 0.24087566172973,    -0.027568326551860367,                      0.0,                      0.0,
+              0.21330733517786962,    -0.021927895627607413,                      0.0,                      0.0,
+               0.1913794395502622,    -0.014741351745208908,                      0.0,                      0.0,
+               0.1766380878050533,    -0.011714380283133263,                      0.0,                      0.0,
+              0.16492370752192004,     -0.01448034343948637,                      0.0,                      0.0,
+              0.15044336408243367,    -0.009026231126075951,                      0.0,                      0.0,
+              0.14141713295635772,    -0.006765371315902963,                      0.0,                      0.0,
+              0.13465176164045475,    -0.003007266644360518,                      0.0,                      0.0,
+              0.13164449499609424,     0.000676227052468531,                      0.0,                      0.0,
+              0.13232072204856277,    0.0027132539918751364,                      0.0,                      0.0,
+               0.1350339760404379,     0.003272462237139756,                      0.0,                      0.0,
+              0.13830643827757766,    0.0033018103551704925,                      0.0,                      0.0,
+              0.14160824863274815,    0.0030580688534077305,                      0.0,                      0.0,
+              0.14466631748615588,    0.0029961975071751135,                      0.0,                      0.0,
+                0.147662514993331,    0.0035711561120315427,                      0.0,                      0.0,
+              0.15123367110536254,     0.004812570372055791,                      0.0,                      0.0,
+              0.15604624147741833,     0.006759819680615703,                      0.0,                      0.0,
+              0.16280606115803403,     0.009373690590822631,                      0.0,                      0.0,
+              0.17217975174885666,     0.011525841541233511,                      0.0,                      0.0,
+              0.18370559329009017,     0.012087931018294445,                      0.0,                      0.0,
+              0.19579352430838462,     0.011542392968073245,                      0.0,                      0.0,
+              0.20733591727645787,     0.012015196516804938,                      0.0,                      0.0,
+               0.2193511137932628,     0.013981333143000235,                      0.0,                      0.0,
+              0.23333244693626304,      0.01614128373196841,                      0.0,                      0.0,
+              0.24947373066823145,     0.017195529202514465,                      0.0,                      0.0,
+               0.2666692598707459,      0.01737193203205817,                      0.0,                      0.0,
+               0.2840411919028041,       0.0178079455066516,                      0.0,                      0.0,
+               0.3018491374094557,     0.018750494808218388,                      0.0,                      0.0,
+              0.32059963221767407,       0.0193385031315344,                      0.0,                      0.0,
+              0.33993813534920847,     0.018710893671762763,                      0.0,                      0.0,
+              0.35864902902097123,     0.017203590457560425,                      0.0,                      0.0,
+              0.37585261947853166,     0.016310042014675785,                      0.0,                      0.0,
+              0.39216266149320744,     0.016408836472833588,                      0.0,                      0.0,
+              0.40857149796604103,     0.017620171042258825,                      0.0,                      0.0,
+              0.42619166900829986,      0.02006424297689663,                      0.0,                      0.0,
+               0.4462559119851965,      0.02322951926289557,                      0.0,                      0.0,
+              0.46948543124809206,     0.025048964083039416,                      0.0,                      0.0,
+              0.49453439533113147,     0.025054540505448253,                      0.0,                      0.0,
+               0.5195889358365797,     0.024366855489850847,                      0.0,                      0.0,
+               0.5439557913264306,     0.024106516025685587,                      0.0,                      0.0,
+               0.5680623073521162,     0.024297743028346974,                      0.0,                      0.0,
+               0.5923600503804631,     0.024842532100441073,                      0.0,                      0.0,
+               0.6172025824809042,     0.025695200678231056,                      0.0,                      0.0,
+               0.6428977831591353,     0.026368575262764038,                      0.0,                      0.0,
+               0.6692663584218993,      0.02637548238903209,                      0.0,                      0.0,
+               0.6956418408109314,     0.026037222432804263,                      0.0,                      0.0,
+               0.7216790632437357,     0.026723722844954056,                      0.0,                      0.0,
+               0.7484027860886897,      0.02872101868000554,                      0.0,                      0.0,
+               0.7771238047686952,     0.030730833382431433,                      0.0,                      0.0,
+               0.8078546381511267,      0.03145489040588456,                      0.0,                      0.0,
+               0.8393095285570112,      0.03108400192785432,                      0.0,                      0.0,
+               0.8703935304848656,     0.030607203894776225,                      0.0,                      0.0,
+               0.9010007343796418,     0.030284993984458386,                      0.0,                      0.0,
+               0.9312857283641002,     0.030421862171890357,                      0.0,                      0.0,
+               0.9617075905359905,      0.03751152443950034,                      0.0,                      0.0,
+    };
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include "math.h"
+
+#include "crxs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+
+#include "linAlg_tools.h"
+
+namespace CRXS {
+
+
+    //  ------------------------------------------------------------- #
+    //   Default and current engine                                   #
+    //  ------------------------------------------------------------- #
+
+    static thread_local XS_engine* fCurrent_engine = 0;
+
+    XS_engine& XS_engine::Default(){
+        static XS_engine engine;
+        return engine;
+    }
+
+    XS_engine& XS_engine::Current(){
+        if (fCurrent_engine) {
+            return *fCurrent_engine;
+        }
+        return Default();
+    }
+
+    XS_engine::Scope::Scope( XS_engine& engine ){
+        fPrevious       = fCurrent_engine;
+        fCurrent_engine = &engine;
+    }
+
+    XS_engine::Scope::~Scope(){
+        fCurrent_engine = fPrevious;
+    }
+
+
+    XS_engine::XS_engine(){
+
+        fIntegrationMethod              = TRAPEZE;
+        fIntegrationMethod_p            = GSL;
+        fIntegrationMethod_antinuclei   = GSL;
+        fIntegrationEpsrel              = 1e-4;
+        fTrapezeSteps                   = 1000;
+        fGaussLegendreNodes             = 64;
+        fIntegrationVariable            = ETA_LAB;
+        fAutotune                       = 0;
+        fSIMD                           = SIMD_AUTO;
+
+        for (int i=0; i<17; i++) fWinkler_SELF_C1_to_C16[i] = XS_definitions::Winkler_SELF_C1_to_C16__default[i];
+        for (int i=0; i<12; i++) fdiMauro_SELF_C1_to_C11[i] = XS_definitions::diMauro_SELF_C1_to_C11__default[i];
+        for (int i=0; i<17; i++) fdiMauro_SELF_C1_to_C16[i] = XS_definitions::diMauro_SELF_C1_to_C16__default[i];
+        for (int i=0; i< 3; i++) fWinkler_SELF_D1_to_D2 [i] = XS_definitions::Winkler_SELF_D1_to_D2__default [i];
+        for (int i=0; i< 3; i++) fdiMauro_SELF_D1_to_D2 [i] = XS_definitions::diMauro_SELF_D1_to_D2__default [i];
+
+        fRestrictedParameterSpace_CM  = 0;
+        fRestrictedParameterSpace_LAB = 0;
+        fIsRestricted_pp              = false;
+    }
+
+
+    Integration_options XS_engine::GetIntegrationOptions( int method ) const{
+        return Integration_options( method, fIntegrationEpsrel, fTrapezeSteps, fGaussLegendreNodes );
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   SELF parameters                                              #
+    //  ------------------------------------------------------------- #
+
+    void XS_engine::Set_SELF_C_parameters_diMauro(double *C){
+        fdiMauro_SELF_C1_to_C11[ 1] = C[ 1];
+        fdiMauro_SELF_C1_to_C11[ 2] = C[ 2];
+        fdiMauro_SELF_C1_to_C11[ 3] = C[ 3];
+        fdiMauro_SELF_C1_to_C11[ 4] = C[ 4];
+        fdiMauro_SELF_C1_to_C11[ 5] = C[ 5];
+        fdiMauro_SELF_C1_to_C11[ 6] = C[ 6];
+        fdiMauro_SELF_C1_to_C11[ 7] = C[ 7];
+        fdiMauro_SELF_C1_to_C11[ 8] = C[ 8];
+        fdiMauro_SELF_C1_to_C11[ 9] = C[ 9];
+        fdiMauro_SELF_C1_to_C11[10] = C[10];
+        fdiMauro_SELF_C1_to_C11[11] = C[11];
+
+        fdiMauro_SELF_C1_to_C16[ 1] = C[12];
+        fdiMauro_SELF_C1_to_C16[ 2] = C[13];
+        fdiMauro_SELF_C1_to_C16[ 3] = C[14];
+        fdiMauro_SELF_C1_to_C16[ 4] = C[15];
+        fdiMauro_SELF_C1_to_C16[14] = C[16];
+        fdiMauro_SELF_C1_to_C16[15] = C[17];
+        fdiMauro_SELF_C1_to_C16[16] = C[18];
+    }
+
+    void XS_engine::Set_SELF_C_parameters_Winkler(double *C){
+        for (int i=1; i<17; i++) {
+            fWinkler_SELF_C1_to_C16[i] = C[i];
+        }
+    }
+
+    void XS_engine::Set_SELF_D_parameters_diMauro(double *D){
+        fdiMauro_SELF_D1_to_D2[ 1] = D[ 1];
+        fdiMauro_SELF_D1_to_D2[ 2] = D[ 2];
+    }
+
+    void XS_engine::Set_SELF_D_parameters_Winkler(double *D){
+        fWinkler_SELF_D1_to_D2[ 1] = D[ 1];
+        fWinkler_SELF_D1_to_D2[ 2] = D[ 2];
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Restricted parameter space                                   #
+    //  ------------------------------------------------------------- #
+
+    void XS_engine::SetRestricted_pp( bool is_pp ){
+        fIsRestricted_pp = is_pp;
+    }
+
+
+    void XS_engine::SetRestrictedParameterSpace_LAB( double Tp, double Tpbar, double eta ){
+        if(fRestrictedParameterSpace_LAB==0){
+            RemoveRestrictedParameterSpace_LAB();
+        }
+        fRestrictedParameterSpace_LAB__hull.Add( Tp, Tpbar, eta );
+        fRestrictedParameterSpace_LAB ++;
+    }
+
+    void XS_engine::RemoveRestrictedParameterSpace_LAB(  ){
+        fRestrictedParameterSpace_LAB = 0;
+        fIsRestricted_pp = false;
+        fRestrictedParameterSpace_LAB__hull.Clear();
+    }
+
+    bool XS_engine::isInRestricted_LAB(double Tp, double Tpbar, double eta) const{
+        return fRestrictedParameterSpace_LAB__hull.isInside( Tp, Tpbar, eta );
+    }
+
+
+    void XS_engine::SetRestrictedParameterSpace_CM( double s, double xf, double pT ){
+        if(fRestrictedParameterSpace_CM==0){
+            RemoveRestrictedParameterSpace_CM();
+        }
+        fRestrictedParameterSpace_CM__hull.Add( s, xf, pT );
+        fRestrictedParameterSpace_CM ++;
+    }
+
+    void XS_engine::RemoveRestrictedParameterSpace_CM(  ){
+        fRestrictedParameterSpace_CM = 0;
+        fIsRestricted_pp = false;
+        fRestrictedParameterSpace_CM__hull.Clear();
+    }
+
+    bool XS_engine::isInRestricted_CM(double s, double xf, double pT) const{
+        return fRestrictedParameterSpace_CM__hull.isInside( s, xf, pT );
+    }
+
+}
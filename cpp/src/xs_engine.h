@@ -0,0 +1,141 @@
+#ifndef CRXS__XS_ENGINE_H
+#define CRXS__XS_ENGINE_H
+
+#include "linAlg_tools.h"
+
+namespace CRXS {
+
+    //! Runtime state of CRXS: configuration, SELF parameters, and restricted parameter spaces.
+    /*!
+     *  All functions of CRXS read their runtime state from the engine of the calling thread, XS_engine::Current(). This is
+     *  the process-wide XS_engine::Default() unless another engine is activated for the thread with XS_engine::Scope.
+     *  The static functions which change the state (CRXS_config::SetupIntegrationMethod, XS::Set_SELF_C_parameters_Winkler,
+     *  XS::SetRestrictedParameterSpace_CM, ...) act on XS_engine::Current() as well. The static data members of the old API
+     *  (CRXS_config::IntegrationMethod, XS_definitions::Winkler_SELF_C1_to_C16, XS::fRestrictedParameterSpace_CM, ...)
+     *  are references to the members of XS_engine::Default().
+     *
+     *  An engine is not modified by evaluating cross sections. Therefore, several threads can share one engine as long as
+     *  nobody changes it, or each thread can use its own engine:
+     *
+     *      XS_engine engine;                           // same initial state as the default engine
+     *      engine.Set_SELF_C_parameters_Winkler( C );
+     *      ...
+     *      // in each thread:
+     *      XS_engine::Scope scope( engine );           // engine is used by this thread until scope is destroyed
+     *      double xs = XS::dE_AA_pbar_LAB( Tn, T, 1, 0, 1, 0, WINKLER_SELF );
+     *
+     *  The tables of total cross sections (XS_definitions::tot_pbarp, ...) are constant arrays compiled into the library
+     *  and shared by all engines.
+     */
+    class XS_engine{
+
+    public:
+
+        /// Constructor, the state is initialized with the default values (as at program start).
+        XS_engine();
+
+        /// Engine used by the static API and by all threads without XS_engine::Scope.
+        static XS_engine& Default();
+        /// Engine of the calling thread.
+        static XS_engine& Current();
+
+        //! Activates an engine for the calling thread during the lifetime of this object.
+        /*!
+         *  Scopes can be nested, the destructor restores the previously active engine.
+         */
+        class Scope{
+        public:
+            Scope ( XS_engine& engine );
+            ~Scope();
+        private:
+            Scope ( const Scope& );
+            Scope& operator= ( const Scope& );
+            XS_engine*  fPrevious;
+        };
+
+
+        //  ------------------------------------------------------------- #
+        //   Configuration                                                #
+        //  ------------------------------------------------------------- #
+
+        /// Integration method of XS::dE_AA_pbar_LAB, enum from [GSL, GSL_QAGIU, TRAPEZE, GAUSS_LEGENDRE, TANH_SINH, ROMBERG, AUTOTUNE], cf. CRXS_config::SetupIntegrationMethod
+        int     fIntegrationMethod;
+        /// Integration method of XS::dE_AA_p_LAB__numerical, enum from [GSL, GSL_QAGIU, TRAPEZE, GAUSS_LEGENDRE, TANH_SINH, ROMBERG], cf. CRXS_config::SetupIntegrationMethod_p
+        int     fIntegrationMethod_p;
+        /// Integration method of XS::dEn_AA_Dbar_LAB, XS::dEn_AA_He3bar_LAB, and XS::dEn_AA_He4bar_LAB, enum as fIntegrationMethod_p, cf. CRXS_config::SetupIntegrationMethod_antinuclei
+        int     fIntegrationMethod_antinuclei;
+        /// Required relative accuracy of the adaptive integration methods, cf. CRXS_config::SetupIntegrationAccuracy
+        double  fIntegrationEpsrel;
+        /// Number of steps of Integration::integrate_trapeze, cf. Integration::SetTrapezeIntegrationSteps
+        int     fTrapezeSteps;
+        /// Number of nodes of the Gauss-Legendre rule, cf. CRXS_config::SetupGaussLegendreNodes
+        int     fGaussLegendreNodes;
+        /// Integration variable of the angular integrals, enum from [ETA_LAB, RAPIDITY_LAB], cf. CRXS_config::SetupIntegrationVariable
+        int     fIntegrationVariable;
+        
+        /// Calibrated rules of the integration method AUTOTUNE (XS::dE_AA_pbar_LAB), not owned by the engine, cf. CRXS_config::SetupAutotune
+        const XS_autotune*  fAutotune;
+        
+        /// Integration_options with the given method and the accuracy settings of this engine
+        Integration_options GetIntegrationOptions( int method ) const;
+        /// Instruction set of the vectorized kernels, enum from [SIMD_AUTO, SIMD_NONE, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512], cf. CRXS_config::SetupSIMD
+        int     fSIMD;
+
+
+        //  ------------------------------------------------------------- #
+        //   SELF parameters                                              #
+        //  ------------------------------------------------------------- #
+
+        /// Same as XS::Set_SELF_C_parameters_diMauro, for this engine.
+        void    Set_SELF_C_parameters_diMauro( double* C );
+        /// Same as XS::Set_SELF_C_parameters_Winkler, for this engine.
+        void    Set_SELF_C_parameters_Winkler( double* C );
+        /// Same as XS::Set_SELF_D_parameters_diMauro, for this engine.
+        void    Set_SELF_D_parameters_diMauro( double* D );
+        /// Same as XS::Set_SELF_D_parameters_Winkler, for this engine.
+        void    Set_SELF_D_parameters_Winkler( double* D );
+
+        double  fWinkler_SELF_C1_to_C16     [17];
+        double  fdiMauro_SELF_C1_to_C11     [12];
+        double  fdiMauro_SELF_C1_to_C16     [17];
+        double  fWinkler_SELF_D1_to_D2       [3];
+        double  fdiMauro_SELF_D1_to_D2       [3];
+
+
+        //  ------------------------------------------------------------- #
+        //   Restricted parameter space                                   #
+        //  ------------------------------------------------------------- #
+
+        /// Same as XS::SetRestricted_pp, for this engine.
+        void    SetRestricted_pp                    ( bool is_pp );
+
+        /// Same as XS::isInRestricted_CM, for this engine.
+        bool    isInRestricted_CM                   ( double s, double xf, double pT ) const;
+        /// Same as XS::SetRestrictedParameterSpace_CM, for this engine.
+        void    SetRestrictedParameterSpace_CM      ( double s, double xf, double pT );
+        /// Same as XS::RemoveRestrictedParameterSpace_CM, for this engine.
+        void    RemoveRestrictedParameterSpace_CM   (  );
+
+        /// Same as XS::isInRestricted_LAB, for this engine.
+        bool    isInRestricted_LAB                  ( double Tp, double Tpbar, double eta ) const;
+        /// Same as XS::SetRestrictedParameterSpace_LAB, for this engine.
+        void    SetRestrictedParameterSpace_LAB     ( double Tp, double Tpbar, double eta );
+        /// Same as XS::RemoveRestrictedParameterSpace_LAB, for this engine.
+        void    RemoveRestrictedParameterSpace_LAB  (  );
+
+        bool    fIsRestricted_pp;
+
+        /// Number of points of the restricted parameter space in (s, xf, pT)
+        int         fRestrictedParameterSpace_CM;
+        /// Convex hull of the points of the restricted parameter space in (s, xf, pT)
+        ConvexHull  fRestrictedParameterSpace_CM__hull;
+
+        /// Number of points of the restricted parameter space in (Tp, Tpbar, eta)
+        int         fRestrictedParameterSpace_LAB;
+        /// Convex hull of the points of the restricted parameter space in (Tp, Tpbar, eta)
+        ConvexHull  fRestrictedParameterSpace_LAB__hull;
+
+    };
+}
+
+#endif
@@ -0,0 +1,271 @@
+#include "math.h"
+#include "iostream"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_simd.h"
+#include "crxs.h"
+
+namespace CRXS {
+
+
+    //
+    //  Gamma-ray production in pp collisions, Kafexhiu et al. 2014 (arXiv:1406.7369v2). Port of python/XS_pp_gamma.py,
+    //  with the masses used there (which differ from XS_definitions::fMass_proton in the 7th digit).
+    //
+
+    static const double gamma__m_p  = 0.938272;     // GeV
+    static const double gamma__m_pi = 0.134976;     // GeV
+
+    const double XS_definitions::pp_gamma__T_p_threshold = 2*gamma__m_pi + gamma__m_pi*gamma__m_pi/2/gamma__m_p;
+
+
+    //  All quantities of Eqs. (8) and (11) which depend only on the proton energy
+    struct gamma__energy{
+        double A_max;           // 0 below threshold
+        double E_gamma_max;
+        double Y_gamma_max;
+        double alpha;
+        double beta;
+        double gamma;
+        double C;
+    };
+
+    static void gamma__setup( double T_p_LAB, gamma__energy& e ){
+
+        e.A_max       = 0;
+        e.E_gamma_max = 0;
+        e.Y_gamma_max = 0;
+        e.alpha       = 1;
+        e.beta        = 0;
+        e.gamma       = 0;
+        e.C           = 1;
+
+        double T_th = XS_definitions::pp_gamma__T_p_threshold;
+        if (T_p_LAB<T_th) {
+            return;
+        }
+        double m_p    = gamma__m_p;
+        double m_pi   = gamma__m_pi;
+        double s      = 2 * m_p * ( T_p_LAB + 2*m_p );
+        double E_pi_max__CM = (s - 4 * m_p*m_p + m_pi*m_pi) / 2 / sqrt(s);
+        if (E_pi_max__CM <= m_pi) {
+            return;
+        }
+
+        //  Eq. (11)
+        double lamb   = 3.0;
+        e.alpha       = 1.0;
+        e.beta        = XS_definitions::pp_gamma__kappa( T_p_LAB );
+        e.gamma       = 0.;
+        if (T_p_LAB > 1.) {
+            double mu = XS_definitions::pp_gamma__mu( T_p_LAB );
+            e.beta    = mu + 2.45;
+            e.gamma   = mu + 1.45;
+            if (T_p_LAB > 4.) {
+                e.beta  = 1.5*mu + 4.95;
+                e.gamma =     mu + 1.50;
+            }
+        }
+        if (T_p_LAB > 20.) {
+            e.alpha = 0.5;
+            e.beta  = 4.2;
+            e.gamma = 1.0;
+        }
+        if (T_p_LAB > 100.) {
+            e.alpha = 0.5;
+            e.beta  = 4.9;
+            e.gamma = 1.0;
+        }
+
+        double E_pi_max__LAB = XS_definitions::pp_gamma__E_pi_max_LAB( T_p_LAB );
+        double gamma_pi__LAB = E_pi_max__LAB/m_pi;
+        double beta_pi__LAB  = sqrt( 1-pow(gamma_pi__LAB,-2) );
+        e.E_gamma_max = m_pi/2. * gamma_pi__LAB * ( 1 + beta_pi__LAB );
+        e.Y_gamma_max = e.E_gamma_max + m_pi*m_pi/4./e.E_gamma_max;
+        e.C           = lamb * m_pi/e.Y_gamma_max;
+        e.A_max       = XS_definitions::pp_gamma__A_max( T_p_LAB );
+    }
+
+    //  Eq. (11) at E_gamma_LAB, 0 outside of [E_gamma_min, E_gamma_max] (X_gamma>=1 below E_gamma_min)
+    static inline double gamma__F( const gamma__energy& e, double E_gamma_LAB ){
+        double m_pi     = gamma__m_pi;
+        double Y_gamma  = E_gamma_LAB + m_pi*m_pi/4./E_gamma_LAB;
+        double X_gamma  = ( Y_gamma - m_pi ) / ( e.Y_gamma_max - m_pi );
+        if (!(E_gamma_LAB>0) || E_gamma_LAB>e.E_gamma_max || !(X_gamma<1)) {
+            return 0;
+        }
+        double N        = pow( 1-pow( X_gamma, e.alpha ), e.beta  );
+        double DN       = pow( 1+X_gamma/e.C,             e.gamma );
+        return N/DN;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   XS_definitions                                               #
+    //  ------------------------------------------------------------- #
+
+    double XS_definitions::dE_pp_gamma_LAB__Kafexhiu( double T_p_LAB, double E_gamma_LAB ){
+        gamma__energy e;
+        gamma__setup( T_p_LAB, e );
+        if (e.A_max==0) {
+            return 0;
+        }
+        return e.A_max * gamma__F( e, E_gamma_LAB );
+    }
+
+
+    double XS_definitions::pp_gamma__A_max( double T_p_LAB ){
+        if (T_p_LAB < pp_gamma__T_p_threshold) {
+            return 0.;
+        }
+        double b_0 = 5.9;
+        double b_1 = 9.53;
+        double b_2 = 0.52;
+        double b_3 = 0.054;
+        if (T_p_LAB >= 5) {
+            b_1 = 9.13;
+            b_2 = 0.35;
+            b_3 = 9.7e-3;
+        }
+        double theta_p = T_p_LAB/gamma__m_p;
+        if (T_p_LAB < 1) {
+            return b_0 * pp_gamma__sigma_pi( T_p_LAB )/pp_gamma__E_pi_max_LAB( T_p_LAB );
+        }
+        return b_1 * pow( theta_p, -b_2 ) * exp( b_3 * pow( log(theta_p), 2 ) ) * pp_gamma__sigma_pi( T_p_LAB )/gamma__m_p;
+    }
+
+
+    double XS_definitions::pp_gamma__F( double T_p_LAB, double E_gamma_LAB ){
+        gamma__energy e;
+        gamma__setup( T_p_LAB, e );
+        if (e.E_gamma_max==0) {
+            return 0;
+        }
+        return gamma__F( e, E_gamma_LAB );
+    }
+
+
+    double XS_definitions::pp_gamma__sigma_pi( double T_p_LAB ){
+        if (T_p_LAB < pp_gamma__T_p_threshold) {
+            return 0.;
+        }
+        if (T_p_LAB < 2.) {
+            return pp_gamma__sigma_1pi( T_p_LAB ) + pp_gamma__sigma_2pi( T_p_LAB );
+        }
+        return pp_gamma__sigma_in( T_p_LAB ) * pp_gamma__n_pi( T_p_LAB );
+    }
+
+
+    double XS_definitions::pp_gamma__sigma_1pi( double T_p_LAB ){
+        if (T_p_LAB < pp_gamma__T_p_threshold) {
+            return 0.;
+        }
+        double m_p     = gamma__m_p;
+        double m_pi    = gamma__m_pi;
+        double sigma_0 = 7.66e-3;
+        double s       = 2 * m_p * ( T_p_LAB + 2*m_p );
+        double eta     = sqrt( fmax( pow( s-m_pi*m_pi-4*m_p*m_p, 2 ) - 16*m_pi*m_pi*m_p*m_p, 0. ) )/( 2*m_pi*sqrt(s) );
+        return sigma_0 * pow( eta, 1.95 ) * ( 1+eta+pow( eta, 5 ) ) * pow( pp_gamma__f_BW( sqrt(s) ), 1.86 );
+    }
+
+
+    double XS_definitions::pp_gamma__f_BW( double sqrt_s ){
+        double m_p       = gamma__m_p;
+        double Gamma_res = 0.2264;      // GeV
+        double M_res     = 1.1883;      // GeV
+        double gamma     = sqrt( M_res*M_res*( M_res*M_res + Gamma_res*Gamma_res ) );
+        double K         = sqrt(8.) * M_res * Gamma_res * gamma / M_PI / sqrt( M_res*M_res + gamma );
+        return m_p * K / ( pow( pow( sqrt_s-m_p, 2 ) - M_res*M_res, 2 ) + M_res*M_res * Gamma_res*Gamma_res );
+    }
+
+
+    double XS_definitions::pp_gamma__sigma_2pi( double T_p_LAB ){
+        if (T_p_LAB < pp_gamma__T_p_threshold || T_p_LAB < 0.56) {
+            return 0.;
+        }
+        double s0 = 5.7;    // mbarn
+        return s0/( 1.+exp( -9.3*(T_p_LAB-1.4) ) );
+    }
+
+
+    double XS_definitions::pp_gamma__E_pi_max_LAB( double T_p_LAB ){
+        double m_p          = gamma__m_p;
+        double m_pi         = gamma__m_pi;
+        double s            = 2 * m_p * ( T_p_LAB + 2*m_p );
+        double E_pi_max__CM = (s - 4 * m_p*m_p + m_pi*m_pi) / 2 / sqrt(s);
+        double gamma_CM     = (T_p_LAB + 2 * m_p)/sqrt(s);
+        double beta_CM      = sqrt( 1-pow(gamma_CM,-2) );
+        return gamma_CM * ( E_pi_max__CM + sqrt( E_pi_max__CM*E_pi_max__CM-m_pi*m_pi )*beta_CM );
+    }
+
+
+    double XS_definitions::pp_gamma__sigma_in( double T_p_LAB ){
+        double L = log( T_p_LAB/pp_gamma__T_p_threshold );
+        return ( 30.7 - 0.96 * L + 0.18 * L*L ) * pow( 1-pow( pp_gamma__T_p_threshold/T_p_LAB, 1.9 ), 3 );
+    }
+
+
+    double XS_definitions::pp_gamma__n_pi( double T_p_LAB ){
+        if (T_p_LAB < 5) {
+            double Q_p = ( T_p_LAB-pp_gamma__T_p_threshold )/gamma__m_p;
+            return -6e-3 + 0.237*Q_p - 0.023*Q_p*Q_p;
+        }
+        double a_1   = 0.728;
+        double a_2   = 0.596;
+        double a_3   = 0.491;
+        double a_4   = 0.2503;
+        double a_5   = 0.117;
+        double eps_p = ( T_p_LAB-3 )/gamma__m_p;
+        return a_1 * pow( eps_p, a_4 ) * ( 1+exp( -a_2*pow( eps_p, a_5 ) ) ) * ( 1-exp( -a_3*pow( eps_p, 0.25 ) ) );
+    }
+
+
+    double XS_definitions::pp_gamma__kappa( double T_p_LAB ){
+        double theta_p = T_p_LAB/gamma__m_p;
+        return 3.29 - 0.2 * pow( theta_p, -1.5 );
+    }
+
+
+    double XS_definitions::pp_gamma__mu( double T_p_LAB ){
+        double q = ( T_p_LAB-1 )/gamma__m_p;
+        return 5./4 * pow( q, 5./4 ) * exp( -5./4 * q );
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   XS                                                           #
+    //  ------------------------------------------------------------- #
+
+    double XS::dE_pp_gamma_LAB( double T_p_LAB, double E_gamma_LAB ){
+        return XS_definitions::dE_pp_gamma_LAB__Kafexhiu( T_p_LAB, E_gamma_LAB );
+    }
+
+
+    void XS::batch__dE_pp_gamma_LAB( double T_p_LAB, int n, const double* E_gamma_LAB, double* result ){
+        gamma__energy e;
+        gamma__setup( T_p_LAB, e );
+        if (e.A_max==0) {
+            for (int i=0; i<n; i++) result[i] = 0;
+            return;
+        }
+        switch (CRXS_config::Get_SIMD()) {
+#ifdef CRXS_SIMD_X86
+            case SIMD_AVX512:
+                SIMD_AVX512_kernels::pp_gamma__F( n, E_gamma_LAB, result, e.A_max, e.E_gamma_max, e.Y_gamma_max, e.alpha, e.beta, e.gamma, e.C, gamma__m_pi );
+                return;
+            case SIMD_AVX2:
+                SIMD_AVX2_kernels  ::pp_gamma__F( n, E_gamma_LAB, result, e.A_max, e.E_gamma_max, e.Y_gamma_max, e.alpha, e.beta, e.gamma, e.C, gamma__m_pi );
+                return;
+            case SIMD_SSE2:
+                SIMD_SSE2_kernels  ::pp_gamma__F( n, E_gamma_LAB, result, e.A_max, e.E_gamma_max, e.Y_gamma_max, e.alpha, e.beta, e.gamma, e.C, gamma__m_pi );
+                return;
+#endif
+            default:
+                for (int i=0; i<n; i++) {
+                    result[i] = e.A_max * gamma__F( e, E_gamma_LAB[i] );
+                }
+        }
+    }
+
+}
@@ -0,0 +1,302 @@
+#include "math.h"
+#include "stdio.h"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_parametrization.h"
+
+
+
+#define C_array_to_double(NAM) double C##NAM = C_array[NAM];
+
+namespace CRXS {
+
+
+    //
+    //  Analytic gradients of the pp kernels with respect to their parameter arrays. The values are computed with the same
+    //  expressions as in xs_definitions.cxx (identical results), the derivatives reuse the factors of the value.
+    //
+
+    //  d/db pow(a, b), 0 where the limit a->0 vanishes (b>0)
+    static inline double gradient__dpow_exponent( double pow_ab, double a ){
+        if (a<=0 || pow_ab==0) {
+            return 0;
+        }
+        return pow_ab*log(a);
+    }
+
+    static inline void gradient__zero( double* gradient, int n ){
+        for (int i=0; i<n; i++) gradient[i] = 0;
+    }
+
+
+    double XS_definitions::gradient__inv_pp_pbar_CM__Winkler( double s, double E_pbar_d, double pT_pbar, double* C_array, double* gradient ){
+
+        C_array_to_double( 0);
+        C_array_to_double( 5);
+        C_array_to_double( 6);
+        C_array_to_double( 7);
+        C_array_to_double( 8);
+        C_array_to_double( 9);
+        C_array_to_double(10);
+        C_array_to_double(11);
+        C_array_to_double(12);
+        C_array_to_double(13);
+
+        gradient__zero( gradient, 17 );
+
+        double E_pbar = fabs(E_pbar_d);
+        if (s<16*fMass_proton*fMass_proton){
+            return 0;
+        }
+        if ( pow(pT_pbar, 2.) > pow(E_pbar, 2.) - pow(fMass_proton, 2.) ){
+            return 0;
+        }
+        double E_pbar_Max   =   ( s-8.*fMass_proton*fMass_proton )/2./sqrt( s );
+        double x_R          =   E_pbar/E_pbar_Max;
+        if ( x_R > 1. )
+            return  0.;
+
+        double m_T = sqrt(  pT_pbar*pT_pbar  +  fMass_proton*fMass_proton  );
+
+        //  R = A * B for sqrt(s)<10
+        double R      = 1.;
+        double dR_C0  = 0, dR_C9 = 0, dR_C10 = 0;
+        if (sqrt(s)<10) {
+            double d      = 10-sqrt(s);
+            double d_C0   = pow(d,C0);
+            double q2     = pow(x_R-fMass_proton/E_pbar_Max, 2);
+            double A      = (1 +C9*pow(10-sqrt(s),5));
+            double B      = exp(C10*pow(10-sqrt(s),C0)*pow(x_R-fMass_proton/E_pbar_Max, 2));
+            R      = A  *  B;
+            dR_C9  = pow(d,5)*B;
+            dR_C10 = R*d_C0*q2;
+            dR_C0  = R*C10*q2*gradient__dpow_exponent( d_C0, d );
+        }
+        double log_sqrt_s = log(sqrt(s));
+        double sigma_in   = C11 +C12*log(sqrt(s)) + C13*pow(log(sqrt(s)), 2);
+        double l4         = pow(log(sqrt(s)/4./fMass_proton),2);
+        double X          = C8 * l4;
+
+        double P   = pow(1-x_R, C6);
+        double u   = m_T-fMass_proton;
+        double Q   = pow( 1+X*(m_T-fMass_proton), -1./X/C7 );
+        double f0_p = R * sigma_in * C5 * P * Q;
+
+        double sPQ  = sigma_in*C5*P*Q;
+        double RPQ  = R*C5*P*Q;
+
+        gradient[ 0] = sPQ*dR_C0;
+        gradient[ 5] = R*sigma_in*P*Q;
+        gradient[ 6] = R*sigma_in*C5*Q*gradient__dpow_exponent( P, 1-x_R );
+        if (X!=0 && C7!=0) {
+            //  log(Q) = -log(1+X u)/(X C7)
+            double log_1Xu = log( 1+X*u );
+            gradient[ 7] = f0_p*log_1Xu/X/C7/C7;
+            gradient[ 8] = f0_p*l4*( -u/(1+X*u)/X/C7 + log_1Xu/X/X/C7 );
+        }
+        gradient[ 9] = sPQ*dR_C9;
+        gradient[10] = sPQ*dR_C10;
+        gradient[11] = RPQ;
+        gradient[12] = RPQ*log_sqrt_s;
+        gradient[13] = RPQ*log_sqrt_s*log_sqrt_s;
+        return f0_p;
+    }
+
+
+    double XS_definitions::gradient__inv_pp_pbar_CM__diMauro( double s, double E_pbar, double pT_pbar, double* C_array, double* gradient ){
+
+        C_array_to_double( 1);
+        C_array_to_double( 2);
+        C_array_to_double( 3);
+        C_array_to_double( 4);
+        C_array_to_double( 5);
+        C_array_to_double( 6);
+        C_array_to_double( 7);
+        C_array_to_double( 8);
+        C_array_to_double( 9);
+        C_array_to_double(10);
+        C_array_to_double(11);
+
+        gradient__zero( gradient, 12 );
+
+        if (s<16*fMass_proton*fMass_proton){
+            return 0;
+        }
+        if ( pow(pT_pbar*0.9, 2.) > pow(E_pbar, 2.) - pow(fMass_proton, 2.) ){
+            return 0;
+        }
+        double E_pbar_Max   =   ( s-8.*fMass_proton*fMass_proton )/2./sqrt( s );
+        double x_R          =   E_pbar/E_pbar_Max;
+        if ( x_R > 1. ){
+            return  0.;
+        }
+        double sigma_in = tot_pp__diMauro(s) - el_pp__diMauro(s);
+        double P  = pow(1 - x_R, C1);
+        double E  = exp(-C2 * x_R);
+        double s4 = pow( s, C4 /2. ), e5 = exp( -C5 *pT_pbar                 );
+        double s7 = pow( s, C7 /2. ), e8 = exp( -C8 *pT_pbar*pT_pbar         );
+        double s10= pow( s, C10/2. ), e11= exp( -C11*pT_pbar*pT_pbar*pT_pbar );
+        double S  = C3 * s4 * e5 +
+                    C6 * s7 * e8 +
+                    C9 * s10* e11;
+        double invCsCM = sigma_in * P * E * fabs(S);
+
+        //  d|S| = sign(S) dS
+        double G      = sigma_in * P * E * ( S<0 ? -1 : 1 );
+        double half_log_s = log(s)/2.;
+        gradient[ 1] = sigma_in * E * fabs(S) * gradient__dpow_exponent( P, 1-x_R );
+        gradient[ 2] = -x_R * invCsCM;
+        gradient[ 3] = G * s4 * e5;
+        gradient[ 4] = G * C3 * s4 * e5 * half_log_s;
+        gradient[ 5] =-G * C3 * s4 * e5 * pT_pbar;
+        gradient[ 6] = G * s7 * e8;
+        gradient[ 7] = G * C6 * s7 * e8 * half_log_s;
+        gradient[ 8] =-G * C6 * s7 * e8 * pT_pbar*pT_pbar;
+        gradient[ 9] = G * s10* e11;
+        gradient[10] = G * C9 * s10* e11* half_log_s;
+        gradient[11] =-G * C9 * s10* e11* pT_pbar*pT_pbar*pT_pbar;
+        return invCsCM;
+    }
+
+
+    double XS_definitions::gradient__deltaHyperon( double s, double* C_array, double* gradient ){
+
+        C_array_to_double( 1);
+        C_array_to_double( 2);
+        C_array_to_double( 3);
+        C_array_to_double( 4);
+
+        gradient__zero( gradient, 17 );
+
+        double factor   = 0.81;
+
+        double w        = pow(C3/s,C4);
+        double hyperon  = C1 + C2/(1+w);
+        hyperon        *= factor;
+
+        //  dw/dC3 = C4 w/C3, dw/dC4 = w log(C3/s)
+        double dh_w  = -factor*C2/(1+w)/(1+w);
+        gradient[1]  = factor;
+        gradient[2]  = factor/(1+w);
+        gradient[3]  = ( w!=0 && C3!=0 ) ? dh_w*C4*w/C3 : 0;
+        gradient[4]  = dh_w*gradient__dpow_exponent( w, C3/s );
+        return hyperon;
+    }
+
+
+    double XS_definitions::gradient__deltaIsospin( double s, double* C_array, double* gradient ){
+
+        C_array_to_double(14);
+        C_array_to_double(15);
+        C_array_to_double(16);
+
+        gradient__zero( gradient, 17 );
+
+        double w     = pow(s/C15, C16);
+        double dd_w  = -C14/(1+w)/(1+w);
+        gradient[14] = 1/(1+w);
+        gradient[15] = ( w!=0 && C15!=0 ) ? -dd_w*C16*w/C15 : 0;
+        gradient[16] = dd_w*gradient__dpow_exponent( w, s/C15 );
+        return C14/(1+w);
+    }
+
+
+    struct gradient__factor__AA__functor{
+        template<class P> void apply(){
+            double * D_array = P::D();
+            double * C_array = P::C_isospin();
+            double   D1_term = pow(A_projectile*A_target, D_array[1]);
+            double   log_AA  = log( (double) A_projectile*A_target );
+            if (P::diMauro_AA) {
+                result          = D1_term;
+                gradient_D[1]   = result*log_AA;
+                return;
+            }
+            double delta_grad[17];
+            double delta   = XS_definitions::gradient__deltaIsospin( s, &C_array[0], delta_grad );
+            double iso     = P::isospin_AA ? 1. : 0.;
+            double F_proj  = XS_definitions::pbar_overlap_function_projectile( xF );
+            double F_targ  = XS_definitions::pbar_overlap_function_target    ( xF );
+            double A2_proj = pow(A_projectile, D_array[2]);
+            double A2_targ = pow(A_target,     D_array[2]);
+            double proj, targ;
+            if (P::isospin_AA) {
+                proj = A2_proj*(1+   delta*N_projectile/A_projectile)*F_proj;
+                targ = A2_targ*(1+   delta*N_target    /A_target    )*F_targ;
+            }else{
+                proj = A2_proj*(1+0.*delta*N_projectile/A_projectile)*F_proj;
+                targ = A2_targ*(1+0.*delta*N_target    /A_target    )*F_targ;
+            }
+            result = D1_term*( proj + targ );
+
+            gradient_D[1] = result*log_AA;
+            gradient_D[2] = D1_term*( proj*log( (double) A_projectile ) + targ*log( (double) A_target ) );
+            double d_delta = iso*D1_term*( A2_proj*N_projectile/A_projectile*F_proj + A2_targ*N_target/A_target*F_targ );
+            for (int i=0; i<17; i++) {
+                gradient_C[i] = d_delta*delta_grad[i];
+            }
+        }
+        void unknown(){
+            unknown_parametrization = true;
+        }
+        double  s, xF;
+        int     A_projectile, N_projectile, A_target, N_target;
+        double  result;
+        double* gradient_C;
+        double* gradient_D;
+        bool    unknown_parametrization;
+    };
+
+
+    double XS_definitions::gradient__factor__AA( double s, double xF, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, double* gradient_C, double* gradient_D ){
+
+        gradient__zero( gradient_C, 17 );
+        gradient__zero( gradient_D,  3 );
+        if (1000*A_projectile+100*N_projectile+10*A_target+N_target==1010) {
+            return 1;
+        }
+        gradient__factor__AA__functor factor;
+        factor.s                        = s;
+        factor.xF                       = xF;
+        factor.A_projectile             = A_projectile;
+        factor.N_projectile             = N_projectile;
+        factor.A_target                 = A_target;
+        factor.N_target                 = N_target;
+        factor.result                   = 0;
+        factor.gradient_C               = gradient_C;
+        factor.gradient_D               = gradient_D;
+        factor.unknown_parametrization  = false;
+        XS_parametrization__dispatch( parametrization, factor );
+        if (factor.unknown_parametrization) {
+            printf( "Warning in CRXS::XS_definitions::gradient__factor__AA. Parametrizatino %i is not known. Return 0.", parametrization);
+        }
+        return factor.result;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Batch versions                                               #
+    //  ------------------------------------------------------------- #
+
+    void XS_definitions::batch__gradient__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* gradient, double* C_array ){
+        for (int i=0; i<n; i++) {
+            result[i] = gradient__inv_pp_pbar_CM__Winkler( s[i], E_pbar[i], pT_pbar[i], C_array, gradient+17*(long)i );
+        }
+    }
+
+
+    void XS_definitions::batch__gradient__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* gradient, double* C_array ){
+        for (int i=0; i<n; i++) {
+            result[i] = gradient__inv_pp_pbar_CM__diMauro( s[i], E_pbar[i], pT_pbar[i], C_array, gradient+12*(long)i );
+        }
+    }
+
+
+    void XS_definitions::batch__gradient__factor__AA( int n, const double* s, const double* xF, double* result, double* gradient_C, double* gradient_D, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        for (int i=0; i<n; i++) {
+            result[i] = gradient__factor__AA( s[i], xF[i], A_projectile, N_projectile, A_target, N_target, parametrization, gradient_C+17*(long)i, gradient_D+3*(long)i );
+        }
+    }
+
+}
@@ -0,0 +1,231 @@
+#include "math.h"
+#include "iostream"
+
+#include "thread"
+#include "atomic"
+#include "vector"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+
+namespace CRXS {
+
+
+    //
+    //  Grid tabulation. The table is split into rows (one species at one projectile energy, all product energies) which are
+    //  distributed dynamically to the threads. Every thread evaluates its rows with the engine of the calling thread, so
+    //  the results are identical to the serial functions, independent of the number of threads.
+    //
+
+    struct grid__job;
+    typedef void (*grid__row_function)( const grid__job& job, int i_Tn, int i_species, double* row );
+
+    struct grid__job{
+        int                 n_Tn;
+        const double*       Tn_proj_LAB;
+        int                 n_T;
+        const double*       T_LAB;
+        int                 n_species;
+        const int*          A_projectile;
+        const int*          N_projectile;
+        const int*          A_target;
+        const int*          N_target;
+        double*             result;
+        int                 parametrization;
+        int                 coalescence;
+        double              p0_val;
+        grid__row_function  row_function;
+        XS_engine*          engine;
+        std::atomic<int>    next_row;
+    };
+
+
+    static void grid__worker( grid__job* job ){
+        XS_engine::Scope scope( *job->engine );
+        int n_rows = job->n_Tn*job->n_species;
+        std::vector<double> row( job->n_T );
+        for (int r = job->next_row++; r<n_rows; r = job->next_row++) {
+            int i_Tn      = r / job->n_species;
+            int i_species = r % job->n_species;
+            job->row_function( *job, i_Tn, i_species, &row[0] );
+            double* out = job->result + (long)i_Tn*job->n_T*job->n_species + i_species;
+            for (int i_T=0; i_T<job->n_T; i_T++) {
+                out[(long)i_T*job->n_species] = row[i_T];
+            }
+        }
+    }
+
+
+    static void grid__run( grid__job& job, int n_threads ){
+        int n_rows = job.n_Tn*job.n_species;
+        if (n_rows<=0 || job.n_T<=0) {
+            return;
+        }
+        if (n_threads<=0) {
+            n_threads = std::thread::hardware_concurrency();
+        }
+        if (n_threads<=0) {
+            n_threads = 1;
+        }
+        if (n_threads>n_rows) {
+            n_threads = n_rows;
+        }
+        job.engine   = &XS_engine::Current();
+        job.next_row = 0;
+        if (n_threads==1) {
+            grid__worker( &job );
+            return;
+        }
+        std::vector<std::thread> threads;
+        for (int t=0; t<n_threads; t++) {
+            threads.push_back( std::thread( grid__worker, &job ) );
+        }
+        for (int t=0; t<n_threads; t++) {
+            threads[t].join();
+        }
+    }
+
+
+    static void grid__setup( grid__job& job, int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int coalescence, double p0_val, grid__row_function row_function ){
+        job.n_Tn            = n_Tn;
+        job.Tn_proj_LAB     = Tn_proj_LAB;
+        job.n_T             = n_T;
+        job.T_LAB           = T_LAB;
+        job.n_species       = n_species;
+        job.A_projectile    = A_projectile;
+        job.N_projectile    = N_projectile;
+        job.A_target        = A_target;
+        job.N_target        = N_target;
+        job.result          = result;
+        job.parametrization = parametrization;
+        job.coalescence     = coalescence;
+        job.p0_val          = p0_val;
+        job.row_function    = row_function;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Rows                                                         #
+    //  ------------------------------------------------------------- #
+
+    //  Rows below the production threshold are set to zero without setting up the cross section, forbidden points within
+    //  a row are skipped by the integrals themselves (cf. XS::kinematics__eta_range).
+    static bool grid__forbidden( const grid__job& job, int i_Tn, int i, int product, double* row ){
+        if (XS::kinematics__E_CM_max( job.Tn_proj_LAB[i_Tn], product, job.A_projectile[i] )>0) {
+            return false;
+        }
+        for (int i_T=0; i_T<job.n_T; i_T++) {
+            row[i_T] = 0;
+        }
+        return true;
+    }
+
+    static void grid__row__dE_AA_pbar_LAB( const grid__job& job, int i_Tn, int i, double* row ){
+        if (grid__forbidden( job, i_Tn, i, P_BAR, row )) {
+            return;
+        }
+        XS::batch__dE_AA_pbar_LAB( job.Tn_proj_LAB[i_Tn], job.n_T, job.T_LAB, row, job.A_projectile[i], job.N_projectile[i], job.A_target[i], job.N_target[i], job.parametrization );
+    }
+
+    static void grid__row__dE_AA_pbar_LAB_incNbarAndHyperon( const grid__job& job, int i_Tn, int i, double* row ){
+        if (grid__forbidden( job, i_Tn, i, P_BAR, row )) {
+            return;
+        }
+        double Tn_proj_LAB = job.Tn_proj_LAB[i_Tn];
+        XS::batch__dE_AA_pbar_LAB( Tn_proj_LAB, job.n_T, job.T_LAB, row, job.A_projectile[i], job.N_projectile[i], job.A_target[i], job.N_target[i], job.parametrization );
+        // same factor as XS::dE_AA_pbar_LAB_incNbarAndHyperon
+        double s = 4.*XS_definitions::fMass_proton*XS_definitions::fMass_proton + 2. * Tn_proj_LAB * XS_definitions::fMass_proton;
+        double * C_array = XS_definitions::Get_C_parameters_isospin(job.parametrization);
+        double factor = ( 2. + 2.*XS_definitions::deltaHyperon(s, C_array) + XS_definitions::deltaIsospin(s, C_array));
+        for (int i_T=0; i_T<job.n_T; i_T++) {
+            row[i_T] *= factor;
+        }
+    }
+
+    static void grid__row__dE_AA_p_LAB( const grid__job& job, int i_Tn, int i, double* row ){
+        for (int i_T=0; i_T<job.n_T; i_T++) {
+            row[i_T] = XS::dE_AA_p_LAB( job.Tn_proj_LAB[i_Tn], job.T_LAB[i_T], job.A_projectile[i], job.N_projectile[i], job.A_target[i], job.N_target[i], job.parametrization );
+        }
+    }
+
+    static void grid__row__dEn_AA_Dbar_LAB( const grid__job& job, int i_Tn, int i, double* row ){
+        if (grid__forbidden( job, i_Tn, i, D_BAR, row )) {
+            return;
+        }
+        for (int i_T=0; i_T<job.n_T; i_T++) {
+            row[i_T] = XS::dEn_AA_Dbar_LAB( job.Tn_proj_LAB[i_Tn], job.T_LAB[i_T], job.A_projectile[i], job.N_projectile[i], job.A_target[i], job.N_target[i], job.parametrization, job.coalescence, job.p0_val );
+        }
+    }
+
+    static void grid__row__dEn_AA_He3bar_LAB( const grid__job& job, int i_Tn, int i, double* row ){
+        if (grid__forbidden( job, i_Tn, i, HE3_BAR, row )) {
+            return;
+        }
+        for (int i_T=0; i_T<job.n_T; i_T++) {
+            row[i_T] = XS::dEn_AA_He3bar_LAB( job.Tn_proj_LAB[i_Tn], job.T_LAB[i_T], job.A_projectile[i], job.N_projectile[i], job.A_target[i], job.N_target[i], job.parametrization, job.coalescence, job.p0_val );
+        }
+    }
+
+    static void grid__row__dEn_AA_He4bar_LAB( const grid__job& job, int i_Tn, int i, double* row ){
+        if (grid__forbidden( job, i_Tn, i, HE4_BAR, row )) {
+            return;
+        }
+        for (int i_T=0; i_T<job.n_T; i_T++) {
+            row[i_T] = XS::dEn_AA_He4bar_LAB( job.Tn_proj_LAB[i_Tn], job.T_LAB[i_T], job.A_projectile[i], job.N_projectile[i], job.A_target[i], job.N_target[i], job.parametrization, job.coalescence, job.p0_val );
+        }
+    }
+
+    //  pp -> gamma: one species, no species arrays (Tn_proj_LAB is the proton energy, T_LAB the gamma-ray energy)
+    static void grid__row__dE_pp_gamma_LAB( const grid__job& job, int i_Tn, int /*i_species*/, double* row ){
+        XS::batch__dE_pp_gamma_LAB( job.Tn_proj_LAB[i_Tn], job.n_T, job.T_LAB, row );
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Public functions                                             #
+    //  ------------------------------------------------------------- #
+
+    void XS::grid__dE_AA_pbar_LAB( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_pbar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tn, Tn_proj_LAB, n_T, T_pbar_LAB, n_species, A_projectile, N_projectile, A_target, N_target, result, parametrization, 0, 0, &grid__row__dE_AA_pbar_LAB );
+        grid__run( job, n_threads );
+    }
+
+    void XS::grid__dE_AA_pbar_LAB_incNbarAndHyperon( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_pbar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tn, Tn_proj_LAB, n_T, T_pbar_LAB, n_species, A_projectile, N_projectile, A_target, N_target, result, parametrization, 0, 0, &grid__row__dE_AA_pbar_LAB_incNbarAndHyperon );
+        grid__run( job, n_threads );
+    }
+
+    void XS::grid__dE_AA_p_LAB( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_p_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tn, Tn_proj_LAB, n_T, T_p_LAB, n_species, A_projectile, N_projectile, A_target, N_target, result, parametrization, 0, 0, &grid__row__dE_AA_p_LAB );
+        grid__run( job, n_threads );
+    }
+
+    void XS::grid__dEn_AA_Dbar_LAB( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* Tn_Dbar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int coalescence, double p0_val, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tn, Tn_proj_LAB, n_T, Tn_Dbar_LAB, n_species, A_projectile, N_projectile, A_target, N_target, result, parametrization, coalescence, p0_val, &grid__row__dEn_AA_Dbar_LAB );
+        grid__run( job, n_threads );
+    }
+
+    void XS::grid__dEn_AA_He3bar_LAB( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* Tn_Hebar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int coalescence, double p0_val, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tn, Tn_proj_LAB, n_T, Tn_Hebar_LAB, n_species, A_projectile, N_projectile, A_target, N_target, result, parametrization, coalescence, p0_val, &grid__row__dEn_AA_He3bar_LAB );
+        grid__run( job, n_threads );
+    }
+
+    void XS::grid__dEn_AA_He4bar_LAB( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* Tn_Hebar_LAB, int n_species, const int* A_projectile, const int* N_projectile, const int* A_target, const int* N_target, double* result, int parametrization, int coalescence, double p0_val, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tn, Tn_proj_LAB, n_T, Tn_Hebar_LAB, n_species, A_projectile, N_projectile, A_target, N_target, result, parametrization, coalescence, p0_val, &grid__row__dEn_AA_He4bar_LAB );
+        grid__run( job, n_threads );
+    }
+
+    void XS::grid__dE_pp_gamma_LAB( int n_Tp, const double* T_p_LAB, int n_E, const double* E_gamma_LAB, double* result, int n_threads ){
+        grid__job job;
+        grid__setup( job, n_Tp, T_p_LAB, n_E, E_gamma_LAB, 1, 0, 0, 0, 0, result, 0, 0, 0, &grid__row__dE_pp_gamma_LAB );
+        grid__run( job, n_threads );
+    }
+
+}
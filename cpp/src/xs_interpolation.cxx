@@ -0,0 +1,201 @@
+#include "math.h"
+#include "stdio.h"
+#include "algorithm"
+
+#include "crxs.h"
+#include "xs_interpolation.h"
+#include "xs_simd.h"
+
+namespace CRXS {
+
+
+    //  Tolerance of the detection of uniform grids, relative to the step in log(x)
+    static const double interpolation__uniform_tolerance = 1e-6;
+
+    //  Derivative at a node from the left and right differences (harmonic mean, Fritsch-Butland), as in XS_table
+    static double interpolation__slope( double d_lo, double d_up ){
+        if (d_lo*d_up<=0) return 0;
+        return 2.*d_lo*d_up/(d_lo+d_up);
+    }
+
+
+    XS_interpolation::XS_interpolation(){
+        fMethod     = INTERPOLATION__LOGLOG_LINEAR;
+        fUniform    = false;
+        fLog_x_min  = 0;
+        fInv_dlog_x = 0;
+    }
+
+    XS_interpolation::XS_interpolation( int n, const double* x, const double* y, int method ){
+        Setup( n, x, y, method );
+    }
+
+    XS_interpolation::XS_interpolation( const std::vector<double>& x, const std::vector<double>& y, int method ){
+        if (x.size()!=y.size()) {
+            printf( "Warning in CRXS::XS_interpolation::XS_interpolation. x and y have different lengths (%i, %i).\n", int(x.size()), int(y.size()) );
+        }
+        int n = std::min( x.size(), y.size() );
+        Setup( n, n ? &x[0] : 0, n ? &y[0] : 0, method );
+    }
+
+
+    bool XS_interpolation::Setup( int n, const double* x, const double* y, int method ){
+
+        fMethod     = method;
+        fUniform    = false;
+        fLog_x_min  = 0;
+        fInv_dlog_x = 0;
+        fX           .clear();
+        fY           .clear();
+        fLog_x       .clear();
+        fLog_y       .clear();
+        fCoefficients.clear();
+
+        bool valid = n>=2 && ( method==INTERPOLATION__LOGLOG_LINEAR || method==INTERPOLATION__LOGLOG_MONOTONE_CUBIC );
+        for (int i=0; valid && i<n; i++) {
+            valid = x[i]>0 && ( i==0 || x[i]>x[i-1] );
+        }
+        if (!valid) {
+            printf( "Warning in CRXS::XS_interpolation::Setup. The table is not valid (at least 2 nodes, strictly increasing positive x, known method). The table is empty.\n" );
+            return false;
+        }
+
+        for (int i=0; i<n; i++) {
+            double v = y[i];
+            if (v<1e-100) v = 1e-100;
+            fX    .push_back( x[i]     );
+            fY    .push_back( v        );
+            fLog_x.push_back( log(x[i]) );
+            fLog_y.push_back( log(v)   );
+        }
+
+        double step = ( fLog_x[n-1]-fLog_x[0] )/(n-1);
+        fUniform    = true;
+        for (int i=0; i<n; i++) {
+            if (fabs( fLog_x[i]-fLog_x[0]-i*step ) > interpolation__uniform_tolerance*step) {
+                fUniform = false;
+                break;
+            }
+        }
+        fLog_x_min  = fLog_x[0];
+        fInv_dlog_x = 1./step;
+
+        //  On uniform grids t is computed from the nominal nodes, so the intervals have the nominal width
+        std::vector<double> h( n-1 ), d( n-1 ), m( n, 0. );
+        for (int i=0; i<n-1; i++) {
+            h[i] = fUniform ? step : fLog_x[i+1]-fLog_x[i];
+            d[i] = ( fLog_y[i+1]-fLog_y[i] )/h[i];
+        }
+        if (method==INTERPOLATION__LOGLOG_MONOTONE_CUBIC) {
+            m[0]   = d[0];
+            m[n-1] = d[n-2];
+            for (int i=1; i<n-1; i++) {
+                m[i] = interpolation__slope( d[i-1], d[i] );
+            }
+        }
+
+        for (int i=0; i<n-1; i++) {
+            double delta = fLog_y[i+1]-fLog_y[i];
+            if (method==INTERPOLATION__LOGLOG_LINEAR) {
+                double c[4] = { fLog_y[i], delta, 0., 0. };
+                fCoefficients.insert( fCoefficients.end(), c, c+4 );
+            }else{
+                double a    = h[i]*m[i];
+                double b    = h[i]*m[i+1];
+                double c[4] = { fLog_y[i], a, 3*delta-2*a-b, -2*delta+a+b };
+                fCoefficients.insert( fCoefficients.end(), c, c+4 );
+            }
+        }
+        return true;
+    }
+
+
+    XS_interpolation__table XS_interpolation::GetTable() const{
+        XS_interpolation__table table = { 0, fMethod, fUniform, fLog_x_min, fInv_dlog_x, 0, 0, 0, 0, 0 };
+        if (fX.size()<2) {
+            return table;
+        }
+        table.n             = fX.size();
+        table.x             = &fX           [0];
+        table.y             = &fY           [0];
+        table.log_x         = &fLog_x       [0];
+        table.log_y         = &fLog_y       [0];
+        table.coefficients  = &fCoefficients[0];
+        return table;
+    }
+
+
+    double XS_interpolation::Interpolate( double x ) const{
+        return Interpolate( GetTable(), x );
+    }
+
+    void XS_interpolation::Interpolate( int n, const double* x, double* result ) const{
+        Interpolate( GetTable(), n, x, result );
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Interpolation                                                #
+    //  ------------------------------------------------------------- #
+
+    //  Interval i in [0, n-2] which contains log_x (first or last interval outside of the table), and the position t in it
+    static int interpolation__interval( const XS_interpolation__table& table, double log_x, double& t ){
+        int last = table.n-2;
+        if (table.uniform) {
+            double u = ( log_x-table.log_x_min )*table.inv_dlog_x;
+            int    i = u>=last ? last : ( u>0 ? int(u) : 0 );
+            t = u-i;
+            return i;
+        }
+        int i = int( std::upper_bound( table.log_x+1, table.log_x+last+1, log_x ) - table.log_x ) - 1;
+        t = ( log_x-table.log_x[i] )/( table.log_x[i+1]-table.log_x[i] );
+        return i;
+    }
+
+    //  Polynomial of the interval, linear extrapolation outside of [0,1]
+    static double interpolation__log_y( const double* c, double t ){
+        if (t<0) {
+            return c[0] + c[1]*t;
+        }
+        if (t>1) {
+            return c[0]+c[1]+c[2]+c[3] + ( c[1]+2*c[2]+3*c[3] )*(t-1);
+        }
+        return c[0] + t*( c[1] + t*( c[2] + t*c[3] ) );
+    }
+
+
+    double XS_interpolation::Interpolate( const XS_interpolation__table& table, double x ){
+        if (table.n<2 || !(x>0)) {
+            return 0;
+        }
+        double t;
+        int    i = interpolation__interval( table, log(x), t );
+        return exp( interpolation__log_y( table.coefficients+4*i, t ) );
+    }
+
+
+    void XS_interpolation::Interpolate( const XS_interpolation__table& table, int n, const double* x, double* result ){
+        if (table.n<2) {
+            for (int i=0; i<n; i++) result[i] = 0;
+            return;
+        }
+        switch (CRXS_config::Get_SIMD()) {
+#ifdef CRXS_SIMD_X86
+            case SIMD_AVX512:
+                SIMD_AVX512_kernels::interpolate_loglog( n, x, result, table.n, table.uniform, table.log_x_min, table.inv_dlog_x, table.log_x, table.coefficients );
+                return;
+            case SIMD_AVX2:
+                SIMD_AVX2_kernels  ::interpolate_loglog( n, x, result, table.n, table.uniform, table.log_x_min, table.inv_dlog_x, table.log_x, table.coefficients );
+                return;
+            case SIMD_SSE2:
+                SIMD_SSE2_kernels  ::interpolate_loglog( n, x, result, table.n, table.uniform, table.log_x_min, table.inv_dlog_x, table.log_x, table.coefficients );
+                return;
+#endif
+            default:
+                for (int i=0; i<n; i++) {
+                    result[i] = Interpolate( table, x[i] );
+                }
+        }
+    }
+
+}
@@ -0,0 +1,118 @@
+#ifndef CRXS__XS_INTERPOLATION_H
+#define CRXS__XS_INTERPOLATION_H
+
+#include "vector"
+
+namespace CRXS {
+
+    //! Interpolation methods of XS_interpolation, both in log(y) as function of log(x).
+    enum interpolation_method{
+        INTERPOLATION__LOGLOG_LINEAR            =  1,   // piecewise linear
+        INTERPOLATION__LOGLOG_MONOTONE_CUBIC    =  2,   // cubic Hermite, monotonic where the table is monotonic
+    };
+
+
+    //! Tabulated function y(x) as used for the interpolation (view on arrays which are owned elsewhere).
+    /*!
+     *  In the interval [x_i, x_(i+1)] the interpolation is
+     *
+     *      log(y) = c_0 + c_1 t + c_2 t^2 + c_3 t^3,    t = ( log(x)-log(x_i) )/( log(x_(i+1))-log(x_i) ),
+     *
+     *  with c_k = coefficients[4*i+k]. Below x_0 and above x_(n-1) the first and the last interval are extrapolated
+     *  linearly in log-log. If the grid is uniform in log(x), the interval is found in O(1) from log_x_min and
+     *  inv_dlog_x, otherwise by binary search in log_x.
+     *
+     *  The tables of XS_definitions (fXS__tot_pbarp, ...) are constant arrays compiled into the library. Tables of
+     *  XS_interpolation objects are returned by XS_interpolation::GetTable.
+     */
+    struct XS_interpolation__table{
+        /// Number of nodes, at least 2
+        int             n;
+        /// Interpolation method, enum from [INTERPOLATION__LOGLOG_LINEAR, INTERPOLATION__LOGLOG_MONOTONE_CUBIC]
+        int             method;
+        /// true if log(x) is uniform (up to a relative deviation of 1e-6 of the step)
+        bool            uniform;
+        /// log(x_0) and (n-1)/( log(x_(n-1))-log(x_0) ), used for uniform grids
+        double          log_x_min;
+        double          inv_dlog_x;
+        /// Nodes and tabulated values, y>=1e-100, arrays of length n
+        const double*   x;
+        const double*   y;
+        /// log(x) and log(y), arrays of length n
+        const double*   log_x;
+        const double*   log_y;
+        /// Polynomial coefficients of log(y) in the intervals, array of length 4*(n-1)
+        const double*   coefficients;
+    };
+
+
+    //! Log-log interpolation of a tabulated function, e.g. of a total cross section as function of the kinetic energy.
+    /*!
+     *  The nodes x are arbitrary, strictly increasing and positive. Values y<1e-100 (vanishing cross sections) are set
+     *  to 1e-100. On grids which are uniform in log(x) the interval of a point is computed directly, on other grids it
+     *  is found by binary search. The logarithms and the polynomial coefficients of all intervals are computed by the
+     *  constructor; an interpolation then needs one log and one exp.
+     *
+     *  INTERPOLATION__LOGLOG_MONOTONE_CUBIC uses the derivatives of XS_table (harmonic mean of the left and right
+     *  differences, Fritsch-Butland), so that the interpolation does not overshoot between the nodes.
+     *
+     *  The batch version Interpolate( n, x, result ) evaluates SSE2 (2 points), AVX2 (4 points) or AVX-512 (8 points)
+     *  at once, see CRXS_config::SetupSIMD. Its vectorized exp and log deviate from the math library by up to 1 ulp; the
+     *  result deviates from the scalar version by about |log(y)| ulp (relative < 1e-13 for cross sections in mbarn).
+     *  x<=0 and NaN give 0.
+     *
+     *  Usage:
+     *
+     *      XS_interpolation interpolation( n, T, sigma, INTERPOLATION__LOGLOG_MONOTONE_CUBIC );
+     *      double sigma_1 = interpolation.Interpolate( T_1 );
+     *      interpolation.Interpolate( n_bins, T_bins, sigma_bins );
+     *
+     *      XS_interpolation::Interpolate( XS_definitions::fXS__tot_pbarp, n_bins, T_bins, sigma_bins );
+     */
+    class XS_interpolation{
+
+    public:
+
+        /// Empty table, Interpolate returns 0
+        XS_interpolation();
+
+        //! Constructor
+        /*!
+         *  \param int     n        Number of nodes, at least 2
+         *  \param double* x        Nodes, strictly increasing and positive, array of length n
+         *  \param double* y        Tabulated values, array of length n
+         *  \param int     method   Interpolation method, enum from [INTERPOLATION__LOGLOG_LINEAR, INTERPOLATION__LOGLOG_MONOTONE_CUBIC]
+         */
+        XS_interpolation( int n, const double* x, const double* y, int method=INTERPOLATION__LOGLOG_LINEAR );
+        XS_interpolation( const std::vector<double>& x, const std::vector<double>& y, int method=INTERPOLATION__LOGLOG_LINEAR );
+
+        /// Sets the table, see the constructor. Returns false (with a warning) and leaves the table empty if the input is not valid.
+        bool    Setup( int n, const double* x, const double* y, int method=INTERPOLATION__LOGLOG_LINEAR );
+
+        /// Interpolation at x
+        double  Interpolate( double x ) const;
+        /// Interpolation at the n points x, result is allocated by the caller
+        void    Interpolate( int n, const double* x, double* result ) const;
+
+        /// View on the arrays of this object, valid until the object is modified or destroyed
+        XS_interpolation__table     GetTable() const;
+
+        /// Interpolation of table at x
+        static double   Interpolate( const XS_interpolation__table& table, double x );
+        /// Interpolation of table at the n points x, result is allocated by the caller
+        static void     Interpolate( const XS_interpolation__table& table, int n, const double* x, double* result );
+
+        int                     fMethod;
+        bool                    fUniform;
+        double                  fLog_x_min;
+        double                  fInv_dlog_x;
+        std::vector<double>     fX;
+        std::vector<double>     fY;
+        std::vector<double>     fLog_x;
+        std::vector<double>     fLog_y;
+        std::vector<double>     fCoefficients;
+    };
+
+}
+
+#endif
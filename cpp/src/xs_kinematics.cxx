@@ -0,0 +1,264 @@
+#include "math.h"
+#include "iostream"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_coalescence.h"
+
+namespace CRXS {
+
+
+    const double XS::fEta_max_LAB = 50;
+
+
+    //  ------------------------------------------------------------- #
+    //   Support of the pp kernels and the coalescence chain          #
+    //  ------------------------------------------------------------- #
+
+    //  Same conditions as in XS_definitions::inv_pp_pbar_CM__Winkler and XS_definitions::inv_pp_pbar_CM__diMauro
+    static bool kinematics__kernel( double s, double E_pbar ){
+        double m_p = XS_definitions::fMass_proton;
+        if (s<16*m_p*m_p) {
+            return false;
+        }
+        return E_pbar <= ( s-8.*m_p*m_p )/2./sqrt( s );
+    }
+
+    //  True if the chain of XS_setup::inv_AA_coalescence_CM<A> is non-zero for the CM energy E_CM of the antinucleus. The
+    //  kernels are required at the levels 0, ..., n_levels-1, the reduced energies of all levels must not be negative.
+    template<int A> static bool kinematics__chain( double sqrt_s, double E_CM, int n_levels ){
+
+        typedef XS_coalescence<A> nucleus;
+
+        double p2_nucleon = ( E_CM*E_CM - nucleus::mass()*nucleus::mass() )/A/A;
+        double E_pbar     = sqrt( pow(XS_definitions::fMass_proton, 2) + p2_nucleon );
+        double E_nbar     = sqrt( pow(XS_definitions::fMass_neutron,2) + p2_nucleon );
+
+        if (!kinematics__kernel( sqrt_s*sqrt_s, E_pbar )) {
+            return false;
+        }
+        double sq__s = sqrt_s;
+        for (int k=1; k<A; k++) {
+            if (k==1 && nucleus::reduce_by_nucleus) {
+                sq__s -= E_CM;
+            }else{
+                sq__s -= 2.*( k%2==1 ? E_pbar : E_nbar );
+            }
+            if (sq__s<0) {
+                return false;
+            }
+            if (k<n_levels && !kinematics__kernel( sq__s*sq__s, E_pbar )) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //  The conditions of the chain are monotonic in E_CM, the largest allowed E_CM is found by bisection between the mass
+    //  of the antinucleus and sqrt(s).
+    template<int A> static double kinematics__E_CM_max_chain( double s, int A_projectile ){
+
+        int    n_levels = A_projectile<0 ? 1 : A;
+        double sqrt_s   = sqrt( s );
+        double E_low    = XS_coalescence<A>::mass();
+        double E_high   = sqrt_s;
+        if (!kinematics__chain<A>( sqrt_s, E_low, n_levels )) {
+            return 0;
+        }
+        if ( kinematics__chain<A>( sqrt_s, E_high, n_levels )) {
+            return E_high;
+        }
+        while (E_high-E_low > 1e-15*E_high) {
+            double E_mid = 0.5*( E_low+E_high );
+            if (E_mid<=E_low || E_mid>=E_high) {
+                break;
+            }
+            if (kinematics__chain<A>( sqrt_s, E_mid, n_levels )) {
+                E_low  = E_mid;
+            }else{
+                E_high = E_mid;
+            }
+        }
+        return E_low;
+    }
+
+    static int kinematics__nucleons( int product ){
+        if (product==D_BAR  ) return 2;
+        if (product==HE3_BAR) return 3;
+        if (product==HE4_BAR) return 4;
+        return 1;
+    }
+
+    static double kinematics__mass( int product ){
+        if (product==D_BAR  ) return XS_definitions::fMass_deuteron;
+        if (product==HE3_BAR) return XS_definitions::fMass_helion3;
+        if (product==HE4_BAR) return XS_definitions::fMass_helion4;
+        return XS_definitions::fMass_proton;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Public functions                                             #
+    //  ------------------------------------------------------------- #
+
+    double XS::kinematics__E_CM_max( double Tn_proj_LAB, int product, int A_projectile ){
+
+        double m_p = XS_definitions::fMass_proton;
+        double s   = 4*m_p*m_p + 2 * Tn_proj_LAB * m_p;
+
+        if (product==P_BAR) {
+            if (s<16*m_p*m_p) {
+                return 0;
+            }
+            return ( s-8.*m_p*m_p )/2./sqrt( s );
+        }
+        if (product==D_BAR  ) return kinematics__E_CM_max_chain<2>( s, A_projectile );
+        if (product==HE3_BAR) return kinematics__E_CM_max_chain<3>( s, A_projectile );
+        if (product==HE4_BAR) return kinematics__E_CM_max_chain<4>( s, A_projectile );
+
+        printf( "Warning in CRXS::XS::kinematics__E_CM_max. Product %i is not known.\n", product );
+        return 0;
+    }
+
+
+    double XS::kinematics__Tn_threshold( int product, int A_projectile ){
+
+        double m_p = XS_definitions::fMass_proton;
+
+        //  s = 16 m_p^2
+        if (product==P_BAR) {
+            return 6*m_p;
+        }
+        if (product!=D_BAR && product!=HE3_BAR && product!=HE4_BAR) {
+            printf( "Warning in CRXS::XS::kinematics__Tn_threshold. Product %i is not known.\n", product );
+            return 0;
+        }
+        //  Bisection between the antiproton threshold and the first energy above threshold
+        double Tn_low  = 6*m_p;
+        double Tn_high = 2*Tn_low;
+        while (kinematics__E_CM_max( Tn_high, product, A_projectile )<=0) {
+            Tn_low   = Tn_high;
+            Tn_high *= 2;
+        }
+        while (Tn_high-Tn_low > 1e-12*Tn_high) {
+            double Tn_mid = 0.5*( Tn_low+Tn_high );
+            if (kinematics__E_CM_max( Tn_mid, product, A_projectile )>0) {
+                Tn_high = Tn_mid;
+            }else{
+                Tn_low  = Tn_mid;
+            }
+        }
+        return Tn_high;
+    }
+
+
+    bool XS::kinematics__T_LAB_range( double Tn_proj_LAB, double& T_min, double& T_max, int product, int A_projectile ){
+
+        T_min = 0;
+        T_max = 0;
+        double E_CM_max = kinematics__E_CM_max( Tn_proj_LAB, product, A_projectile );
+        if (E_CM_max<=0) {
+            return false;
+        }
+        double m_p       = XS_definitions::fMass_proton;
+        double mass      = kinematics__mass    ( product );
+        int    nucleons  = kinematics__nucleons( product );
+
+        //  Lorentz factors of the CM frame as in convert_LAB_to_CM
+        double E_p_LAB   = Tn_proj_LAB+m_p;
+        double beta      = sqrt(E_p_LAB - m_p)/sqrt(E_p_LAB + m_p);
+        double gamma     = 1./sqrt(1 - beta*beta);
+        double gammabeta = gamma * beta;
+
+        double p_CM_max  = sqrt( fmax( E_CM_max*E_CM_max - mass*mass, 0. ) );
+        T_min = fmax( gamma*E_CM_max - gammabeta*p_CM_max - mass, 0. )/nucleons;
+        T_max =       ( gamma*E_CM_max + gammabeta*p_CM_max - mass     )/nucleons;
+        return true;
+    }
+
+
+    double XS::kinematics__eta_min( double gamma, double gammabeta, double E_LAB, double p_LAB, double E_CM_max ){
+        if (E_CM_max<=0) {
+            return -1;
+        }
+        if (p_LAB<=0 || gammabeta<=0) {
+            return gamma*E_LAB<=E_CM_max ? 0 : -1;
+        }
+        double tanh_eta_min = ( gamma*E_LAB - E_CM_max )/( gammabeta*p_LAB );
+        if (tanh_eta_min>=1) {
+            return -1;
+        }
+        if (tanh_eta_min<=0) {
+            return 0;
+        }
+        return fmin( atanh( tanh_eta_min ), fEta_max_LAB );
+    }
+
+
+    //  Rapidity of the product at pseudo rapidity eta_LAB, y = asinh(pL/mT)
+    static double kinematics__rapidity( double eta_LAB, double mass, double p_LAB ){
+        double pT = p_LAB/cosh( eta_LAB );
+        return asinh( p_LAB*tanh( eta_LAB )/sqrt( mass*mass + pT*pT ) );
+    }
+
+    void XS::kinematics__rapidity_range( double eta_min, double eta_max, double mass, double p_LAB, double& w_min, double& w_max ){
+        double y_max = asinh( p_LAB/mass );
+        w_min = sqrt( fmax( y_max - kinematics__rapidity( eta_max, mass, p_LAB ), 0. ) );
+        w_max = sqrt( fmax( y_max - kinematics__rapidity( eta_min, mass, p_LAB ), 0. ) );
+    }
+
+
+    double XS::kinematics__rapidity_to_eta( double w, double mass, double E_LAB, double p_LAB, double& eta_LAB, double& cosh_eta_LAB ){
+        eta_LAB      = 0;
+        cosh_eta_LAB = 1;
+        if (p_LAB<=0) {
+            return 0;
+        }
+        double y_LAB  = asinh( p_LAB/mass ) - w*w;
+        double tanh_y = tanh( y_LAB );
+        double cosh_y = cosh( y_LAB );
+        if (tanh_y<0) {
+            return 0;
+        }
+        double pL     = E_LAB*tanh_y;
+        double pT     = sqrt( E_LAB*mass*sinh( w*w )*( p_LAB/E_LAB + tanh_y )/cosh_y );
+        if (pT<=0) {
+            //  forward direction, the Jacobian vanishes
+            eta_LAB      = fEta_max_LAB;
+            cosh_eta_LAB = cosh( fEta_max_LAB );
+            return 0;
+        }
+        eta_LAB      = asinh( pL/pT );
+        cosh_eta_LAB = p_LAB/pT;
+        return 2*w*E_LAB/( p_LAB*cosh_y*cosh_y );
+    }
+
+
+    bool XS::kinematics__eta_range( double Tn_proj_LAB, double T_LAB, double& eta_min, double& eta_max, int product, int A_projectile ){
+
+        eta_min = 0;
+        eta_max = 0;
+        double m_p       = XS_definitions::fMass_proton;
+        double mass      = kinematics__mass    ( product );
+        int    nucleons  = kinematics__nucleons( product );
+
+        double E_p_LAB   = Tn_proj_LAB+m_p;
+        double beta      = sqrt(E_p_LAB - m_p)/sqrt(E_p_LAB + m_p);
+        double gamma     = 1./sqrt(1 - beta*beta);
+        double gammabeta = gamma * beta;
+
+        double T_prod    = nucleons*T_LAB;
+        double p_LAB     = sqrt(  T_prod*(T_prod+2*mass)  );
+        if (p_LAB!=p_LAB) {
+            return false;
+        }
+        double eta = kinematics__eta_min( gamma, gammabeta, T_prod+mass, p_LAB, kinematics__E_CM_max( Tn_proj_LAB, product, A_projectile ) );
+        if (eta<0) {
+            return false;
+        }
+        eta_min = eta;
+        eta_max = fEta_max_LAB;
+        return true;
+    }
+
+}
@@ -0,0 +1,335 @@
+#include "math.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "unistd.h"
+
+#include "thread"
+#include "atomic"
+#include "vector"
+#include "string"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_matrix.h"
+
+namespace CRXS {
+
+
+    //
+    //  Production matrix. The columns (projectile energies) are distributed dynamically to the threads. Every column is
+    //  evaluated only in the rows with kinematically allowed product energies, the non-zero elements are collected per
+    //  column and then transposed to the CSR layout.
+    //
+
+    struct matrix__job{
+        const XS_matrix*                    matrix;
+        int                                 product;        // product of the kinematic limits, 0: no limits
+        std::vector<int>                    row_first;      // per column: first evaluated row
+        std::vector< std::vector<double> >  values;         // per column: values in the rows row_first, row_first+1, ...
+        XS_engine*                          engine;
+        std::atomic<int>                    next_column;
+    };
+
+
+    //  Product of the kinematic limits (XS::kinematics__T_LAB_range) of a quantity, 0 for protons and gamma rays (no limits)
+    static int matrix__product( int quantity ){
+        if (quantity==TABLE__DE_AA_PBAR_LAB || quantity==TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON) return P_BAR;
+        if (quantity==TABLE__DEN_AA_DBAR_LAB  ) return D_BAR;
+        if (quantity==TABLE__DEN_AA_HE3BAR_LAB) return HE3_BAR;
+        if (quantity==TABLE__DEN_AA_HE4BAR_LAB) return HE4_BAR;
+        return 0;
+    }
+
+
+    static void matrix__worker( matrix__job* job ){
+        XS_engine::Scope scope( *job->engine );
+        const XS_matrix& m    = *job->matrix;
+        int              n_T  = m.fT_LAB.size();
+        int              n_Tn = m.fTn_proj_LAB.size();
+        for (int j = job->next_column++; j<n_Tn; j = job->next_column++) {
+            double Tn_proj_LAB = m.fTn_proj_LAB[j];
+            int    first = 0, last = n_T;
+            if (job->product) {
+                double T_min, T_max;
+                if (!XS::kinematics__T_LAB_range( Tn_proj_LAB, T_min, T_max, job->product, m.fA_projectile )) {
+                    continue;
+                }
+                while (first<n_T   && m.fT_LAB[first] <T_min) first++;
+                while (last >first && m.fT_LAB[last-1]>T_max) last--;
+            }
+            if (last<=first) {
+                continue;
+            }
+            job->row_first[j] = first;
+            job->values   [j].resize( last-first );
+            //  one column in the calling thread
+            XS_table::Evaluate_quantity( m.fQuantity, m.fA_projectile, m.fN_projectile, m.fA_target, m.fN_target, m.fParametrization, m.fCoalescence, m.fP0, 1, &Tn_proj_LAB, last-first, &m.fT_LAB[first], &job->values[j][0], 1 );
+        }
+    }
+
+
+    XS_matrix::XS_matrix( int quantity, int n_T, const double* T_LAB, int n_Tn, const double* Tn_proj_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_threads ){
+
+        fQuantity           = quantity;
+        fA_projectile       = A_projectile;
+        fN_projectile       = N_projectile;
+        fA_target           = A_target;
+        fN_target           = N_target;
+        fParametrization    = parametrization;
+        fCoalescence        = coalescence;
+        fP0                 = p0_val;
+        fT_LAB      .assign( T_LAB,       T_LAB      +(n_T >0 ? n_T : 0)  );
+        fTn_proj_LAB.assign( Tn_proj_LAB, Tn_proj_LAB+(n_Tn>0 ? n_Tn : 0) );
+        fRow_begin  .assign( fT_LAB.size()+1, 0 );
+
+        if (quantity<TABLE__DE_AA_PBAR_LAB || quantity>TABLE__DE_PP_GAMMA_LAB) {
+            printf( "Warning in CRXS::XS_matrix::XS_matrix. Quantity %i is not known, the matrix is empty.\n", quantity );
+            return;
+        }
+        for (int i=1; i<n_T; i++) {
+            if (!(T_LAB[i]>T_LAB[i-1])) {
+                printf( "Warning in CRXS::XS_matrix::XS_matrix. T_LAB is not strictly increasing, the matrix is empty.\n" );
+                return;
+            }
+        }
+        if (n_T<=0 || n_Tn<=0) {
+            return;
+        }
+
+        matrix__job job;
+        job.matrix      = this;
+        job.product     = matrix__product( quantity );
+        job.row_first   .assign( n_Tn, 0 );
+        job.values      .resize( n_Tn );
+        job.engine      = &XS_engine::Current();
+        job.next_column = 0;
+
+        if (n_threads<=0) {
+            n_threads = std::thread::hardware_concurrency();
+        }
+        if (n_threads<=0) {
+            n_threads = 1;
+        }
+        if (n_threads>n_Tn) {
+            n_threads = n_Tn;
+        }
+        if (n_threads==1) {
+            matrix__worker( &job );
+        }else{
+            std::vector<std::thread> threads;
+            for (int t=0; t<n_threads; t++) {
+                threads.push_back( std::thread( matrix__worker, &job ) );
+            }
+            for (int t=0; t<n_threads; t++) {
+                threads[t].join();
+            }
+        }
+
+        //  Transposition to CSR, the columns of every row are increasing
+        for (int j=0; j<n_Tn; j++) {
+            const std::vector<double>& values = job.values[j];
+            for (unsigned int k=0; k<values.size(); k++) {
+                if (values[k]!=0) fRow_begin[ job.row_first[j]+k+1 ]++;
+            }
+        }
+        for (int i=0; i<n_T; i++) {
+            fRow_begin[i+1] += fRow_begin[i];
+        }
+        fColumn.resize( fRow_begin[n_T] );
+        fValue .resize( fRow_begin[n_T] );
+        std::vector<int> next( fRow_begin.begin(), fRow_begin.end()-1 );
+        for (int j=0; j<n_Tn; j++) {
+            const std::vector<double>& values = job.values[j];
+            for (unsigned int k=0; k<values.size(); k++) {
+                if (values[k]==0) continue;
+                int e = next[ job.row_first[j]+k ]++;
+                fColumn[e] = j;
+                fValue [e] = values[k];
+            }
+        }
+    }
+
+
+    void XS_matrix::Multiply( const double* x, double* y ) const{
+        int n_T = fT_LAB.size();
+        for (int i=0; i<n_T; i++) {
+            double sum = 0;
+            for (int k=fRow_begin[i]; k<fRow_begin[i+1]; k++) {
+                sum += fValue[k]*x[ fColumn[k] ];
+            }
+            y[i] = sum;
+        }
+    }
+
+
+    double XS_matrix::Get( int i_T, int i_Tn ) const{
+        if (i_T<0 || i_T>=(int)fT_LAB.size()) {
+            return 0;
+        }
+        for (int k=fRow_begin[i_T]; k<fRow_begin[i_T+1]; k++) {
+            if (fColumn[k]==i_Tn) return fValue[k];
+        }
+        return 0;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Files                                                        #
+    //  ------------------------------------------------------------- #
+
+    //
+    //  File layout: matrix__file_header (padded to data_offset bytes), followed by T_LAB (n_T doubles), Tn_proj_LAB
+    //  (n_Tn doubles), the row begins (n_T+1 ints), the columns (n_nonzero ints), and the values (n_nonzero doubles).
+    //  All numbers in native byte order.
+    //
+    struct matrix__file_header{
+        char                magic[8];
+        int                 version;
+        int                 byte_order;
+        int                 quantity;
+        int                 A_projectile;
+        int                 N_projectile;
+        int                 A_target;
+        int                 N_target;
+        int                 parametrization;
+        int                 coalescence;
+        int                 n_T;
+        int                 n_Tn;
+        int                 n_nonzero;
+        int                 data_offset;
+        double              p0_val;
+    };
+
+    static const char matrix__magic[8]      = { 'C', 'R', 'X', 'S', 'M', 'A', 'T', 0 };
+    static const int  matrix__byte_order    = 0x01020304;
+    static const int  matrix__data_offset   = 128;
+    static_assert( sizeof(matrix__file_header)<=matrix__data_offset, "matrix__file_header does not fit into the data offset" );
+
+
+    bool XS_matrix::Save( const char* filename ) const{
+
+        matrix__file_header header;
+        memset( &header, 0, sizeof(header) );
+        memcpy( header.magic, matrix__magic, sizeof(matrix__magic) );
+        header.version          = fFileVersion;
+        header.byte_order       = matrix__byte_order;
+        header.quantity         = fQuantity;
+        header.A_projectile     = fA_projectile;
+        header.N_projectile     = fN_projectile;
+        header.A_target         = fA_target;
+        header.N_target         = fN_target;
+        header.parametrization  = fParametrization;
+        header.coalescence      = fCoalescence;
+        header.n_T              = fT_LAB.size();
+        header.n_Tn             = fTn_proj_LAB.size();
+        header.n_nonzero        = fValue.size();
+        header.data_offset      = matrix__data_offset;
+        header.p0_val           = fP0;
+
+        char padding[matrix__data_offset];
+        memset( padding, 0, sizeof(padding) );
+        memcpy( padding, &header, sizeof(header) );
+
+        // write to a temporary file first, rename is atomic
+        char suffix[64];
+        snprintf( suffix, sizeof(suffix), ".tmp.%li", (long) getpid() );
+        std::string tmp = std::string(filename)+suffix;
+
+        FILE* file = fopen( tmp.c_str(), "wb" );
+        if (!file) {
+            printf( "Warning in CRXS::XS_matrix::Save. Cannot write file %s.\n", tmp.c_str() );
+            return false;
+        }
+        size_t n_T  = header.n_T;
+        size_t n_Tn = header.n_Tn;
+        size_t n_nz = header.n_nonzero;
+        bool   ok   = fwrite( padding, 1, sizeof(padding), file )==sizeof(padding);
+        ok = ok && ( n_T ==0 || fwrite( &fT_LAB     [0], sizeof(double), n_T,   file )==n_T   );
+        ok = ok && ( n_Tn==0 || fwrite( &fTn_proj_LAB[0], sizeof(double), n_Tn,  file )==n_Tn  );
+        ok = ok &&              fwrite( &fRow_begin [0], sizeof(int),    n_T+1, file )==n_T+1;
+        ok = ok && ( n_nz==0 || fwrite( &fColumn    [0], sizeof(int),    n_nz,  file )==n_nz  );
+        ok = ok && ( n_nz==0 || fwrite( &fValue     [0], sizeof(double), n_nz,  file )==n_nz  );
+        ok = ( fclose( file )==0 ) && ok;
+        if (!ok || rename( tmp.c_str(), filename )!=0) {
+            printf( "Warning in CRXS::XS_matrix::Save. Cannot write file %s.\n", filename );
+            remove( tmp.c_str() );
+            return false;
+        }
+        return true;
+    }
+
+
+    XS_matrix::XS_matrix( const char* filename ){
+
+        fQuantity           = 0;
+        fA_projectile       = 0;
+        fN_projectile       = 0;
+        fA_target           = 0;
+        fN_target           = 0;
+        fParametrization    = 0;
+        fCoalescence        = 0;
+        fP0                 = 0;
+        fRow_begin.assign( 1, 0 );
+
+        FILE* file = fopen( filename, "rb" );
+        if (!file) {
+            printf( "Warning in CRXS::XS_matrix::XS_matrix. Cannot read file %s, the matrix is empty.\n", filename );
+            return;
+        }
+        char padding[matrix__data_offset];
+        matrix__file_header header;
+        bool ok = fread( padding, 1, sizeof(padding), file )==sizeof(padding);
+        memcpy( &header, padding, sizeof(header) );
+        ok = ok &&   memcmp( header.magic, matrix__magic, sizeof(matrix__magic) )==0
+                && header.version     == fFileVersion
+                && header.byte_order  == matrix__byte_order
+                && header.data_offset == matrix__data_offset
+                && header.n_T>=0 && header.n_Tn>=0 && header.n_nonzero>=0;
+        std::vector<double> T_LAB, Tn_proj_LAB, value;
+        std::vector<int>    row_begin, column;
+        if (ok) {
+            size_t n_T  = header.n_T;
+            size_t n_Tn = header.n_Tn;
+            size_t n_nz = header.n_nonzero;
+            T_LAB      .resize( n_T   );
+            Tn_proj_LAB.resize( n_Tn  );
+            row_begin  .resize( n_T+1 );
+            column     .resize( n_nz  );
+            value      .resize( n_nz  );
+            ok = ok && ( n_T ==0 || fread( &T_LAB      [0], sizeof(double), n_T,   file )==n_T   );
+            ok = ok && ( n_Tn==0 || fread( &Tn_proj_LAB[0], sizeof(double), n_Tn,  file )==n_Tn  );
+            ok = ok &&              fread( &row_begin  [0], sizeof(int),    n_T+1, file )==n_T+1;
+            ok = ok && ( n_nz==0 || fread( &column     [0], sizeof(int),    n_nz,  file )==n_nz  );
+            ok = ok && ( n_nz==0 || fread( &value      [0], sizeof(double), n_nz,  file )==n_nz  );
+            ok = ok && row_begin[0]==0 && row_begin[n_T]==(int)n_nz;
+            for (size_t i=0; ok && i<n_T; i++) {
+                ok = row_begin[i]<=row_begin[i+1];
+            }
+            for (size_t k=0; ok && k<n_nz; k++) {
+                ok = column[k]>=0 && column[k]<(int)n_Tn;
+            }
+        }
+        fclose( file );
+        if (!ok) {
+            printf( "Warning in CRXS::XS_matrix::XS_matrix. File %s is not a valid matrix file (version %i), the matrix is empty.\n", filename, fFileVersion );
+            return;
+        }
+
+        fQuantity           = header.quantity;
+        fA_projectile       = header.A_projectile;
+        fN_projectile       = header.N_projectile;
+        fA_target           = header.A_target;
+        fN_target           = header.N_target;
+        fParametrization    = header.parametrization;
+        fCoalescence        = header.coalescence;
+        fP0                 = header.p0_val;
+        fT_LAB      .swap( T_LAB       );
+        fTn_proj_LAB.swap( Tn_proj_LAB );
+        fRow_begin  .swap( row_begin   );
+        fColumn     .swap( column      );
+        fValue      .swap( value       );
+    }
+
+}
@@ -0,0 +1,99 @@
+#ifndef CRXS__XS_MATRIX_H
+#define CRXS__XS_MATRIX_H
+
+#include "vector"
+
+#include "xs.h"
+#include "xs_table.h"
+
+namespace CRXS {
+
+    //! Production matrix of an energy-differential cross section on the energy grids of a propagation code.
+    /*!
+     *  The matrix element in row i (energy of the product) and column j (energy of the projectile) is
+     *
+     *      M[i][j] = dsigma/dT( Tn_proj_LAB[j], T_LAB[i] )     in mbarn/GeV (per nucleon for antinuclei),
+     *
+     *  for one projectile, target and quantity (enum table_quantity, cf. XS_table). The matrix is stored in compressed
+     *  sparse row (CSR) layout: the non-zero elements of row i are fValue[k] in the columns fColumn[k] for
+     *  k = fRow_begin[i], ..., fRow_begin[i+1]-1, with increasing columns.
+     *
+     *  For antiprotons and antinuclei, the elements outside of the kinematically allowed range of the product energy
+     *  (XS::kinematics__T_LAB_range) are not evaluated. Since this range grows with the projectile energy, the non-zero
+     *  elements of a row are the columns above its production threshold. Elements which evaluate to 0 are dropped as
+     *  well. The columns are distributed dynamically to n_threads threads, every thread uses the engine of the
+     *  constructing thread (XS_engine::Current()), so the matrix does not depend on the number of threads.
+     *
+     *  With x[j] = 4 pi n_target phi(Tn_proj_LAB[j]) w[j] for the flux phi, the target density n_target and the quadrature
+     *  weights w of the projectile grid, Multiply gives the source term q(T_LAB[i]) of this projectile and target (cf. XS_source).
+     *
+     *  Matrices are written to compact binary files by Save (a header, the grids, and the CSR arrays with 32 bit indices,
+     *  in native byte order) and read by the constructor with a file name.
+     *
+     *  Usage:
+     *
+     *      XS_matrix matrix( TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON, n_T, T_pbar, n_Tn, Tn_proj, 1, 0, 1, 0 );
+     *      matrix.Save( "M_pp_pbar.bin" );
+     *      matrix.Multiply( x, q );
+     */
+    class XS_matrix{
+
+    public:
+
+        /// Version of the file format written by Save
+        static const int fFileVersion = 1;
+
+        //! Constructor, evaluates the matrix
+        /*!
+         *  \param int     quantity         Cross section, enum from [TABLE__DE_AA_PBAR_LAB, TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON, TABLE__DE_AA_P_LAB, TABLE__DEN_AA_DBAR_LAB, TABLE__DEN_AA_HE3BAR_LAB, TABLE__DEN_AA_HE4BAR_LAB, TABLE__DE_PP_GAMMA_LAB]
+         *  \param int     n_T              Number of rows
+         *  \param double* T_LAB            Kinetic energy (per nucleon for antinuclei) of the product (in the LAB frame), strictly increasing, array of length n_T
+         *  \param int     n_Tn             Number of columns
+         *  \param double* Tn_proj_LAB      Kinetic energy per nucleon of the projectile (in the LAB frame), array of length n_Tn
+         *  \param int     A_projectile     Mass number of the projectile
+         *  \param int     N_projectile     Number of neutrons in the projectile
+         *  \param int     A_target         Mass number of the target
+         *  \param int     N_target         Number of neutrons in the target
+         *  \param int     parametrization  Cross section parametrization, cf. XS::dE_AA_pbar_LAB, XS::dE_AA_p_LAB, XS::dEn_AA_Dbar_LAB
+         *  \param int     coalescence      Coalescence model (antinuclei only)
+         *  \param double  p0_val           Coalescence momentum in GeV (antinuclei only)
+         *  \param int     n_threads        Number of threads, 0: number of cores
+         */
+        XS_matrix( int quantity, int n_T, const double* T_LAB, int n_Tn, const double* Tn_proj_LAB, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160, int n_threads=0 );
+
+        //! Constructor, reads a matrix written by Save. The matrix is empty (with a warning) if the file cannot be read.
+        XS_matrix( const char* filename );
+
+        /// y = M x, x has n_Tn elements, y has n_T elements and is allocated by the caller
+        void    Multiply( const double* x, double* y ) const;
+
+        /// Matrix element in row i_T and column i_Tn, 0 if it is not stored
+        double  Get( int i_T, int i_Tn ) const;
+
+        /// Number of stored (non-zero) elements
+        int     Get_NonZeros() const { return fValue.size(); };
+
+        //! Writes the matrix to a file, returns false (with a warning) if the file cannot be written
+        bool    Save( const char* filename ) const;
+
+        int     fQuantity;
+        int     fA_projectile;
+        int     fN_projectile;
+        int     fA_target;
+        int     fN_target;
+        int     fParametrization;
+        int     fCoalescence;
+        double  fP0;
+
+        std::vector<double> fT_LAB;
+        std::vector<double> fTn_proj_LAB;
+
+        /// CSR arrays, fRow_begin has n_T+1 elements
+        std::vector<int>    fRow_begin;
+        std::vector<int>    fColumn;
+        std::vector<double> fValue;
+
+    };
+}
+
+#endif
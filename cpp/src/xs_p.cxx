@@ -1,53 +1,40 @@
 #include "math.h"
 #include "iostream"
-
-#include "gsl_integration.h"
+#include "map"
+#include "mutex"
 
 #include "xs.h"
 #include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_setup.h"
 
 namespace CRXS {
    
     
     double XS::inv_AA_p_CM( double s, double xF, double pT_p, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization){
-        
-        double pL_p = xF*sqrt(s)/2.;
-        double E_p  = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_p*pL_p + pT_p*pT_p );
-        
-        if      (  parametrization==ANDERSON  ){
-            double pp = XS_definitions::inv_pp_p_CM__Anderson(s, E_p, pT_p ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else{
-            printf( "Warning in CRXS::XS::inv_AA_p_CM. Parametrization %i is not known.", parametrization);
-        }
-        return 0;
+        return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization ).inv_AA_p_CM( s, xF, pT_p );
     }
     
     double XS::inv_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization){
-        double s, E_p, pT_p, x_F;
-        convert_LAB_to_CM( Tn_proj_LAB, T_p_LAB, eta_LAB, s, E_p, pT_p, x_F );
-        return inv_AA_p_CM(s, x_F, pT_p, A_projectile, N_projectile, A_target, N_target, parametrization);
+        return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization ).inv_AA_p_LAB( Tn_proj_LAB, T_p_LAB, eta_LAB );
     }
     
     double XS::integrand__dE_AA_p_LAB (double eta_LAB, void* parameters  ){
-        
-        double* par = (double * ) parameters;
-        double Tn_proj_LAB      = par[0];
-        double T_p_LAB          = par[1];
-        int    A_projectile     = par[2];
-        int    N_projectile     = par[3];
-        int    A_target         = par[4];
-        int    N_target         = par[5];
-        int    parametrization  = par[6];
-        
-        return  pow( cosh(eta_LAB), -2 ) * XS::inv_AA_p_LAB( Tn_proj_LAB, T_p_LAB, eta_LAB, A_projectile, N_projectile, A_target, N_target, parametrization );
-        
+        XS_setup__integrand_parameters* par = (XS_setup__integrand_parameters*) parameters;
+        return  pow( cosh(eta_LAB), -2 ) * par->setup->inv_AA_p_LAB( par->Tn_proj_LAB, par->T_LAB, eta_LAB );
     }
     
     
     
     double XS::dE_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        if (parametrization==ANDERSON) {
+            return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization ).dE_AA_p_LAB__Anderson( Tn_proj_LAB, T_p_LAB );
+        }
+        return dE_AA_p_LAB__numerical( Tn_proj_LAB, T_p_LAB, A_projectile, N_projectile, A_target, N_target, parametrization );
+    }
+    
+    
+    double XS::dE_AA_p_LAB__numerical( double Tn_proj_LAB, double T_p_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
         
         //
         //  Integrate over all solid angle and transform to enery differential (d sigma / d E)
@@ -59,28 +46,62 @@ namespace CRXS {
         }
         double Jacobian_and_conversion      = 2*3.1415926536*p_p_LAB;
         // it contains: phi_integration (2 pi), inv to d3p (1/E_p_LAB), Jacobian(p_p_Lab*p_p_Lab), dp to dE (E_p_LAB/p_p_Lab)
-        double epsabs = 0;
-        double epsrel = 1e-4;
+        const XS_engine&   engine  = XS_engine::Current();
+        Integration_options options = engine.GetIntegrationOptions( engine.fIntegrationMethod_p );
         double res, err;
-        size_t neval;
-        double par[] = { Tn_proj_LAB, T_p_LAB, 1.0001*A_projectile, 1.0001*N_projectile, 1.0001*A_target, 1.0001*N_target, 1.0001*parametrization };
+        XS_setup                        setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        XS_setup__integrand_parameters  par;
+        par.setup       = &setup;
+        par.Tn_proj_LAB = Tn_proj_LAB;
+        par.T_LAB       = T_p_LAB;
         
-        gsl_integration_workspace * w = gsl_integration_workspace_alloc (1000);
+        res = Integration::integrate( &integrand__dE_AA_p_LAB, 0, 50, &par, options, &err );
+        if(err/res>options.epsrel){
+            printf( "Warning in CRXS::XS::dE_AA_p_LAB__numerical. Integral accuarcy of %f is below required value of %f. \n", err/res, options.epsrel);
+        }
         
-        gsl_function F;
-        F.function = &integrand__dE_AA_p_LAB;
-        F.params = &par[0];
+        res *=  Jacobian_and_conversion;
+        return res;
         
-        gsl_integration_qag(&F, 0, 50, epsabs, epsrel, 1000, 2, w, &res, &err);
-        gsl_integration_workspace_free (w);
+    }
+    
+    
+    //  ------------------------------------------------------------- #
+    //   Normalization of the tertiary shape                          #
+    //  ------------------------------------------------------------- #
+    
+    // Memoized norm__dE_pp_p_LAB, key: Tn_proj_LAB, shared by all threads and engines.
+    // The key is complete only as long as the integral does not depend on any engine setting: the pp cross section of
+    // ANDERSON has no free parameters, dE_AA_p_LAB__Anderson uses a fixed Gauss-Legendre rule (not the integration method
+    // of the engine), and inv_AA_p_CM does not check the restricted parameter space. Settings which enter the integral
+    // in the future have to be added to the key.
+    // The cache is cleared completely if it exceeds this number of entries (e.g. for scans over continuous projectile
+    // energies), the values are recomputed on demand.
+    static const size_t                         p__norm__cache_size = 1<<16;
+    static std::map<double, double>             p__norm__cache;
+    static std::mutex                           p__norm__mutex;
+    
+    double XS::norm__dE_pp_p_LAB( double Tn_proj_LAB ){
         
-        if(err/res>epsrel){
-            printf( "Warning in CRXS::XS::dE_AA_p_LAB. Integral accuarcy of %f is below required value of %f. \n", err/res, epsrel);
+        {
+            std::lock_guard<std::mutex> lock( p__norm__mutex );
+            std::map<double, double>::const_iterator it = p__norm__cache.find( Tn_proj_LAB );
+            if (it!=p__norm__cache.end()) return it->second;
         }
         
-        res *=  Jacobian_and_conversion;
-        return res;
+        // Computed without the lock: threads asking for the same energy at the same time compute the identical value.
+        double norm       = 0.;
+        double dlog10T    = 0.1;
+        for (double log10T=-7; log10T<log10(Tn_proj_LAB); log10T+=dlog10T) {
+            double T = pow(10,log10T);
+            norm += T* dE_AA_p_LAB( Tn_proj_LAB, T, 1, 0, 1, 0, ANDERSON);
+        }
+        norm *= dlog10T * log(10.);
         
+        std::lock_guard<std::mutex> lock( p__norm__mutex );
+        if (p__norm__cache.size()>=p__norm__cache_size) p__norm__cache.clear();
+        p__norm__cache[Tn_proj_LAB] = norm;
+        return norm;
     }
     
     
@@ -0,0 +1,166 @@
+#ifndef CRXS__XS_PARAMETRIZATION_H
+#define CRXS__XS_PARAMETRIZATION_H
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+
+namespace CRXS {
+
+    //! Functional form of the invariant pp cross section of a parametrization.
+    enum pp_kernel{
+        PP_KERNEL__NONE         = 0,
+        PP_KERNEL__WINKLER      = 1,    // XS_definitions::inv_pp_pbar_CM__Winkler
+        PP_KERNEL__DI_MAURO     = 2,    // XS_definitions::inv_pp_pbar_CM__diMauro
+        PP_KERNEL__ANDERSON     = 3,    // XS_definitions::inv_pp_p_CM__Anderson (protons only)
+    };
+
+    //! Compile-time description of the parametrization P (traits).
+    /*!
+     *  Each specialization provides:
+     *
+     *      kernel          pp_kernel of the antiproton (or proton) cross section
+     *      C0              exponent of (10-sqrt(s)) in the Winkler factor R, 0 if it is taken from C[0] at runtime (SELF)
+     *      coalescence     true if the parametrization can be used for antinuclei
+     *      isospin_AA      true if XS_definitions::factor__AA includes the isospin correction
+     *      diMauro_AA      true if XS_definitions::factor__AA is the simple scaling pow(A_projectile*A_target, D1)
+     *      C()             parameter array, as XS_definitions::Get_C_parameters
+     *      C_isospin()     parameter array, as XS_definitions::Get_C_parameters_isospin
+     *      D()             parameter array, as XS_definitions::Get_D_parameters
+     *
+     *  The SELF parametrizations return the arrays of the current engine (XS_engine::Current()). Functions which are
+     *  templates of the traits (e.g. XS_setup, XS_energy_context) resolve all parametrization dependent branches at compile
+     *  time; XS_parametrization__dispatch selects the instantiation for a runtime parametrization id once.
+     */
+    template<int P> struct XS_parametrization;
+
+    template<> struct XS_parametrization<KORSMEIER_I>{
+        static const int  kernel      = PP_KERNEL__DI_MAURO;
+        static const int  C0          = 0;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_definitions::Korsmeier_I_C1_to_C11;   }
+        static double* C_isospin () { return XS_definitions::Korsmeier_II_C1_to_C16;  }  // KORSMEIER I and II use the same isospin parameters
+        static double* D         () { return XS_definitions::Korsmeier_I_D1_to_D2;    }
+    };
+
+    template<> struct XS_parametrization<KORSMEIER_II>{
+        static const int  kernel      = PP_KERNEL__WINKLER;
+        static const int  C0          = 1;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_definitions::Korsmeier_II_C1_to_C16;  }
+        static double* C_isospin () { return XS_definitions::Korsmeier_II_C1_to_C16;  }
+        static double* D         () { return XS_definitions::Korsmeier_II_D1_to_D2;   }
+    };
+
+    template<> struct XS_parametrization<KORSMEIER_III>{
+        static const int  kernel      = PP_KERNEL__WINKLER;
+        static const int  C0          = 2;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_definitions::Korsmeier_III_C1_to_C16; }
+        static double* C_isospin () { return XS_definitions::Korsmeier_III_C1_to_C16; }
+        static double* D         () { return XS_definitions::Korsmeier_III_D1_to_D2;  }
+    };
+
+    template<> struct XS_parametrization<WINKLER>{
+        static const int  kernel      = PP_KERNEL__WINKLER;
+        static const int  C0          = 1;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = false;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_definitions::Winkler_C1_to_C16;       }
+        static double* C_isospin () { return XS_definitions::Winkler_C1_to_C16;       }
+        static double* D         () { return XS_definitions::Winkler_D1_to_D2;        }
+    };
+
+    template<> struct XS_parametrization<WINKLER_II>{
+        static const int  kernel      = PP_KERNEL__WINKLER;
+        static const int  C0          = 2;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = false;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_definitions::Winkler_II_C1_to_C16;    }
+        static double* C_isospin () { return XS_definitions::Winkler_II_C1_to_C16;    }
+        static double* D         () { return XS_definitions::Winkler_II_D1_to_D2;     }
+    };
+
+    template<> struct XS_parametrization<DI_MAURO_I>{
+        static const int  kernel      = PP_KERNEL__DI_MAURO;
+        static const int  C0          = 0;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = true;
+        static double* C         () { return XS_definitions::diMauro_I_C1_to_C11;     }
+        static double* C_isospin () { return XS_definitions::diMauro_I_C1_to_C16;     }
+        static double* D         () { return XS_definitions::diMauro_I_D1_to_D2;      }
+    };
+
+    template<> struct XS_parametrization<DI_MAURO_II>{
+        static const int  kernel      = PP_KERNEL__DI_MAURO;
+        static const int  C0          = 0;
+        static const bool coalescence = true;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = true;
+        static double* C         () { return XS_definitions::diMauro_II_C1_to_C11;    }
+        static double* C_isospin () { return XS_definitions::diMauro_II_C1_to_C16;    }
+        static double* D         () { return XS_definitions::diMauro_II_D1_to_D2;     }
+    };
+
+    template<> struct XS_parametrization<ANDERSON>{
+        static const int  kernel      = PP_KERNEL__ANDERSON;
+        static const int  C0          = 0;
+        static const bool coalescence = false;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_definitions::Korsmeier_II_C1_to_C16;  }
+        static double* C_isospin () { return XS_definitions::Anderson_C1_to_C16;      }
+        static double* D         () { return XS_definitions::Korsmeier_II_D1_to_D2;   }
+    };
+
+    template<> struct XS_parametrization<WINKLER_SELF>{
+        static const int  kernel      = PP_KERNEL__WINKLER;
+        static const int  C0          = 0;
+        static const bool coalescence = false;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_engine::Current().fWinkler_SELF_C1_to_C16; }
+        static double* C_isospin () { return XS_engine::Current().fWinkler_SELF_C1_to_C16; }
+        static double* D         () { return XS_engine::Current().fWinkler_SELF_D1_to_D2;  }
+    };
+
+    template<> struct XS_parametrization<DI_MAURO_SELF>{
+        static const int  kernel      = PP_KERNEL__DI_MAURO;
+        static const int  C0          = 0;
+        static const bool coalescence = false;
+        static const bool isospin_AA  = true;
+        static const bool diMauro_AA  = false;
+        static double* C         () { return XS_engine::Current().fdiMauro_SELF_C1_to_C11; }
+        static double* C_isospin () { return XS_engine::Current().fdiMauro_SELF_C1_to_C16; }
+        static double* D         () { return XS_engine::Current().fdiMauro_SELF_D1_to_D2;  }
+    };
+
+
+    //! Calls function.template apply< XS_parametrization<parametrization> >(), or function.unknown() if there are no traits for parametrization.
+    template<class Function> void XS_parametrization__dispatch( int parametrization, Function& function ){
+        switch (parametrization) {
+            case KORSMEIER_I:   function.template apply< XS_parametrization<KORSMEIER_I>   >(); break;
+            case KORSMEIER_II:  function.template apply< XS_parametrization<KORSMEIER_II>  >(); break;
+            case KORSMEIER_III: function.template apply< XS_parametrization<KORSMEIER_III> >(); break;
+            case WINKLER:       function.template apply< XS_parametrization<WINKLER>       >(); break;
+            case WINKLER_II:    function.template apply< XS_parametrization<WINKLER_II>    >(); break;
+            case DI_MAURO_I:    function.template apply< XS_parametrization<DI_MAURO_I>    >(); break;
+            case DI_MAURO_II:   function.template apply< XS_parametrization<DI_MAURO_II>   >(); break;
+            case ANDERSON:      function.template apply< XS_parametrization<ANDERSON>      >(); break;
+            case WINKLER_SELF:  function.template apply< XS_parametrization<WINKLER_SELF>  >(); break;
+            case DI_MAURO_SELF: function.template apply< XS_parametrization<DI_MAURO_SELF> >(); break;
+            default:            function.unknown(); break;
+        }
+    }
+}
+
+#endif
@@ -6,6 +6,8 @@
 
 #include "xs.h"
 #include "xs_definitions.h"
+#include "xs_setup.h"
+#include "xs_context.h"
 
 #include "linAlg_tools.h"
 namespace CRXS {
@@ -13,122 +15,35 @@ namespace CRXS {
     
     
     double XS::inv_AA_pbar_CM( double s, double xF, double pT_pbar, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization){
-        
-        double pL_pbar = xF*sqrt(s)/2.;
-        double E_pbar  = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_pbar*pL_pbar + pT_pbar*pT_pbar );
-        if (fRestrictedParameterSpace_CM) {
-            if(fIsRestricted_pp){
-                if(!(isInRestricted_CM(s, -xF, pT_pbar)||isInRestricted_CM(s, xF, pT_pbar))) return 0;
-            }else{
-                if(!isInRestricted_CM(s, xF, pT_pbar)) return 0;
-            }
-        }
-        if      (  parametrization==KORSMEIER_II  ){
-            double pp = XS_definitions::inv_pp_pbar_CM__Winkler(s, E_pbar, pT_pbar, XS_definitions::Korsmeier_II_C1_to_C16 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==KORSMEIER_I   ){
-            double pp = XS_definitions::inv_pp_pbar_CM__diMauro(s, E_pbar, pT_pbar, XS_definitions::Korsmeier_I_C1_to_C11 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==KORSMEIER_III ){
-            double pp = XS_definitions::inv_pp_pbar_CM__Winkler(s, E_pbar, pT_pbar, XS_definitions::Korsmeier_III_C1_to_C16 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==WINKLER       ){
-            double pp = XS_definitions::inv_pp_pbar_CM__Winkler(s, E_pbar, pT_pbar, XS_definitions::Winkler_C1_to_C16 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==WINKLER_II    ){
-            double pp = XS_definitions::inv_pp_pbar_CM__Winkler(s, E_pbar, pT_pbar, XS_definitions::Winkler_II_C1_to_C16 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==DI_MAURO_I    ){
-            double pp = XS_definitions::inv_pp_pbar_CM__diMauro(s, E_pbar, pT_pbar, XS_definitions::diMauro_I_C1_to_C11 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==DI_MAURO_II   ){
-            double pp = XS_definitions::inv_pp_pbar_CM__diMauro(s, E_pbar, pT_pbar, XS_definitions::diMauro_II_C1_to_C11 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==WINKLER_SELF  ){
-            double pp = XS_definitions::inv_pp_pbar_CM__Winkler(s, E_pbar, pT_pbar, XS_definitions::Winkler_SELF_C1_to_C16 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else if(  parametrization==DI_MAURO_SELF ){
-            double pp = XS_definitions::inv_pp_pbar_CM__diMauro(s, E_pbar, pT_pbar, XS_definitions::diMauro_SELF_C1_to_C11 ) ;
-            double AA = XS_definitions::factor__AA( s, xF, A_projectile, N_projectile, A_target, N_target, parametrization );
-            return pp * AA;
-        }else{
-            printf( "Warning in CRXS::XS::inv_AA_pbar_CM. Parametrization %i is not known.", parametrization);
-        }
-        return 0;
+        return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization ).inv_AA_pbar_CM( s, xF, pT_pbar );
     }
     
     double XS::inv_AA_pbar_LAB( double Tn_proj_LAB, double T_pbar_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization){
-        double s, E_pbar, pT_pbar, x_F;
-        convert_LAB_to_CM( Tn_proj_LAB, T_pbar_LAB, eta_LAB, s, E_pbar, pT_pbar, x_F );
-        if (fRestrictedParameterSpace_LAB) {
-            if(fIsRestricted_pp){
-                if(!(isInRestricted_LAB(Tn_proj_LAB, T_pbar_LAB, -eta_LAB)||isInRestricted_LAB(Tn_proj_LAB, T_pbar_LAB, eta_LAB))) return 0;
-            }else{
-                if(!isInRestricted_LAB(Tn_proj_LAB, T_pbar_LAB, eta_LAB)) return 0;
-            }
-        }
-        return inv_AA_pbar_CM(s, x_F, pT_pbar, A_projectile, N_projectile, A_target, N_target, parametrization);
+        return XS_setup( A_projectile, N_projectile, A_target, N_target, parametrization ).inv_AA_pbar_LAB( Tn_proj_LAB, T_pbar_LAB, eta_LAB );
     }
     
     double XS::integrand__dE_AA_pbar_LAB (double eta_LAB, void* parameters  ){
-        
-        double* par = (double * ) parameters;
-        double Tn_proj_LAB      = par[0];
-        double T_pbar_LAB       = par[1];
-        int    A_projectile     = par[2];
-        int    N_projectile     = par[3];
-        int    A_target         = par[4];
-        int    N_target         = par[5];
-        int    parametrization  = par[6];
-        
-        return  pow( cosh(eta_LAB), -2 ) * XS::inv_AA_pbar_LAB( Tn_proj_LAB, T_pbar_LAB, eta_LAB, A_projectile, N_projectile, A_target, N_target, parametrization );
-        
+        XS_setup__integrand_parameters* par = (XS_setup__integrand_parameters*) parameters;
+        return  pow( cosh(eta_LAB), -2 ) * par->setup->inv_AA_pbar_LAB( par->Tn_proj_LAB, par->T_LAB, eta_LAB );
     }
     
     double XS::dE_AA_pbar_LAB( double Tn_proj_LAB, double T_pbar_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
         
         //
-        //  Integrate over all solid angle and transform to enery differential (d sigma / d E)
+        //  Integrate over all solid angle and transform to enery differential (d sigma / d E), see XS_energy_context::dE_AA_pbar_LAB
         //
-        double E_pbar_LAB = T_pbar_LAB + XS_definitions::fMass_proton;
-        double p_pbar_LAB = sqrt(  pow( E_pbar_LAB, 2 ) - pow( XS_definitions::fMass_proton, 2 )  );
-        if (p_pbar_LAB!=p_pbar_LAB){
-            return 0;
-        }
-        double Jacobian_and_conversion      = 2*3.1415926536*p_pbar_LAB;
-        // it contains: phi_integration (2 pi), inv to d3p (1/E_pbar_LAB), Jacobian(p_pbar_Lab*p_pbar_Lab), dp to dE (E_pbar_LAB/p_pbar_Lab)
-        double par[] = { Tn_proj_LAB, T_pbar_LAB, 1.0001*A_projectile, 1.0001*N_projectile, 1.0001*A_target, 1.0001*N_target, 1.0001*parametrization };
+        XS_setup setup( A_projectile, N_projectile, A_target, N_target, parametrization );
+        return XS_energy_context( setup, Tn_proj_LAB ).dE_AA_pbar_LAB( T_pbar_LAB );
         
-        double res, err;
-        if(CRXS_config::IntegrationMethod==GSL){
-            double epsabs = 0;
-            double epsrel = 1e-4;
-            //size_t neval;
-            gsl_integration_workspace * w = gsl_integration_workspace_alloc (1000);
-            gsl_function F;
-            F.function = &integrand__dE_AA_pbar_LAB;
-            F.params = &par[0];
-            gsl_integration_qag(&F, 0, 50, epsabs, epsrel, 1000, 2, w, &res, &err);
-            gsl_integration_workspace_free (w);
-            if(err/res>epsrel){
-                printf( "Warning in CRXS::XS::dE_AA_pbar_LAB. Integral accuarcy of %f is below required value of %f. \n", err/res, epsrel);
-            }
-        }else if (CRXS_config::IntegrationMethod==TRAPEZE){
-            res = CRXS::Integration::integrate_trapeze( integrand__dE_AA_pbar_LAB, 0, 50, &par[0] );
+    }
+    
+    
+    void XS::batch__dE_AA_pbar_LAB( double Tn_proj_LAB, int n, const double* T_pbar_LAB, double* result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization ){
+        XS_setup          setup  ( A_projectile, N_projectile, A_target, N_target, parametrization );
+        XS_energy_context context( setup, Tn_proj_LAB );
+        for (int i=0; i<n; i++) {
+            result[i] = context.dE_AA_pbar_LAB( T_pbar_LAB[i] );
         }
-        
-        
-        res *=  Jacobian_and_conversion;
-        return res;
-        
     }
     
     
@@ -0,0 +1,427 @@
+#include "math.h"
+#include "stdlib.h"
+#include "iostream"
+#include "vector"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_setup.h"
+#include "xs_parametrization.h"
+
+namespace CRXS {
+
+
+    //  Properties of the parametrization, from the traits in xs_parametrization.h
+    struct setup__traits{
+        setup__traits() : known(false), kernel(PP_KERNEL__NONE), C0(0), coalescence(false), isospin_AA(true), diMauro_AA(false), C(0), C_isospin(0), D(0) {};
+        template<class P> void apply(){
+            known       = true;
+            kernel      = P::kernel;
+            C0          = P::C0;
+            coalescence = P::coalescence;
+            isospin_AA  = P::isospin_AA;
+            diMauro_AA  = P::diMauro_AA;
+            C           = P::C();
+            C_isospin   = P::C_isospin();
+            D           = P::D();
+        }
+        void unknown(){}
+        bool    known;
+        int     kernel;
+        int     C0;
+        bool    coalescence;
+        bool    isospin_AA;
+        bool    diMauro_AA;
+        double* C;
+        double* C_isospin;
+        double* D;
+    };
+
+
+    XS_setup::XS_setup( int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val ){
+
+        fSigned_A_projectile = A_projectile; //For pbar projectiles A_projectile=-1 (only used for antinuclei)
+        fA_projectile        = abs(A_projectile);
+        fN_projectile        = N_projectile;
+        fA_target            = A_target;
+        fN_target            = N_target;
+        fParametrization     = parametrization;
+        fCoalescence         = coalescence;
+        fP0                  = p0_val;
+        fCoalescence_known   = ( coalescence==FIXED_P0 || coalescence==ENERGY_DEP__VAN_DOETINCHEM || coalescence==PT_DEP );
+
+        fC_array             = XS_definitions::Dummy;
+        fC_array_isospin     = XS_definitions::Dummy;
+        fD_array             = XS_definitions::Dummy;
+
+        fKernel_pbar         = 0;
+        fKernel_coalescence  = 0;
+        fBatchKernel_pbar    = 0;
+        fEnsembleKernel_pbar = 0;
+        fN_C                 = 0;
+
+        fEngine              = &XS_engine::Current();
+
+        setup__traits traits;
+        XS_parametrization__dispatch( parametrization, traits );
+
+        fKernel              = traits.kernel;
+        fC0                  = traits.C0;
+        if      (  fKernel==PP_KERNEL__WINKLER ){
+            fKernel_pbar         = &XS_definitions::inv_pp_pbar_CM__Winkler;
+            fBatchKernel_pbar    = &XS_definitions::batch__inv_pp_pbar_CM__Winkler;
+            fEnsembleKernel_pbar = &XS_definitions::ensemble__inv_pp_pbar_CM__Winkler;
+            fN_C                 = 17;
+        }else if(  fKernel==PP_KERNEL__DI_MAURO ){
+            fKernel_pbar         = &XS_definitions::inv_pp_pbar_CM__diMauro;
+            fBatchKernel_pbar    = &XS_definitions::batch__inv_pp_pbar_CM__diMauro;
+            fEnsembleKernel_pbar = &XS_definitions::ensemble__inv_pp_pbar_CM__diMauro;
+            fN_C                 = 12;
+        }
+        if (traits.coalescence) {
+            fKernel_coalescence  = fKernel_pbar;
+        }
+
+        bool known = traits.known;
+        if (known) {
+            fC_array         = traits.C;
+            fC_array_isospin = traits.C_isospin;
+            fD_array         = traits.D;
+        }
+
+        for (int nucleons=0; nucleons<5; nucleons++) {
+            fNorm_coalescence[nucleons] = 1;
+            if (known && nucleons>1 && fA_target*fA_projectile!=1) {
+                fNorm_coalescence[nucleons] = pow(fA_target*fA_projectile, (nucleons-1.)*(fD_array[1]+fD_array[2]));
+            }
+        }
+
+        fAA_is_pp      = ( 1000*fA_projectile+100*fN_projectile+10*fA_target+fN_target==1010 );
+        fAA_is_diMauro = traits.diMauro_AA;
+        fAA_isospin    = traits.isospin_AA;
+        fAA_norm       = 1;
+        fAA_proj       = 1;
+        fAA_targ       = 1;
+        if (known && !fAA_is_pp) {
+            fAA_norm   = pow(fA_projectile*fA_target, fD_array[1]);
+            fAA_proj   = pow(fA_projectile,           fD_array[2]);
+            fAA_targ   = pow(fA_target,               fD_array[2]);
+        }
+    }
+
+
+    double XS_setup::factor__AA( double s, double xF ) const{
+        if (fAA_is_pp) {
+            return 1;
+        }
+        if (fAA_is_diMauro) {
+            return fAA_norm;
+        }
+        double proj = fAA_proj;
+        double targ = fAA_targ;
+        if (fAA_isospin) {
+            double deltaIsospin = XS_definitions::deltaIsospin(s, fC_array_isospin);
+            proj *= (1+deltaIsospin*fN_projectile/fA_projectile);
+            targ *= (1+deltaIsospin*fN_target    /fA_target    );
+        }
+        proj *= XS_definitions::pbar_overlap_function_projectile( xF );
+        targ *= XS_definitions::pbar_overlap_function_target    ( xF );
+        return fAA_norm*( proj + targ );
+    }
+
+
+    double XS_setup::p_coalescence( double s, double pToverA ) const{
+        if       (fCoalescence==FIXED_P0) {
+            return fP0; //USING THE NOTATION WITH pow(pc/2,3.)
+        }else if (fCoalescence==ENERGY_DEP__VAN_DOETINCHEM) {
+            return XS::p_coal__VonDoetinchen(s);
+        }else if (fCoalescence==PT_DEP) {
+            return XS::p_coal__pTdep(pToverA, fP0);
+        }
+        return -1;
+    }
+
+
+    double XS_setup::inv_AA_pbar_CM( double s, double xF, double pT_pbar ) const{
+
+        double pL_pbar = xF*sqrt(s)/2.;
+        double E_pbar  = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_pbar*pL_pbar + pT_pbar*pT_pbar );
+        if (fEngine->fRestrictedParameterSpace_CM) {
+            if(fEngine->fIsRestricted_pp){
+                if(!(fEngine->isInRestricted_CM(s, -xF, pT_pbar)||fEngine->isInRestricted_CM(s, xF, pT_pbar))) return 0;
+            }else{
+                if(!fEngine->isInRestricted_CM(s, xF, pT_pbar)) return 0;
+            }
+        }
+        if (!fKernel_pbar) {
+            printf( "Warning in CRXS::XS::inv_AA_pbar_CM. Parametrization %i is not known.", fParametrization);
+            return 0;
+        }
+        double pp = fKernel_pbar(s, E_pbar, pT_pbar, fC_array, -1);
+        double AA = factor__AA( s, xF );
+        return pp * AA;
+    }
+
+
+    double XS_setup::inv_AA_pbar_LAB( double Tn_proj_LAB, double T_pbar_LAB, double eta_LAB ) const{
+        double s, E_pbar, pT_pbar, x_F;
+        XS::convert_LAB_to_CM( Tn_proj_LAB, T_pbar_LAB, eta_LAB, s, E_pbar, pT_pbar, x_F );
+        if (fEngine->fRestrictedParameterSpace_LAB) {
+            if(fEngine->fIsRestricted_pp){
+                if(!(fEngine->isInRestricted_LAB(Tn_proj_LAB, T_pbar_LAB, -eta_LAB)||fEngine->isInRestricted_LAB(Tn_proj_LAB, T_pbar_LAB, eta_LAB))) return 0;
+            }else{
+                if(!fEngine->isInRestricted_LAB(Tn_proj_LAB, T_pbar_LAB, eta_LAB)) return 0;
+            }
+        }
+        return inv_AA_pbar_CM(s, x_F, pT_pbar);
+    }
+
+
+    //  Number of points per call of the vectorized kernel, the intermediate arrays are on the stack.
+    static const int batch__chunk = 256;
+
+
+    void XS_setup::inv_AA_pbar_CM( int n, const double* s, const double* xF, const double* pT_pbar, double* result ) const{
+        double E_pbar[batch__chunk];
+        for (int i0=0; i0<n; i0+=batch__chunk) {
+            int m = ( n-i0<batch__chunk ? n-i0 : batch__chunk );
+            for (int k=0; k<m; k++) {
+                double pL_pbar = xF[i0+k]*sqrt(s[i0+k])/2.;
+                E_pbar[k]      = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_pbar*pL_pbar + pT_pbar[i0+k]*pT_pbar[i0+k] );
+            }
+            fBatchKernel_pbar( m, s+i0, E_pbar, pT_pbar+i0, result+i0, fC_array );
+            for (int k=0; k<m; k++) {
+                int i = i0+k;
+                if (fEngine->fRestrictedParameterSpace_CM) {
+                    if(fEngine->fIsRestricted_pp){
+                        if(!(fEngine->isInRestricted_CM(s[i], -xF[i], pT_pbar[i])||fEngine->isInRestricted_CM(s[i], xF[i], pT_pbar[i]))) { result[i] = 0; continue; }
+                    }else{
+                        if(!fEngine->isInRestricted_CM(s[i], xF[i], pT_pbar[i]))                                                     { result[i] = 0; continue; }
+                    }
+                }
+                result[i] *= factor__AA( s[i], xF[i] );
+            }
+        }
+    }
+
+
+    void XS_setup::inv_AA_pbar_LAB( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result ) const{
+        double s[batch__chunk], E_pbar, pT_pbar[batch__chunk], x_F[batch__chunk];
+        for (int i0=0; i0<n; i0+=batch__chunk) {
+            int m = ( n-i0<batch__chunk ? n-i0 : batch__chunk );
+            for (int k=0; k<m; k++) {
+                XS::convert_LAB_to_CM( Tn_proj_LAB[i0+k], T_pbar_LAB[i0+k], eta_LAB[i0+k], s[k], E_pbar, pT_pbar[k], x_F[k] );
+            }
+            inv_AA_pbar_CM( m, s, x_F, pT_pbar, result+i0 );
+            if (fEngine->fRestrictedParameterSpace_LAB) {
+                for (int i=i0; i<i0+m; i++) {
+                    if(fEngine->fIsRestricted_pp){
+                        if(!(fEngine->isInRestricted_LAB(Tn_proj_LAB[i], T_pbar_LAB[i], -eta_LAB[i])||fEngine->isInRestricted_LAB(Tn_proj_LAB[i], T_pbar_LAB[i], eta_LAB[i]))) result[i] = 0;
+                    }else{
+                        if(!fEngine->isInRestricted_LAB(Tn_proj_LAB[i], T_pbar_LAB[i], eta_LAB[i]))                                                                        result[i] = 0;
+                    }
+                }
+            }
+        }
+    }
+
+
+    //  Ensembles: the nuclear factors depend on the parameter sets, their energy-independent parts are computed per call
+    void XS_setup::inv_AA_pbar_CM( int n, const double* s, const double* xF, const double* pT_pbar, double* result, int K, const double* C_sets, const double* D_sets, const double* C_isospin_sets ) const{
+        if (K<=0) {
+            return;
+        }
+        std::vector<double> norm( K, fAA_norm ), proj( K, fAA_proj ), targ( K, fAA_targ );
+        if (D_sets && !fAA_is_pp) {
+            for (int k=0; k<K; k++) {
+                norm[k] = pow(fA_projectile*fA_target, D_sets[3*k+1]);
+                proj[k] = pow(fA_projectile,           D_sets[3*k+2]);
+                targ[k] = pow(fA_target,               D_sets[3*k+2]);
+            }
+        }
+        //  isospin parameters of set k: C_isospin+k*ld_isospin
+        const double* C_isospin  = C_isospin_sets;
+        int           ld_isospin = 17;
+        if (!C_isospin) {
+            if (fKernel==PP_KERNEL__WINKLER) {
+                C_isospin  = C_sets;
+            }else{
+                C_isospin  = fC_array_isospin;
+                ld_isospin = 0;
+            }
+        }
+        bool isospin = ( fAA_isospin && (fN_projectile!=0 || fN_target!=0) );
+
+        double E_pbar[batch__chunk];
+        for (int i0=0; i0<n; i0+=batch__chunk) {
+            int m = ( n-i0<batch__chunk ? n-i0 : batch__chunk );
+            for (int j=0; j<m; j++) {
+                double pL_pbar = xF[i0+j]*sqrt(s[i0+j])/2.;
+                E_pbar[j]      = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_pbar*pL_pbar + pT_pbar[i0+j]*pT_pbar[i0+j] );
+            }
+            fEnsembleKernel_pbar( m, s+i0, E_pbar, pT_pbar+i0, result+(long)i0*K, K, C_sets );
+            for (int i=i0; i<i0+m; i++) {
+                double* row = result+(long)i*K;
+                bool    in  = true;
+                if (fEngine->fRestrictedParameterSpace_CM) {
+                    if(fEngine->fIsRestricted_pp){
+                        in = ( fEngine->isInRestricted_CM(s[i], -xF[i], pT_pbar[i])||fEngine->isInRestricted_CM(s[i], xF[i], pT_pbar[i]) );
+                    }else{
+                        in =   fEngine->isInRestricted_CM(s[i],  xF[i], pT_pbar[i]);
+                    }
+                }
+                if (!in) {
+                    for (int k=0; k<K; k++) row[k] = 0;
+                    continue;
+                }
+                if (fAA_is_pp) {
+                    continue;
+                }
+                if (fAA_is_diMauro) {
+                    for (int k=0; k<K; k++) row[k] *= norm[k];
+                    continue;
+                }
+                double overlap_proj = XS_definitions::pbar_overlap_function_projectile( xF[i] );
+                double overlap_targ = XS_definitions::pbar_overlap_function_target    ( xF[i] );
+                for (int k=0; k<K; k++) {
+                    double p = proj[k];
+                    double t = targ[k];
+                    if (isospin) {
+                        double deltaIsospin = XS_definitions::deltaIsospin(s[i], const_cast<double*>( C_isospin+(long)k*ld_isospin ));
+                        p *= (1+deltaIsospin*fN_projectile/fA_projectile);
+                        t *= (1+deltaIsospin*fN_target    /fA_target    );
+                    }
+                    p *= overlap_proj;
+                    t *= overlap_targ;
+                    row[k] *= norm[k]*( p + t );
+                }
+            }
+        }
+    }
+
+
+    void XS_setup::inv_AA_pbar_LAB( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result, int K, const double* C_sets, const double* D_sets, const double* C_isospin_sets ) const{
+        double s[batch__chunk], E_pbar, pT_pbar[batch__chunk], x_F[batch__chunk];
+        for (int i0=0; i0<n; i0+=batch__chunk) {
+            int m = ( n-i0<batch__chunk ? n-i0 : batch__chunk );
+            for (int j=0; j<m; j++) {
+                XS::convert_LAB_to_CM( Tn_proj_LAB[i0+j], T_pbar_LAB[i0+j], eta_LAB[i0+j], s[j], E_pbar, pT_pbar[j], x_F[j] );
+            }
+            inv_AA_pbar_CM( m, s, x_F, pT_pbar, result+(long)i0*K, K, C_sets, D_sets, C_isospin_sets );
+            if (fEngine->fRestrictedParameterSpace_LAB) {
+                for (int i=i0; i<i0+m; i++) {
+                    bool in;
+                    if(fEngine->fIsRestricted_pp){
+                        in = ( fEngine->isInRestricted_LAB(Tn_proj_LAB[i], T_pbar_LAB[i], -eta_LAB[i])||fEngine->isInRestricted_LAB(Tn_proj_LAB[i], T_pbar_LAB[i], eta_LAB[i]) );
+                    }else{
+                        in =   fEngine->isInRestricted_LAB(Tn_proj_LAB[i], T_pbar_LAB[i],  eta_LAB[i]);
+                    }
+                    if (!in) {
+                        for (int k=0; k<K; k++) result[(long)i*K+k] = 0;
+                    }
+                }
+            }
+        }
+    }
+
+
+    double XS_setup::inv_AA_p_CM( double s, double xF, double pT_p ) const{
+
+        double pL_p = xF*sqrt(s)/2.;
+        double E_p  = sqrt( XS_definitions::fMass_proton*XS_definitions::fMass_proton + pL_p*pL_p + pT_p*pT_p );
+
+        if (fParametrization!=ANDERSON) {
+            printf( "Warning in CRXS::XS::inv_AA_p_CM. Parametrization %i is not known.", fParametrization);
+            return 0;
+        }
+        double pp = XS_definitions::inv_pp_p_CM__Anderson(s, E_p, pT_p ) ;
+        double AA = factor__AA( s, xF );
+        return pp * AA;
+    }
+
+
+    double XS_setup::inv_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, double eta_LAB ) const{
+        double s, E_p, pT_p, x_F;
+        XS::convert_LAB_to_CM( Tn_proj_LAB, T_p_LAB, eta_LAB, s, E_p, pT_p, x_F );
+        return inv_AA_p_CM(s, x_F, pT_p);
+    }
+
+
+    //  Integrand of dE_AA_p_LAB__Anderson in the LAB polar angle theta
+    struct setup__Anderson_parameters{
+        const XS_setup* setup;
+        double          s;
+        double          sqrt_s;
+        double          p_LAB;
+        double          E_LAB;
+        double          gamma;
+        double          gammabeta;
+    };
+
+    static double setup__integrand__Anderson( double theta, void* parameters ){
+        setup__Anderson_parameters* par = (setup__Anderson_parameters*) parameters;
+        double cos_theta = cos(theta);
+        double sin_theta = sin(theta);
+        double pL_p      = -par->gammabeta * par->E_LAB + par->gamma * par->p_LAB * cos_theta;
+        // d(tanh(eta)) = sin(theta) d(theta)
+        return sin_theta * par->setup->inv_AA_p_CM( par->s, 2.*pL_p/par->sqrt_s, par->p_LAB*sin_theta );
+    }
+
+    double XS_setup::dE_AA_p_LAB__Anderson( double Tn_proj_LAB, double T_p_LAB, int n_nodes ) const{
+
+        if (fParametrization!=ANDERSON) {
+            printf( "Warning in CRXS::XS_setup::dE_AA_p_LAB__Anderson. Parametrization %i is not known.", fParametrization);
+            return 0;
+        }
+
+        double m = XS_definitions::fMass_proton;
+        setup__Anderson_parameters par;
+        par.setup       = this;
+        par.s           = 4*m*m + 2 * Tn_proj_LAB * m;
+        par.sqrt_s      = sqrt(par.s);
+        par.E_LAB       = T_p_LAB + m;
+        par.p_LAB       = sqrt(  pow( par.E_LAB, 2 ) - pow( m, 2 )  );
+        double E_proj   = Tn_proj_LAB + m;
+        double beta     = sqrt(E_proj - m)/sqrt(E_proj + m);
+        par.gamma       = 1./sqrt(1 - beta*beta);
+        par.gammabeta   = par.gamma * beta;
+        if (!(par.p_LAB>0) || !(par.gammabeta>0)) {
+            return 0;
+        }
+
+        //  Kinematic limit: E_p_CM = gamma*E_LAB - gammabeta*p_LAB*cos(theta) < sqrt(s)/2
+        double cos_min  = ( par.gamma*par.E_LAB - par.sqrt_s/2. )/( par.gammabeta*par.p_LAB );
+        if (cos_min>=1) {
+            return 0;
+        }
+        double theta_max = cos_min>0 ? acos(cos_min) : M_PI/2.;
+        //  Exponential suppression: exp(-pT/0.166) < exp(-40)
+        double sin_max   = 40*0.166/par.p_LAB;
+        if (sin_max<1) {
+            theta_max = fmin( theta_max, asin(sin_max) );
+        }
+
+        //  Nodes of the overlap function in theta, x_F is linear in cos(theta)
+        double limits[XS_definitions::pbar_overlap_function__n+2];
+        int    n_limits = 0;
+        limits[n_limits++] = 0;
+        if (!fAA_is_pp && !fAA_is_diMauro) {
+            double cos_max_theta = cos(theta_max);
+            for (int i=XS_definitions::pbar_overlap_function__n-1; i>=0; i--) {
+                double cos_theta = ( XS_definitions::pbar_overlap_function__xF[i]*par.sqrt_s/2. + par.gammabeta*par.E_LAB )/( par.gamma*par.p_LAB );
+                if (cos_theta<1 && cos_theta>cos_max_theta) {
+                    limits[n_limits++] = acos(cos_theta);
+                }
+            }
+        }
+        limits[n_limits++] = theta_max;
+
+        double res = 0;
+        for (int i=0; i<n_limits-1; i++) {
+            res += Integration::integrate_gauss_legendre( &setup__integrand__Anderson, limits[i], limits[i+1], &par, n_nodes );
+        }
+        // phi integration (2 pi), inv to d3p (1/E_p_LAB), Jacobian(p_p_Lab*p_p_Lab), dp to dE (E_p_LAB/p_p_Lab)
+        return res * 2*3.1415926536*par.p_LAB;
+    }
+
+}
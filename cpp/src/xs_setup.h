@@ -0,0 +1,185 @@
+#ifndef CRXS__XS_SETUP_H
+#define CRXS__XS_SETUP_H
+
+#include "xs.h"
+
+namespace CRXS {
+
+    struct XS_coalescence__levels;
+
+    //! Function type of the invariant pp cross section parametrizations in XS_definitions (e.g. inv_pp_pbar_CM__Winkler)
+    typedef double (*inv_pp_kernel)( double s, double E, double pT, double* C_array, int len_C_array );
+    //! Function type of the vectorized pp parametrizations in XS_definitions (e.g. batch__inv_pp_pbar_CM__Winkler)
+    typedef void   (*inv_pp_batch_kernel)( int n, const double* s, const double* E, const double* pT, double* result, double* C_array );
+    //! Function type of the pp parametrizations for several parameter sets in XS_definitions (e.g. ensemble__inv_pp_pbar_CM__Winkler)
+    typedef void   (*inv_pp_ensemble_kernel)( int n, const double* s, const double* E, const double* pT, double* result, int K, const double* C_sets );
+
+    //! Configuration of a cross section evaluation with all parameter lookups resolved.
+    /*!
+     *  The constructor resolves the parametrization dispatch, the parameter arrays (XS_definitions::Get_C_parameters,
+     *  XS_definitions::Get_D_parameters, XS_definitions::Get_C_parameters_isospin) and the energy-independent parts of
+     *  the nuclear scaling factor (XS_definitions::factor__AA) for one projectile-target pair. The member functions then
+     *  evaluate the invariant cross sections point by point without repeating these steps.
+     *
+     *  The scalar functions in XS construct a temporary XS_setup, the batch functions in XS construct one per batch.
+     *  The SELF parameters and the restricted parameter space are taken from the engine which is current in the
+     *  constructing thread (XS_engine::Current()).
+     */
+    class XS_setup{
+
+    public:
+
+        //! Constructor
+        /*!
+         *  \param int    A_projectile     Mass number of the projectile, if A_projectile is negative we use an antiproton as projectile (antinuclei only)
+         *  \param int    N_projectile     Number of neutrons in the projectile
+         *  \param int    A_target         Mass number of the target
+         *  \param int    N_target         Number of neutrons in the target
+         *  \param int    parametrization  Cross section parametrization, enum from[KORSMEIER_II (default), KORSMEIER_I, WINKLER, DI_MAURO_I, DI_MAURO_II, WINKLER_SELF, DI_MAURO_SELF, ANDERSON]
+         *  \param int    coalescence      Coalescence model, enum from[FIXED_P0, ENERGY_DEP__VAN_DOETINCHEM, PT_DEP] (antinuclei only)
+         *  \param double p0_val           Coalescence momentum in GeV (antinuclei only)
+         */
+        XS_setup( int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence=FIXED_P0, double p0_val=0.160 );
+
+        /// Same as XS::inv_AA_pbar_CM, but for the configuration of this object.
+        double inv_AA_pbar_CM  ( double s, double xF, double pT_pbar ) const;
+        /// Same as XS::inv_AA_pbar_LAB, but for the configuration of this object.
+        double inv_AA_pbar_LAB ( double Tn_proj_LAB, double T_pbar_LAB, double eta_LAB ) const;
+
+        /// Same as XS::batch__inv_AA_pbar_CM, but for the configuration of this object. Uses the vectorized pp kernel.
+        void   inv_AA_pbar_CM  ( int n, const double* s, const double* xF, const double* pT_pbar, double* result ) const;
+        /// Same as XS::batch__inv_AA_pbar_LAB, but for the configuration of this object. Uses the vectorized pp kernel.
+        void   inv_AA_pbar_LAB ( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result ) const;
+
+        /// Same as XS::ensemble__inv_AA_pbar_CM, but for the configuration of this object. Null parameter arrays are resolved as described there.
+        void   inv_AA_pbar_CM  ( int n, const double* s, const double* xF, const double* pT_pbar, double* result, int K, const double* C_sets, const double* D_sets, const double* C_isospin_sets ) const;
+        /// Same as XS::ensemble__inv_AA_pbar_LAB, but for the configuration of this object.
+        void   inv_AA_pbar_LAB ( int n, const double* Tn_proj_LAB, const double* T_pbar_LAB, const double* eta_LAB, double* result, int K, const double* C_sets, const double* D_sets, const double* C_isospin_sets ) const;
+
+        /// Same as XS::inv_AA_p_CM, but for the configuration of this object.
+        double inv_AA_p_CM     ( double s, double xF, double pT_p ) const;
+        /// Same as XS::inv_AA_p_LAB, but for the configuration of this object.
+        double inv_AA_p_LAB    ( double Tn_proj_LAB, double T_p_LAB, double eta_LAB ) const;
+
+        //! Same as XS::dE_AA_p_LAB for the ANDERSON parametrization, but for the configuration of this object.
+        /*!
+         *  The angular integral is evaluated in the polar angle theta of the proton in the LAB frame (tanh(eta_LAB)=cos(theta)),
+         *  where the Anderson cross section is proportional to sin(theta)^2 * exp(-p_LAB*sin(theta)/0.166 GeV) times a linear
+         *  function of cos(theta). The integration range is restricted analytically to the kinematically allowed region
+         *  (E_p_CM < sqrt(s)/2) and to p_LAB*sin(theta) < 40*0.166 GeV, where the integrand has decayed by exp(-40). The range
+         *  is split at the nodes of the overlap function (XS_definitions::pbar_overlap_function_projectile), such that the
+         *  integrand is smooth in each interval, and each interval is integrated with a fixed Gauss-Legendre rule.
+         *
+         *  \param double Tn_proj_LAB      Kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param double T_p_LAB          Kinetic energy of the proton (in the LAB frame)
+         *  \param int    n_nodes          Number of Gauss-Legendre nodes per interval
+         *
+         *  \return double XS              Cross section in mbarn/GeV, 0 (with a warning) for other parametrizations than ANDERSON
+         */
+        double dE_AA_p_LAB__Anderson( double Tn_proj_LAB, double T_p_LAB, int n_nodes=24 ) const;
+
+        /// Same as XS::inv_AA_Dbar_CM, but for the configuration of this object.
+        double inv_AA_Dbar_CM  ( double s, double xF_Dbar, double pT_Dbar ) const;
+        /// Same as XS::inv_AA_Dbar_LAB, but for the configuration of this object.
+        double inv_AA_Dbar_LAB ( double Tn_proj_LAB, double Tn_Dbar_LAB, double eta_LAB ) const;
+
+        /// Same as XS::inv_AA_He3bar_CM, but for the configuration of this object.
+        double inv_AA_He3bar_CM ( double s, double xF_Hebar, double pT_Hebar ) const;
+        /// Same as XS::inv_AA_He3bar_LAB, but for the configuration of this object.
+        double inv_AA_He3bar_LAB( double Tn_proj_LAB, double Tn_Hebar_LAB, double eta_LAB ) const;
+
+        /// Same as XS::inv_AA_He4bar_CM, but for the configuration of this object.
+        double inv_AA_He4bar_CM ( double s, double xF_Hebar, double pT_Hebar ) const;
+        /// Same as XS::inv_AA_He4bar_LAB, but for the configuration of this object.
+        double inv_AA_He4bar_LAB( double Tn_proj_LAB, double Tn_Hebar_LAB, double eta_LAB ) const;
+
+        //! Invariant production cross section of the antinucleus with A nucleons in the coalescence model (A=2: XS::inv_AA_Dbar_CM, 3: XS::inv_AA_He3bar_CM, 4: XS::inv_AA_He4bar_CM).
+        /*!
+         *  The chain of reduced CM energies is computed once, and the pp cross sections of all its levels are evaluated in
+         *  one call of the vectorized kernel. The antinucleus is described by XS_coalescence<A> (xs_coalescence.h, which
+         *  has to be included for this function).
+         */
+        template<int A> double inv_AA_coalescence_CM( double s, double xF, double pT ) const;
+        /// Same as XS::inv_AA_antinuclei_CM, but for the configuration of this object.
+        void   inv_AA_antinuclei_CM( double s, double xF_nucleon, double pT_nucleon, double* Dbar, double* He3bar, double* He4bar ) const;
+
+        //! Nuclear scaling factor, identical to XS_definitions::factor__AA for the configuration of this object.
+        /*!
+         *  \param double s         CM energy, squared.
+         *  \param doulbe xF        Feynman scaling (2*pL/sqrt(s) in CMF)
+         *  \return double factor   Scaling factor
+         */
+        double factor__AA( double s, double xF ) const;
+
+        /// Coalescence momentum in GeV of the configured coalescence model, -1 if the model is not known.
+        double p_coalescence( double s, double pToverA ) const;
+
+        int     fSigned_A_projectile;
+        int     fA_projectile;
+        int     fN_projectile;
+        int     fA_target;
+        int     fN_target;
+        int     fParametrization;
+        int     fCoalescence;
+        double  fP0;
+
+        /// True if fCoalescence is one of the known coalescence models
+        bool    fCoalescence_known;
+        /// Rescaling of the total XS in the coalescence formula, pow(A_target*A_projectile, (nucleons-1)*(D1+D2)), index: nucleons
+        double  fNorm_coalescence[5];
+
+        /// Functional form of the pp cross section, enum from [PP_KERNEL__NONE, PP_KERNEL__WINKLER, PP_KERNEL__DI_MAURO, PP_KERNEL__ANDERSON], cf. XS_parametrization
+        int     fKernel;
+        /// Exponent of (10-sqrt(s)) in the Winkler factor R, 0 if it is taken from fC_array[0], cf. XS_parametrization
+        int     fC0;
+        //  Runtime dispatch of the pp kernel. Only the angular integrands of XS_energy_context are instantiated per kernel
+        //  (xs_context.h). The point-wise functions of this class, the batch and ensemble functions (one call per chunk of
+        //  points) and the coalescence engine (one call per chain of CM energies) call the kernels through these pointers.
+        //  The proton cross section has a single kernel (XS_definitions::inv_pp_p_CM__Anderson), which is called directly.
+
+        /// pp kernel for antiproton production, 0 if the parametrization is not available for antiprotons
+        inv_pp_kernel fKernel_pbar;
+        /// pp kernel for antinuclei production (coalescence), 0 if the parametrization is not available for antinuclei
+        inv_pp_kernel fKernel_coalescence;
+        /// Vectorized version of fKernel_pbar
+        inv_pp_batch_kernel fBatchKernel_pbar;
+        /// Version of fKernel_pbar for several parameter sets
+        inv_pp_ensemble_kernel fEnsembleKernel_pbar;
+        /// Number of parameters of fKernel_pbar (length of C_array), 17 (Winkler) or 12 (di Mauro), 0 without kernel
+        int     fN_C;
+
+        double* fC_array;
+        double* fC_array_isospin;
+        double* fD_array;
+
+        /// Engine of the thread which constructed this object (XS_engine::Current()), provides the restricted parameter space and the integration settings
+        const XS_engine* fEngine;
+
+    private:
+
+        friend class XS_energy_context;
+
+        //  Coalescence engine (xs_coalescence.cxx): single-nucleon cross sections at the n CM energies s, and the
+        //  coalescence cross section of an antinucleus with A nucleons (Z antiprotons) from the levels level[0..A-1]
+        void    coalescence__levels ( int n, const double* s, double E_pbar, double pT_nucleon, double xF_nucleon, XS_coalescence__levels& levels ) const;
+        double  coalescence__combine( int A, int Z, double mass, const XS_coalescence__levels& levels, const int* level ) const;
+
+        // energy-independent parts of factor__AA
+        bool    fAA_is_pp;
+        bool    fAA_is_diMauro;
+        bool    fAA_isospin;
+        double  fAA_norm;
+        double  fAA_proj;
+        double  fAA_targ;
+
+    };
+
+    /// Parameters of the angular integrands XS::integrand__dE_AA_pbar_LAB, XS::integrand__dE_AA_p_LAB, XS::integrand__dE_AA_Dbar_LAB, XS::integrand__dE_AA_He3bar_LAB, and XS::integrand__dE_AA_He4bar_LAB
+    struct XS_setup__integrand_parameters{
+        const XS_setup*     setup;
+        double              Tn_proj_LAB;
+        double              T_LAB;          // kinetic energy of the product (per nucleon for antinuclei)
+    };
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "math.h"
+#include "vector"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_simd.h"
+#include "crxs.h"
+
+namespace CRXS {
+
+
+    //
+    //  Runtime dispatch of the vectorized pp kernels (see xs_simd.h and xs_simd_kernels.h).
+    //
+
+    static int simd__detect(){
+#ifdef CRXS_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))                                  return SIMD_AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))    return SIMD_AVX2;
+        if (__builtin_cpu_supports("sse2"))                                     return SIMD_SSE2;
+#endif
+        return SIMD_NONE;
+    }
+
+    int CRXS_config::Get_SIMD(){
+        static const int supported = simd__detect();
+        int requested = XS_engine::Current().fSIMD;
+        if (requested==SIMD_AUTO || requested>supported) {
+            return supported;
+        }
+        return requested;
+    }
+
+
+    void XS_definitions::batch__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* C_array ){
+        switch (CRXS_config::Get_SIMD()) {
+#ifdef CRXS_SIMD_X86
+            case SIMD_AVX512:
+                SIMD_AVX512_kernels::inv_pp_pbar_CM__Winkler( n, s, E_pbar, pT_pbar, result, C_array, fMass_proton );
+                return;
+            case SIMD_AVX2:
+                SIMD_AVX2_kernels  ::inv_pp_pbar_CM__Winkler( n, s, E_pbar, pT_pbar, result, C_array, fMass_proton );
+                return;
+            case SIMD_SSE2:
+                SIMD_SSE2_kernels  ::inv_pp_pbar_CM__Winkler( n, s, E_pbar, pT_pbar, result, C_array, fMass_proton );
+                return;
+#endif
+            default:
+                for (int i=0; i<n; i++) {
+                    result[i] = inv_pp_pbar_CM__Winkler( s[i], E_pbar[i], pT_pbar[i], C_array );
+                }
+        }
+    }
+
+
+    void XS_definitions::batch__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, double* C_array ){
+        switch (CRXS_config::Get_SIMD()) {
+#ifdef CRXS_SIMD_X86
+            case SIMD_AVX512:
+                SIMD_AVX512_kernels::inv_pp_pbar_CM__diMauro( n, s, E_pbar, pT_pbar, result, C_array, fMass_proton );
+                return;
+            case SIMD_AVX2:
+                SIMD_AVX2_kernels  ::inv_pp_pbar_CM__diMauro( n, s, E_pbar, pT_pbar, result, C_array, fMass_proton );
+                return;
+            case SIMD_SSE2:
+                SIMD_SSE2_kernels  ::inv_pp_pbar_CM__diMauro( n, s, E_pbar, pT_pbar, result, C_array, fMass_proton );
+                return;
+#endif
+            default:
+                for (int i=0; i<n; i++) {
+                    result[i] = inv_pp_pbar_CM__diMauro( s[i], E_pbar[i], pT_pbar[i], C_array );
+                }
+        }
+    }
+
+#ifdef CRXS_SIMD_X86
+    //  Parameters of the K sets transposed and padded with copies of the last set (cf. xs_simd.h), returns the leading dimension
+    static int simd__transpose( int K, int n_C, const double* C_sets, std::vector<double>& C_T ){
+        int ld = ( K+SIMD__ensemble_padding-1 )/SIMD__ensemble_padding*SIMD__ensemble_padding;
+        C_T.resize( (size_t)n_C*ld );
+        for (int c=0; c<n_C; c++) {
+            for (int k=0; k<ld; k++) {
+                C_T[(size_t)c*ld+k] = C_sets[(size_t)( k<K ? k : K-1 )*n_C+c];
+            }
+        }
+        return ld;
+    }
+#endif
+
+
+    void XS_definitions::ensemble__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_sets ){
+        if (K<=0) {
+            return;
+        }
+#ifdef CRXS_SIMD_X86
+        int simd = CRXS_config::Get_SIMD();
+        if (simd!=SIMD_NONE) {
+            std::vector<double> C_T;
+            int ld = simd__transpose( K, 17, C_sets, C_T );
+            if      (simd==SIMD_AVX512) SIMD_AVX512_kernels::ensemble__inv_pp_pbar_CM__Winkler( n, s, E_pbar, pT_pbar, result, K, C_T.data(), ld, fMass_proton );
+            else if (simd==SIMD_AVX2  ) SIMD_AVX2_kernels  ::ensemble__inv_pp_pbar_CM__Winkler( n, s, E_pbar, pT_pbar, result, K, C_T.data(), ld, fMass_proton );
+            else                        SIMD_SSE2_kernels  ::ensemble__inv_pp_pbar_CM__Winkler( n, s, E_pbar, pT_pbar, result, K, C_T.data(), ld, fMass_proton );
+            return;
+        }
+#endif
+        for (int i=0; i<n; i++) {
+            for (int k=0; k<K; k++) {
+                result[(long)i*K+k] = inv_pp_pbar_CM__Winkler( s[i], E_pbar[i], pT_pbar[i], const_cast<double*>( C_sets+17*k ) );
+            }
+        }
+    }
+
+
+    void XS_definitions::ensemble__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_sets ){
+        if (K<=0) {
+            return;
+        }
+#ifdef CRXS_SIMD_X86
+        int simd = CRXS_config::Get_SIMD();
+        if (simd!=SIMD_NONE) {
+            std::vector<double> C_T;
+            int ld = simd__transpose( K, 12, C_sets, C_T );
+            if      (simd==SIMD_AVX512) SIMD_AVX512_kernels::ensemble__inv_pp_pbar_CM__diMauro( n, s, E_pbar, pT_pbar, result, K, C_T.data(), ld, fMass_proton );
+            else if (simd==SIMD_AVX2  ) SIMD_AVX2_kernels  ::ensemble__inv_pp_pbar_CM__diMauro( n, s, E_pbar, pT_pbar, result, K, C_T.data(), ld, fMass_proton );
+            else                        SIMD_SSE2_kernels  ::ensemble__inv_pp_pbar_CM__diMauro( n, s, E_pbar, pT_pbar, result, K, C_T.data(), ld, fMass_proton );
+            return;
+        }
+#endif
+        for (int i=0; i<n; i++) {
+            for (int k=0; k<K; k++) {
+                result[(long)i*K+k] = inv_pp_pbar_CM__diMauro( s[i], E_pbar[i], pT_pbar[i], const_cast<double*>( C_sets+12*k ) );
+            }
+        }
+    }
+
+}
@@ -0,0 +1,47 @@
+#ifndef CRXS__XS_SIMD_H
+#define CRXS__XS_SIMD_H
+
+//
+//  Internal header (not installed): entry points of the vectorized pp kernels.
+//
+//  Each instruction set has its own translation unit (xs_simd_sse2.cxx, xs_simd_avx2.cxx, xs_simd_avx512.cxx), compiled
+//  with the corresponding compiler flags, and the runtime dispatch in xs_simd.cxx selects one of them. The kernels are
+//  called by XS_definitions::batch__inv_pp_pbar_CM__Winkler, XS_definitions::batch__inv_pp_pbar_CM__diMauro,
+//  XS_interpolation::Interpolate (batch version, dispatch in xs_interpolation.cxx), and XS::batch__dE_pp_gamma_LAB
+//  (dispatch in xs_gamma.cxx).
+//
+//  The instruction set translation units must not include any other header of CRXS or the standard library: inline
+//  functions instantiated there would be compiled with e.g. AVX-512 instructions and could be picked by the linker for
+//  the whole library.
+//
+
+//  The ensemble kernels are vectorized across K parameter sets instead of the points. They take the parameters transposed,
+//  C_T[c*ld_C_T+k] is parameter c of set k, where ld_C_T>=K is a multiple of SIMD__ensemble_padding (the padding lanes
+//  are evaluated but not stored). The result is stored point by point, result[i*K+k].
+//
+
+//  CRXS_SIMD_X86 is set by cmake if the instruction set translation units are compiled with their flags.
+//  Otherwise they are empty and only the scalar code is used.
+
+namespace CRXS {
+
+    /// Lanes of the widest instruction set, the transposed parameters of the ensemble kernels are padded to a multiple of it
+    static const int SIMD__ensemble_padding = 8;
+
+#define CRXS_SIMD_DECLARE_KERNELS                                                                                                            \
+    void inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, const double* C_array, double m_p ); \
+    void inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, const double* C_array, double m_p ); \
+    void interpolate_loglog     ( int n, const double* x, double* result, int n_nodes, int uniform, double log_x_min, double inv_dlog_x, const double* log_x, const double* coefficients ); \
+    void ensemble__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_T, int ld_C_T, double m_p ); \
+    void ensemble__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_T, int ld_C_T, double m_p ); \
+    void pp_gamma__F            ( int n, const double* E_gamma, double* result, double A_max, double E_gamma_max, double Y_gamma_max, double alpha, double beta, double gamma, double C, double m_pi );
+
+    namespace SIMD_SSE2_kernels   { CRXS_SIMD_DECLARE_KERNELS }
+    namespace SIMD_AVX2_kernels   { CRXS_SIMD_DECLARE_KERNELS }
+    namespace SIMD_AVX512_kernels { CRXS_SIMD_DECLARE_KERNELS }
+
+#undef CRXS_SIMD_DECLARE_KERNELS
+
+}
+
+#endif
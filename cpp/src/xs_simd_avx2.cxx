@@ -0,0 +1,12 @@
+//
+//  Vectorized pp kernels for AVX2 and FMA (-mavx2 -mfma), see xs_simd_kernels.h.
+//  Do not include other headers here, see xs_simd.h.
+//
+
+#ifdef CRXS_SIMD_X86
+
+#define CRXS_SIMD_NAMESPACE SIMD_AVX2_kernels
+#define CRXS_SIMD_BYTES     32
+#include "xs_simd_kernels.h"
+
+#endif
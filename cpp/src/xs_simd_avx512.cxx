@@ -0,0 +1,12 @@
+//
+//  Vectorized pp kernels for AVX-512F (-mavx512f), see xs_simd_kernels.h.
+//  Do not include other headers here, see xs_simd.h.
+//
+
+#ifdef CRXS_SIMD_X86
+
+#define CRXS_SIMD_NAMESPACE SIMD_AVX512_kernels
+#define CRXS_SIMD_BYTES     64
+#include "xs_simd_kernels.h"
+
+#endif
@@ -0,0 +1,512 @@
+//
+//  Internal header (not installed): vectorized Winkler and di Mauro pp kernels (across points and across parameter sets),
+//  the log-log interpolation of tables, and the pp -> gamma spectrum.
+//
+//  This file is included by xs_simd_sse2.cxx, xs_simd_avx2.cxx and xs_simd_avx512.cxx, which define
+//
+//      CRXS_SIMD_NAMESPACE     namespace of the kernels, see xs_simd.h
+//      CRXS_SIMD_BYTES         vector width in bytes (16, 32, 64)
+//
+//  The code uses the vector extensions of gcc and clang, the compiler flags of the including file select the instructions.
+//  The functions follow XS_definitions::inv_pp_pbar_CM__Winkler and XS_definitions::inv_pp_pbar_CM__diMauro line by line,
+//  but the kinematic cutoffs are applied as masks after all lanes are evaluated (invalid lanes may contain NaN before).
+//
+//  exp and log are vectorized versions of the Cephes library routines (S. L. Moshier), max. 1 ulp on their own. pow(a,b)
+//  is evaluated as exp(b*log(a)) which loses |b*log(a)| ulp, and products of powers and exponentials are merged into a
+//  single exp. Results below the smallest normal double (2.2e-308) are flushed to 0. See XS_definitions.h for the tolerance
+//  with respect to the scalar functions.
+//
+
+#if !defined(CRXS_SIMD_NAMESPACE) || !defined(CRXS_SIMD_BYTES)
+#error "xs_simd_kernels.h: define CRXS_SIMD_NAMESPACE and CRXS_SIMD_BYTES before including this file."
+#endif
+
+#include "immintrin.h"
+
+#include "xs_simd.h"
+
+#define CRXS_SIMD_INLINE static inline __attribute__((always_inline))
+
+namespace CRXS {
+    namespace CRXS_SIMD_NAMESPACE {
+
+        typedef double    vd __attribute__(( vector_size(CRXS_SIMD_BYTES) ));
+        typedef long long vi __attribute__(( vector_size(CRXS_SIMD_BYTES) ));
+
+        static const int W = CRXS_SIMD_BYTES/8;
+
+
+        //  ------------------------------------------------------------- #
+        //   Basic operations                                             #
+        //  ------------------------------------------------------------- #
+
+        CRXS_SIMD_INLINE vd   set   ( double x       ){ vd r; for (int k=0; k<W; k++) r[k]=x; return r;               }
+        CRXS_SIMD_INLINE vi   set_i ( long long x    ){ vi r; for (int k=0; k<W; k++) r[k]=x; return r;               }
+        CRXS_SIMD_INLINE vd   load  ( const double* p){ vd r; __builtin_memcpy( &r, p, sizeof(vd) ); return r;        }
+        CRXS_SIMD_INLINE void store ( double* p, vd x){ __builtin_memcpy( p, &x, sizeof(vd) );                         }
+
+        //  m ? a : b, lane by lane (m is the result of a comparison: all bits set or 0)
+        CRXS_SIMD_INLINE vd   select( vi m, vd a, vd b ){ return (vd)( ( m & (vi)a ) | ( ~m & (vi)b ) );              }
+        CRXS_SIMD_INLINE vd   vabs  ( vd x           ){ return (vd)( (vi)x & set_i( 0x7FFFFFFFFFFFFFFFLL ) );         }
+
+        CRXS_SIMD_INLINE vd   vsqrt ( vd x ){
+#if   CRXS_SIMD_BYTES==16
+            return (vd)_mm_sqrt_pd   ( (__m128d)x );
+#elif CRXS_SIMD_BYTES==32
+            return (vd)_mm256_sqrt_pd( (__m256d)x );
+#else
+            return (vd)_mm512_mask_sqrt_pd( (__m512d)x, (__mmask8)0xFF, (__m512d)x ); // _mm512_sqrt_pd triggers -Wmaybe-uninitialized in gcc 12
+#endif
+        }
+
+
+        //  a*b+c, fused with FMA instructions. For expressions which must be evaluated identically in different kernels: the
+        //  compiler contracts a*b+c to an FMA depending on the context.
+        CRXS_SIMD_INLINE vd vfma( vd a, vd b, vd c ){
+#if   CRXS_SIMD_BYTES==16
+            return a*b+c;
+#elif CRXS_SIMD_BYTES==32
+            return (vd)_mm256_fmadd_pd( (__m256d)a, (__m256d)b, (__m256d)c );
+#else
+            return (vd)_mm512_fmadd_pd( (__m512d)a, (__m512d)b, (__m512d)c );
+#endif
+        }
+
+
+        //  ------------------------------------------------------------- #
+        //   exp and log                                                  #
+        //  ------------------------------------------------------------- #
+
+        //  1.5*2^52: x+MAGIC-MAGIC rounds x to an integer and the lower bits of x+MAGIC contain this integer
+        static const double    MAGIC      = 6755399441055744.0;
+        static const long long MAGIC_BITS = 0x4338000000000000LL;
+
+        //  2^k for integer valued k in [-1022, 1023]
+        CRXS_SIMD_INLINE vd pow2i( vd k ){
+            vi bits = (vi)( k + set(MAGIC) ) - set_i( MAGIC_BITS - 1023 );
+            return (vd)( bits << 52 );
+        }
+
+        CRXS_SIMD_INLINE vd vexp( vd x ){
+            const vd x_min = set( -745.2 );
+            const vd x_max = set(  709.78 );
+            vd xc = select( x < x_min, x_min, select( x > x_max, x_max, x ) );
+
+            //  exp(x) = 2^n exp(r),  |r| < ln(2)/2
+            vd n  = ( xc*1.4426950408889634073599 + MAGIC ) - MAGIC;
+            vd r  = xc - n*6.93145751953125E-1;
+            r     = r  - n*1.42860682030941723212E-6;
+
+            vd rr = r*r;
+            vd px = r * ( ( 1.26177193074810590878E-4*rr + 3.02994407707441961300E-2 )*rr + 9.99999999999999999910E-1 );
+            vd qx =     ( ( 3.00198505138664455042E-6*rr + 2.52448340349684104192E-3 )*rr + 2.27265548208155028766E-1 )*rr + 2.00000000000000000009E0;
+            vd e  = 1. + 2.*( px/( qx-px ) );
+
+            //  2^n in two factors to cover subnormal and large results
+            vd n1 = ( n*0.5 + MAGIC ) - MAGIC;
+            e     = e * pow2i( n1 ) * pow2i( n-n1 );
+
+            e = select( x < x_min, set(0.),           e );
+            e = select( x > x_max, set(__builtin_inf()), e );
+            return select( x != x, x, e );
+        }
+
+        CRXS_SIMD_INLINE vd vlog( vd x ){
+            vi bits = (vi)x;
+
+            //  x = m 2^e,  m in [0.5, 1)
+            vd e  = (vd)( ( ( bits >> 52 ) & set_i( 0x7FF ) ) | set_i( 0x4330000000000000LL ) ) - 4503599627370496.0 - 1022.;
+            vd m  = (vd)( ( bits & set_i( 0x000FFFFFFFFFFFFFLL ) ) | set_i( 0x3FE0000000000000LL ) );
+
+            vi small = m < 0.70710678118654752440;
+            e     = select( small, e-1.,    e     );
+            m     = select( small, m+m-1.,  m-1.  );
+
+            vd z  = m*m;
+            vd p  = ( ( ( ( 1.01875663804580931796E-4*m + 4.97494994976747001425E-1 )*m + 4.70579119878881725854E0 )*m + 1.44989225341610930846E1 )*m + 1.79368678507819816313E1 )*m + 7.70838733755885391666E0;
+            vd q  = ( ( ( (                            m + 1.12873587189167450590E1 )*m + 4.52279145837532221105E1 )*m + 8.29875266912776603211E1 )*m + 7.11544750618563894466E1 )*m + 2.31251620126765340583E1;
+            vd y  = m*( z*p/q );
+            y     = y - e*2.121944400546905827679e-4;
+            y     = y - 0.5*z;
+            vd l  = m + y + e*0.693359375;
+
+            //  special values (subnormal x is not treated)
+            l = select( x == 0.,                 set(-__builtin_inf()), l );
+            l = select( x == __builtin_inf(),    x,                     l );
+            return select( ( x < 0. ) | ( x != x ), set(__builtin_nan("")), l );
+        }
+
+        //  pow(a, b) for a>=0
+        CRXS_SIMD_INLINE vd vpow( vd a, vd b ){
+            return vexp( b*vlog(a) );
+        }
+
+
+        //  ------------------------------------------------------------- #
+        //   Kernels                                                      #
+        //  ------------------------------------------------------------- #
+
+        //  Momentum squared E^2-m^2 as a product: with -mfma the compiler contracts E*E-m*m to fma(E,E,-m*m), which is not 0
+        //  for E=m (pT=0, xF=0) and removes these points with the kinematic mask.
+        CRXS_SIMD_INLINE vd p2( vd E, double m ){
+            return (E-m)*(E+m);
+        }
+
+        //  Exponent -1./X/C7 of pow( 1+X*(m_T-m_p), -1./X/C7 ), 0 for X=0 (sqrt(s)=4 m_p): the power is 1 as pow(1, -inf) in
+        //  the scalar function, and not NaN as -inf*log(1)
+        CRXS_SIMD_INLINE vd Winkler_exponent_mT( vd X, vd C7 ){
+            return select( X==0., set(0.), -1./X/C7 );
+        }
+
+        CRXS_SIMD_INLINE vd Winkler( vd s, vd E_pbar_d, vd pT_pbar, const double* C_array, double m_p ){
+
+            double C0  = C_array[ 0];
+            double C5  = C_array[ 5];
+            double C6  = C_array[ 6];
+            double C7  = C_array[ 7];
+            double C8  = C_array[ 8];
+            double C9  = C_array[ 9];
+            double C10 = C_array[10];
+            double C11 = C_array[11];
+            double C12 = C_array[12];
+            double C13 = C_array[13];
+
+            vd E_pbar     = vabs( E_pbar_d );
+            vi valid      = ~( s < 16*m_p*m_p ) & ~( pT_pbar*pT_pbar > p2( E_pbar, m_p ) );
+
+            vd sqrt_s     = vsqrt( s );
+            vd E_pbar_Max = ( s-8.*m_p*m_p )/2./sqrt_s;
+            vd x_R        = E_pbar/E_pbar_Max;
+            valid        &= ~( x_R > 1. );
+
+            vd m_T        = vsqrt( vfma( pT_pbar, pT_pbar, set(m_p*m_p) ) );
+
+            //  R = (1 +C9*(10-sqrt(s))^5) * exp( C10*(10-sqrt(s))^C0*(x_R-m_p/E_pbar_Max)^2 ),  R=1 for sqrt(s)>=10
+            vi below_10   = sqrt_s < 10.;
+            vd d          = 10.-sqrt_s;
+            vd d_C0       = ( C0==1 ? d : ( C0==2 ? d*d : vpow( d, set(C0) ) ) );
+            vd y          = x_R-m_p/E_pbar_Max;
+            vd R_prefac   = select( below_10, 1 +C9*(d*d*d*d*d), set(1.) );
+            vd R_exponent = select( below_10, C10*d_C0*(y*y),    set(0.) );
+
+            vd log_sqrt_s = vlog( sqrt_s );
+            vd sigma_in   = C11 +C12*log_sqrt_s + C13*(log_sqrt_s*log_sqrt_s);
+            vd log_X      = vlog( sqrt_s/4./m_p );
+            vd X          = C8 * (log_X*log_X);
+
+            //  R * sigma_in * C5 * pow(1-x_R, C6) * pow( 1+X*(m_T-m_p), -1./X/C7 )
+            vd exponent   = R_exponent + C6*vlog( 1-x_R ) + Winkler_exponent_mT( X, set(C7) )*vlog( 1+X*(m_T-m_p) );
+            vd f0_p       = R_prefac * sigma_in * C5 * vexp( exponent );
+
+            return select( valid, f0_p, set(0.) );
+        }
+
+
+        //  sigma = Z + B*log(s/sM)^2 + Y1*(sM/s)^n1 - Y2*(sM/s)^n2, see XS_definitions::tot_pp__diMauro and XS_definitions::el_pp__diMauro
+        CRXS_SIMD_INLINE vd diMauro_pp( vd s, double Z, double Y1, double Y2, double n1, double n2, double M, double m_p ){
+            double hbar2 = 0.38937966; // GeV^2 mbarn (PDG)
+            double B     = 3.14159265358979323846 * hbar2/M/M;
+            double sM    = (2*m_p+M)*(2*m_p+M);
+            vd log_sM_s  = vlog( sM/s );
+            return Z + B*(log_sM_s*log_sM_s) + Y1*vexp( n1*log_sM_s ) - Y2*vexp( n2*log_sM_s );
+        }
+
+        CRXS_SIMD_INLINE vd diMauro( vd s, vd E_pbar, vd pT_pbar, const double* C_array, double m_p ){
+
+            double C1  = C_array[ 1];
+            double C2  = C_array[ 2];
+            double C3  = C_array[ 3];
+            double C4  = C_array[ 4];
+            double C5  = C_array[ 5];
+            double C6  = C_array[ 6];
+            double C7  = C_array[ 7];
+            double C8  = C_array[ 8];
+            double C9  = C_array[ 9];
+            double C10 = C_array[10];
+            double C11 = C_array[11];
+
+            vi valid      = ~( s < 16*m_p*m_p ) & ~( (pT_pbar*0.9)*(pT_pbar*0.9) > p2( E_pbar, m_p ) );
+
+            vd E_pbar_Max = ( s-8.*m_p*m_p )/2./vsqrt( s );
+            vd x_R        = E_pbar/E_pbar_Max;
+            valid        &= ~( x_R > 1. );
+
+            vd sigma_in   =   diMauro_pp( s,  33.44, 13.53,   6.38, 0.324,  0.324,    2.06, m_p )
+                            - diMauro_pp( s, 144.98,  2.64, 137.27, 1.57,  -4.65e-3, 3.06, m_p );
+
+            vd log_s      = vlog( s );
+            vd pT2        = pT_pbar*pT_pbar;
+            vd sum        = C3 * vexp( C4 /2.*log_s - C5 *pT_pbar     ) +
+                            C6 * vexp( C7 /2.*log_s - C8 *pT2         ) +
+                            C9 * vexp( C10/2.*log_s - C11*pT2*pT_pbar );
+
+            //  pow(1 - x_R, C1) * exp(-C2 * x_R)
+            vd invCsCM    = sigma_in * vexp( C1*vlog( 1-x_R ) - C2*x_R ) * vabs( sum );
+
+            return select( valid, invCsCM, set(0.) );
+        }
+
+
+        //  ------------------------------------------------------------- #
+        //   Loops over the arrays                                        #
+        //  ------------------------------------------------------------- #
+
+        //  The last n%W points are copied to a padded buffer (padding with s=0, which is masked).
+#define CRXS_SIMD_LOOP( KERNEL )                                                                                        \
+        int i = 0;                                                                                                      \
+        for (; i+W<=n; i+=W) {                                                                                          \
+            store( result+i, KERNEL( load(s+i), load(E_pbar+i), load(pT_pbar+i), C_array, m_p ) );                      \
+        }                                                                                                               \
+        if (i<n) {                                                                                                      \
+            double s_buf[W], E_buf[W], pT_buf[W], r_buf[W];                                                             \
+            for (int k=0; k<W; k++) {                                                                                   \
+                s_buf[k]  = ( i+k<n ? s      [i+k] : 0 );                                                               \
+                E_buf[k]  = ( i+k<n ? E_pbar [i+k] : 0 );                                                               \
+                pT_buf[k] = ( i+k<n ? pT_pbar[i+k] : 0 );                                                               \
+            }                                                                                                           \
+            store( r_buf, KERNEL( load(s_buf), load(E_buf), load(pT_buf), C_array, m_p ) );                             \
+            for (int k=0; i+k<n; k++) result[i+k] = r_buf[k];                                                           \
+        }
+
+        void inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, const double* C_array, double m_p ){
+            CRXS_SIMD_LOOP( Winkler )
+        }
+
+        void inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, const double* C_array, double m_p ){
+            CRXS_SIMD_LOOP( diMauro )
+        }
+
+#undef CRXS_SIMD_LOOP
+
+
+        //  ------------------------------------------------------------- #
+        //   Ensembles: vectorized across parameter sets                  #
+        //  ------------------------------------------------------------- #
+
+        //  The kinematic quantities of a point are computed once (as broadcast vectors, with the same operations as in
+        //  Winkler and diMauro above, so that the results agree bit by bit with inv_pp_pbar_CM__Winkler and
+        //  inv_pp_pbar_CM__diMauro of this instruction set). Points outside of the kinematic range give a row of 0.
+        //  The last K%W sets are stored from a buffer.
+#define CRXS_SIMD_ENSEMBLE_STORE( VALUE )                                                                               \
+            if (k+W<=K) {                                                                                               \
+                store( row+k, VALUE );                                                                                  \
+            }else{                                                                                                      \
+                double r_buf[W];                                                                                        \
+                store( r_buf, VALUE );                                                                                  \
+                for (int l=0; k+l<K; l++) row[k+l] = r_buf[l];                                                          \
+            }
+
+        void ensemble__inv_pp_pbar_CM__Winkler( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_T, int ld_C_T, double m_p ){
+            for (int i=0; i<n; i++) {
+                double* row   = result+(long)i*K;
+
+                vd s_i        = set( s[i] );
+                vd E_i        = vabs( set( E_pbar[i] ) );
+                vd pT_i       = set( pT_pbar[i] );
+                vi valid      = ~( s_i < 16*m_p*m_p ) & ~( pT_i*pT_i > p2( E_i, m_p ) );
+
+                vd sqrt_s     = vsqrt( s_i );
+                vd E_pbar_Max = ( s_i-8.*m_p*m_p )/2./sqrt_s;
+                vd x_R        = E_i/E_pbar_Max;
+                valid        &= ~( x_R > 1. );
+                if (!valid[0]) {
+                    for (int k=0; k<K; k++) row[k] = 0;
+                    continue;
+                }
+
+                vd m_T        = vsqrt( vfma( pT_i, pT_i, set(m_p*m_p) ) );
+                bool below_10 = ( sqrt_s[0] < 10. );
+                vd d          = 10.-sqrt_s;
+                vd log_d      = ( below_10 ? vlog( d ) : set(0.) );
+                vd d_5        = d*d*d*d*d;
+                vd y          = x_R-m_p/E_pbar_Max;
+                vd y_2        = y*y;
+                vd log_sqrt_s = vlog( sqrt_s );
+                vd log_sqrt_s_2 = log_sqrt_s*log_sqrt_s;
+                vd log_X      = vlog( sqrt_s/4./m_p );
+                vd log_X_2    = log_X*log_X;
+                vd log_1_x_R  = vlog( 1-x_R );
+                vd u          = m_T-m_p;
+
+                for (int k=0; k<K; k+=W) {
+                    vd C0         = load( C_T+ 0*ld_C_T+k );
+                    vd C5         = load( C_T+ 5*ld_C_T+k );
+                    vd C6         = load( C_T+ 6*ld_C_T+k );
+                    vd C7         = load( C_T+ 7*ld_C_T+k );
+                    vd C8         = load( C_T+ 8*ld_C_T+k );
+                    vd C9         = load( C_T+ 9*ld_C_T+k );
+                    vd C10        = load( C_T+10*ld_C_T+k );
+                    vd C11        = load( C_T+11*ld_C_T+k );
+                    vd C12        = load( C_T+12*ld_C_T+k );
+                    vd C13        = load( C_T+13*ld_C_T+k );
+
+                    vd R_prefac   = set(1.);
+                    vd R_exponent = set(0.);
+                    if (below_10) {
+                        vd d_C0    = select( C0==1., d, select( C0==2., d*d, vexp( C0*log_d ) ) );
+                        R_prefac   = 1 +C9*d_5;
+                        R_exponent = C10*d_C0*y_2;
+                    }
+                    vd sigma_in   = C11 +C12*log_sqrt_s + C13*log_sqrt_s_2;
+                    vd X          = C8 * log_X_2;
+                    vd exponent   = R_exponent + C6*log_1_x_R + Winkler_exponent_mT( X, C7 )*vlog( 1+X*u );
+                    CRXS_SIMD_ENSEMBLE_STORE( R_prefac * sigma_in * C5 * vexp( exponent ) )
+                }
+            }
+        }
+
+        void ensemble__inv_pp_pbar_CM__diMauro( int n, const double* s, const double* E_pbar, const double* pT_pbar, double* result, int K, const double* C_T, int ld_C_T, double m_p ){
+            for (int i=0; i<n; i++) {
+                double* row   = result+(long)i*K;
+
+                vd s_i        = set( s[i] );
+                vd E_i        = set( E_pbar[i] );
+                vd pT_i       = set( pT_pbar[i] );
+                vi valid      = ~( s_i < 16*m_p*m_p ) & ~( (pT_i*0.9)*(pT_i*0.9) > p2( E_i, m_p ) );
+
+                vd E_pbar_Max = ( s_i-8.*m_p*m_p )/2./vsqrt( s_i );
+                vd x_R        = E_i/E_pbar_Max;
+                valid        &= ~( x_R > 1. );
+                if (!valid[0]) {
+                    for (int k=0; k<K; k++) row[k] = 0;
+                    continue;
+                }
+
+                vd sigma_in   =   diMauro_pp( s_i,  33.44, 13.53,   6.38, 0.324,  0.324,    2.06, m_p )
+                                - diMauro_pp( s_i, 144.98,  2.64, 137.27, 1.57,  -4.65e-3, 3.06, m_p );
+                vd log_s      = vlog( s_i );
+                vd pT2        = pT_i*pT_i;
+                vd log_1_x_R  = vlog( 1-x_R );
+
+                for (int k=0; k<K; k+=W) {
+                    vd C1         = load( C_T+ 1*ld_C_T+k );
+                    vd C2         = load( C_T+ 2*ld_C_T+k );
+                    vd C3         = load( C_T+ 3*ld_C_T+k );
+                    vd C4         = load( C_T+ 4*ld_C_T+k );
+                    vd C5         = load( C_T+ 5*ld_C_T+k );
+                    vd C6         = load( C_T+ 6*ld_C_T+k );
+                    vd C7         = load( C_T+ 7*ld_C_T+k );
+                    vd C8         = load( C_T+ 8*ld_C_T+k );
+                    vd C9         = load( C_T+ 9*ld_C_T+k );
+                    vd C10        = load( C_T+10*ld_C_T+k );
+                    vd C11        = load( C_T+11*ld_C_T+k );
+
+                    vd sum        = C3 * vexp( C4 /2.*log_s - C5 *pT_i     ) +
+                                    C6 * vexp( C7 /2.*log_s - C8 *pT2      ) +
+                                    C9 * vexp( C10/2.*log_s - C11*pT2*pT_i );
+                    CRXS_SIMD_ENSEMBLE_STORE( sigma_in * vexp( C1*log_1_x_R - C2*x_R ) * vabs( sum ) )
+                }
+            }
+        }
+
+#undef CRXS_SIMD_ENSEMBLE_STORE
+
+
+        //  ------------------------------------------------------------- #
+        //   Log-log interpolation                                        #
+        //  ------------------------------------------------------------- #
+
+        //  Follows XS_interpolation::Interpolate (scalar version in xs_interpolation.cxx): the interval of each lane is
+        //  computed on uniform grids and found by binary search otherwise, the coefficients are gathered lane by lane.
+        CRXS_SIMD_INLINE vd interpolate( vd x, int n_nodes, int uniform, double log_x_min, double inv_dlog_x, const double* log_x, const double* coefficients ){
+
+            int last = n_nodes-2;
+            vd  lx   = vlog( x );
+            vd  t  = set(0.);
+            vd  c0 = set(0.), c1 = set(0.), c2 = set(0.), c3 = set(0.);
+
+            int interval[W];
+            if (uniform) {
+                vd u  = ( lx-log_x_min )*inv_dlog_x;
+                vd uc = select( u>=(double)last, set((double)last), select( u>0., u, set(0.) ) );
+                vd f  = ( uc + MAGIC ) - MAGIC;
+                f     = select( f>uc, f-1., f );
+                t     = u-f;
+                for (int k=0; k<W; k++) interval[k] = (int)f[k];
+            }else{
+                vd lo = set(0.);
+                vd h  = set(1.);
+                for (int k=0; k<W; k++) {
+                    int i_lo = 0;
+                    int i_up = last;
+                    while (i_lo<i_up) {
+                        int i_mid = ( i_lo+i_up+1 )/2;
+                        if (log_x[i_mid]<=lx[k]) i_lo = i_mid;
+                        else                     i_up = i_mid-1;
+                    }
+                    interval[k] = i_lo;
+                    lo[k]       = log_x[i_lo];
+                    h [k]       = log_x[i_lo+1]-log_x[i_lo];
+                }
+                t = ( lx-lo )/h;
+            }
+            for (int k=0; k<W; k++) {
+                const double* c = coefficients+4*interval[k];
+                c0[k] = c[0];
+                c1[k] = c[1];
+                c2[k] = c[2];
+                c3[k] = c[3];
+            }
+
+            vd inside = c0 + t*( c1 + t*( c2 + t*c3 ) );
+            vd below  = c0 + c1*t;
+            vd above  = c0+c1+c2+c3 + ( c1+2.*c2+3.*c3 )*(t-1.);
+            vd log_y  = select( t<0., below, select( t>1., above, inside ) );
+
+            return select( x>0., vexp( log_y ), set(0.) );
+        }
+
+        //  The last n%W points are padded with x=1
+        void interpolate_loglog( int n, const double* x, double* result, int n_nodes, int uniform, double log_x_min, double inv_dlog_x, const double* log_x, const double* coefficients ){
+            int i = 0;
+            for (; i+W<=n; i+=W) {
+                store( result+i, interpolate( load(x+i), n_nodes, uniform, log_x_min, inv_dlog_x, log_x, coefficients ) );
+            }
+            if (i<n) {
+                double x_buf[W], r_buf[W];
+                for (int k=0; k<W; k++) {
+                    x_buf[k] = ( i+k<n ? x[i+k] : 1. );
+                }
+                store( r_buf, interpolate( load(x_buf), n_nodes, uniform, log_x_min, inv_dlog_x, log_x, coefficients ) );
+                for (int k=0; i+k<n; k++) result[i+k] = r_buf[k];
+            }
+        }
+
+
+        //  ------------------------------------------------------------- #
+        //   pp -> gamma (Kafexhiu et al.)                                #
+        //  ------------------------------------------------------------- #
+
+        //  A_max * F(E_gamma) of Eq. (11) at one proton energy, follows gamma__F in xs_gamma.cxx. Lanes outside of
+        //  [E_gamma_min, E_gamma_max] are evaluated at X_gamma=0 and masked. alpha is 1 or 0.5 for all proton energies.
+        CRXS_SIMD_INLINE vd pp_gamma( vd E_gamma, double A_max, double E_gamma_max, double Y_gamma_max, double alpha, double beta, double gamma, double C, double m_pi ){
+            vd Y_gamma    = E_gamma + m_pi*m_pi/4./E_gamma;
+            vd X_gamma    = ( Y_gamma - m_pi ) / ( Y_gamma_max - m_pi );
+            vi valid      = ( E_gamma > 0. ) & ~( E_gamma > E_gamma_max ) & ( X_gamma < 1. );
+            X_gamma       = select( valid & ( X_gamma > 0. ), X_gamma, set(0.) );
+
+            vd X_alpha    = ( alpha==1. ? X_gamma : ( alpha==0.5 ? vsqrt( X_gamma ) : vpow( X_gamma, set(alpha) ) ) );
+            vd F          = vexp( beta*vlog( 1-X_alpha ) - gamma*vlog( 1+X_gamma/C ) );
+            return select( valid, A_max*F, set(0.) );
+        }
+
+        //  The last n%W points are padded with E_gamma=0 (masked)
+        void pp_gamma__F( int n, const double* E_gamma, double* result, double A_max, double E_gamma_max, double Y_gamma_max, double alpha, double beta, double gamma, double C, double m_pi ){
+            int i = 0;
+            for (; i+W<=n; i+=W) {
+                store( result+i, pp_gamma( load(E_gamma+i), A_max, E_gamma_max, Y_gamma_max, alpha, beta, gamma, C, m_pi ) );
+            }
+            if (i<n) {
+                double E_buf[W], r_buf[W];
+                for (int k=0; k<W; k++) {
+                    E_buf[k] = ( i+k<n ? E_gamma[i+k] : 0 );
+                }
+                store( r_buf, pp_gamma( load(E_buf), A_max, E_gamma_max, Y_gamma_max, alpha, beta, gamma, C, m_pi ) );
+                for (int k=0; i+k<n; k++) result[i+k] = r_buf[k];
+            }
+        }
+
+    }
+}
+
+#undef CRXS_SIMD_INLINE
@@ -0,0 +1,12 @@
+//
+//  Vectorized pp kernels for SSE2 (-msse2), see xs_simd_kernels.h.
+//  Do not include other headers here, see xs_simd.h.
+//
+
+#ifdef CRXS_SIMD_X86
+
+#define CRXS_SIMD_NAMESPACE SIMD_SSE2_kernels
+#define CRXS_SIMD_BYTES     16
+#include "xs_simd_kernels.h"
+
+#endif
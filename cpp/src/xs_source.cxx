@@ -0,0 +1,349 @@
+#include "math.h"
+#include "stdio.h"
+
+#include "thread"
+#include "atomic"
+#include "vector"
+#include "algorithm"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_setup.h"
+#include "xs_context.h"
+#include "xs_source.h"
+
+namespace CRXS {
+
+
+    //
+    //  Source term. Projectiles and targets with the same (A, N) are combined to groups, the integral over the energy of
+    //  the projectile is computed for every projectile group with all target groups at the same nodes. The energies of
+    //  the product are distributed dynamically to the threads (as the rows of the grid tabulation in xs_grid.cxx).
+    //
+
+    struct source__projectile_group{
+        int                 A;
+        int                 N;
+        std::vector<int>    projectiles;    // indices in XS_source::fProjectiles
+        double              Tn_min;         // range of the union of the flux tables
+        double              Tn_max;
+        std::vector<double> breaks;         // ends of the flux tables, sorted
+        double              Tn_threshold;   // kinematic threshold of the product
+    };
+
+    struct source__target_group{
+        int                 A;
+        int                 N;
+        double              density;        // sum of the densities
+        int                 n_targets;
+    };
+
+    struct source__job{
+        const XS_source*                        source;
+        std::vector<source__projectile_group>   projectiles;
+        std::vector<source__target_group>       targets;
+        int                                     n;
+        const double*                           T_LAB;
+        double*                                 result;
+        XS_engine*                              engine;
+        std::atomic<int>                        next;
+        std::atomic<long>                       evaluations;
+        std::atomic<long>                       evaluations_species;
+    };
+
+    //  Parameters of source__integrand: one projectile group at one energy of the product
+    struct source__integrand_parameters{
+        const source__job*              job;
+        const source__projectile_group* projectile;
+        const XS_setup*                 setups;     // antiprotons: one per target group
+        double                          T_LAB;
+        long                            evaluations;
+        long                            evaluations_species;
+    };
+
+
+    //  Energy-differential cross section in mbarn/GeV (per nucleon for antinuclei) of one projectile and target group
+    static double source__dsigma( const source__integrand_parameters& par, int i_target, double Tn_proj_LAB, double factor ){
+        const XS_source&                source = *par.job->source;
+        const source__projectile_group& p      = *par.projectile;
+        const source__target_group&     t      = par.job->targets[i_target];
+        if (source.fProduct==P_BAR) {
+            return factor*XS_energy_context( par.setups[i_target], Tn_proj_LAB ).dE_AA_pbar_LAB( par.T_LAB );
+        }
+        if (source.fProduct==D_BAR  ) return XS::dEn_AA_Dbar_LAB  ( Tn_proj_LAB, par.T_LAB, p.A, p.N, t.A, t.N, source.fParametrization, source.fCoalescence, source.fP0 );
+        if (source.fProduct==HE3_BAR) return XS::dEn_AA_He3bar_LAB( Tn_proj_LAB, par.T_LAB, p.A, p.N, t.A, t.N, source.fParametrization, source.fCoalescence, source.fP0 );
+        if (source.fProduct==HE4_BAR) return XS::dEn_AA_He4bar_LAB( Tn_proj_LAB, par.T_LAB, p.A, p.N, t.A, t.N, source.fParametrization, source.fCoalescence, source.fP0 );
+        return 0;
+    }
+
+    //  Integrand in x = log(Tn_proj_LAB): Tn * sum_i phi_i(Tn) * sum_j n_j dsigma_j/dT
+    static double source__integrand( double x, void* parameters ){
+        source__integrand_parameters& par    = *( (source__integrand_parameters*) parameters );
+        const XS_source&              source = *par.job->source;
+        const source__projectile_group& p    = *par.projectile;
+
+        double Tn_proj_LAB = exp( x );
+        double flux        = 0;
+        int    n_flux      = 0;
+        for (unsigned int k=0; k<p.projectiles.size(); k++) {
+            const XS_source__projectile& projectile = source.fProjectiles[ p.projectiles[k] ];
+            if (Tn_proj_LAB<projectile.Tn_min || Tn_proj_LAB>projectile.Tn_max) {
+                continue;
+            }
+            flux += projectile.flux.Interpolate( Tn_proj_LAB );
+            n_flux++;
+        }
+        if (flux<=0) {
+            return 0;
+        }
+
+        // same factor as XS::dE_AA_pbar_LAB_incNbarAndHyperon
+        double factor = 1;
+        if (source.fProduct==P_BAR && source.fIncNbarAndHyperon) {
+            double s = 4.*XS_definitions::fMass_proton*XS_definitions::fMass_proton + 2. * Tn_proj_LAB * XS_definitions::fMass_proton;
+            double * C_array = XS_definitions::Get_C_parameters_isospin(source.fParametrization);
+            factor = ( 2. + 2.*XS_definitions::deltaHyperon(s, C_array) + XS_definitions::deltaIsospin(s, C_array));
+        }
+
+        double sum = 0;
+        for (unsigned int i_target=0; i_target<par.job->targets.size(); i_target++) {
+            const source__target_group& t = par.job->targets[i_target];
+            sum += t.density*source__dsigma( par, i_target, Tn_proj_LAB, factor );
+            par.evaluations         += 1;
+            par.evaluations_species += n_flux*t.n_targets;
+        }
+        return 4*M_PI*Tn_proj_LAB*flux*sum;
+    }
+
+
+    //  Smallest projectile energy in [Tn_threshold, Tn_max] at which T_LAB is kinematically allowed, -1 if there is none.
+    //  The allowed range of T_LAB grows with the projectile energy, the limit is found by bisection in log(Tn).
+    static double source__Tn_min( double T_LAB, int product, int A_projectile, double Tn_threshold, double Tn_max ){
+        double T_min, T_max;
+        if (Tn_max<=Tn_threshold || !XS::kinematics__T_LAB_range( Tn_max, T_min, T_max, product, A_projectile ) || T_LAB<T_min || T_LAB>T_max) {
+            return -1;
+        }
+        double Tn_low  = Tn_threshold;
+        double Tn_high = Tn_max;
+        while (Tn_high-Tn_low > 1e-12*Tn_high) {
+            double Tn_mid = sqrt( Tn_low*Tn_high );
+            if (Tn_mid<=Tn_low || Tn_mid>=Tn_high) {
+                break;
+            }
+            if (XS::kinematics__T_LAB_range( Tn_mid, T_min, T_max, product, A_projectile ) && T_LAB>=T_min && T_LAB<=T_max) {
+                Tn_high = Tn_mid;
+            }else{
+                Tn_low  = Tn_mid;
+            }
+        }
+        return Tn_high;
+    }
+
+
+    //  Source term of one projectile group at T_LAB. The range is split at the ends of the flux tables.
+    static double source__integrate( source__integrand_parameters& par, double& abserr ){
+        const XS_source&                source = *par.job->source;
+        const source__projectile_group& p      = *par.projectile;
+
+        abserr = 0;
+        double Tn_low = source__Tn_min( par.T_LAB, source.fProduct, p.A, p.Tn_threshold, p.Tn_max );
+        if (Tn_low<0) {
+            return 0;
+        }
+        Tn_low = std::max( Tn_low, p.Tn_min );
+
+        double res   = 0;
+        double lower = Tn_low;
+        for (unsigned int k=0; k<=p.breaks.size(); k++) {
+            double upper = k<p.breaks.size() ? p.breaks[k] : p.Tn_max;
+            if (upper<=lower) {
+                continue;
+            }
+            double err = 0;
+            res   += Integration::integrate( &source__integrand, log(lower), log(upper), &par, source.fOptions, &err );
+            abserr += err;
+            lower  = upper;
+        }
+        return res;
+    }
+
+
+    static void source__worker( source__job* job ){
+        XS_engine::Scope scope( *job->engine );
+        const XS_source& source = *job->source;
+
+        //  Antiprotons: configurations of all projectile and target groups, resolved with the engine of this thread
+        std::vector<XS_setup> setups;
+        if (source.fProduct==P_BAR) {
+            for (unsigned int g=0; g<job->projectiles.size(); g++) {
+                for (unsigned int t=0; t<job->targets.size(); t++) {
+                    setups.push_back( XS_setup( job->projectiles[g].A, job->projectiles[g].N, job->targets[t].A, job->targets[t].N, source.fParametrization ) );
+                }
+            }
+        }
+
+        long evaluations = 0, evaluations_species = 0;
+        for (int i = job->next++; i<job->n; i = job->next++) {
+            double res = 0, err = 0;
+            for (unsigned int g=0; g<job->projectiles.size(); g++) {
+                source__integrand_parameters par;
+                par.job                 = job;
+                par.projectile          = &job->projectiles[g];
+                par.setups              = setups.size() ? &setups[ g*job->targets.size() ] : 0;
+                par.T_LAB               = job->T_LAB[i];
+                par.evaluations         = 0;
+                par.evaluations_species = 0;
+                double abserr;
+                res += source__integrate( par, abserr );
+                err += abserr;
+                evaluations         += par.evaluations;
+                evaluations_species += par.evaluations_species;
+            }
+            if (err > source.fOptions.epsabs + source.fOptions.epsrel*fabs(res) && source.fOptions.epsrel>0) {
+                printf( "Warning in CRXS::XS_source::Evaluate. Integral accuarcy of %f is below required value of %f at T=%f. \n", err/fabs(res), source.fOptions.epsrel, job->T_LAB[i] );
+            }
+            job->result[i] = res;
+        }
+        job->evaluations         += evaluations;
+        job->evaluations_species += evaluations_species;
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Public functions                                             #
+    //  ------------------------------------------------------------- #
+
+    XS_source::XS_source( int product, int parametrization, int coalescence, double p0_val ){
+        if (product!=P_BAR && product!=D_BAR && product!=HE3_BAR && product!=HE4_BAR) {
+            printf( "Warning in CRXS::XS_source::XS_source. Product %i is not known, the source term is 0.\n", product );
+        }
+        fProduct            = product;
+        fParametrization    = parametrization;
+        fCoalescence        = coalescence;
+        fP0                 = p0_val;
+        fIncNbarAndHyperon  = true;
+        fOptions            = Integration_options( GSL, 1e-4 );
+        fEvaluations         = 0;
+        fEvaluations_species = 0;
+    }
+
+
+    bool XS_source::AddProjectile( int A_projectile, int N_projectile, int n, const double* Tn, const double* flux ){
+        XS_source__projectile projectile;
+        projectile.A = A_projectile;
+        projectile.N = N_projectile;
+        if (!projectile.flux.Setup( n, Tn, flux, INTERPOLATION__LOGLOG_LINEAR )) {
+            printf( "Warning in CRXS::XS_source::AddProjectile. The flux of the projectile (A=%i, N=%i) is not valid, the projectile is not added.\n", A_projectile, N_projectile );
+            return false;
+        }
+        projectile.Tn_min = Tn[0];
+        projectile.Tn_max = Tn[n-1];
+        fProjectiles.push_back( projectile );
+        return true;
+    }
+
+
+    void XS_source::AddTarget( int A_target, int N_target, double density ){
+        XS_source__target target = { A_target, N_target, density };
+        fTargets.push_back( target );
+    }
+
+
+    double XS_source::Evaluate( double T_LAB ){
+        double result;
+        Evaluate( 1, &T_LAB, &result, 1 );
+        return result;
+    }
+
+
+    void XS_source::Evaluate( int n, const double* T_LAB, double* result, int n_threads ){
+
+        fEvaluations         = 0;
+        fEvaluations_species = 0;
+        for (int i=0; i<n; i++) {
+            result[i] = 0;
+        }
+        if (n<=0 || fProjectiles.empty() || fTargets.empty()) {
+            return;
+        }
+        if (fProduct!=P_BAR && fProduct!=D_BAR && fProduct!=HE3_BAR && fProduct!=HE4_BAR) {
+            return;
+        }
+
+        source__job job;
+        job.source = this;
+        for (unsigned int i=0; i<fProjectiles.size(); i++) {
+            const XS_source__projectile& projectile = fProjectiles[i];
+            unsigned int g = 0;
+            while (g<job.projectiles.size() && ( job.projectiles[g].A!=projectile.A || job.projectiles[g].N!=projectile.N )) {
+                g++;
+            }
+            if (g==job.projectiles.size()) {
+                source__projectile_group group;
+                group.A            = projectile.A;
+                group.N            = projectile.N;
+                group.Tn_min       = projectile.Tn_min;
+                group.Tn_max       = projectile.Tn_max;
+                group.Tn_threshold = XS::kinematics__Tn_threshold( fProduct, projectile.A );
+                job.projectiles.push_back( group );
+            }
+            source__projectile_group& group = job.projectiles[g];
+            group.projectiles.push_back( i );
+            group.Tn_min = std::min( group.Tn_min, projectile.Tn_min );
+            group.Tn_max = std::max( group.Tn_max, projectile.Tn_max );
+            group.breaks.push_back( projectile.Tn_min );
+            group.breaks.push_back( projectile.Tn_max );
+        }
+        for (unsigned int g=0; g<job.projectiles.size(); g++) {
+            std::vector<double>& breaks = job.projectiles[g].breaks;
+            std::sort( breaks.begin(), breaks.end() );
+            breaks.erase( std::unique( breaks.begin(), breaks.end() ), breaks.end() );
+        }
+        for (unsigned int j=0; j<fTargets.size(); j++) {
+            const XS_source__target& target = fTargets[j];
+            unsigned int t = 0;
+            while (t<job.targets.size() && ( job.targets[t].A!=target.A || job.targets[t].N!=target.N )) {
+                t++;
+            }
+            if (t==job.targets.size()) {
+                source__target_group group = { target.A, target.N, 0., 0 };
+                job.targets.push_back( group );
+            }
+            job.targets[t].density   += target.density;
+            job.targets[t].n_targets += 1;
+        }
+
+        job.n                   = n;
+        job.T_LAB               = T_LAB;
+        job.result              = result;
+        job.engine              = &XS_engine::Current();
+        job.next                = 0;
+        job.evaluations         = 0;
+        job.evaluations_species = 0;
+
+        if (n_threads<=0) {
+            n_threads = std::thread::hardware_concurrency();
+        }
+        if (n_threads<=0) {
+            n_threads = 1;
+        }
+        if (n_threads>n) {
+            n_threads = n;
+        }
+        if (n_threads==1) {
+            source__worker( &job );
+        }else{
+            std::vector<std::thread> threads;
+            for (int t=0; t<n_threads; t++) {
+                threads.push_back( std::thread( source__worker, &job ) );
+            }
+            for (int t=0; t<n_threads; t++) {
+                threads[t].join();
+            }
+        }
+        fEvaluations         = job.evaluations;
+        fEvaluations_species = job.evaluations_species;
+    }
+
+}
@@ -0,0 +1,129 @@
+#ifndef CRXS__XS_SOURCE_H
+#define CRXS__XS_SOURCE_H
+
+#include "vector"
+
+#include "xs.h"
+#include "xs_interpolation.h"
+#include "linAlg_tools.h"
+
+namespace CRXS {
+
+    //! Cosmic-ray projectile of an XS_source: species and tabulated flux.
+    struct XS_source__projectile{
+        int                 A;
+        int                 N;
+        /// Flux per kinetic energy per nucleon, interpolated log-log linearly, 0 outside of [Tn_min, Tn_max]
+        XS_interpolation    flux;
+        double              Tn_min;
+        double              Tn_max;
+    };
+
+    //! Target of an XS_source: species and density in the interstellar medium.
+    struct XS_source__target{
+        int                 A;
+        int                 N;
+        double              density;
+    };
+
+
+    //! Secondary source term of antiprotons and antinuclei from cosmic rays hitting the interstellar medium.
+    /*!
+     *  For projectiles i with flux phi_i(Tn) and targets j with density n_j the source term at the kinetic energy T (per
+     *  nucleon for antinuclei) of the product is
+     *
+     *      q(T) = 4 pi sum_ij n_j int dTn phi_i(Tn) dsigma_ij/dT( Tn, T ),
+     *
+     *  with dsigma/dT from XS::dE_AA_pbar_LAB_incNbarAndHyperon (or XS::dE_AA_pbar_LAB, see fIncNbarAndHyperon),
+     *  XS::dEn_AA_Dbar_LAB, XS::dEn_AA_He3bar_LAB, or XS::dEn_AA_He4bar_LAB in mbarn/GeV (per nucleon). The result has the
+     *  units of density * flux * mbarn; with the density in 1/m^3 and the flux in 1/(m^2 s sr GeV) a factor 1e-31 gives
+     *  the source term in 1/(m^3 s GeV).
+     *
+     *  The integral is computed in log(Tn) with Integration::integrate (fOptions, adaptive GSL by default) from the
+     *  kinematic threshold of T to the largest tabulated energy. The integration range is split at the ends of all flux
+     *  tables, so that the integrand is smooth in every part. Projectiles and targets with the same mass and neutron
+     *  number are combined: at every node, the cross section is evaluated once per distinct combination (A, N) of
+     *  projectile and target, and multiplied by the sum of the fluxes and the sum of the densities. Every distinct
+     *  projectile is integrated separately (with its own kinematic threshold and adaptive subdivision), the targets
+     *  share the nodes. For antiprotons, the configurations (XS_setup) are resolved once per thread and the factor of
+     *  the antineutrons and hyperons once per node.
+     *
+     *  The energies T are distributed dynamically to n_threads threads. Every thread evaluates the cross sections with
+     *  the engine of the calling thread (XS_engine::Current()), such that the result does not depend on the number of
+     *  threads.
+     *
+     *  Usage:
+     *
+     *      XS_source source( P_BAR, KORSMEIER_II );
+     *      source.AddProjectile( 1, 0, n_Tn, Tn, flux_p  );
+     *      source.AddProjectile( 4, 2, n_Tn, Tn, flux_He );
+     *      source.AddTarget    ( 1, 0, 1e6 );
+     *      source.AddTarget    ( 4, 2, 1e5 );
+     *      source.Evaluate     ( n_T, T_pbar, q_pbar );
+     */
+    class XS_source{
+
+    public:
+
+        //! Constructor
+        /*!
+         *  \param int    product          Product, enum from [P_BAR (default), D_BAR, HE3_BAR, HE4_BAR]
+         *  \param int    parametrization  Cross section parametrization, cf. XS::dE_AA_pbar_LAB and XS::dEn_AA_Dbar_LAB
+         *  \param int    coalescence      Coalescence model (antinuclei only), cf. XS::dEn_AA_Dbar_LAB
+         *  \param double p0_val           Coalescence momentum in GeV (antinuclei only)
+         */
+        XS_source( int product=P_BAR, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160 );
+
+        //! Adds a projectile species with tabulated flux.
+        /*!
+         *  \param int     A_projectile  Mass number of the projectile, if A_projectile is negative we use an antiproton as projectile (antinuclei only)
+         *  \param int     N_projectile  Number of neutrons in the projectile
+         *  \param int     n             Number of nodes, at least 2
+         *  \param double* Tn            Kinetic energy per nucleon in GeV, strictly increasing and positive, array of length n
+         *  \param double* flux          Flux per kinetic energy per nucleon, array of length n
+         *
+         *  \return bool                 false (with a warning) if the table is not valid, the projectile is not added
+         */
+        bool    AddProjectile( int A_projectile, int N_projectile, int n, const double* Tn, const double* flux );
+
+        //! Adds a target species.
+        /*!
+         *  \param int    A_target      Mass number of the target
+         *  \param int    N_target      Number of neutrons in the target
+         *  \param double density       Density in the interstellar medium
+         */
+        void    AddTarget    ( int A_target, int N_target, double density );
+
+        /// Source term at T_LAB
+        double  Evaluate( double T_LAB );
+
+        //! Source term at n energies.
+        /*!
+         *  \param int     n           Number of energies
+         *  \param double* T_LAB       Kinetic energy (per nucleon for antinuclei) of the product in GeV, array of length n
+         *  \param double* result      Returns: source term, array of length n allocated by the caller
+         *  \param int     n_threads   Number of threads, 0: number of cores
+         */
+        void    Evaluate( int n, const double* T_LAB, double* result, int n_threads=0 );
+
+        int     fProduct;
+        int     fParametrization;
+        int     fCoalescence;
+        double  fP0;
+        /// Antiprotons only: include the antineutrons and hyperons (XS::dE_AA_pbar_LAB_incNbarAndHyperon), default: true
+        bool    fIncNbarAndHyperon;
+        /// Integration in log(Tn), default: GSL with epsrel=1e-4
+        Integration_options fOptions;
+
+        std::vector<XS_source__projectile>  fProjectiles;
+        std::vector<XS_source__target>      fTargets;
+
+        /// Statistics of the last call of Evaluate: number of cross sections evaluated, and the number without combining equal species
+        long    fEvaluations;
+        long    fEvaluations_species;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,517 @@
+#include "math.h"
+#include "string.h"
+#include "iostream"
+
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_table.h"
+#include "xs_setup.h"
+#include "xs_parametrization.h"
+#include "xs_autotune.h"
+
+namespace CRXS {
+
+    //  Derivative at a node from the left and right differences (harmonic mean, Fritsch-Butland). It vanishes at local
+    //  extrema and keeps the interpolation monotonic where log(XS) is monotonic, which avoids overshooting at the kinematic
+    //  limits. Where both differences are similar, it is close to the central difference.
+    static double slope( double d_lo, double d_up ){
+        if (d_lo*d_up<=0) return 0;
+        return 2.*d_lo*d_up/(d_lo+d_up);
+    }
+
+
+    XS_table::XS_table( int quantity, double Tn_min, double Tn_max, int n_Tn, double T_min, double T_max, int n_T, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_threads ){
+        Setup( quantity, Tn_min, Tn_max, n_Tn, T_min, T_max, n_T, A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val, n_threads );
+        Tabulate();
+    }
+
+
+    XS_table::XS_table( const char* cache_directory, int quantity, double Tn_min, double Tn_max, int n_Tn, double T_min, double T_max, int n_T, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_threads ){
+        Setup( quantity, Tn_min, Tn_max, n_Tn, T_min, T_max, n_T, A_projectile, N_projectile, A_target, N_target, parametrization, coalescence, p0_val, n_threads );
+        std::string filename = Get_CacheFile( cache_directory );
+        if (Map( filename.c_str() )) {
+            return;
+        }
+        Tabulate();
+        Save( filename.c_str() );
+    }
+
+
+    XS_table::~XS_table(){
+        if (fMapped) {
+            munmap( fMapped, fMappedSize );
+        }
+    }
+
+
+    //
+    //  Cache key: FNV-1a hash of everything which changes the tabulated values.
+    //
+    static void table__hash( unsigned long long& hash, const void* data, size_t size ){
+        const unsigned char* bytes = (const unsigned char*) data;
+        for (size_t i=0; i<size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    //  Calibrated rules of the integration method AUTOTUNE: grid of the regions, target accuracy, and the rule of every region
+    static void table__hash_autotune( unsigned long long& hash, const XS_autotune* autotune ){
+        int calibrated = ( autotune!=0 );
+        table__hash( hash, &calibrated, sizeof(int) );
+        if (!calibrated) {
+            return;
+        }
+        int    integers[] = { autotune->fN_Tn, autotune->fN_T };
+        double doubles [] = { autotune->fEpsrel, autotune->fLog_Tn_min, autotune->fLog_Tn_max, autotune->fLog_T_min, autotune->fLog_T_max };
+        table__hash( hash, integers, sizeof(integers) );
+        table__hash( hash, doubles,  sizeof(doubles)  );
+        for (size_t k=0; k<autotune->fRegions.size(); k++) {
+            const Integration_options& options = autotune->fRegions[k].options;
+            int rule[] = { options.method, options.steps, options.nodes, options.levels, options.limit };
+            table__hash( hash, rule, sizeof(rule) );
+            table__hash( hash, &options.epsabs, sizeof(double) );
+            table__hash( hash, &options.epsrel, sizeof(double) );
+        }
+    }
+
+    void XS_table::Setup( int quantity, double Tn_min, double Tn_max, int n_Tn, double T_min, double T_max, int n_T, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_threads ){
+
+        fQuantity           = quantity;
+        fA_projectile       = A_projectile;
+        fN_projectile       = N_projectile;
+        fA_target           = A_target;
+        fN_target           = N_target;
+        fParametrization    = parametrization;
+        fCoalescence        = coalescence;
+        fP0                 = p0_val;
+        fThreads            = n_threads;
+        fEngine             = &XS_engine::Current();
+
+        fMaxRelativeError    = -1;
+        fMaxRelativeError_Tn = 0;
+        fMaxRelativeError_T  = 0;
+
+        fMapped             = 0;
+        fMappedSize         = 0;
+
+        if (n_Tn<2 || n_T<2 || Tn_min<=0 || T_min<=0 || Tn_max<=Tn_min || T_max<=T_min) {
+            printf( "Warning in CRXS::XS_table::XS_table. The grid [%e, %e] x %i, [%e, %e] x %i is not valid.", Tn_min, Tn_max, n_Tn, T_min, T_max, n_T );
+            n_Tn   = 2;
+            n_T    = 2;
+            Tn_max = Tn_min*10;
+            T_max  = T_min *10;
+        }
+
+        fN_Tn               = n_Tn;
+        fN_T                = n_T;
+        fLogTn_min          = log(Tn_min);
+        fLogT_min           = log(T_min);
+        fLogTn_max          = log(Tn_max);
+        fLogT_max           = log(T_max);
+        fDeltaLogTn         = ( fLogTn_max-fLogTn_min )/(n_Tn-1);
+        fDeltaLogT          = ( fLogT_max -fLogT_min  )/(n_T -1);
+        SetNodes( 0 );
+
+        unsigned long long hash = 14695981039346656037ULL;
+        int version = fFileVersion;
+        int    integers[] = { version, fQuantity, fA_projectile, fN_projectile, fA_target, fN_target, fParametrization, fCoalescence, fN_Tn, fN_T };
+        double doubles [] = { fP0, fLogTn_min, fLogTn_max, fLogT_min, fLogT_max };
+        table__hash( hash, integers, sizeof(integers) );
+        table__hash( hash, doubles,  sizeof(doubles)  );
+
+        //  parameter arrays at their lengths: C of the pp kernel (none for ANDERSON), 17 isospin parameters, D1 and D2 (with index 0).
+        //  Unknown parametrizations have no parameters (the table is 0).
+        XS_engine::Scope scope( *fEngine );
+        XS_setup setup( fA_projectile, fN_projectile, fA_target, fN_target, fParametrization );
+        if (setup.fKernel!=PP_KERNEL__NONE) {
+            table__hash( hash, setup.fC_array,         setup.fN_C*sizeof(double) );
+            table__hash( hash, setup.fC_array_isospin, 17*sizeof(double)         );
+            table__hash( hash, setup.fD_array,         3*sizeof(double)          );
+        }
+
+        const XS_engine& engine = *fEngine;
+        int    integration[] = { engine.fIntegrationMethod, engine.fIntegrationMethod_p, engine.fIntegrationMethod_antinuclei, engine.fTrapezeSteps, engine.fGaussLegendreNodes, engine.fIntegrationVariable };
+        table__hash( hash, integration, sizeof(integration) );
+        table__hash( hash, &engine.fIntegrationEpsrel, sizeof(double) );
+        if (engine.fIntegrationMethod==AUTOTUNE) {
+            table__hash_autotune( hash, engine.fAutotune );
+        }
+
+        int    restricted[] = { engine.fIsRestricted_pp, engine.fRestrictedParameterSpace_CM, engine.fRestrictedParameterSpace_LAB };
+        table__hash( hash, restricted, sizeof(restricted) );
+        const std::vector<double>& points_CM  = engine.fRestrictedParameterSpace_CM__hull .fPoints;
+        const std::vector<double>& points_LAB = engine.fRestrictedParameterSpace_LAB__hull.fPoints;
+        if (points_CM .size()) table__hash( hash, &points_CM [0], points_CM .size()*sizeof(double) );
+        if (points_LAB.size()) table__hash( hash, &points_LAB[0], points_LAB.size()*sizeof(double) );
+        fCacheKey = hash;
+    }
+
+
+    void XS_table::SetNodes( const double* nodes ){
+        int n = fN_Tn*fN_T;
+        fXS           = nodes;
+        fLogXS        = nodes ? nodes+1*n : 0;
+        fLogXS_dTn    = nodes ? nodes+2*n : 0;
+        fLogXS_dT     = nodes ? nodes+3*n : 0;
+        fLogXS_dTn_dT = nodes ? nodes+4*n : 0;
+    }
+
+
+    void XS_table::Tabulate(){
+
+        int n_Tn = fN_Tn;
+        int n_T  = fN_T;
+
+        std::vector<double> Tn( n_Tn );
+        std::vector<double> T ( n_T  );
+        for (int i=0; i<n_Tn; i++) Tn[i] = exp( fLogTn_min + i*fDeltaLogTn );
+        for (int j=0; j<n_T;  j++) T [j] = exp( fLogT_min  + j*fDeltaLogT  );
+        // avoid rounding at the upper limits
+        Tn[n_Tn-1] = exp( fLogTn_max );
+        T [n_T -1] = exp( fLogT_max  );
+
+        fNodes.assign( 5*n_Tn*n_T, 0 );
+        double* XS           = &fNodes[0];
+        double* LogXS        = XS          +n_Tn*n_T;
+        double* LogXS_dTn    = LogXS       +n_Tn*n_T;
+        double* LogXS_dT     = LogXS_dTn   +n_Tn*n_T;
+        double* LogXS_dTn_dT = LogXS_dT    +n_Tn*n_T;
+
+        Evaluate( n_Tn, &Tn[0], n_T, &T[0], XS );
+
+        //
+        //  log(XS) and its derivatives (finite differences, in units of the grid spacing). Nodes with vanishing XS are
+        //  excluded from the differences, if both neighbours are excluded the derivative is 0.
+        //
+        for (int k=0; k<n_Tn*n_T; k++) {
+            if (XS[k]>0) LogXS[k] = log( XS[k] );
+        }
+        for (int i=0; i<n_Tn; i++) {
+            for (int j=0; j<n_T; j++) {
+                int  k  = i*n_T+j;
+                if (!(XS[k]>0)) continue;
+                bool up = ( i+1<n_Tn && XS[k+n_T]>0 );
+                bool lo = ( i>0      && XS[k-n_T]>0 );
+                if      (up && lo)  LogXS_dTn[k] = slope( LogXS[k]-LogXS[k-n_T], LogXS[k+n_T]-LogXS[k] );
+                else if (up)        LogXS_dTn[k] =   LogXS[k+n_T]-LogXS[k];
+                else if (lo)        LogXS_dTn[k] =   LogXS[k]    -LogXS[k-n_T];
+                up = ( j+1<n_T && XS[k+1]>0 );
+                lo = ( j>0     && XS[k-1]>0 );
+                if      (up && lo)  LogXS_dT[k]  = slope( LogXS[k]-LogXS[k-1], LogXS[k+1]-LogXS[k] );
+                else if (up)        LogXS_dT[k]  =   LogXS[k+1]-LogXS[k];
+                else if (lo)        LogXS_dT[k]  =   LogXS[k]  -LogXS[k-1];
+            }
+        }
+        for (int i=0; i<n_Tn; i++) {
+            for (int j=0; j<n_T; j++) {
+                int  k  = i*n_T+j;
+                if (!(XS[k]>0)) continue;
+                bool up = ( i+1<n_Tn && XS[k+n_T]>0 );
+                bool lo = ( i>0      && XS[k-n_T]>0 );
+                if      (up && lo)  LogXS_dTn_dT[k] = ( LogXS_dT[k+n_T]-LogXS_dT[k-n_T] )/2.;
+                else if (up)        LogXS_dTn_dT[k] =   LogXS_dT[k+n_T]-LogXS_dT[k];
+                else if (lo)        LogXS_dTn_dT[k] =   LogXS_dT[k]    -LogXS_dT[k-n_T];
+            }
+        }
+
+        SetNodes( &fNodes[0] );
+    }
+
+
+    //  ------------------------------------------------------------- #
+    //   Cache files                                                  #
+    //  ------------------------------------------------------------- #
+
+    //
+    //  File layout: table__file_header, followed by the 5 node arrays (fXS, fLogXS, fLogXS_dTn, fLogXS_dT, fLogXS_dTn_dT)
+    //  at offset data_offset. All numbers in native byte order.
+    //
+    struct table__file_header{
+        char                magic[8];
+        int                 version;
+        int                 byte_order;
+        unsigned long long  key;
+        int                 quantity;
+        int                 A_projectile;
+        int                 N_projectile;
+        int                 A_target;
+        int                 N_target;
+        int                 parametrization;
+        int                 coalescence;
+        int                 n_Tn;
+        int                 n_T;
+        int                 data_offset;
+        double              p0_val;
+        double              logTn_min;
+        double              logTn_max;
+        double              logT_min;
+        double              logT_max;
+    };
+
+    static const char table__magic[8]      = { 'C', 'R', 'X', 'S', 'T', 'A', 'B', 0 };
+    static const int  table__byte_order    = 0x01020304;
+    static const int  table__data_offset   = 128;
+    static_assert( sizeof(table__file_header)<=table__data_offset, "table__file_header does not fit into the data offset" );
+
+
+    std::string XS_table::Get_CacheFile( const char* cache_directory ) const{
+        char name[64];
+        snprintf( name, sizeof(name), "crxs_table_v%i_%016llx.bin", fFileVersion, fCacheKey );
+        std::string dir( cache_directory );
+        if (dir.size()>0 && dir[dir.size()-1]!='/') dir += "/";
+        return dir+name;
+    }
+
+
+    bool XS_table::Save( const char* filename ) const{
+
+        if (!fXS) {
+            return false;
+        }
+
+        table__file_header header;
+        memset( &header, 0, sizeof(header) );
+        memcpy( header.magic, table__magic, sizeof(table__magic) );
+        header.version          = fFileVersion;
+        header.byte_order       = table__byte_order;
+        header.key              = fCacheKey;
+        header.quantity         = fQuantity;
+        header.A_projectile     = fA_projectile;
+        header.N_projectile     = fN_projectile;
+        header.A_target         = fA_target;
+        header.N_target         = fN_target;
+        header.parametrization  = fParametrization;
+        header.coalescence      = fCoalescence;
+        header.n_Tn             = fN_Tn;
+        header.n_T              = fN_T;
+        header.data_offset      = table__data_offset;
+        header.p0_val           = fP0;
+        header.logTn_min        = fLogTn_min;
+        header.logTn_max        = fLogTn_max;
+        header.logT_min         = fLogT_min;
+        header.logT_max         = fLogT_max;
+
+        char padding[table__data_offset];
+        memset( padding, 0, sizeof(padding) );
+        memcpy( padding, &header, sizeof(header) );
+
+        // write to a temporary file first, rename is atomic
+        char suffix[64];
+        snprintf( suffix, sizeof(suffix), ".tmp.%li", (long) getpid() );
+        std::string tmp = std::string(filename)+suffix;
+
+        FILE* file = fopen( tmp.c_str(), "wb" );
+        if (!file) {
+            printf( "Warning in CRXS::XS_table::Save. Cannot write file %s.\n", tmp.c_str() );
+            return false;
+        }
+        size_t n  = 5*(size_t)fN_Tn*fN_T;
+        bool   ok = fwrite( padding, 1, sizeof(padding), file )==sizeof(padding);
+        ok = ok && fwrite( fXS, sizeof(double), n, file )==n;
+        ok = ( fclose( file )==0 ) && ok;
+        if (!ok || rename( tmp.c_str(), filename )!=0) {
+            printf( "Warning in CRXS::XS_table::Save. Cannot write file %s.\n", filename );
+            remove( tmp.c_str() );
+            return false;
+        }
+        return true;
+    }
+
+
+    bool XS_table::Map( const char* filename ){
+
+        int fd = open( filename, O_RDONLY );
+        if (fd<0) {
+            return false;
+        }
+        struct stat st;
+        size_t size = 5*(size_t)fN_Tn*fN_T*sizeof(double) + table__data_offset;
+        if (fstat( fd, &st )!=0 || (size_t)st.st_size!=size) {
+            close( fd );
+            return false;
+        }
+        void* mapped = mmap( 0, size, PROT_READ, MAP_SHARED, fd, 0 );
+        close( fd );
+        if (mapped==MAP_FAILED) {
+            return false;
+        }
+
+        const table__file_header& header = *(const table__file_header*) mapped;
+        bool ok =    memcmp( header.magic, table__magic, sizeof(table__magic) )==0
+                  && header.version         == fFileVersion
+                  && header.byte_order      == table__byte_order
+                  && header.key             == fCacheKey
+                  && header.quantity        == fQuantity
+                  && header.A_projectile    == fA_projectile
+                  && header.N_projectile    == fN_projectile
+                  && header.A_target        == fA_target
+                  && header.N_target        == fN_target
+                  && header.parametrization == fParametrization
+                  && header.coalescence     == fCoalescence
+                  && header.n_Tn            == fN_Tn
+                  && header.n_T             == fN_T
+                  && header.data_offset     == table__data_offset
+                  && header.p0_val          == fP0
+                  && header.logTn_min       == fLogTn_min
+                  && header.logTn_max       == fLogTn_max
+                  && header.logT_min        == fLogT_min
+                  && header.logT_max        == fLogT_max;
+        if (!ok) {
+            printf( "Warning in CRXS::XS_table::Map. File %s does not match the table and is ignored.\n", filename );
+            munmap( mapped, size );
+            return false;
+        }
+
+        fMapped     = mapped;
+        fMappedSize = size;
+        SetNodes( (const double*)( (const char*) mapped + table__data_offset ) );
+        return true;
+    }
+
+
+    void XS_table::Evaluate( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_LAB, double* result ) const{
+        XS_engine::Scope scope( *fEngine );
+        if (!Evaluate_quantity( fQuantity, fA_projectile, fN_projectile, fA_target, fN_target, fParametrization, fCoalescence, fP0, n_Tn, Tn_proj_LAB, n_T, T_LAB, result, fThreads )) {
+            printf( "Warning in CRXS::XS_table::Evaluate. Quantity %i is not known.", fQuantity );
+        }
+    }
+
+
+    bool XS_table::Evaluate_quantity( int quantity, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_LAB, double* result, int n_threads ){
+        int A[] = { A_projectile };
+        int N[] = { N_projectile };
+        int At[]= { A_target     };
+        int Nt[]= { N_target     };
+        if        (quantity==TABLE__DE_AA_PBAR_LAB){
+            XS::grid__dE_AA_pbar_LAB                    ( n_Tn, Tn_proj_LAB, n_T, T_LAB, 1, A, N, At, Nt, result, parametrization, n_threads );
+        }else if  (quantity==TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON){
+            XS::grid__dE_AA_pbar_LAB_incNbarAndHyperon  ( n_Tn, Tn_proj_LAB, n_T, T_LAB, 1, A, N, At, Nt, result, parametrization, n_threads );
+        }else if  (quantity==TABLE__DE_AA_P_LAB){
+            XS::grid__dE_AA_p_LAB                       ( n_Tn, Tn_proj_LAB, n_T, T_LAB, 1, A, N, At, Nt, result, parametrization, n_threads );
+        }else if  (quantity==TABLE__DEN_AA_DBAR_LAB){
+            XS::grid__dEn_AA_Dbar_LAB                   ( n_Tn, Tn_proj_LAB, n_T, T_LAB, 1, A, N, At, Nt, result, parametrization, coalescence, p0_val, n_threads );
+        }else if  (quantity==TABLE__DEN_AA_HE3BAR_LAB){
+            XS::grid__dEn_AA_He3bar_LAB                 ( n_Tn, Tn_proj_LAB, n_T, T_LAB, 1, A, N, At, Nt, result, parametrization, coalescence, p0_val, n_threads );
+        }else if  (quantity==TABLE__DEN_AA_HE4BAR_LAB){
+            XS::grid__dEn_AA_He4bar_LAB                 ( n_Tn, Tn_proj_LAB, n_T, T_LAB, 1, A, N, At, Nt, result, parametrization, coalescence, p0_val, n_threads );
+        }else if  (quantity==TABLE__DE_PP_GAMMA_LAB){
+            XS::grid__dE_pp_gamma_LAB                   ( n_Tn, Tn_proj_LAB, n_T, T_LAB, result, n_threads );
+        }else{
+            for (int k=0; k<n_Tn*n_T; k++) result[k] = 0;
+            return false;
+        }
+        return true;
+    }
+
+
+    double XS_table::Interpolate_cell( int i, int j, double t, double u ) const{
+
+        int k00 = i*fN_T+j;
+        int k01 = k00+1;
+        int k10 = k00+fN_T;
+        int k11 = k10+1;
+
+        //  Threshold: bilinear in XS
+        if (!(fXS[k00]>0 && fXS[k01]>0 && fXS[k10]>0 && fXS[k11]>0)) {
+            return    (1-t)*(1-u)*fXS[k00] + (1-t)*u*fXS[k01]
+                    +    t *(1-u)*fXS[k10] +    t *u*fXS[k11];
+        }
+
+        //  Bicubic Hermite in log(XS)
+        double t2  = t*t,  t3 = t2*t;
+        double u2  = u*u,  u3 = u2*u;
+        double ht0 = 2*t3-3*t2+1,   ht1 = -2*t3+3*t2;       // value basis
+        double gt0 = t3-2*t2+t,     gt1 = t3-t2;            // derivative basis
+        double hu0 = 2*u3-3*u2+1,   hu1 = -2*u3+3*u2;
+        double gu0 = u3-2*u2+u,     gu1 = u3-u2;
+
+        double log_xs =   fLogXS       [k00]*ht0*hu0 + fLogXS       [k01]*ht0*hu1 + fLogXS       [k10]*ht1*hu0 + fLogXS       [k11]*ht1*hu1
+                        + fLogXS_dTn   [k00]*gt0*hu0 + fLogXS_dTn   [k01]*gt0*hu1 + fLogXS_dTn   [k10]*gt1*hu0 + fLogXS_dTn   [k11]*gt1*hu1
+                        + fLogXS_dT    [k00]*ht0*gu0 + fLogXS_dT    [k01]*ht0*gu1 + fLogXS_dT    [k10]*ht1*gu0 + fLogXS_dT    [k11]*ht1*gu1
+                        + fLogXS_dTn_dT[k00]*gt0*gu0 + fLogXS_dTn_dT[k01]*gt0*gu1 + fLogXS_dTn_dT[k10]*gt1*gu0 + fLogXS_dTn_dT[k11]*gt1*gu1;
+        return exp( log_xs );
+    }
+
+
+    double XS_table::Interpolate( double Tn_proj_LAB, double T_LAB ) const{
+        double x = ( log(Tn_proj_LAB)-fLogTn_min )/fDeltaLogTn;
+        double y = ( log(T_LAB)      -fLogT_min  )/fDeltaLogT;
+        // tolerate rounding at the limits
+        if ( !(x>=-1e-9 && x<=fN_Tn-1+1e-9 && y>=-1e-9 && y<=fN_T-1+1e-9) ) {
+            printf( "Warning in CRXS::XS_table::Interpolate. Tn_proj_LAB=%e, T_LAB=%e is outside of the table. Return 0.\n", Tn_proj_LAB, T_LAB );
+            return 0;
+        }
+        int i = (int) x;
+        int j = (int) y;
+        if (i<0)        i = 0;
+        if (i>fN_Tn-2)  i = fN_Tn-2;
+        if (j<0)        j = 0;
+        if (j>fN_T-2)   j = fN_T-2;
+        return Interpolate_cell( i, j, x-i, y-j );
+    }
+
+
+    void XS_table::Interpolate( int n, const double* Tn_proj_LAB, const double* T_LAB, double* result ) const{
+        for (int k=0; k<n; k++) {
+            result[k] = Interpolate( Tn_proj_LAB[k], T_LAB[k] );
+        }
+    }
+
+
+    double XS_table::Validate( int stride, double xs_fraction ){
+        if (stride<1) stride = 1;
+
+        std::vector<int>    cell_i;
+        std::vector<int>    cell_j;
+        std::vector<double> Tn;
+        std::vector<double> T;
+        for (int i=0; i<fN_Tn-1; i+=stride) {
+            cell_i.push_back( i );
+            Tn    .push_back( exp( fLogTn_min + (i+0.5)*fDeltaLogTn ) );
+        }
+        for (int j=0; j<fN_T-1;  j+=stride) {
+            cell_j.push_back( j );
+            T     .push_back( exp( fLogT_min  + (j+0.5)*fDeltaLogT  ) );
+        }
+        int n_Tn = Tn.size();
+        int n_T  = T .size();
+
+        std::vector<double> xs( n_Tn*n_T );
+        Evaluate( n_Tn, &Tn[0], n_T, &T[0], &xs[0] );
+
+        fMaxRelativeError    = 0;
+        fMaxRelativeError_Tn = 0;
+        fMaxRelativeError_T  = 0;
+        for (int a=0; a<n_Tn; a++) {
+            double xs_max = 0;
+            for (int b=0; b<n_T; b++) {
+                if (xs[a*n_T+b]>xs_max) xs_max = xs[a*n_T+b];
+            }
+            for (int b=0; b<n_T; b++) {
+                int k00 = cell_i[a]*fN_T+cell_j[b];
+                if (!(fXS[k00]>0 && fXS[k00+1]>0 && fXS[k00+fN_T]>0 && fXS[k00+fN_T+1]>0 && xs[a*n_T+b]>0)) {
+                    continue;
+                }
+                if (xs[a*n_T+b]<xs_fraction*xs_max) {
+                    continue;
+                }
+                double interpolated = Interpolate_cell( cell_i[a], cell_j[b], 0.5, 0.5 );
+                double deviation    = fabs( interpolated/xs[a*n_T+b]-1 );
+                if (deviation>fMaxRelativeError) {
+                    fMaxRelativeError    = deviation;
+                    fMaxRelativeError_Tn = Tn[a];
+                    fMaxRelativeError_T  = T [b];
+                }
+            }
+        }
+        return fMaxRelativeError;
+    }
+
+}
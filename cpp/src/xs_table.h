@@ -0,0 +1,195 @@
+#ifndef CRXS__XS_TABLE_H
+#define CRXS__XS_TABLE_H
+
+#include "vector"
+#include "string"
+
+#include "xs.h"
+
+namespace CRXS {
+
+    //! Energy-differential cross sections which can be tabulated with XS_table.
+    enum table_quantity{
+        TABLE__DE_AA_PBAR_LAB                       =  1,   // XS::dE_AA_pbar_LAB
+        TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON  =  2,   // XS::dE_AA_pbar_LAB_incNbarAndHyperon
+        TABLE__DE_AA_P_LAB                          =  3,   // XS::dE_AA_p_LAB
+        TABLE__DEN_AA_DBAR_LAB                      =  4,   // XS::dEn_AA_Dbar_LAB
+        TABLE__DEN_AA_HE3BAR_LAB                    =  5,   // XS::dEn_AA_He3bar_LAB
+        TABLE__DEN_AA_HE4BAR_LAB                    =  6,   // XS::dEn_AA_He4bar_LAB
+        TABLE__DE_PP_GAMMA_LAB                      =  7,   // XS::dE_pp_gamma_LAB (projectile: proton, product: gamma ray; species ignored)
+    };
+
+    //! Table of an energy-differential cross section on a logarithmic grid with bicubic interpolation in log space.
+    /*!
+     *  The constructor tabulates the cross section for one configuration (projectile, target, parametrization) on a grid
+     *  which is uniform in log(Tn_proj_LAB) and log(T_LAB), using the multi-threaded XS::grid__* functions. Interpolate
+     *  then evaluates a bicubic Hermite interpolation of log(XS) in log(Tn_proj_LAB) and log(T_LAB); the derivatives at the
+     *  grid nodes are finite differences, limited such that the interpolation is monotonic where the tabulated log(XS) is
+     *  monotonic (no overshooting at the steep kinematic limits). Cells with a vanishing cross section at one of the
+     *  corners (kinematic threshold) are interpolated bilinearly in the cross section itself.
+     *
+     *  Validate compares the interpolation to the direct integration in the centers of a subset of the cells and returns
+     *  the maximal relative deviation. The deviation is largest close to the kinematic limits, where the cross section
+     *  changes by orders of magnitude between neighbouring nodes; a finer grid or a cut on xs_fraction is required there.
+     *
+     *  Tables can be cached on disk: the constructor with a cache directory first looks for a file with the cache key of
+     *  the table (Get_CacheKey) in this directory. If it exists, the file is mapped read-only into memory (mmap) instead of
+     *  tabulating the cross section, such that all processes on a node share one physical copy of the table. Otherwise,
+     *  the table is tabulated and saved. The cache key covers the quantity, the parametrization and the content of its
+     *  parameter arrays (including the SELF parameters of the engine), the projectile and target, the coalescence model,
+     *  the grid, the integration settings (with the integration variable and the calibrated rules for AUTOTUNE), and the restricted parameter spaces. The files are in native byte order and
+     *  carry a format version (fFileVersion); files of another version or architecture are not used. The file is written
+     *  to a temporary file and renamed afterwards, so that processes which tabulate the same table at the same time do
+     *  not see incomplete files.
+     *
+     *  Usage:
+     *
+     *      XS_table table( TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON, 1, 1e7, 211, 0.1, 1e4, 151 );
+     *      double   error = table.Validate( 4, 1e-2 );
+     *      double   xs    = table.Interpolate( Tn_proj_LAB, T_pbar_LAB );
+     *
+     *      XS_table cached( "/scratch/crxs_tables", TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON, 1, 1e7, 211, 0.1, 1e4, 151 );
+     */
+    class XS_table{
+
+    public:
+
+        //! Version of the file format written by Save, increased with every incompatible change of the file format or the interpolation,
+        //! and with every change of the tabulated values which is not covered by the cache key (e.g. a correction of a cross section).
+        /*!
+         *  2: coalescence momentum of the antinuclei without the factor 1.0001
+         *  3: TRAPEZE integrates over the kinematically allowed eta interval
+         *  4: the cache key covers the integration variable
+         */
+        static const int fFileVersion = 4;
+
+        //! Constructor, tabulates the cross section
+        /*!
+         *  \param int    quantity         Tabulated cross section, enum from [TABLE__DE_AA_PBAR_LAB, TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON, TABLE__DE_AA_P_LAB, TABLE__DEN_AA_DBAR_LAB, TABLE__DEN_AA_HE3BAR_LAB, TABLE__DEN_AA_HE4BAR_LAB, TABLE__DE_PP_GAMMA_LAB]
+         *  \param double Tn_min           Minimal kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param double Tn_max           Maximal kinetic energy per nucleon of the projectile (in the LAB frame)
+         *  \param int    n_Tn             Number of grid points in Tn_proj_LAB, at least 2
+         *  \param double T_min            Minimal kinetic energy (per nucleon for antinuclei) of the product (in the LAB frame)
+         *  \param double T_max            Maximal kinetic energy (per nucleon for antinuclei) of the product (in the LAB frame)
+         *  \param int    n_T              Number of grid points in T_LAB, at least 2
+         *  \param int    A_projectile     Mass number of the projectile
+         *  \param int    N_projectile     Number of neutrons in the projectile
+         *  \param int    A_target         Mass number of the target
+         *  \param int    N_target         Number of neutrons in the target
+         *  \param int    parametrization  Cross section parametrization, cf. XS::dE_AA_pbar_LAB, XS::dE_AA_p_LAB, XS::dEn_AA_Dbar_LAB
+         *  \param int    coalescence      Coalescence model (antinuclei only)
+         *  \param double p0_val           Coalescence momentum in GeV (antinuclei only)
+         *  \param int    n_threads        Number of threads for the tabulation, 0: number of cores
+         */
+        XS_table( int quantity, double Tn_min, double Tn_max, int n_Tn, double T_min, double T_max, int n_T, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160, int n_threads=0 );
+
+        //! Constructor, maps the table from the cache directory or tabulates and saves it
+        /*!
+         *  \param const char* cache_directory   Directory of the cache files (has to exist)
+         *
+         *  All other parameters as above.
+         */
+        XS_table( const char* cache_directory, int quantity, double Tn_min, double Tn_max, int n_Tn, double T_min, double T_max, int n_T, int A_projectile=1, int N_projectile=0, int A_target=1, int N_target=0, int parametrization=KORSMEIER_II, int coalescence=ENERGY_DEP__VAN_DOETINCHEM, double p0_val=0.160, int n_threads=0 );
+
+        /// Destructor, unmaps the cache file
+        ~XS_table();
+
+        //! Interpolated cross section, 0 (with a warning) outside of the table
+        double Interpolate( double Tn_proj_LAB, double T_LAB ) const;
+        //! Interpolated cross section for n points, result has to be provided by the caller
+        void   Interpolate( int n, const double* Tn_proj_LAB, const double* T_LAB, double* result ) const;
+
+        //! Cross section computed directly (by integration) with the configuration of this table
+        void   Evaluate   ( int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_LAB, double* result ) const;
+
+        //! Cross section of a quantity on the grid Tn_proj_LAB x T_LAB, dispatched to the XS::grid__* function of the quantity.
+        /*!
+         *  Shared by XS_table and XS_matrix, evaluated with the engine of the calling thread. The arguments are the
+         *  configuration of the table (cf. the constructor); result has the layout of the XS::grid__* functions (one species).
+         *
+         *  \return bool                   false if the quantity is not known, result is set to 0 then
+         */
+        static bool Evaluate_quantity( int quantity, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_Tn, const double* Tn_proj_LAB, int n_T, const double* T_LAB, double* result, int n_threads );
+
+        //! Validates the interpolation in the centers of every stride-th cell in both directions.
+        /*!
+         *  The cross section is computed directly at the cell centers and compared to Interpolate. Cells at the kinematic
+         *  threshold (a corner with vanishing cross section) are skipped. Close to the kinematic limits the cross section
+         *  drops steeply and the relative deviation can be large; points where the cross section is below
+         *  xs_fraction times the maximum at the same projectile energy can be excluded.
+         *
+         *  \param int    stride           Validate every stride-th cell
+         *  \param double xs_fraction      Skip points with XS < xs_fraction * max_T( XS ), 0: validate all points
+         *
+         *  \return double                 Maximal relative deviation |Interpolate/XS-1|, also stored in fMaxRelativeError
+         */
+        double Validate( int stride=1, double xs_fraction=0 );
+
+        /// Maximal relative deviation found by Validate (-1 if not validated)
+        double Get_MaxRelativeError() const { return fMaxRelativeError; };
+
+        //! Writes the table to a file, returns false (with a warning) if the file cannot be written
+        bool   Save( const char* filename ) const;
+
+        /// Cache key of this table, computed with the state of fEngine at construction
+        unsigned long long Get_CacheKey() const { return fCacheKey; };
+        /// Name of the cache file of this table in the directory cache_directory
+        std::string        Get_CacheFile( const char* cache_directory ) const;
+        /// True if the table is mapped from a cache file
+        bool               isMapped() const { return fMapped!=0; };
+
+        int     fQuantity;
+        int     fA_projectile;
+        int     fN_projectile;
+        int     fA_target;
+        int     fN_target;
+        int     fParametrization;
+        int     fCoalescence;
+        double  fP0;
+        int     fThreads;
+        /// Engine of the thread which constructed this object (XS_engine::Current()), used for all direct evaluations
+        XS_engine* fEngine;
+
+        int     fN_Tn;
+        int     fN_T;
+        double  fLogTn_min;
+        double  fLogT_min;
+        double  fLogTn_max;
+        double  fLogT_max;
+        double  fDeltaLogTn;
+        double  fDeltaLogT;
+
+        double  fMaxRelativeError;
+        /// Position of fMaxRelativeError
+        double  fMaxRelativeError_Tn;
+        double  fMaxRelativeError_T;
+
+        unsigned long long fCacheKey;
+
+    private:
+
+        XS_table ( const XS_table& );
+        XS_table& operator= ( const XS_table& );
+
+        void    Setup     ( int quantity, double Tn_min, double Tn_max, int n_Tn, double T_min, double T_max, int n_T, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, double p0_val, int n_threads );
+        void    Tabulate  ();
+        bool    Map       ( const char* filename );
+        void    SetNodes  ( const double* nodes );
+
+        double  Interpolate_cell( int i, int j, double t, double u ) const;
+
+        // Nodes, index i*fN_T+j. The derivatives are in units of the grid spacing. The arrays point either to fNodes or
+        // to the mapped cache file, one after the other in this order.
+        const double*       fXS;
+        const double*       fLogXS;
+        const double*       fLogXS_dTn;
+        const double*       fLogXS_dT;
+        const double*       fLogXS_dTn_dT;
+
+        std::vector<double> fNodes;
+        void*               fMapped;
+        size_t              fMappedSize;
+    };
+}
+
+#endif
@@ -0,0 +1,120 @@
+//
+//  test_ensemble: ensemble evaluation against the batch functions with the SELF parameters.
+//
+//      - set k of XS::ensemble__inv_AA_pbar_CM and XS::ensemble__inv_AA_pbar_LAB is bit-equal to XS::batch__inv_AA_pbar_CM
+//        and XS::batch__inv_AA_pbar_LAB with the SELF parameters set to the parameters of set k
+//      - and agrees with the scalar XS::inv_AA_pbar_CM and XS::inv_AA_pbar_LAB within the tolerance of the SIMD kernels
+//        (bit-equal for SIMD_NONE), also at zero momentum (xF=0, pT=0) where the kinematic mask is sensitive to rounding
+//      - for WINKLER_SELF and DI_MAURO_SELF, pp, pA, Ap and AA collisions, and each SIMD level (levels which are not
+//        supported by the CPU are replaced by the best supported one, cf. CRXS_config::Get_SIMD)
+//      - the first sets are copies of the SELF parameters, the others vary all parameters (and the exponent C0 of the
+//        Winkler kernel); the number of sets is not a multiple of the SIMD width
+//
+//  Returns 0 if all checks pass.
+//
+
+#include "math.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "string"
+#include "vector"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_definitions.h"
+
+#include "test_tools.h"
+
+using namespace CRXS;
+
+
+//  Ensemble and scalar function: bit-equal for SIMD_NONE, otherwise both 0 or a relative deviation below 1e-12
+//  (cf. the accuracy of the batch kernels in xs_definitions.h)
+static bool test__close( double ensemble, double scalar, int simd ){
+    if (simd==SIMD_NONE || scalar==0 || ensemble==0) {
+        return ensemble==scalar;
+    }
+    return fabs( ensemble/scalar-1 )<1e-12;
+}
+
+
+int main(){
+
+    const int K = 13;       // sets, K%8!=0
+    const int n = 500;      // points
+    const int copies = 3;   // sets 0, 1, 2: SELF parameters
+
+    //  points, partly outside of the kinematically allowed range, every 10th point at zero momentum in the CM frame
+    std::vector<double> s( n ), xF( n ), pT( n ), Tn( n ), T( n ), eta( n );
+    for (int i=0; i<n; i++) {
+        s  [i] = pow( 10., 1.5 + 4.*( (i*37)%n )/n );
+        xF [i] = i%10==0 ? 0. : -0.6 + 1.5*( (i*53)%n )/n;
+        pT [i] = i%10==0 ? 0. :  0.05 + 3.*( (i*11)%n )/n;
+        Tn [i] = pow( 10., 0.7 + 3.5*( (i*37)%n )/n );
+        T  [i] = pow( 10.,-0.5 + 3.0*( (i*53)%n )/n );
+        eta[i] = -1. + 8.*( (i*11)%n )/n;
+    }
+
+    struct test__species{ int A_p, N_p, A_t, N_t; };
+    test__species species[] = { {1,0,1,0}, {1,0,12,6}, {4,2,1,0}, {4,2,4,2} };
+    const char*   simd_name[] = { "", "SIMD_NONE", "SIMD_SSE2", "SIMD_AVX2", "SIMD_AVX512" };
+
+    for (int kernel=0; kernel<2; kernel++) {
+        int         parametrization = kernel==0 ? WINKLER_SELF : DI_MAURO_SELF;
+        std::string name            = kernel==0 ? "WINKLER_SELF" : "DI_MAURO_SELF";
+        int         n_C             = kernel==0 ? 17 : 12;
+        double*     C_self          = kernel==0 ? XS_definitions::Winkler_SELF_C1_to_C16 : XS_definitions::diMauro_SELF_C1_to_C11;
+        double*     D_self          = kernel==0 ? XS_definitions::Winkler_SELF_D1_to_D2  : XS_definitions::diMauro_SELF_D1_to_D2;
+        double*     I_self          = XS_definitions::diMauro_SELF_C1_to_C16;   // isospin parameters of DI_MAURO_SELF
+
+        std::vector<double> C_0( C_self, C_self+n_C ), D_0( D_self, D_self+3 ), I_0( I_self, I_self+17 );
+        std::vector<double> C( K*n_C ), D( K*3 ), I( K*17 );
+        for (int k=0; k<K; k++) {
+            double v = k<copies ? 0 : 1;
+            for (int c=0; c<n_C; c++) C[k*n_C+c] = C_0[c]*( c==0 ? 1 : 1+v*0.02*sin( 1.3*k+c ) );
+            for (int d=0; d<3;   d++) D[k*3  +d] = D_0[d]*( 1+v*0.03*cos( k+d ) );
+            for (int c=0; c<17;  c++) I[k*17 +c] = I_0[c]*( 1+v*0.02*cos( 0.7*k+c ) );
+            if (kernel==0 && k>=copies && k%3==1) C[k*n_C] = 1.7;
+        }
+        const double* I_sets = kernel==0 ? 0 : &I[0];   // Winkler: isospin parameters from C_sets
+
+        for (int simd=SIMD_NONE; simd<=SIMD_AVX512; simd++) {
+            CRXS_config::SetupSIMD( simd );
+            bool equal_CM = true, equal_LAB = true, scalar_CM = true, scalar_LAB = true;
+            long non_zeros = 0;
+            for (int sp=0; sp<4; sp++) {
+                const test__species& c = species[sp];
+                std::vector<double> ensemble_CM( n*K ), ensemble_LAB( n*K ), batch_CM( n ), batch_LAB( n );
+                XS::ensemble__inv_AA_pbar_CM ( n, &s [0], &xF[0], &pT [0], &ensemble_CM [0], K, &C[0], &D[0], I_sets, c.A_p, c.N_p, c.A_t, c.N_t, parametrization );
+                XS::ensemble__inv_AA_pbar_LAB( n, &Tn[0], &T [0], &eta[0], &ensemble_LAB[0], K, &C[0], &D[0], I_sets, c.A_p, c.N_p, c.A_t, c.N_t, parametrization );
+                for (int k=0; k<K; k++) {
+                    memcpy( C_self, &C[k*n_C], n_C*sizeof(double) );
+                    memcpy( D_self, &D[k*3  ], 3  *sizeof(double) );
+                    if (kernel==1) memcpy( I_self, &I[k*17], 17*sizeof(double) );
+                    XS::batch__inv_AA_pbar_CM ( n, &s [0], &xF[0], &pT [0], &batch_CM [0], c.A_p, c.N_p, c.A_t, c.N_t, parametrization );
+                    XS::batch__inv_AA_pbar_LAB( n, &Tn[0], &T [0], &eta[0], &batch_LAB[0], c.A_p, c.N_p, c.A_t, c.N_t, parametrization );
+                    for (int i=0; i<n; i++) {
+                        equal_CM   = equal_CM   && ensemble_CM [(long)i*K+k]==batch_CM [i];
+                        equal_LAB  = equal_LAB  && ensemble_LAB[(long)i*K+k]==batch_LAB[i];
+                        scalar_CM  = scalar_CM  && test__close( ensemble_CM [(long)i*K+k], XS::inv_AA_pbar_CM ( s [i], xF[i], pT [i], c.A_p, c.N_p, c.A_t, c.N_t, parametrization ), simd );
+                        scalar_LAB = scalar_LAB && test__close( ensemble_LAB[(long)i*K+k], XS::inv_AA_pbar_LAB( Tn[i], T [i], eta[i], c.A_p, c.N_p, c.A_t, c.N_t, parametrization ), simd );
+                        non_zeros += ( batch_CM[i]!=0 ) + ( batch_LAB[i]!=0 );
+                    }
+                }
+                memcpy( C_self, &C_0[0], n_C*sizeof(double) );
+                memcpy( D_self, &D_0[0], 3  *sizeof(double) );
+                memcpy( I_self, &I_0[0], 17 *sizeof(double) );
+            }
+            std::string level = std::string( " (" )+simd_name[simd]+", used: "+simd_name[CRXS_config::Get_SIMD()]+")";
+            test__check( non_zeros>n*K, ( name+": cross sections are not empty"+level           ).c_str() );
+            test__check( equal_CM,      ( name+": ensemble__inv_AA_pbar_CM equals the batch"+level  ).c_str() );
+            test__check( equal_LAB,     ( name+": ensemble__inv_AA_pbar_LAB equals the batch"+level ).c_str() );
+            test__check( scalar_CM,     ( name+": ensemble__inv_AA_pbar_CM agrees with inv_AA_pbar_CM"+level   ).c_str() );
+            test__check( scalar_LAB,    ( name+": ensemble__inv_AA_pbar_LAB agrees with inv_AA_pbar_LAB"+level ).c_str() );
+        }
+        CRXS_config::SetupSIMD( SIMD_AUTO );
+    }
+
+    return test__result();
+}
@@ -0,0 +1,154 @@
+//
+//  test_gradient: analytic gradients of the pp kernels and of factor__AA against central finite differences.
+//
+//      - gradient__inv_pp_pbar_CM__Winkler for C5,...,C13 (parameters of KORSMEIER_I)
+//      - gradient__inv_pp_pbar_CM__diMauro for C1,...,C11 (parameters of DI_MAURO_I)
+//      - gradient__factor__AA for D1, D2 and C14,...,C16 (SELF parameters of WINKLER_SELF)
+//      - the values equal the functions without gradient and are positive at all test points
+//
+//  Returns 0 if all checks pass.
+//
+
+#include "math.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "string"
+#include "vector"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_definitions.h"
+
+#include "test_tools.h"
+
+using namespace CRXS;
+
+
+//  Points in the kinematically allowed range, below and above sqrt(s)=10 GeV (R factor of the Winkler kernel)
+struct test__point{ double s, E_pbar, pT_pbar; };
+
+static std::vector<test__point> test__points(){
+    double m_p = XS_definitions::fMass_proton;
+    double sqrt_s[] = { 6., 8., 20., 200. };
+    double f     [] = { 0.1, 0.4, 0.8 };
+    double pT    [] = { 0.1, 0.5, 1.5 };
+    std::vector<test__point> points;
+    for (int a=0; a<4; a++) {
+        for (int b=0; b<3; b++) {
+            for (int c=0; c<3; c++) {
+                //  E_pbar between m_T and the maximal energy
+                double s          = sqrt_s[a]*sqrt_s[a];
+                double E_pbar_Max = ( s-8.*m_p*m_p )/2./sqrt_s[a];
+                double m_T        = sqrt( m_p*m_p + pT[c]*pT[c] );
+                if (m_T < E_pbar_Max) {
+                    test__point p = { s, m_T + f[b]*( E_pbar_Max-m_T ), pT[c] };
+                    points.push_back( p );
+                }
+            }
+        }
+    }
+    return points;
+}
+
+//  |analytic - numerical| relative to the scale of the derivative, |XS|/max(|C|,1)
+static double test__deviation( double analytic, double numerical, double value, double C ){
+    return fabs( analytic-numerical )/( fabs( value )/fmax( fabs( C ), 1. ) );
+}
+
+//  Central difference with a relative step
+static double test__step( double C ){
+    return 1e-6*fmax( fabs( C ), 1e-2 );
+}
+
+
+int main(){
+
+    std::vector<test__point> points = test__points();
+    test__check( points.size()>20, "enough points in the kinematically allowed range" );
+
+    //  Winkler kernel
+    {
+        double C[17], gradient[17];
+        memcpy( C, XS_definitions::Get_C_parameters( KORSMEIER_I ), sizeof(C) );
+        double worst = 0;
+        bool   equal = true;
+        for (size_t k=0; k<points.size(); k++) {
+            const test__point& p = points[k];
+            double value = XS_definitions::gradient__inv_pp_pbar_CM__Winkler( p.s, p.E_pbar, p.pT_pbar, C, gradient );
+            equal = equal && value==XS_definitions::inv_pp_pbar_CM__Winkler( p.s, p.E_pbar, p.pT_pbar, C ) && value>0;
+            for (int i=5; i<=13; i++) {
+                double C_i = C[i], h = test__step( C_i );
+                C[i] = C_i+h;   double up   = XS_definitions::inv_pp_pbar_CM__Winkler( p.s, p.E_pbar, p.pT_pbar, C );
+                C[i] = C_i-h;   double down = XS_definitions::inv_pp_pbar_CM__Winkler( p.s, p.E_pbar, p.pT_pbar, C );
+                C[i] = C_i;
+                worst = fmax( worst, test__deviation( gradient[i], ( up-down )/( 2*h ), value, C_i ) );
+            }
+        }
+        printf( "        Winkler: max. deviation %.2e\n", worst );
+        test__check( equal,      "Winkler: value of the gradient function equals inv_pp_pbar_CM__Winkler (>0)" );
+        test__check( worst<1e-6, "Winkler: gradient C5,...,C13 agrees with central differences" );
+    }
+
+    //  di Mauro kernel
+    {
+        double C[12], gradient[12];
+        memcpy( C, XS_definitions::Get_C_parameters( DI_MAURO_I ), sizeof(C) );
+        double worst = 0;
+        bool   equal = true;
+        for (size_t k=0; k<points.size(); k++) {
+            const test__point& p = points[k];
+            double value = XS_definitions::gradient__inv_pp_pbar_CM__diMauro( p.s, p.E_pbar, p.pT_pbar, C, gradient );
+            equal = equal && value==XS_definitions::inv_pp_pbar_CM__diMauro( p.s, p.E_pbar, p.pT_pbar, C ) && value>0;
+            for (int i=1; i<=11; i++) {
+                double C_i = C[i], h = test__step( C_i );
+                C[i] = C_i+h;   double up   = XS_definitions::inv_pp_pbar_CM__diMauro( p.s, p.E_pbar, p.pT_pbar, C );
+                C[i] = C_i-h;   double down = XS_definitions::inv_pp_pbar_CM__diMauro( p.s, p.E_pbar, p.pT_pbar, C );
+                C[i] = C_i;
+                worst = fmax( worst, test__deviation( gradient[i], ( up-down )/( 2*h ), value, C_i ) );
+            }
+        }
+        printf( "        di Mauro: max. deviation %.2e\n", worst );
+        test__check( equal,      "di Mauro: value of the gradient function equals inv_pp_pbar_CM__diMauro (>0)" );
+        test__check( worst<1e-6, "di Mauro: gradient C1,...,C11 agrees with central differences" );
+    }
+
+    //  factor__AA, the SELF parameters are changed in place and restored
+    {
+        double* C = XS_definitions::Get_C_parameters_isospin( WINKLER_SELF );
+        double* D = XS_definitions::Get_D_parameters        ( WINKLER_SELF );
+        double  gradient_C[17], gradient_D[3];
+        struct test__nucleus{ int A, N; };
+        test__nucleus projectiles[] = { {1,0}, {4,2}, {12,6} };
+        test__nucleus targets    [] = { {1,0}, {4,2}, {56,30} };
+        double xF[] = { -0.5, -0.1, 0., 0.1, 0.5 };
+        double s [] = { 36., 400., 4e4 };
+        double worst_D = 0, worst_C = 0;
+        bool   equal   = true;
+        for (int a=0; a<3; a++) for (int b=0; b<3; b++) for (int c=0; c<5; c++) for (int d=0; d<3; d++) {
+            int A_p = projectiles[a].A, N_p = projectiles[a].N, A_t = targets[b].A, N_t = targets[b].N;
+            double value = XS_definitions::gradient__factor__AA( s[d], xF[c], A_p, N_p, A_t, N_t, WINKLER_SELF, gradient_C, gradient_D );
+            equal = equal && value==XS_definitions::factor__AA( s[d], xF[c], A_p, N_p, A_t, N_t, WINKLER_SELF ) && value>0;
+            for (int i=1; i<=2; i++) {
+                double D_i = D[i], h = test__step( D_i );
+                D[i] = D_i+h;   double up   = XS_definitions::factor__AA( s[d], xF[c], A_p, N_p, A_t, N_t, WINKLER_SELF );
+                D[i] = D_i-h;   double down = XS_definitions::factor__AA( s[d], xF[c], A_p, N_p, A_t, N_t, WINKLER_SELF );
+                D[i] = D_i;
+                worst_D = fmax( worst_D, test__deviation( gradient_D[i], ( up-down )/( 2*h ), value, D_i ) );
+            }
+            for (int i=14; i<=16; i++) {
+                double C_i = C[i], h = test__step( C_i );
+                C[i] = C_i+h;   double up   = XS_definitions::factor__AA( s[d], xF[c], A_p, N_p, A_t, N_t, WINKLER_SELF );
+                C[i] = C_i-h;   double down = XS_definitions::factor__AA( s[d], xF[c], A_p, N_p, A_t, N_t, WINKLER_SELF );
+                C[i] = C_i;
+                worst_C = fmax( worst_C, test__deviation( gradient_C[i], ( up-down )/( 2*h ), value, C_i ) );
+            }
+        }
+        printf( "        factor__AA: max. deviation %.2e (D), %.2e (C)\n", worst_D, worst_C );
+        test__check( equal,        "factor__AA: value of the gradient function equals factor__AA (>0)" );
+        test__check( worst_D<1e-6, "factor__AA: gradient D1, D2 agrees with central differences" );
+        test__check( worst_C<1e-6, "factor__AA: gradient C14,...,C16 agrees with central differences" );
+    }
+
+    return test__result();
+}
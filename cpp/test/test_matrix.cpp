@@ -0,0 +1,100 @@
+//
+//  test_matrix: XS_matrix against the XS::grid__* functions.
+//
+//      - every element of the matrix equals the grid function at the same energies (bit-equal, also with several
+//        threads), elements which are not stored are 0 in the grid
+//      - Multiply equals the dense product of the grid with the same vector
+//
+//  Returns 0 if all checks pass.
+//
+
+#include "math.h"
+#include "stdio.h"
+
+#include "string"
+#include "vector"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_matrix.h"
+
+#include "test_tools.h"
+
+using namespace CRXS;
+
+
+//  Logarithmic grid
+static std::vector<double> test__grid( double min, double max, int n ){
+    std::vector<double> grid( n );
+    for (int i=0; i<n; i++) grid[i] = min*pow( max/min, i/(n-1.) );
+    return grid;
+}
+
+//  Reference values from the XS::grid__* function of the quantity, layout result[i_Tn*n_T+i_T]
+static void test__reference( int quantity, int A_p, int N_p, int A_t, int N_t, int parametrization, const std::vector<double>& Tn, const std::vector<double>& T, double* result ){
+    int n_Tn = Tn.size(), n_T = T.size();
+    if (quantity==TABLE__DE_AA_PBAR_LAB)                        XS::grid__dE_AA_pbar_LAB                  ( n_Tn, &Tn[0], n_T, &T[0], 1, &A_p, &N_p, &A_t, &N_t, result, parametrization, 1 );
+    if (quantity==TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON)   XS::grid__dE_AA_pbar_LAB_incNbarAndHyperon( n_Tn, &Tn[0], n_T, &T[0], 1, &A_p, &N_p, &A_t, &N_t, result, parametrization, 1 );
+    if (quantity==TABLE__DE_AA_P_LAB)                           XS::grid__dE_AA_p_LAB                     ( n_Tn, &Tn[0], n_T, &T[0], 1, &A_p, &N_p, &A_t, &N_t, result, parametrization, 1 );
+    if (quantity==TABLE__DEN_AA_DBAR_LAB)                       XS::grid__dEn_AA_Dbar_LAB                 ( n_Tn, &Tn[0], n_T, &T[0], 1, &A_p, &N_p, &A_t, &N_t, result, parametrization, ENERGY_DEP__VAN_DOETINCHEM, 0.160, 1 );
+    if (quantity==TABLE__DE_PP_GAMMA_LAB)                       XS::grid__dE_pp_gamma_LAB                 ( n_Tn, &Tn[0], n_T, &T[0], result, 1 );
+}
+
+
+int main(){
+
+    CRXS_config::SetupIntegrationMethod ( GAUSS_LEGENDRE );
+    CRXS_config::SetupGaussLegendreNodes( 24 );
+
+    struct test__quantity{ const char* name; int quantity; int A_projectile; int N_projectile; int A_target; int N_target; int parametrization; };
+    test__quantity quantities[] = {
+        { "pbar",               TABLE__DE_AA_PBAR_LAB,                      1, 0, 1, 0, KORSMEIER_II },
+        { "pbar (nbar, hyp.)",  TABLE__DE_AA_PBAR_LAB_INC_NBAR_AND_HYPERON, 4, 2, 1, 0, KORSMEIER_II },
+        { "p",                  TABLE__DE_AA_P_LAB,                         1, 0, 4, 2, ANDERSON     },
+        { "Dbar",               TABLE__DEN_AA_DBAR_LAB,                     1, 0, 1, 0, KORSMEIER_II },
+        { "gamma",              TABLE__DE_PP_GAMMA_LAB,                     1, 0, 1, 0, KORSMEIER_II },
+    };
+
+    std::vector<double> T  = test__grid( 0.1,  100, 7 );
+    std::vector<double> Tn = test__grid( 5.,  1000, 6 );
+    int n_T  = T .size();
+    int n_Tn = Tn.size();
+
+    for (size_t q=0; q<sizeof(quantities)/sizeof(quantities[0]); q++) {
+        const test__quantity& c = quantities[q];
+        std::string name = c.name;
+
+        std::vector<double> grid( n_Tn*n_T );
+        test__reference( c.quantity, c.A_projectile, c.N_projectile, c.A_target, c.N_target, c.parametrization, Tn, T, &grid[0] );
+
+        int non_zeros = 0;
+        for (int k=0; k<n_Tn*n_T; k++) non_zeros += grid[k]!=0;
+        test__check( non_zeros>0, ( name+": grid is not empty" ).c_str() );
+
+        for (int n_threads=1; n_threads<=3; n_threads+=2) {
+            XS_matrix matrix( c.quantity, n_T, &T[0], n_Tn, &Tn[0], c.A_projectile, c.N_projectile, c.A_target, c.N_target, c.parametrization, ENERGY_DEP__VAN_DOETINCHEM, 0.160, n_threads );
+            std::string suffix = n_threads==1 ? " (1 thread)" : " (3 threads)";
+
+            bool equal = true;
+            for (int i=0; i<n_T; i++) {
+                for (int j=0; j<n_Tn; j++) {
+                    equal = equal && matrix.Get( i, j )==grid[j*n_T+i];
+                }
+            }
+            test__check( equal,                               ( name+": matrix rows equal the grid"+suffix          ).c_str() );
+            test__check( matrix.Get_NonZeros()==non_zeros,    ( name+": matrix stores the non-zero elements"+suffix ).c_str() );
+
+            std::vector<double> x( n_Tn ), y( n_T ), y_grid( n_T, 0 );
+            for (int j=0; j<n_Tn; j++) x[j] = 1./( j+1 );
+            matrix.Multiply( &x[0], &y[0] );
+            double deviation = 0;
+            for (int i=0; i<n_T; i++) {
+                for (int j=0; j<n_Tn; j++) y_grid[i] += grid[j*n_T+i]*x[j];
+                deviation = fmax( deviation, fabs( y[i]-y_grid[i] )/fmax( fabs( y_grid[i] ), 1e-300 ) );
+            }
+            test__check( deviation<1e-14,                     ( name+": Multiply equals the dense product"+suffix   ).c_str() );
+        }
+    }
+
+    return test__result();
+}
@@ -0,0 +1,96 @@
+//
+//  test_simd: vectorized pp kernels against the scalar functions at the edges of the kinematic range.
+//
+//      - XS::batch__inv_AA_pbar_CM equals XS::inv_AA_pbar_CM within the tolerance of the SIMD kernels at zero momentum
+//        of the antiproton (xF=0, pT=0), for the Winkler (KORSMEIER_II) and di Mauro (KORSMEIER_I) kernels
+//      - XS_definitions::batch__inv_pp_pbar_CM__Winkler and XS_definitions::batch__inv_pp_pbar_CM__diMauro equal the scalar
+//        kernels at the threshold s = 16 m_p^2 (0, not NaN) and at zero momentum
+//      - on each SIMD level (levels which are not supported by the CPU are replaced by the best supported one)
+//
+//  Returns 0 if all checks pass.
+//
+
+#include "math.h"
+#include "stdio.h"
+
+#include "string"
+#include "vector"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_definitions.h"
+
+#include "test_tools.h"
+
+using namespace CRXS;
+
+
+//  Both 0 or relative deviation below 1e-13 (cf. the accuracy of the batch kernels in xs_definitions.h)
+static bool test__equal( double batch, double scalar ){
+    if (scalar==0 || batch==0) {
+        return batch==scalar;
+    }
+    return fabs( batch/scalar-1 )<1e-13;
+}
+
+
+int main(){
+
+    const char* simd_name[] = { "", "SIMD_NONE", "SIMD_SSE2", "SIMD_AVX2", "SIMD_AVX512" };
+    double      m_p         = XS_definitions::fMass_proton;
+
+    //  zero momentum in the CM frame, n is not a multiple of the SIMD width
+    std::vector<double> s, xF, pT;
+    for (int i=0; i<13; i++) {
+        s .push_back( 20.*pow( 1e4/20., i/12. ) );
+        xF.push_back( 0. );
+        pT.push_back( 0. );
+    }
+    int n = s.size();
+
+    //  pp kernels: threshold (E_pbar=m_p, x_R=1) and zero momentum
+    double s_th = 16*m_p*m_p;
+    std::vector<double> s_pp, E_pp, pT_pp;
+    s_pp.push_back( s_th );                     E_pp.push_back( m_p );          pT_pp.push_back( 0.  );
+    s_pp.push_back( s_th );                     E_pp.push_back( m_p*(1+1e-9) ); pT_pp.push_back( 0.  );
+    s_pp.push_back( s_th*(1+1e-6) );            E_pp.push_back( m_p );          pT_pp.push_back( 0.  );
+    s_pp.push_back( 100. );                     E_pp.push_back( m_p );          pT_pp.push_back( 0.  );
+    s_pp.push_back( 1e4 );                      E_pp.push_back( m_p );          pT_pp.push_back( 0.  );
+    int n_pp = s_pp.size();
+
+    struct test__kernel{ const char* name; int parametrization; };
+    test__kernel kernels[] = { { "Winkler (KORSMEIER_II)", KORSMEIER_II }, { "di Mauro (KORSMEIER_I)", KORSMEIER_I } };
+
+    for (int simd=SIMD_NONE; simd<=SIMD_AVX512; simd++) {
+        CRXS_config::SetupSIMD( simd );
+        std::string level = std::string( " (" )+simd_name[simd]+", used: "+simd_name[CRXS_config::Get_SIMD()]+")";
+
+        for (int k=0; k<2; k++) {
+            std::string name = kernels[k].name;
+            std::vector<double> batch( n );
+            XS::batch__inv_AA_pbar_CM( n, &s[0], &xF[0], &pT[0], &batch[0], 1, 0, 1, 0, kernels[k].parametrization );
+            bool equal = true, positive = true;
+            for (int i=0; i<n; i++) {
+                double scalar = XS::inv_AA_pbar_CM( s[i], xF[i], pT[i], 1, 0, 1, 0, kernels[k].parametrization );
+                equal    = equal    && test__equal( batch[i], scalar );
+                positive = positive && scalar>0;
+            }
+            test__check( positive, ( name+": scalar cross section at zero momentum is positive"+level          ).c_str() );
+            test__check( equal,    ( name+": batch__inv_AA_pbar_CM equals the scalar function at zero momentum"+level ).c_str() );
+        }
+
+        std::vector<double> batch_W( n_pp ), batch_D( n_pp );
+        XS_definitions::batch__inv_pp_pbar_CM__Winkler( n_pp, &s_pp[0], &E_pp[0], &pT_pp[0], &batch_W[0], XS_definitions::Get_C_parameters( KORSMEIER_II ) );
+        XS_definitions::batch__inv_pp_pbar_CM__diMauro( n_pp, &s_pp[0], &E_pp[0], &pT_pp[0], &batch_D[0], XS_definitions::Get_C_parameters( KORSMEIER_I  ) );
+        bool equal_W = true, equal_D = true;
+        for (int i=0; i<n_pp; i++) {
+            equal_W = equal_W && test__equal( batch_W[i], XS_definitions::inv_pp_pbar_CM__Winkler( s_pp[i], E_pp[i], pT_pp[i], XS_definitions::Get_C_parameters( KORSMEIER_II ) ) );
+            equal_D = equal_D && test__equal( batch_D[i], XS_definitions::inv_pp_pbar_CM__diMauro( s_pp[i], E_pp[i], pT_pp[i], XS_definitions::Get_C_parameters( KORSMEIER_I  ) ) );
+        }
+        test__check( equal_W, ( "Winkler: batch kernel equals the scalar kernel at the threshold and zero momentum"+level  ).c_str() );
+        test__check( equal_D, ( "di Mauro: batch kernel equals the scalar kernel at the threshold and zero momentum"+level ).c_str() );
+    }
+    CRXS_config::SetupSIMD( SIMD_AUTO );
+
+    return test__result();
+}
@@ -0,0 +1,132 @@
+//
+//  test_table: XS_table cache files.
+//
+//      - a table saved to the cache directory is mapped by a second table with the same configuration, and both
+//        interpolate the same values, which agree with the direct evaluation at the nodes
+//      - the cache key changes with the integration settings (including the AUTOTUNE calibration) and the parameters of the parametrization
+//
+//  Returns 0 if all checks pass.
+//
+
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+#include "string"
+#include "vector"
+
+#include "crxs.h"
+#include "xs.h"
+#include "xs_definitions.h"
+#include "xs_table.h"
+#include "xs_autotune.h"
+
+#include "test_tools.h"
+
+using namespace CRXS;
+
+
+//  Cache key of a small table with the current settings
+static unsigned long long test__key( int parametrization=KORSMEIER_II ){
+    XS_table table( TABLE__DE_AA_PBAR_LAB, 10, 1e3, 2, 0.5, 50, 2, 1, 0, 12, 6, parametrization, ENERGY_DEP__VAN_DOETINCHEM, 0.160, 1 );
+    return table.Get_CacheKey();
+}
+
+
+int main(){
+
+    char directory[] = "/tmp/crxs_test_table_XXXXXX";
+    if (!mkdtemp( directory )) {
+        printf( "FAILED  cannot create a temporary directory\n" );
+        return 1;
+    }
+
+    CRXS_config::SetupIntegrationMethod ( GAUSS_LEGENDRE );
+    CRXS_config::SetupGaussLegendreNodes( 24 );
+
+    const int    n_Tn   = 5;
+    const int    n_T    = 6;
+    const double Tn_min = 10,  Tn_max = 1e3;
+    const double T_min  = 0.5, T_max  = 50;
+
+    XS_table saved ( directory, TABLE__DE_AA_PBAR_LAB, Tn_min, Tn_max, n_Tn, T_min, T_max, n_T, 1, 0, 1, 0, KORSMEIER_II, ENERGY_DEP__VAN_DOETINCHEM, 0.160, 1 );
+    XS_table mapped( directory, TABLE__DE_AA_PBAR_LAB, Tn_min, Tn_max, n_Tn, T_min, T_max, n_T, 1, 0, 1, 0, KORSMEIER_II, ENERGY_DEP__VAN_DOETINCHEM, 0.160, 1 );
+    test__check( !saved.isMapped() && mapped.isMapped(),            "second table is mapped from the cache file" );
+    test__check( saved.Get_CacheKey()==mapped.Get_CacheKey(),       "same cache key for the same configuration" );
+
+    //  nodes and cell centers
+    std::vector<double> Tn, T;
+    for (int i=0; i<2*n_Tn-1; i++) Tn.push_back( Tn_min*pow( Tn_max/Tn_min, i/(2.*n_Tn-2) ) );
+    for (int j=0; j<2*n_T -1; j++) T .push_back( T_min *pow( T_max /T_min,  j/(2.*n_T -2) ) );
+    int identical = 1;
+    for (size_t i=0; i<Tn.size(); i++) {
+        for (size_t j=0; j<T.size(); j++) {
+            if (saved.Interpolate( Tn[i], T[j] )!=mapped.Interpolate( Tn[i], T[j] )) identical = 0;
+        }
+    }
+    test__check( identical, "saved and mapped table interpolate identical values" );
+
+    std::vector<double> Tn_nodes, T_nodes;
+    for (size_t i=0; i<Tn.size(); i+=2) Tn_nodes.push_back( Tn[i] );
+    for (size_t j=0; j<T .size(); j+=2) T_nodes .push_back( T [j] );
+    std::vector<double> direct( n_Tn*n_T );
+    mapped.Evaluate( n_Tn, &Tn_nodes[0], n_T, &T_nodes[0], &direct[0] );
+    double deviation = 0;
+    for (int i=0; i<n_Tn; i++) {
+        for (int j=0; j<n_T; j++) {
+            double xs = direct[i*n_T+j];
+            double ip = mapped.Interpolate( Tn_nodes[i], T_nodes[j] );
+            if (xs>0) deviation = fmax( deviation, fabs( ip/xs-1 ) );
+            else if (ip!=0) deviation = 1;
+        }
+    }
+    test__check( direct[(n_Tn-1)*n_T]>0, "table is not empty" );
+    test__check( deviation<1e-12, "mapped table agrees with the direct evaluation at the nodes" );
+
+    //  cache key of the same configuration after each change of the integration settings
+    unsigned long long key = test__key();
+    struct test__setting{ const char* name; void (*change)(); };
+    test__setting settings[] = {
+        { "integration method",   [](){ CRXS_config::SetupIntegrationMethod  ( TRAPEZE      ); } },
+        { "Gauss-Legendre nodes", [](){ CRXS_config::SetupGaussLegendreNodes ( 32           ); } },
+        { "integration accuracy", [](){ CRXS_config::SetupIntegrationAccuracy( 1e-6         ); } },
+        { "integration variable", [](){ CRXS_config::SetupIntegrationVariable( RAPIDITY_LAB ); } },
+    };
+    for (size_t k=0; k<sizeof(settings)/sizeof(settings[0]); k++) {
+        settings[k].change();
+        unsigned long long changed = test__key();
+        test__check( changed!=key, ( std::string("cache key changes with the ")+settings[k].name ).c_str() );
+        key = changed;
+    }
+
+    //  AUTOTUNE: the key covers the calibrated rules, also if the calibration object is recalibrated
+    XS_autotune autotune;
+    autotune.Calibrate( 1e-2, 1, 10, 1e3, 1, 0.5, 50, 1 );
+    CRXS_config::SetupAutotune( &autotune );
+    CRXS_config::SetupIntegrationMethod( AUTOTUNE );
+    key = test__key();
+    autotune.Calibrate( 1e-4, 2, 10, 1e3, 1, 0.5, 50, 1 );
+    test__check( test__key()!=key,                          "cache key changes with the AUTOTUNE calibration" );
+    CRXS_config::SetupIntegrationMethod( GAUSS_LEGENDRE );
+    CRXS_config::SetupAutotune( 0 );
+
+    //  parameters: all 12 (17) parameters of the di Mauro (Winkler) SELF parametrization enter the key, parametrizations
+    //  without pp kernel have no parameters
+    key = test__key( DI_MAURO_SELF );
+    XS_definitions::diMauro_SELF_C1_to_C11[11] += 0.01;
+    test__check( test__key( DI_MAURO_SELF )!=key,           "cache key changes with C11 of DI_MAURO_SELF" );
+    XS_definitions::diMauro_SELF_C1_to_C11[11] -= 0.01;
+    test__check( test__key( DI_MAURO_SELF )==key,           "cache key of DI_MAURO_SELF is reproducible" );
+    key = test__key( WINKLER_SELF );
+    XS_definitions::Winkler_SELF_C1_to_C16[16] *= 1.01;
+    test__check( test__key( WINKLER_SELF )!=key,            "cache key changes with C16 of WINKLER_SELF" );
+    XS_definitions::Winkler_SELF_C1_to_C16[16] /= 1.01;
+    test__check( test__key( 99 )==test__key( 99 ),          "cache key of an unknown parametrization is reproducible" );
+
+    std::string command = std::string("rm -rf ")+directory;
+    if (system( command.c_str() )!=0) {
+        printf( "Warning: %s could not be removed\n", directory );
+    }
+    return test__result();
+}
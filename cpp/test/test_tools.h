@@ -0,0 +1,26 @@
+#ifndef CRXS__TEST_TOOLS_H
+#define CRXS__TEST_TOOLS_H
+
+//
+//  Checks of the regression tests: every test prints one line per check and returns test__result() from main,
+//  which is 0 if all checks pass (ctest).
+//
+
+#include "stdio.h"
+
+
+static int test__failed = 0;
+
+//  Prints the result of a check, failed checks are counted
+static void test__check( bool passed, const char* what ){
+    printf( "%s  %s\n", passed ? "passed" : "FAILED", what );
+    if (!passed) test__failed++;
+}
+
+//  Prints the number of failed checks, returns the exit code of the test
+static int test__result(){
+    printf( "%i checks failed\n", test__failed );
+    return test__failed ? 1 : 0;
+}
+
+#endif
@@ -2,12 +2,35 @@
 #include "xs.h"
 #include "crxs.h"
 #include "xs_definitions.h"
+#include "xs_engine.h"
+#include "xs_setup.h"
+#include "xs_source.h"
 #include <iostream>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <functional>
 
 
 void SetIntegrationMethod( int method ){
     CRXS::CRXS_config::SetupIntegrationMethod(method);
 };
+void SetIntegrationMethod_p( int method ){
+    CRXS::CRXS_config::SetupIntegrationMethod_p(method);
+};
+void SetIntegrationMethod_antinuclei( int method ){
+    CRXS::CRXS_config::SetupIntegrationMethod_antinuclei(method);
+};
+void SetIntegrationAccuracy( double epsrel ){
+    CRXS::CRXS_config::SetupIntegrationAccuracy(epsrel);
+};
+void SetGaussLegendreNodes( int nodes ){
+    CRXS::CRXS_config::SetupGaussLegendreNodes(nodes);
+};
+void SetIntegrationVariable( int variable ){
+    CRXS::CRXS_config::SetupIntegrationVariable(variable);
+};
 void SetTrapezeIntegrationSteps( int steps ){
     CRXS::Integration::SetTrapezeIntegrationSteps( steps );
 };
@@ -80,6 +103,10 @@ double dE_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, int A_projectile, int N_
     return CRXS::XS::dE_AA_p_LAB( Tn_proj_LAB, T_p_LAB, A_projectile, N_projectile, A_target, N_target, parametrization);
 };
 
+double dE_pp_gamma_LAB( double T_p_LAB, double E_gamma_LAB ){
+    return CRXS::XS::dE_pp_gamma_LAB( T_p_LAB, E_gamma_LAB );
+};
+
 void set_C_winkler_self(double* C_array, int len_C_array){
     for (int i=0; i<len_C_array; i++) {
         std::cout << CRXS::XS_definitions::XS_definitions::Winkler_SELF_C1_to_C16[i] << std::endl;
@@ -92,3 +119,255 @@ void set_D_winkler_self(double* D_array, int len_D_array){
         CRXS::XS_definitions::XS_definitions::Winkler_SELF_D1_to_D2[i] = D_array[i];
     }
 };
+
+
+
+// arrays
+
+typedef std::function<void(int begin, int end)> array__chunk_function;
+
+struct array__job{
+    int                     n;
+    int                     chunk;
+    array__chunk_function   function;
+    CRXS::XS_engine*        engine;
+    std::atomic<int>        next;
+};
+
+static void array__worker( array__job* job ){
+    CRXS::XS_engine::Scope scope( *job->engine );
+    for (int begin = job->next.fetch_add(job->chunk); begin<job->n; begin = job->next.fetch_add(job->chunk)) {
+        int end = begin+job->chunk < job->n ? begin+job->chunk : job->n;
+        job->function( begin, end );
+    }
+}
+
+//  Chunks are handed out dynamically, since the cost of the angular integrations varies strongly over the parameter space.
+static void array__run( int n, int chunk, int n_threads, const array__chunk_function& function ){
+    if (n<=0) {
+        return;
+    }
+    if (n_threads<=0) {
+        n_threads = std::thread::hardware_concurrency();
+    }
+    if (n_threads<=0) {
+        n_threads = 1;
+    }
+    if (n_threads>(n+chunk-1)/chunk) {
+        n_threads = (n+chunk-1)/chunk;
+    }
+    array__job job;
+    job.n        = n;
+    job.chunk    = chunk;
+    job.function = function;
+    job.engine   = &CRXS::XS_engine::Current();
+    job.next     = 0;
+    if (n_threads==1) {
+        array__worker( &job );
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (int t=0; t<n_threads; t++) {
+        threads.push_back( std::thread( array__worker, &job ) );
+    }
+    for (int t=0; t<n_threads; t++) {
+        threads[t].join();
+    }
+}
+
+static bool array__check( const char* function, int n_result, int n_1, int n_2=-1, int n_3=-1 ){
+    if ( n_1!=n_result || (n_2>=0 && n_2!=n_result) || (n_3>=0 && n_3!=n_result) ) {
+        printf( "Warning in xs_wrapper::%s. The arrays have different lengths, nothing is computed.\n", function );
+        return false;
+    }
+    return true;
+}
+
+//  Chunk sizes: the batch functions of the invariant cross sections profit from long chunks,
+//  the angular integrations are distributed in small chunks to balance the threads.
+static const int array__chunk_inv = 1024;
+static const int array__chunk_dE  = 8;
+
+
+void array__tot_pp__diMauro( double* s, int n_s, double* result, int n_result, int n_threads ){
+    if (!array__check( "array__tot_pp__diMauro", n_result, n_s )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS_definitions::tot_pp__diMauro( s[i] );
+    });
+};
+void array__el_pp__diMauro( double* s, int n_s, double* result, int n_result, int n_threads ){
+    if (!array__check( "array__el_pp__diMauro", n_result, n_s )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS_definitions::el_pp__diMauro( s[i] );
+    });
+};
+
+
+// pbar
+void array__inv_AA_pbar_CM( double* s, int n_s, double* xF, int n_xF, double* pT_pbar, int n_pT_pbar, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__inv_AA_pbar_CM", n_result, n_s, n_xF, n_pT_pbar )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS::batch__inv_AA_pbar_CM( end-begin, s+begin, xF+begin, pT_pbar+begin, result+begin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+void array__inv_AA_pbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__inv_AA_pbar_LAB", n_result, n_Tn_proj_LAB, n_T_pbar_LAB, n_eta_LAB )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS::batch__inv_AA_pbar_LAB( end-begin, Tn_proj_LAB+begin, T_pbar_LAB+begin, eta_LAB+begin, result+begin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+void array__dE_AA_pbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__dE_AA_pbar_LAB", n_result, n_Tn_proj_LAB, n_T_pbar_LAB )) return;
+    array__run( n_result, array__chunk_dE, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS::dE_AA_pbar_LAB( Tn_proj_LAB[i], T_pbar_LAB[i], A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+void array__dE_AA_pbar_LAB_incNbarAndHyperon( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__dE_AA_pbar_LAB_incNbarAndHyperon", n_result, n_Tn_proj_LAB, n_T_pbar_LAB )) return;
+    array__run( n_result, array__chunk_dE, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS::dE_AA_pbar_LAB_incNbarAndHyperon( Tn_proj_LAB[i], T_pbar_LAB[i], A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+
+
+// Dbar
+void array__inv_AA_Dbar_CM( double* s, int n_s, double* xF_Dbar, int n_xF_Dbar, double* pT_Dbar, int n_pT_Dbar, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, int n_threads ){
+    if (!array__check( "array__inv_AA_Dbar_CM", n_result, n_s, n_xF_Dbar, n_pT_Dbar )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS::batch__inv_AA_Dbar_CM( end-begin, s+begin, xF_Dbar+begin, pT_Dbar+begin, result+begin, A_projectile, N_projectile, A_target, N_target, parametrization, coalescence );
+    });
+};
+void array__inv_AA_Dbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, int n_threads ){
+    if (!array__check( "array__inv_AA_Dbar_LAB", n_result, n_Tn_proj_LAB, n_Tn_Dbar_LAB, n_eta_LAB )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS::batch__inv_AA_Dbar_LAB( end-begin, Tn_proj_LAB+begin, Tn_Dbar_LAB+begin, eta_LAB+begin, result+begin, A_projectile, N_projectile, A_target, N_target, parametrization, coalescence );
+    });
+};
+void array__dEn_AA_Dbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, int n_threads ){
+    if (!array__check( "array__dEn_AA_Dbar_LAB", n_result, n_Tn_proj_LAB, n_Tn_Dbar_LAB )) return;
+    array__run( n_result, array__chunk_dE, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS::dEn_AA_Dbar_LAB( Tn_proj_LAB[i], Tn_Dbar_LAB[i], A_projectile, N_projectile, A_target, N_target, parametrization, coalescence );
+    });
+};
+
+void array__dEn_DbarA_Dbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB, double* result, int n_result, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__dEn_DbarA_Dbar_LAB", n_result, n_Tn_proj_LAB, n_Tn_Dbar_LAB )) return;
+    array__run( n_result, array__chunk_dE, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS::dEn_DbarA_Dbar_LAB( Tn_proj_LAB[i], Tn_Dbar_LAB[i], A_target, N_target, parametrization );
+    });
+};
+
+
+// p
+void array__inv_AA_p_CM( double* s, int n_s, double* xF, int n_xF, double* pT_p, int n_pT_p, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__inv_AA_p_CM", n_result, n_s, n_xF, n_pT_p )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS::batch__inv_AA_p_CM( end-begin, s+begin, xF+begin, pT_p+begin, result+begin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+void array__inv_AA_p_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_p_LAB, int n_T_p_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__inv_AA_p_LAB", n_result, n_Tn_proj_LAB, n_T_p_LAB, n_eta_LAB )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS::batch__inv_AA_p_LAB( end-begin, Tn_proj_LAB+begin, T_p_LAB+begin, eta_LAB+begin, result+begin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+void array__dE_AA_p_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_p_LAB, int n_T_p_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__dE_AA_p_LAB", n_result, n_Tn_proj_LAB, n_T_p_LAB )) return;
+    array__run( n_result, array__chunk_dE, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; i++) result[i] = CRXS::XS::dE_AA_p_LAB( Tn_proj_LAB[i], T_p_LAB[i], A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+
+
+//  Gradients: n_C derivatives per point
+static bool array__check_gradient( const char* function, int n_result, int n_gradient, int n_C, int len_C_array ){
+    if (n_gradient!=n_result*n_C || len_C_array<n_C) {
+        printf( "Warning in xs_wrapper::%s. The gradient needs %i parameters and %i elements per point, nothing is computed.\n", function, n_C, n_C );
+        return false;
+    }
+    return true;
+}
+void array__gradient__inv_pp_pbar_CM__Winkler( double* s, int n_s, double* E_pbar, int n_E_pbar, double* pT_pbar, int n_pT_pbar, double* result, int n_result, double* gradient, int n_gradient, double* C_array, int len_C_array, int n_threads ){
+    if (!array__check( "array__gradient__inv_pp_pbar_CM__Winkler", n_result, n_s, n_E_pbar, n_pT_pbar )) return;
+    if (!array__check_gradient( "array__gradient__inv_pp_pbar_CM__Winkler", n_result, n_gradient, 17, len_C_array )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS_definitions::batch__gradient__inv_pp_pbar_CM__Winkler( end-begin, s+begin, E_pbar+begin, pT_pbar+begin, result+begin, gradient+17*(long)begin, C_array );
+    });
+};
+void array__gradient__inv_pp_pbar_CM__diMauro( double* s, int n_s, double* E_pbar, int n_E_pbar, double* pT_pbar, int n_pT_pbar, double* result, int n_result, double* gradient, int n_gradient, double* C_array, int len_C_array, int n_threads ){
+    if (!array__check( "array__gradient__inv_pp_pbar_CM__diMauro", n_result, n_s, n_E_pbar, n_pT_pbar )) return;
+    if (!array__check_gradient( "array__gradient__inv_pp_pbar_CM__diMauro", n_result, n_gradient, 12, len_C_array )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS_definitions::batch__gradient__inv_pp_pbar_CM__diMauro( end-begin, s+begin, E_pbar+begin, pT_pbar+begin, result+begin, gradient+12*(long)begin, C_array );
+    });
+};
+void array__gradient__factor__AA( double* s, int n_s, double* xF, int n_xF, double* result, int n_result, double* gradient_C, int n_gradient_C, double* gradient_D, int n_gradient_D, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__gradient__factor__AA", n_result, n_s, n_xF )) return;
+    if (!array__check_gradient( "array__gradient__factor__AA", n_result, n_gradient_C, 17, 17 ) || !array__check_gradient( "array__gradient__factor__AA", n_result, n_gradient_D, 3, 3 )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        CRXS::XS_definitions::batch__gradient__factor__AA( end-begin, s+begin, xF+begin, result+begin, gradient_C+17*(long)begin, gradient_D+3*(long)begin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+
+
+// ensembles: K parameter sets (rows of C_sets, D_sets, C_isospin_sets; empty arrays: null, cf. XS::ensemble__inv_AA_pbar_CM), result[i*K+k]
+static bool array__check_ensemble( const char* function, int n, int n_result, int K, int n_C_sets, int n_D_sets, int n_C_isospin_sets, int parametrization ){
+    int n_C = CRXS::XS_setup( 1, 0, 1, 0, parametrization ).fN_C;
+    if (K<=0 || n_C==0 || (long)n*K!=n_result || n_C_sets!=K*n_C || (n_D_sets>0 && n_D_sets!=K*3) || (n_C_isospin_sets>0 && n_C_isospin_sets!=K*17)) {
+        printf( "Warning in xs_wrapper::%s. The parameter sets need %i (C), 3 (D), and 17 (C isospin) parameters per set and the result %i elements per point, nothing is computed.\n", function, n_C, K );
+        return false;
+    }
+    return true;
+}
+void array__ensemble__inv_AA_pbar_CM( double* s, int n_s, double* xF, int n_xF, double* pT_pbar, int n_pT_pbar, double* result, int n_result, double* C_sets, int n_C_sets, double* D_sets, int n_D_sets, double* C_isospin_sets, int n_C_isospin_sets, int K, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__ensemble__inv_AA_pbar_CM", n_s, n_xF, n_pT_pbar )) return;
+    if (!array__check_ensemble( "array__ensemble__inv_AA_pbar_CM", n_s, n_result, K, n_C_sets, n_D_sets, n_C_isospin_sets, parametrization )) return;
+    double* D         = ( n_D_sets>0         ? D_sets         : 0 );
+    double* C_isospin = ( n_C_isospin_sets>0 ? C_isospin_sets : 0 );
+    array__run( n_s, array__chunk_inv/K+1, n_threads, [=]( int begin, int end ){
+        CRXS::XS::ensemble__inv_AA_pbar_CM( end-begin, s+begin, xF+begin, pT_pbar+begin, result+(long)K*begin, K, C_sets, D, C_isospin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+void array__ensemble__inv_AA_pbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, double* C_sets, int n_C_sets, double* D_sets, int n_D_sets, double* C_isospin_sets, int n_C_isospin_sets, int K, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads ){
+    if (!array__check( "array__ensemble__inv_AA_pbar_LAB", n_Tn_proj_LAB, n_T_pbar_LAB, n_eta_LAB )) return;
+    if (!array__check_ensemble( "array__ensemble__inv_AA_pbar_LAB", n_Tn_proj_LAB, n_result, K, n_C_sets, n_D_sets, n_C_isospin_sets, parametrization )) return;
+    double* D         = ( n_D_sets>0         ? D_sets         : 0 );
+    double* C_isospin = ( n_C_isospin_sets>0 ? C_isospin_sets : 0 );
+    array__run( n_Tn_proj_LAB, array__chunk_inv/K+1, n_threads, [=]( int begin, int end ){
+        CRXS::XS::ensemble__inv_AA_pbar_LAB( end-begin, Tn_proj_LAB+begin, T_pbar_LAB+begin, eta_LAB+begin, result+(long)K*begin, K, C_sets, D, C_isospin, A_projectile, N_projectile, A_target, N_target, parametrization );
+    });
+};
+
+
+//  Consecutive elements with the same proton energy (e.g. a broadcast spectrum) are evaluated in one batch call
+void array__dE_pp_gamma_LAB( double* T_p_LAB, int n_T_p_LAB, double* E_gamma_LAB, int n_E_gamma_LAB, double* result, int n_result, int n_threads ){
+    if (!array__check( "array__dE_pp_gamma_LAB", n_result, n_T_p_LAB, n_E_gamma_LAB )) return;
+    array__run( n_result, array__chunk_inv, n_threads, [=]( int begin, int end ){
+        for (int i=begin; i<end; ) {
+            int j = i+1;
+            while (j<end && T_p_LAB[j]==T_p_LAB[i]) j++;
+            CRXS::XS::batch__dE_pp_gamma_LAB( T_p_LAB[i], j-i, E_gamma_LAB+i, result+i );
+            i = j;
+        }
+    });
+};
+
+
+
+// source term
+void source_term( double* T_LAB, int n_T_LAB, double* result, int n_result, double* Tn, int n_Tn, double* flux, int n_flux, int* A_projectile, int n_A_projectile, int* N_projectile, int n_N_projectile, int* A_target, int n_A_target, int* N_target, int n_N_target, double* density, int n_density, int product, int parametrization, int coalescence, double epsrel, int n_threads ){
+    if (!array__check( "source_term", n_result, n_T_LAB )) return;
+    if (n_N_projectile!=n_A_projectile || n_flux!=n_A_projectile*n_Tn || n_A_target!=n_N_target || n_density!=n_A_target) {
+        printf( "Warning in xs_wrapper::source_term. The arrays of the projectiles or targets have different lengths, nothing is computed.\n" );
+        return;
+    }
+    CRXS::XS_source source( product, parametrization, coalescence );
+    source.fOptions.epsrel = epsrel;
+    for (int i=0; i<n_A_projectile; i++) {
+        source.AddProjectile( A_projectile[i], N_projectile[i], n_Tn, Tn, flux+(long)i*n_Tn );
+    }
+    for (int j=0; j<n_A_target; j++) {
+        source.AddTarget( A_target[j], N_target[j], density[j] );
+    }
+    source.Evaluate( n_T_LAB, T_LAB, result, n_threads );
+};
@@ -2,6 +2,11 @@
 // general
 
 void SetIntegrationMethod( int method );
+void SetIntegrationMethod_p( int method );
+void SetIntegrationMethod_antinuclei( int method );
+void SetIntegrationAccuracy( double epsrel );
+void SetGaussLegendreNodes( int nodes );
+void SetIntegrationVariable( int variable );
 void SetTrapezeIntegrationSteps( int steps );
 
 // pbar
@@ -39,3 +44,57 @@ double inv_AA_p_CM( double s, double xF, double pT_p, int A_projectile, int N_pr
 double inv_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, double eta_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization );
 double dE_AA_p_LAB( double Tn_proj_LAB, double T_p_LAB, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization);
 
+
+// gamma
+double dE_pp_gamma_LAB( double T_p_LAB, double E_gamma_LAB );
+
+
+
+// arrays
+//
+// Array versions of the functions above, called by XS_wrapper.py with broadcast and flattened numpy arrays. All kinematic
+// arrays and result have the same length. The loop runs in C++ without the GIL, split into chunks over n_threads threads
+// (n_threads<=0: all cores). Every thread uses the engine of the calling thread, so the results do not depend on n_threads.
+
+void array__tot_pp__diMauro( double* s, int n_s, double* result, int n_result, int n_threads );
+void array__el_pp__diMauro ( double* s, int n_s, double* result, int n_result, int n_threads );
+
+// pbar
+void array__inv_AA_pbar_CM( double* s, int n_s, double* xF, int n_xF, double* pT_pbar, int n_pT_pbar, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+void array__inv_AA_pbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+void array__dE_AA_pbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+void array__dE_AA_pbar_LAB_incNbarAndHyperon( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+
+// Dbar
+void array__inv_AA_Dbar_CM( double* s, int n_s, double* xF_Dbar, int n_xF_Dbar, double* pT_Dbar, int n_pT_Dbar, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, int n_threads );
+void array__inv_AA_Dbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, int n_threads );
+void array__dEn_AA_Dbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int coalescence, int n_threads );
+
+void array__dEn_DbarA_Dbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB, double* result, int n_result, int A_target, int N_target, int parametrization, int n_threads );
+
+// p
+void array__inv_AA_p_CM( double* s, int n_s, double* xF, int n_xF, double* pT_p, int n_pT_p, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+void array__inv_AA_p_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_p_LAB, int n_T_p_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+void array__dE_AA_p_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_p_LAB, int n_T_p_LAB, double* result, int n_result, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+
+// gradients with respect to the parameters: gradient[i*n_C+k] = d result[i]/d C_k (d D_k for gradient_D), cf. XS_definitions::gradient__*
+void array__gradient__inv_pp_pbar_CM__Winkler( double* s, int n_s, double* E_pbar, int n_E_pbar, double* pT_pbar, int n_pT_pbar, double* result, int n_result, double* gradient, int n_gradient, double* C_array, int len_C_array, int n_threads );
+void array__gradient__inv_pp_pbar_CM__diMauro( double* s, int n_s, double* E_pbar, int n_E_pbar, double* pT_pbar, int n_pT_pbar, double* result, int n_result, double* gradient, int n_gradient, double* C_array, int len_C_array, int n_threads );
+void array__gradient__factor__AA( double* s, int n_s, double* xF, int n_xF, double* result, int n_result, double* gradient_C, int n_gradient_C, double* gradient_D, int n_gradient_D, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+
+// ensembles of K parameter sets: result[i*K+k] for point i and set k, cf. XS::ensemble__inv_AA_pbar_CM (empty D_sets or C_isospin_sets: defaults)
+void array__ensemble__inv_AA_pbar_CM( double* s, int n_s, double* xF, int n_xF, double* pT_pbar, int n_pT_pbar, double* result, int n_result, double* C_sets, int n_C_sets, double* D_sets, int n_D_sets, double* C_isospin_sets, int n_C_isospin_sets, int K, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+void array__ensemble__inv_AA_pbar_LAB( double* Tn_proj_LAB, int n_Tn_proj_LAB, double* T_pbar_LAB, int n_T_pbar_LAB, double* eta_LAB, int n_eta_LAB, double* result, int n_result, double* C_sets, int n_C_sets, double* D_sets, int n_D_sets, double* C_isospin_sets, int n_C_isospin_sets, int K, int A_projectile, int N_projectile, int A_target, int N_target, int parametrization, int n_threads );
+
+// gamma
+void array__dE_pp_gamma_LAB( double* T_p_LAB, int n_T_p_LAB, double* E_gamma_LAB, int n_E_gamma_LAB, double* result, int n_result, int n_threads );
+
+
+
+// source term
+//
+// Secondary source term of CRXS::XS_source. The n_projectile projectiles have the fluxes flux[i*n_Tn+k] at the common
+// energies Tn[k], the n_target targets the densities density[j]. The integral over Tn runs in C++ without the GIL,
+// the energies T_LAB are distributed over n_threads threads.
+
+void source_term( double* T_LAB, int n_T_LAB, double* result, int n_result, double* Tn, int n_Tn, double* flux, int n_flux, int* A_projectile, int n_A_projectile, int* N_projectile, int n_N_projectile, int* A_target, int n_A_target, int* N_target, int n_N_target, double* density, int n_density, int product, int parametrization, int coalescence, double epsrel, int n_threads );
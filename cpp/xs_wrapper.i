@@ -1,4 +1,7 @@
-%module xs_wrapper
+//  threads="1": the wrapped evaluation functions are called without the GIL. The functions which change the state of the
+//  default engine (settings, restricted parameter spaces, SELF parameters) keep the GIL (nothreadallow below), such that
+//  they stay serialized with all other Python code.
+%module(threads="1") xs_wrapper
 %include "std_string.i"
 
 %{
@@ -15,6 +18,50 @@
 
 %apply (double* IN_ARRAY1, int DIM1) {(double* C_array, int len_C_array)};
 %apply (double* IN_ARRAY1, int DIM1) {(double* D_array, int len_D_array)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* C_sets, int n_C_sets)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* D_sets, int n_D_sets)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* C_isospin_sets, int n_C_isospin_sets)};
+
+%apply (double* IN_ARRAY1, int DIM1) {(double* s, int n_s)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* xF, int n_xF)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* pT_pbar, int n_pT_pbar)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* E_pbar, int n_E_pbar)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* pT_p, int n_pT_p)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* xF_Dbar, int n_xF_Dbar)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* pT_Dbar, int n_pT_Dbar)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* Tn_proj_LAB, int n_Tn_proj_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* T_pbar_LAB, int n_T_pbar_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* T_p_LAB, int n_T_p_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* E_gamma_LAB, int n_E_gamma_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* Tn_Dbar_LAB, int n_Tn_Dbar_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* eta_LAB, int n_eta_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* T_LAB, int n_T_LAB)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* Tn, int n_Tn)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* flux, int n_flux)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* density, int n_density)};
+%apply (int*    IN_ARRAY1, int DIM1) {(int* A_projectile, int n_A_projectile)};
+%apply (int*    IN_ARRAY1, int DIM1) {(int* N_projectile, int n_N_projectile)};
+%apply (int*    IN_ARRAY1, int DIM1) {(int* A_target, int n_A_target)};
+%apply (int*    IN_ARRAY1, int DIM1) {(int* N_target, int n_N_target)};
+%apply (double* INPLACE_ARRAY1, int DIM1) {(double* result, int n_result)};
+%apply (double* INPLACE_ARRAY1, int DIM1) {(double* gradient, int n_gradient)};
+%apply (double* INPLACE_ARRAY1, int DIM1) {(double* gradient_C, int n_gradient_C)};
+%apply (double* INPLACE_ARRAY1, int DIM1) {(double* gradient_D, int n_gradient_D)};
+
+%feature("nothreadallow") SetIntegrationMethod;
+%feature("nothreadallow") SetIntegrationMethod_p;
+%feature("nothreadallow") SetIntegrationMethod_antinuclei;
+%feature("nothreadallow") SetIntegrationAccuracy;
+%feature("nothreadallow") SetGaussLegendreNodes;
+%feature("nothreadallow") SetIntegrationVariable;
+%feature("nothreadallow") SetTrapezeIntegrationSteps;
+%feature("nothreadallow") SetRestrictedParameterSpace_LAB;
+%feature("nothreadallow") RemoveRestrictedParameterSpace_LAB;
+%feature("nothreadallow") SetRestrictedParameterSpace_CM;
+%feature("nothreadallow") RemoveRestrictedParameterSpace_CM;
+%feature("nothreadallow") SetRestricted_pp;
+%feature("nothreadallow") set_C_winkler_self;
+%feature("nothreadallow") set_D_winkler_self;
 
 %include "xs_wrapper.h"
 
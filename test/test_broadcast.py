@@ -0,0 +1,64 @@
+#! /usr/bin/env python3
+
+#
+#   Array arguments of CRXS.XS_wrapper: the kinematic arguments are broadcast against each other, and every element
+#   of the result equals the scalar call at the same point. Returns 0 if all checks pass.
+#
+
+import sys
+
+import numpy                         as np
+
+import CRXS.XS_wrapper               as XS
+
+
+failed = 0
+
+def check( passed, what ):
+    global failed
+    print( '%s  %s' % ( 'passed' if passed else 'FAILED', what ) )
+    if not passed:
+        failed += 1
+
+
+def compare( name, function, kinematics, **options ):
+    """
+        Calls function with the arrays in kinematics, and with the scalars of every point of the broadcast shape.
+        """
+    result = function( *kinematics, **options )
+    shape  = np.broadcast( *kinematics ).shape
+    check( np.shape(result)==shape, '%s: shape %s of the result is the broadcast shape %s' % ( name, np.shape(result), shape ) )
+    if np.shape(result)!=shape:
+        return
+    arrays = np.broadcast_arrays( *[ np.asarray(x, dtype=np.float64) for x in kinematics ] )
+    equal  = True
+    for index in np.ndindex( *shape ):
+        scalar = function( *[ float(x[index]) for x in arrays ], **options )
+        equal  = equal and ( result[index]==scalar or abs( result[index]/scalar-1 )<1e-12 )
+    check( equal, '%s: array elements equal the scalar calls' % name )
+
+
+#   columns against rows, and an array against a scalar
+s       = np.array( [ 20., 100., 1e3, 1e4 ] )[:,None]
+xF      = np.array( [ -0.3, 0., 0.1, 0.4, 0.7 ] )
+pT      = 0.5
+Tn_proj = np.array( [ 10., 100., 1e3 ] )[:,None]
+T_prod  = np.array( [ 0.5, 2., 10., 50. ] )
+eta     = np.array( [ 0.5, 2., 3.5, 5. ] )
+
+compare( 'inv_AA_pbar_CM',       XS.inv_AA_pbar_CM,       [ s, xF, pT ] )
+compare( 'inv_AA_pbar_CM (pHe)', XS.inv_AA_pbar_CM,       [ s, xF, pT ], A_target=4, N_target=2, parametrization='DI_MAURO_I' )
+compare( 'inv_AA_pbar_LAB',      XS.inv_AA_pbar_LAB,      [ Tn_proj, T_prod, eta ] )
+compare( 'dE_AA_pbar_LAB',       XS.dE_AA_pbar_LAB,       [ Tn_proj, T_prod ] )
+compare( 'inv_AA_p_CM',          XS.inv_AA_p_CM,          [ s, xF, pT ] )
+compare( 'inv_AA_Dbar_CM',       XS.inv_AA_Dbar_CM,       [ s, xF, pT ] )
+compare( 'dEn_AA_Dbar_LAB',      XS.dEn_AA_Dbar_LAB,      [ Tn_proj, T_prod ] )
+compare( 'dE_pp_gamma_LAB',      XS.dE_pp_gamma_LAB,      [ Tn_proj, T_prod ] )
+
+#   the results do not depend on the number of threads
+XS.SetNumberOfThreads( 4 )
+compare( 'dE_AA_pbar_LAB (4 threads)', XS.dE_AA_pbar_LAB, [ Tn_proj, T_prod ] )
+XS.SetNumberOfThreads( 1 )
+
+print( '%i checks failed' % failed )
+sys.exit( 1 if failed else 0 )